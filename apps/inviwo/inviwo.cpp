@@ -126,7 +126,7 @@ int main(int argc, char** argv) {
     // process last arguments
     if (clp.getQuitApplicationAfterStartup()) {
         mainWin.exitInviwo(false);
-        return 0;
+        return clp.getExitCode();
     }
 
     inviwo::util::setThreadDescription("Inviwo Main");
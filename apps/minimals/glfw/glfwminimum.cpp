@@ -168,7 +168,7 @@ int main(int argc, char** argv) {
 
     if (cmdparser.getQuitApplicationAfterStartup()) {
         glfwTerminate();
-        return 0;
+        return cmdparser.getExitCode();
     }
 
     while (CanvasGLFW::getVisibleWindowCount() > 0) {
@@ -230,7 +230,7 @@ int main(int argc, char** argv) {
     cmdparser.processCallbacks();  // run any command line callbacks from modules.
 
     if (cmdparser.getQuitApplicationAfterStartup()) {
-        return 0;
+        return cmdparser.getExitCode();
     } else {
         return qtApp.exec();
     }
@@ -1920,6 +1920,16 @@ namespace ticpp
 		*/
 		void RemoveAttribute( const std::string& name );
 
+		/**
+		Access the wrapped TiXmlElement.
+		Allows reading names and attribute values in place, without copying them into new strings.
+		*/
+		const TiXmlElement* GetTiXmlElement() const
+		{
+			ValidatePointer();
+			return m_tiXmlPointer;
+		}
+
 	private:
 
 		/**
@@ -36,7 +36,11 @@
 
 #include <glm/common.hpp>
 
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <iterator>
+#include <limits>
 #include <vector>
 #include <bitset>
 
@@ -84,6 +88,7 @@ protected:
 class IVW_CORE_API HistogramContainer {
 public:
     HistogramContainer() = default;
+    explicit HistogramContainer(std::vector<NormalizedHistogram> histograms);
     template <typename FirstIter, typename LastIter>
     HistogramContainer(dvec2 range, size_t bins, FirstIter begin, LastIter end);
 
@@ -102,64 +107,197 @@ private:
     std::vector<NormalizedHistogram> histograms_;
 };
 
-template <typename FirstIter, typename LastIter>
-HistogramContainer::HistogramContainer(dvec2 dataRange, size_t bins, FirstIter begin,
-                                       LastIter end) {
-    using T = typename std::iterator_traits<FirstIter>::value_type;
+namespace detail {
 
+/**
+ * Accumulates the bin counts and the statistics (min, max, sum and sum of squares) of a data
+ * range. Accumulators for disjoint parts of the data can be merged, which makes it possible to
+ * compute a histogram with one accumulator per thread. Values are processed in blocks, first
+ * converting a block to double and then computing the statistics and bin indices of the whole
+ * block, which keeps the inner loops simple enough to be vectorized.
+ */
+template <typename T>
+class HistogramAccumulator {
+public:
     // a double type with the same extent as T
     using D = typename util::same_extent<T, double>::type;
     // a size_t type with same extent as T
     using I = typename util::same_extent<T, size_t>::type;
 
-    constexpr size_t extent = util::rank<T>::value > 0 ? util::extent<T>::value : 1;
+    static constexpr size_t extent = util::rank<T>::value > 0 ? util::extent<T>::value : 1;
+    static constexpr size_t blockSize = 512;
+
+    HistogramAccumulator(dvec2 dataRange, size_t bins);
+
+    /// Add all values in [begin, end)
+    template <typename FirstIter, typename LastIter>
+    void add(FirstIter begin, LastIter end);
+
+    /// Add every @p stride:th value of the @p size values in @p data
+    void add(const T* data, size_t size, size_t stride);
+
+    /// Add the counts and statistics of @p other, which has to have the same range and bins
+    void merge(const HistogramAccumulator& other);
+
+    size_t count() const { return count_; }
+
+    /// Create one normalized histogram per channel
+    std::vector<NormalizedHistogram> histograms() const;
+
+private:
+    void addBlock(const D* values, size_t n);
+
+    dvec2 dataRange_;
+    size_t bins_;
+    D rangeMin_;
+    D rangeScaleFactor_;
+
+    std::array<std::vector<size_t>, extent> counts_;
+    D min_;
+    D max_;
+    D sum_;
+    D sum2_;
+    size_t count_;
+};
+
+template <typename T>
+HistogramAccumulator<T>::HistogramAccumulator(dvec2 dataRange, size_t bins)
+    : dataRange_{dataRange}
+    , bins_{bins}
+    , rangeMin_{}
+    , rangeScaleFactor_{}
+    , counts_{}
+    , min_(std::numeric_limits<double>::max())
+    , max_(std::numeric_limits<double>::lowest())
+    , sum_(0)
+    , sum2_(0)
+    , count_{0} {
 
     // check whether number of bins exceeds the data range only if it is an integral type
     if constexpr (!util::is_floating_point<typename util::value_type<T>::type>::value) {
-        bins = std::min(bins, static_cast<std::size_t>(dataRange.y - dataRange.x + 1));
-    }
-
-    std::array<std::vector<double>, extent> histData;
-    for (size_t i = 0; i < extent; ++i) {
-        histData[i].resize(bins, 0.0);
+        bins_ = std::min(bins_, static_cast<std::size_t>(dataRange.y - dataRange.x + 1));
     }
+    rangeMin_ = D(dataRange.x);
+    rangeScaleFactor_ = D(static_cast<double>(bins_ - 1) / (dataRange.y - dataRange.x));
 
-    D min(std::numeric_limits<double>::max());
-    D max(std::numeric_limits<double>::lowest());
-    D sum(0);
-    D sum2(0);
-    size_t count(0);
-
-    const D rangeMin(dataRange.x);
-    const D rangeScaleFactor(static_cast<double>(bins - 1) / (dataRange.y - dataRange.x));
+    for (auto& c : counts_) c.resize(bins_, 0);
+}
 
+template <typename T>
+template <typename FirstIter, typename LastIter>
+void HistogramAccumulator<T>::add(FirstIter begin, LastIter end) {
+    std::array<D, blockSize> values;
+    size_t n = 0;
     for (; begin != end; ++begin) {
+        values[n++] = static_cast<D>(*begin);
+        if (n == blockSize) {
+            addBlock(values.data(), n);
+            n = 0;
+        }
+    }
+    addBlock(values.data(), n);
+}
 
-        const auto val = static_cast<D>(*begin);
+template <typename T>
+void HistogramAccumulator<T>::add(const T* data, size_t size, size_t stride) {
+    std::array<D, blockSize> values;
+    if (stride == 1) {
+        for (size_t offset = 0; offset < size; offset += blockSize) {
+            const size_t n = std::min(blockSize, size - offset);
+            const T* src = data + offset;
+            for (size_t i = 0; i < n; ++i) values[i] = static_cast<D>(src[i]);
+            addBlock(values.data(), n);
+        }
+    } else {
+        size_t n = 0;
+        for (size_t i = 0; i < size; i += stride) {
+            values[n++] = static_cast<D>(data[i]);
+            if (n == blockSize) {
+                addBlock(values.data(), n);
+                n = 0;
+            }
+        }
+        addBlock(values.data(), n);
+    }
+}
 
-        min = glm::min(min, val);
-        max = glm::max(max, val);
-        sum += val;
-        sum2 += val * val;
-        count++;
+template <typename T>
+void HistogramAccumulator<T>::addBlock(const D* values, size_t n) {
+    if (n == 0) return;
 
-        const auto ind = static_cast<I>(glm::clamp((val - rangeMin) * rangeScaleFactor, D{0.0},
-                                                   D{static_cast<double>(bins - 1)}));
-        for (size_t i = 0; i < extent; ++i) {
-            const auto v = util::glmcomp(ind, i);
-            ++histData[i][v];
+    D min = min_;
+    D max = max_;
+    D sum(0);
+    D sum2(0);
+    for (size_t i = 0; i < n; ++i) {
+        min = glm::min(min, values[i]);
+        max = glm::max(max, values[i]);
+        sum += values[i];
+        sum2 += values[i] * values[i];
+    }
+    min_ = min;
+    max_ = max;
+    sum_ += sum;
+    sum2_ += sum2;
+    count_ += n;
+
+    std::array<I, blockSize> indices;
+    const D maxIndex{static_cast<double>(bins_ - 1)};
+    for (size_t i = 0; i < n; ++i) {
+        indices[i] = static_cast<I>(
+            glm::clamp((values[i] - rangeMin_) * rangeScaleFactor_, D{0.0}, maxIndex));
+    }
+    for (size_t c = 0; c < extent; ++c) {
+        auto* counts = counts_[c].data();
+        for (size_t i = 0; i < n; ++i) {
+            ++counts[util::glmcomp(indices[i], c)];
         }
     }
+}
+
+template <typename T>
+void HistogramAccumulator<T>::merge(const HistogramAccumulator& other) {
+    for (size_t c = 0; c < extent; ++c) {
+        std::transform(counts_[c].begin(), counts_[c].end(), other.counts_[c].begin(),
+                       counts_[c].begin(), std::plus<>{});
+    }
+    min_ = glm::min(min_, other.min_);
+    max_ = glm::max(max_, other.max_);
+    sum_ += other.sum_;
+    sum2_ += other.sum2_;
+    count_ += other.count_;
+}
+
+template <typename T>
+std::vector<NormalizedHistogram> HistogramAccumulator<T>::histograms() const {
+    const auto dcount = static_cast<double>(count_);
+    const auto mean = sum_ / dcount;
+    const auto stddev = glm::sqrt((dcount * sum2_ - sum_ * sum_) / (dcount * (dcount - D{1})));
+
+    std::vector<NormalizedHistogram> histograms;
+    for (size_t c = 0; c < extent; ++c) {
+        histograms.emplace_back(dataRange_,
+                                std::vector<double>(counts_[c].begin(), counts_[c].end()),
+                                util::glmcomp(min_, c), util::glmcomp(max_, c),
+                                util::glmcomp(mean, c), util::glmcomp(stddev, c));
+    }
+    return histograms;
+}
+
+}  // namespace detail
 
-    const auto dcount = static_cast<double>(count);
-    const auto mean = sum / dcount;
-    const auto stddev = glm::sqrt((dcount * sum2 - sum * sum) / (dcount * (dcount - D{1})));
+template <typename FirstIter, typename LastIter>
+HistogramContainer::HistogramContainer(dvec2 dataRange, size_t bins, FirstIter begin,
+                                       LastIter end) {
+    using T = typename std::iterator_traits<FirstIter>::value_type;
 
-    for (size_t i = 0; i < extent; ++i) {
-        histograms_.emplace_back(dataRange, std::move(histData[i]), util::glmcomp(min, i),
-                                 util::glmcomp(max, i), util::glmcomp(mean, i),
-                                 util::glmcomp(stddev, i));
+    detail::HistogramAccumulator<T> accumulator(dataRange, bins);
+    if constexpr (std::is_pointer_v<FirstIter> && std::is_same_v<FirstIter, LastIter>) {
+        accumulator.add(static_cast<const T*>(begin), static_cast<size_t>(end - begin), 1);
+    } else {
+        accumulator.add(begin, end);
     }
+    histograms_ = accumulator.histograms();
 }
 
 }  // namespace inviwo
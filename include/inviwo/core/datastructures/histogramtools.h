@@ -36,6 +36,7 @@
 
 #include <atomic>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace inviwo {
@@ -56,14 +57,27 @@ public:
 
     void whenDone(std::function<void(const HistogramContainer&)> callback);
 
+    /**
+     * Register a callback for the preview histograms. For large data sets a preview is first
+     * computed from a strided subsample of the data, and published before the full histograms are
+     * done. The callback is not called if the full histograms are done before the preview, or if
+     * the data set is small enough to not need a preview.
+     * @see HistogramSupplier::previewSampleCount
+     */
+    void whenPreview(std::function<void(const HistogramContainer&)> callback);
+
     size_t getBins() const { return bins_; }
     dvec2 getDataRange() const { return dataRange_; }
+    bool isDone() const { return done; }
+    bool hasPreview() const { return preview_.has_value(); }
 
 private:
     std::weak_ptr<HistogramContainer> container_;
     Dispatcher<void(const HistogramContainer&)> callbacks_;
+    Dispatcher<void(const HistogramContainer&)> previewCallbacks_;
     std::vector<std::shared_ptr<std::function<void(const HistogramContainer&)>>> callbackHandles_;
     std::shared_ptr<std::atomic<bool>> stop_;
+    std::optional<HistogramContainer> preview_;
     bool done = false;
 
     size_t bins_;
@@ -72,6 +86,14 @@ private:
 
 class IVW_CORE_API HistogramSupplier {
 public:
+    /**
+     * Data sets with more than 4 times this number of elements will first get a preview histogram
+     * computed from approximately this many samples.
+     */
+    static constexpr size_t previewSampleCount = size_t{1} << 22;
+    /// Smallest number of elements handled by each job when computing histograms in parallel
+    static constexpr size_t minElementsPerJob = size_t{1} << 18;
+
     HistogramSupplier();
     HistogramSupplier(const HistogramSupplier& rhs);
     HistogramSupplier(HistogramSupplier&& rhs) = default;
@@ -96,6 +118,8 @@ protected:
 private:
     static void done(std::shared_ptr<HistogramCalculationState> state,
                      HistogramContainer histograms);
+    static void preview(std::shared_ptr<HistogramCalculationState> state,
+                        HistogramContainer histograms);
 
     mutable std::shared_ptr<HistogramCalculationState> calculation_;
     mutable std::shared_ptr<HistogramContainer> histograms_;
@@ -31,6 +31,7 @@
 
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/datastructures/image/layerrepresentation.h>
+#include <inviwo/core/datastructures/minmaxcache.h>
 #include <inviwo/core/util/formats.h>
 #include <inviwo/core/util/assertion.h>
 #include <inviwo/core/util/formatdispatching.h>
@@ -59,6 +60,10 @@ public:
      */
     virtual bool copyRepresentationsTo(LayerRepresentation*) const override;
 
+    /**
+     * Non-const access to the data. Calling any of the non-const accessors increments the
+     * modification count of the MinMaxCache, @see getMinMaxCache.
+     */
     virtual void* getData() = 0;
     virtual const void* getData() const = 0;
 
@@ -90,6 +95,12 @@ public:
 
     virtual std::type_index getTypeIndex() const override final;
 
+    /**
+     * Cache of the component-wise minimum and maximum values, used by util::layerMinMax. Cached
+     * values are invalidated whenever the data is accessed through a non-const accessor.
+     */
+    MinMaxCache& getMinMaxCache() const { return minMaxCache_; }
+
     /**
      * Dispatch functionality to retrieve the actual underlaying LayerRamPrecision.
      * The dispatcher takes a generic lambda as argument. Code will be instantiated for all the
@@ -144,6 +155,9 @@ public:
     template <typename Result, template <class> class Predicate = dispatching::filter::All,
               typename Callable, typename... Args>
     auto dispatch(Callable&& callable, Args&&... args) const -> Result;
+
+protected:
+    mutable MinMaxCache minMaxCache_;
 };
 
 /**
@@ -168,6 +182,9 @@ public:
     virtual LayerRAMPrecision<T>* clone() const override;
     virtual ~LayerRAMPrecision() = default;
 
+    /**
+     * Invalidates the MinMaxCache, @see LayerRAM::getData
+     */
     T* getDataTyped();
     const T* getDataTyped() const;
 
@@ -303,6 +320,7 @@ LayerRAMPrecision<T>* LayerRAMPrecision<T>::clone() const {
 
 template <typename T>
 T* inviwo::LayerRAMPrecision<T>::getDataTyped() {
+    minMaxCache_.invalidate();
     return data_.get();
 }
 
@@ -313,6 +331,7 @@ const T* inviwo::LayerRAMPrecision<T>::getDataTyped() const {
 
 template <typename T>
 void* LayerRAMPrecision<T>::getData() {
+    minMaxCache_.invalidate();
     return data_.get();
 }
 template <typename T>
@@ -322,6 +341,7 @@ const void* LayerRAMPrecision<T>::getData() const {
 
 template <typename T>
 void inviwo::LayerRAMPrecision<T>::setData(void* d, size2_t dimensions) {
+    minMaxCache_.invalidate();
     std::unique_ptr<T[]> data(static_cast<T*>(d));
     data_.swap(data);
     std::swap(dimensions_, dimensions);
@@ -329,6 +349,7 @@ void inviwo::LayerRAMPrecision<T>::setData(void* d, size2_t dimensions) {
 
 template <typename T>
 void LayerRAMPrecision<T>::setDimensions(size2_t dimensions) {
+    minMaxCache_.invalidate();
     if (dimensions != dimensions_) {
         auto data = std::make_unique<T[]>(dimensions.x * dimensions.y);
         data_.swap(data);
@@ -393,21 +414,25 @@ dvec4 LayerRAMPrecision<T>::getAsDVec4(const size2_t& pos) const {
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromDouble(const size2_t& pos, double val) {
+    minMaxCache_.invalidate();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromDVec2(const size2_t& pos, dvec2 val) {
+    minMaxCache_.invalidate();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromDVec3(const size2_t& pos, dvec3 val) {
+    minMaxCache_.invalidate();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromDVec4(const size2_t& pos, dvec4 val) {
+    minMaxCache_.invalidate();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
@@ -433,21 +458,25 @@ dvec4 LayerRAMPrecision<T>::getAsNormalizedDVec4(const size2_t& pos) const {
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromNormalizedDouble(const size2_t& pos, double val) {
+    minMaxCache_.invalidate();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromNormalizedDVec2(const size2_t& pos, dvec2 val) {
+    minMaxCache_.invalidate();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromNormalizedDVec3(const size2_t& pos, dvec3 val) {
+    minMaxCache_.invalidate();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromNormalizedDVec4(const size2_t& pos, dvec4 val) {
+    minMaxCache_.invalidate();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
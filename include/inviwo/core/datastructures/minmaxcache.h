@@ -0,0 +1,99 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/glmvec.h>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace inviwo {
+
+/**
+ * \ingroup datastructures
+ * \brief Thread safe cache of the component-wise minimum and maximum values of a representation.
+ *
+ * The values are set by the functions computing them, i.e. util::volumeMinMax and
+ * util::layerMinMax. The owning representation calls invalidate() from every non-const data
+ * accessor, which increments a modification count. Cached values are tagged with the count that
+ * was current when their computation started and are only returned while the count is unchanged,
+ * hence a result computed while the data was accessed for writing is never served. Values are
+ * stored separately for the computation including and excluding special values (NaN and Inf).
+ * Copies of the cache keep the cached values since the copied data is identical.
+ */
+class IVW_CORE_API MinMaxCache {
+public:
+    using MinMax = std::pair<dvec4, dvec4>;
+
+    MinMaxCache() = default;
+    MinMaxCache(const MinMaxCache& rhs);
+    MinMaxCache& operator=(const MinMaxCache& that);
+    ~MinMaxCache() = default;
+
+    /**
+     * The current modification count. Read it before computing the values passed to set().
+     */
+    size_t getModificationCount() const {
+        return modificationCount_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Returns the cached values if they were computed at the current modification count.
+     */
+    std::optional<MinMax> get(bool ignoreSpecialValues) const;
+
+    /**
+     * Cache @p minMax computed from the data at @p modificationCount. The values are discarded if
+     * the data has been accessed for writing since then.
+     */
+    void set(bool ignoreSpecialValues, const MinMax& minMax, size_t modificationCount);
+
+    /**
+     * Increment the modification count, invalidating all cached values. Lock free, it is called
+     * for every non-const data access.
+     */
+    void invalidate() { modificationCount_.fetch_add(1, std::memory_order_acq_rel); }
+
+private:
+    struct Entry {
+        MinMax minMax;
+        size_t modificationCount;
+    };
+
+    mutable std::mutex mutex_;
+    std::array<std::optional<Entry>, 2> values_{};
+    std::atomic<size_t> modificationCount_{0};
+};
+
+}  // namespace inviwo
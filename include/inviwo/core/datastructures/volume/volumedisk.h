@@ -38,6 +38,26 @@
 
 namespace inviwo {
 
+class VolumeRAM;
+
+/**
+ * \ingroup datastructures
+ * A DiskRepresentationLoader that in addition to loading the whole volume can read a sub-region
+ * of it, reading only the bytes needed for that region from the source.
+ * \see VolumeDisk::readRegion
+ */
+class IVW_CORE_API VolumeRegionLoader : public DiskRepresentationLoader<VolumeRepresentation> {
+public:
+    virtual VolumeRegionLoader* clone() const override = 0;
+
+    /**
+     * Read the region of @p src starting at voxel @p offset, with the dimensions of @p dest,
+     * into @p dest. The region has to be inside the dimensions of @p src.
+     */
+    virtual void updateRegion(std::shared_ptr<VolumeRepresentation> dest,
+                              const VolumeRepresentation& src, size3_t offset) const = 0;
+};
+
 /**
  * \ingroup datastructures
  */
@@ -78,6 +98,21 @@ public:
     virtual void setWrapping(const Wrapping3D& wrapping) override;
     virtual Wrapping3D getWrapping() const override;
 
+    /**
+     * Returns true if the loader supports reading sub-regions, \see VolumeRegionLoader
+     */
+    bool canReadRegion() const;
+
+    /**
+     * Read a sub-region of the volume into a new VolumeRAM without loading the whole volume.
+     * The wrapping of the new representation is set to clamp for axes that are cut.
+     * @param offset the first voxel of the region
+     * @param extent the dimensions of the region
+     * @throw Exception if the loader does not support regions or if the region is outside the
+     *        volume
+     */
+    std::shared_ptr<VolumeRAM> readRegion(size3_t offset, size3_t extent) const;
+
 private:
     size3_t dimensions_;
     SwizzleMask swizzleMask_;
@@ -32,6 +32,7 @@
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/datastructures/volume/volumerepresentation.h>
 #include <inviwo/core/datastructures/histogram.h>
+#include <inviwo/core/datastructures/minmaxcache.h>
 #include <inviwo/core/util/glmvec.h>
 #include <inviwo/core/util/formats.h>
 #include <inviwo/core/util/formatdispatching.h>
@@ -52,6 +53,10 @@ public:
     virtual VolumeRAM* clone() const override = 0;
     virtual ~VolumeRAM() = default;
 
+    /**
+     * Non-const access to the data. Calling any of the non-const accessors increments the
+     * modification count of the MinMaxCache, @see getMinMaxCache.
+     */
     virtual void* getData() = 0;
     virtual const void* getData() const = 0;
     virtual void* getData(size_t) = 0;
@@ -98,6 +103,12 @@ public:
 
     virtual std::type_index getTypeIndex() const override final;
 
+    /**
+     * Cache of the component-wise minimum and maximum values, used by util::volumeMinMax. Cached
+     * values are invalidated whenever the data is accessed through a non-const accessor.
+     */
+    MinMaxCache& getMinMaxCache() const { return minMaxCache_; }
+
     /**
      * Dispatch functionality to retrieve the actual underlaying VolumeRamPrecision.
      * The dispatcher takes a generic lambda as argument. Code will be instantiated for all the
@@ -152,6 +163,9 @@ public:
     template <typename Result, template <class> class Predicate = dispatching::filter::All,
               typename Callable, typename... Args>
     auto dispatch(Callable&& callable, Args&&... args) const -> Result;
+
+protected:
+    mutable MinMaxCache minMaxCache_;
 };
 
 class Volume;
@@ -182,6 +196,9 @@ public:
     virtual VolumeRAMPrecision<T>* clone() const override;
     virtual ~VolumeRAMPrecision();
 
+    /**
+     * Invalidates the MinMaxCache, @see VolumeRAM::getData
+     */
     T* getDataTyped();
     const T* getDataTyped() const;
 
@@ -346,11 +363,13 @@ const T* inviwo::VolumeRAMPrecision<T>::getDataTyped() const {
 
 template <typename T>
 T* inviwo::VolumeRAMPrecision<T>::getDataTyped() {
+    minMaxCache_.invalidate();
     return data_.get();
 }
 
 template <typename T>
 void* VolumeRAMPrecision<T>::getData() {
+    minMaxCache_.invalidate();
     return data_.get();
 }
 template <typename T>
@@ -360,6 +379,7 @@ const void* VolumeRAMPrecision<T>::getData() const {
 
 template <typename T>
 void* VolumeRAMPrecision<T>::getData(size_t pos) {
+    minMaxCache_.invalidate();
     return data_.get() + pos;
 }
 
@@ -370,6 +390,7 @@ const void* VolumeRAMPrecision<T>::getData(size_t pos) const {
 
 template <typename T>
 void VolumeRAMPrecision<T>::setData(void* d, size3_t dimensions) {
+    minMaxCache_.invalidate();
     std::unique_ptr<T[]> data(static_cast<T*>(d));
     data_.swap(data);
     std::swap(dimensions_, dimensions);
@@ -395,6 +416,7 @@ size_t VolumeRAMPrecision<T>::getNumberOfBytes() const {
 
 template <typename T>
 void VolumeRAMPrecision<T>::setDimensions(size3_t dimensions) {
+    minMaxCache_.invalidate();
     if (dimensions_ != dimensions) {
         auto data = std::make_unique<T[]>(dimensions.x * dimensions.y * dimensions.z);
         data_.swap(data);
@@ -456,21 +478,25 @@ dvec4 VolumeRAMPrecision<T>::getAsDVec4(const size3_t& pos) const {
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDouble(const size3_t& pos, double val) {
+    minMaxCache_.invalidate();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDVec2(const size3_t& pos, dvec2 val) {
+    minMaxCache_.invalidate();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDVec3(const size3_t& pos, dvec3 val) {
+    minMaxCache_.invalidate();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDVec4(const size3_t& pos, dvec4 val) {
+    minMaxCache_.invalidate();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
@@ -496,21 +522,25 @@ dvec4 VolumeRAMPrecision<T>::getAsNormalizedDVec4(const size3_t& pos) const {
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDouble(const size3_t& pos, double val) {
+    minMaxCache_.invalidate();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDVec2(const size3_t& pos, dvec2 val) {
+    minMaxCache_.invalidate();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDVec3(const size3_t& pos, dvec3 val) {
+    minMaxCache_.invalidate();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDVec4(const size3_t& pos, dvec4 val) {
+    minMaxCache_.invalidate();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
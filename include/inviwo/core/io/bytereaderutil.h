@@ -30,6 +30,7 @@
 #pragma once
 
 #include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/glmvec.h>
 #include <string_view>
 #include <filesystem>
 
@@ -40,6 +41,16 @@ namespace util {
 void IVW_CORE_API readBytesIntoBuffer(const std::filesystem::path& file, size_t offset,
                                       size_t bytes, bool littleEndian, size_t elementSize,
                                       void* dest);
+
+/**
+ * Read the sub-region @p regionOffset, @p regionExtent of a volume with dimensions @p dims stored
+ * at @p offset in @p file into @p dest. Whole rows and slices of the region are read at once.
+ * For regions that only cover part of the rows, all rows of a slice are read in one go, which
+ * reads some bytes outside of the region but avoids seeking for every row.
+ */
+void IVW_CORE_API readRegionIntoBuffer(const std::filesystem::path& file, size_t offset,
+                                       size3_t dims, size3_t regionOffset, size3_t regionExtent,
+                                       bool littleEndian, size_t elementSize, void* dest);
 }  // namespace util
 
 }  // namespace inviwo
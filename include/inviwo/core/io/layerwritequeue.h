@@ -0,0 +1,117 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/io/datawriter.h>
+#include <inviwo/core/util/exceptionpropagator.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace inviwo {
+
+class InviwoApplication;
+class Layer;
+
+/**
+ * \ingroup dataio
+ * @brief Writes layers to disk on the thread pool.
+ *
+ * The layer is copied into a LayerRAM snapshot on the calling thread, after that encoding and
+ * writing run on the thread pool, so the caller only pays for the copy. Encoding of several
+ * layers runs in parallel, but the files are written in the order they were queued. At most
+ * getMaxQueued() layers are held in memory, queueing more blocks until an earlier layer has been
+ * written. Errors from the pool threads are rethrown by the next call to write() or wait().
+ */
+class IVW_CORE_API LayerWriteQueue {
+public:
+    using Writer = std::shared_ptr<const DataWriterType<Layer>>;
+    /// Called on a pool thread after a file has been written
+    using Callback = std::function<void(const std::filesystem::path&)>;
+
+    explicit LayerWriteQueue(InviwoApplication* app, size_t maxQueued = 8);
+    LayerWriteQueue(const LayerWriteQueue&) = delete;
+    LayerWriteQueue(LayerWriteQueue&&) = delete;
+    LayerWriteQueue& operator=(const LayerWriteQueue&) = delete;
+    LayerWriteQueue& operator=(LayerWriteQueue&&) = delete;
+    /// Waits for all queued layers, any errors are logged.
+    ~LayerWriteQueue();
+
+    /**
+     * Queue a snapshot of @p layer to be written to @p file using @p writer.
+     * @throws the first error of any earlier write
+     */
+    void write(const Layer& layer, Writer writer, const std::filesystem::path& file,
+               Callback onWritten = {});
+    /**
+     * Queue @p layer to be written to @p file using @p writer without making a copy. The layer
+     * must not be modified until it has been written.
+     * @throws the first error of any earlier write
+     */
+    void write(std::shared_ptr<const Layer> layer, Writer writer,
+               const std::filesystem::path& file, Callback onWritten = {});
+
+    /**
+     * Block until all queued layers have been written.
+     * @throws the first error of any earlier write
+     */
+    void wait();
+
+    /// The number of layers queued but not yet written
+    size_t size() const;
+
+    size_t getMaxQueued() const;
+    void setMaxQueued(size_t maxQueued);
+
+private:
+    void encode(size_t index, std::shared_ptr<const Layer> layer, Writer writer,
+                std::filesystem::path file, Callback onWritten);
+    void flush(std::unique_lock<std::mutex>& lock);
+
+    InviwoApplication* app_;
+    size_t maxQueued_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable written_;
+    size_t queuedCount_;
+    size_t writtenCount_;
+    bool flushing_;
+    /// Encoded layers waiting for earlier layers to be written, keyed on queue order
+    std::map<size_t, std::function<void()>> ready_;
+
+    ExceptionPropagator exception_;
+};
+
+}  // namespace inviwo
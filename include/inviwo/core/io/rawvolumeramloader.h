@@ -33,7 +33,9 @@
 #include <inviwo/core/io/bytereaderutil.h>
 #include <inviwo/core/io/datareaderexception.h>
 #include <inviwo/core/datastructures/diskrepresentation.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
 #include <inviwo/core/datastructures/volume/volumerepresentation.h>
+#include <inviwo/core/util/volumereorientation.h>
 
 #include <string>
 #include <memory>
@@ -44,21 +46,28 @@ namespace inviwo {
  * \class RawVolumeRAMLoader
  * \brief A loader of raw files. Used to create VolumeRAM representations.
  * This class us used by the DatVolumeSequenceReader, IvfVolumeReader and RawVolumeReader.
+ * An optional reorientation is applied in place after reading, in that case the dimensions of the
+ * VolumeRepresentation refer to the reoriented volume, and not to the layout in the raw file.
+ * Sub-regions are read directly from the file without loading the whole volume.
  */
 
-class IVW_CORE_API RawVolumeRAMLoader : public DiskRepresentationLoader<VolumeRepresentation> {
+class IVW_CORE_API RawVolumeRAMLoader : public VolumeRegionLoader {
 public:
-    RawVolumeRAMLoader(const std::filesystem::path& rawFile, size_t offset, bool littleEndian);
+    RawVolumeRAMLoader(const std::filesystem::path& rawFile, size_t offset, bool littleEndian,
+                       const util::VolumeReorientation& reorientation = {});
     virtual RawVolumeRAMLoader* clone() const override;
     virtual std::shared_ptr<VolumeRepresentation> createRepresentation(
         const VolumeRepresentation& src) const override;
     virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
                                       const VolumeRepresentation& src) const override;
+    virtual void updateRegion(std::shared_ptr<VolumeRepresentation> dest,
+                              const VolumeRepresentation& src, size3_t offset) const override;
 
 private:
     std::filesystem::path rawFile_;
     size_t offset_;
     bool littleEndian_;
+    util::VolumeReorientation reorientation_;
 };
 
 }  // namespace inviwo
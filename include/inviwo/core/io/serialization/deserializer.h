@@ -49,6 +49,8 @@
 #include <map>
 #include <unordered_map>
 #include <filesystem>
+#include <cstring>
+#include <limits>
 
 #include <fmt/core.h>
 
@@ -333,9 +335,15 @@ constexpr bool canDeserialize() {
 
 IVW_CORE_API std::string getNodeAttribute(TxElement* node, std::string_view key);
 
+/**
+ * Get the value of attribute \p key of \p node without copying it. The view is valid as long as
+ * the node is not modified. Returns an empty view if the attribute does not exist.
+ */
+IVW_CORE_API std::string_view getNodeAttributeView(TxElement* node, std::string_view key);
+
 template <typename T>
 void getNodeAttribute(TxElement* node, std::string_view key, T& dest) {
-    const auto val = getNodeAttribute(node, key);
+    const auto val = getNodeAttributeView(node, key);
     if (!val.empty()) {
         detail::fromStr(val, dest);
     }
@@ -692,11 +700,11 @@ std::basic_istream<Elem, Traits>& operator>>(std::basic_istream<Elem, Traits>& i
             wrapper.value = std::numeric_limits<T>::quiet_NaN();
         else if (tmp == "-nan" || tmp == "-nan(ind)")
             wrapper.value = -std::numeric_limits<T>::quiet_NaN();
-        else
+        else {
             is.setstate(std::ios_base::failbit);
-
-        throw SerializationException("Error deserializing value: \"" + tmp + "\"",
-                                     IVW_CONTEXT_CUSTOM("Deserialization"));
+            throw SerializationException("Error deserializing value: \"" + tmp + "\"",
+                                         IVW_CONTEXT_CUSTOM("Deserialization"));
+        }
     }
 
     return is;
@@ -711,6 +719,17 @@ void Deserializer::getSafeValue(std::string_view key, T& data) {
 // reals specialization for reals to handled inf/nan values
 template <typename T, typename std::enable_if<util::is_floating_point<T>::value, int>::type>
 void Deserializer::getSafeValue(std::string_view key, T& data) {
+    if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+        // Fast path, numericalFromStr throws for anything it can not fully parse, in which case we
+        // fall back to stream parsing with handling of inf/nan
+        const auto val = detail::getNodeAttributeView(rootElement_, key);
+        if (val.empty()) return;
+        try {
+            detail::numericalFromStr(val, data);
+            return;
+        } catch (const SerializationException&) {
+        }
+    }
     ParseWrapper<T> wrapper(data);
     try {
         detail::getNodeAttribute(rootElement_, key, wrapper);
@@ -912,6 +931,33 @@ void Deserializer::deserialize(std::string_view key, std::vector<T>& vector,
     NodeSwitch vectorNodeSwitch(*this, key);
     if (!vectorNodeSwitch) return;
 
+    if constexpr (detail::isBinarySerializable<T>()) {
+        // Written by Serializer::serializeBinary
+        if (const auto encoding =
+                detail::getNodeAttributeView(rootElement_, SerializeConstants::EncodingAttribute);
+            !encoding.empty()) {
+            try {
+                size_t count = 0;
+                detail::getNodeAttribute(rootElement_, SerializeConstants::CountAttribute, count);
+                const auto content = detail::getNodeAttributeView(
+                    rootElement_, SerializeConstants::ContentAttribute);
+                if (count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+                    throw SerializationException(
+                        fmt::format("Invalid binary item count {}", count), IVW_CONTEXT);
+                }
+                // Validate the payload before allocating anything based on the count
+                const auto bytes = detail::decodeBinary(
+                    content, encoding, sizeof(util::value_type_t<T>), count * sizeof(T));
+                std::vector<T> items(count);
+                std::memcpy(items.data(), bytes.data(), bytes.size());
+                vector = std::move(items);
+            } catch (...) {
+                handleError(IVW_CONTEXT);
+            }
+            return;
+        }
+    }
+
     size_t i = 0;
     detail::forEachChild(rootElement_, itemKey, [&](TxElement* child) {
         // In the next deserialization call do not fetch the "child" since we are looping...
@@ -32,10 +32,14 @@
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/io/serialization/serializeconstants.h>
 #include <inviwo/core/io/serialization/serializationexception.h>
+#include <inviwo/core/util/glmutils.h>
 
 #include <map>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <array>
+#include <span>
 #include <sstream>
 #include <filesystem>
 
@@ -157,10 +161,35 @@ public:
 protected:
     friend class NodeSwitch;
 
+    /**
+     * \brief Find the first child element of \p parent named \p key
+     *
+     * When the child index is enabled, the children of each searched element are indexed by
+     * name on first access, making repeated lookups logarithmic and reusing the same TxElement
+     * wrappers instead of allocating new ones on every lookup. The index lives in an arena that is
+     * released as a whole. Otherwise the children are searched linearly.
+     * @return the child or nullptr if not found.
+     */
+    TxElement* findChild(TxElement* parent, std::string_view key);
+
+    /**
+     * \brief Enable indexing of child elements in findChild, the document must not be modified
+     * while the index is in use, call invalidateChildIndex after any modification.
+     */
+    void enableChildIndex();
+
+    /**
+     * \brief Drop all indexed elements, needed after modifying the document.
+     */
+    void invalidateChildIndex();
+
+    struct ChildIndex;
+
     std::filesystem::path fileName_;
     std::unique_ptr<TxDocument> doc_;
     TxElement* rootElement_;
     bool retrieveChild_;
+    std::unique_ptr<ChildIndex> childIndex_;
 };
 
 namespace detail {
@@ -194,18 +223,48 @@ decltype(auto) toStr(const T& value) {
 }
 
 template <class T>
-void fromStr(const std::string& value, T& dest) {
+void fromStr(std::string_view value, T& dest) {
     if constexpr (std::is_same_v<std::string, T>) {
         dest = value;
     } else if constexpr (std::is_same_v<double, T> || std::is_same_v<float, T> ||
                          (!std::is_same_v<bool, T> && std::is_integral_v<T>)) {
         numericalFromStr(value, dest);
     } else {
-        std::istringstream stream{value};
+        std::istringstream stream{std::string{value}};
         stream >> dest;
     }
 }
 
+/**
+ * Types that can be serialized as one block of binary data instead of one node per item, i.e.
+ * arithmetic types and glm vectors and matrices of them.
+ */
+template <typename T>
+constexpr bool isBinarySerializable() {
+    using V = util::value_type_t<T>;
+    return std::is_arithmetic_v<V> && !std::is_same_v<V, bool> &&
+           sizeof(T) == sizeof(V) * util::flat_extent_v<T>;
+}
+
+/**
+ * Encode \p bytes as little-endian base64, compressing them with zlib first if \p compress is
+ * set. \p componentSize is the size of each scalar component, used for byte swapping on
+ * big-endian hosts.
+ * @throws SerializationException if the compression fails
+ */
+IVW_CORE_API std::string encodeBinary(std::span<const char> bytes, size_t componentSize,
+                                      bool compress);
+
+/**
+ * Decode data encoded by encodeBinary. \p encoding is either SerializeConstants::BinaryEncoding
+ * or SerializeConstants::CompressedBinaryEncoding. Compressed data is never inflated beyond
+ * \p expectedSize bytes.
+ * @throws SerializationException for unknown encodings, or if the decoded data is not exactly
+ * \p expectedSize bytes.
+ */
+IVW_CORE_API std::string decodeBinary(std::string_view encoded, std::string_view encoding,
+                                      size_t componentSize, size_t expectedSize);
+
 }  // namespace detail
 
 class IVW_CORE_API NodeSwitch {
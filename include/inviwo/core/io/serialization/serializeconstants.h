@@ -45,6 +45,11 @@ public:
 
     static constexpr std::string_view TypeAttribute = "type";
 
+    static constexpr std::string_view EncodingAttribute = "encoding";
+    static constexpr std::string_view CountAttribute = "count";
+    static constexpr std::string_view BinaryEncoding = "base64";
+    static constexpr std::string_view CompressedBinaryEncoding = "zlib+base64";
+
     static constexpr std::string_view VectorAttributes[] = {"x", "y", "z", "w"};
     static constexpr std::string_view MatrixAttributes[] = {"col0", "col1", "col2", "col3"};
 };
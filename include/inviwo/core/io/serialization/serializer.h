@@ -46,6 +46,7 @@
 #include <bitset>
 #include <vector>
 #include <array>
+#include <span>
 #include <unordered_set>
 #include <unordered_map>
 #include <map>
@@ -83,6 +84,24 @@ public:
      */
     virtual void writeFile(std::ostream& stream, bool format = false);
 
+    /**
+     * \brief Vectors of arithmetic or glm types with at least \p threshold items, and without
+     * predicate or projection, are serialized using serializeBinary. Use
+     * std::numeric_limits<size_t>::max() to always write one node per item. Default is 1024.
+     */
+    void setBinaryThreshold(size_t threshold);
+    size_t getBinaryThreshold() const;
+
+    /**
+     * \brief Serialize \p data as a single node with the items encoded as base64 little-endian
+     * binary data, optionally zlib compressed.
+     *
+     * Much more compact than one node per item for large arrays. Deserializing a std::vector<T>
+     * with the same key reads both this and the per item format.
+     */
+    template <typename T>
+    void serializeBinary(std::string_view key, std::span<const T> data, bool compress = true);
+
     // std containers
     template <typename T, typename Pred = util::alwaysTrue, typename Proj = util::identity>
     void serialize(std::string_view key, const std::vector<T>& sVector,
@@ -179,13 +198,38 @@ protected:
     void linkEndChild(TxElement* child);
     static void setAttribute(TxElement* node, std::string_view key, std::string_view val);
     static void setValue(TxElement* node, std::string_view val);
+
+    size_t binaryThreshold_ = 1024;
 };
 
+template <typename T>
+void Serializer::serializeBinary(std::string_view key, std::span<const T> data, bool compress) {
+    static_assert(detail::isBinarySerializable<T>(), "Type is not binary serializable");
+
+    auto nodeSwitch = switchToNewNode(key);
+    setAttribute(rootElement_, SerializeConstants::EncodingAttribute,
+                 compress ? SerializeConstants::CompressedBinaryEncoding
+                          : SerializeConstants::BinaryEncoding);
+    setAttribute(rootElement_, SerializeConstants::CountAttribute, detail::toStr(data.size()));
+    setAttribute(rootElement_, SerializeConstants::ContentAttribute,
+                 detail::encodeBinary(
+                     {reinterpret_cast<const char*>(data.data()), data.size_bytes()},
+                     sizeof(util::value_type_t<T>), compress));
+}
+
 template <typename T, typename Pred, typename Proj>
 void Serializer::serialize(std::string_view key, const std::vector<T>& vector,
                            std::string_view itemKey, Pred pred, Proj proj) {
     if (vector.empty()) return;
 
+    if constexpr (detail::isBinarySerializable<T>() && std::is_same_v<Pred, util::alwaysTrue> &&
+                  std::is_same_v<Proj, util::identity>) {
+        if (vector.size() >= binaryThreshold_) {
+            serializeBinary(key, std::span<const T>{vector});
+            return;
+        }
+    }
+
     auto nodeSwitch = switchToNewNode(key);
     for (const auto& item : vector) {
         if (std::invoke(pred, item)) {
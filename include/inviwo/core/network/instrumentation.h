@@ -0,0 +1,201 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \ingroup network
+ * \brief Records timing spans of the network evaluation.
+ *
+ * The ProcessorNetworkEvaluator records one span for each network evaluation and, for every
+ * evaluated processor, spans for initializeResources, the inport onChange callbacks and process.
+ * PoolProcessor background jobs are recorded as well. Each span holds the wall time, the thread it
+ * ran on, the index of the network evaluation, and for process spans an estimate of the bytes of
+ * data set on the processor's outports. If an allocation counter is set with
+ * setAllocationCounter(), each span also holds the allocations made on its thread during the span.
+ *
+ * Recording is disabled by default, and the events are kept in a bounded ring buffer, the oldest
+ * events are dropped when it is full. The events can be queried with getEvents() and summarize()
+ * or exported in the Chrome trace event format (chrome://tracing, Perfetto) with
+ * exportChromeTrace(). All functions are thread safe.
+ *
+ * Example:
+ * ```c++
+ * auto instrumentation = app->getProcessorNetworkEvaluator()->getInstrumentation();
+ * instrumentation->setEnabled(true);
+ * // ... evaluate the network
+ * std::ofstream file{"trace.json"};
+ * instrumentation->exportChromeTrace(file);
+ * ```
+ */
+class IVW_CORE_API Instrumentation {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Kind { Evaluation, InitializeResources, PortOnChange, Process, BackgroundJob };
+
+    struct Allocations {
+        size_t count = 0;
+        size_t bytes = 0;
+    };
+
+    /**
+     * Returns the total number of allocations and allocated bytes made by the calling thread.
+     * Inviwo does not count allocations itself, an application can do it by replacing the global
+     * operator new, see tests/benchmarks/workspace-benchmarks.cpp
+     */
+    using AllocationCounter = Allocations (*)();
+
+    struct Event {
+        Kind kind;
+        /// Identifier of the processor, empty for Kind::Evaluation
+        std::string processor;
+        std::thread::id thread;
+        Clock::time_point start;
+        Clock::duration duration;
+        /// Index of the network evaluation the event belongs to
+        size_t evaluation;
+        /// Estimated bytes of data on the outports after a Kind::Process event, 0 otherwise
+        size_t outportBytes;
+        /// Allocations made on the thread during the event, 0 if there is no allocation counter
+        Allocations allocations;
+    };
+
+    /**
+     * Accumulated times for one processor over all recorded events
+     */
+    struct Summary {
+        std::string processor;
+        size_t processCount = 0;
+        Clock::duration initializeResources{0};
+        Clock::duration portOnChange{0};
+        Clock::duration process{0};
+        Clock::duration backgroundJob{0};
+        size_t backgroundJobCount = 0;
+        /// The outport bytes of the last process event
+        size_t outportBytes = 0;
+        /// Allocations summed over all events. Allocations made by other threads, e.g. by tasks
+        /// that a background job dispatches to the thread pool, are not included.
+        Allocations allocations;
+    };
+
+    /**
+     * RAII helper that records an event from construction to destruction. Does nothing if
+     * the instrumentation is null or disabled at construction.
+     */
+    class IVW_CORE_API Scope {
+    public:
+        Scope(Instrumentation* instrumentation, Kind kind, std::string_view processor = {});
+        Scope(const Scope&) = delete;
+        Scope(Scope&&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        Scope& operator=(Scope&&) = delete;
+        ~Scope();
+
+        bool isActive() const { return instrumentation_ != nullptr; }
+        void setOutportBytes(size_t bytes) { event_.outportBytes = bytes; }
+
+    private:
+        Instrumentation* instrumentation_;
+        AllocationCounter allocationCounter_;
+        Event event_;
+    };
+
+    explicit Instrumentation(size_t capacity = 65536);
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * Set a function to count the allocations of each event, nullptr to not count allocations.
+     * The function is called on the thread of the event at its start and end.
+     */
+    void setAllocationCounter(AllocationCounter counter);
+    AllocationCounter getAllocationCounter() const;
+
+    /**
+     * Set the maximum number of events kept. Existing events are cleared.
+     */
+    void setCapacity(size_t capacity);
+    size_t getCapacity() const;
+
+    /**
+     * Remove all recorded events, the evaluation counter is not reset.
+     */
+    void clear();
+
+    /**
+     * Increment and return the index of the current network evaluation.
+     */
+    size_t beginEvaluation();
+    size_t getEvaluationCount() const;
+
+    void record(Event event);
+
+    /**
+     * All recorded events, oldest first
+     */
+    std::vector<Event> getEvents() const;
+
+    /**
+     * Per processor accumulated times, sorted by total time in descending order.
+     */
+    std::vector<Summary> summarize() const;
+
+    /**
+     * Write all recorded events as a Chrome trace event JSON document to \p os
+     */
+    void exportChromeTrace(std::ostream& os) const;
+
+    static std::string_view name(Kind kind);
+
+private:
+    std::atomic<bool> enabled_;
+    std::atomic<AllocationCounter> allocationCounter_;
+    std::atomic<size_t> evaluation_;
+    mutable std::mutex mutex_;
+    size_t capacity_;
+    size_t next_;
+    std::vector<Event> events_;
+};
+
+}  // namespace inviwo
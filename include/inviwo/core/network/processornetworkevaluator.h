@@ -34,6 +34,9 @@
 #include <inviwo/core/processors/processorobserver.h>
 #include <inviwo/core/network/processornetworkevaluationobserver.h>
 #include <inviwo/core/network/evaluationerrorhandler.h>
+#include <inviwo/core/network/instrumentation.h>
+
+#include <memory>
 
 namespace inviwo {
 
@@ -50,6 +53,12 @@ public:
     virtual ~ProcessorNetworkEvaluator() = default;
     void setExceptionHandler(EvaluationErrorHandler handler);
 
+    /**
+     * The instrumentation recording timings of the network evaluations, disabled by default.
+     * @see Instrumentation
+     */
+    const std::shared_ptr<Instrumentation>& getInstrumentation() const;
+
 private:
     // ProcessorNetworkObserver overrides
     virtual void onProcessorNetworkEvaluateRequest() override;
@@ -72,6 +81,7 @@ private:
     bool needsSorting_;
     bool evaulationQueued_;
     EvaluationErrorHandler exceptionHandler_;
+    std::shared_ptr<Instrumentation> instrumentation_;
 };
 
 }  // namespace inviwo
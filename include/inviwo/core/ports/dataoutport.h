@@ -36,6 +36,7 @@
 #include <inviwo/core/ports/porttraits.h>
 #include <inviwo/core/util/stringconversion.h>
 #include <inviwo/core/util/document.h>
+#include <inviwo/core/util/introspection.h>
 
 #include <glm/fwd.hpp>
 
@@ -89,6 +90,11 @@ public:
 
     virtual bool hasData() const override;
 
+    /**
+     * \copydoc inviwo::Outport::getDataSizeInBytes
+     */
+    virtual size_t getDataSizeInBytes() const override;
+
 protected:
     std::shared_ptr<const T> data_;
 };
@@ -157,6 +163,11 @@ bool DataOutport<T>::hasData() const {
     return data_.get() != nullptr;
 }
 
+template <typename T>
+size_t DataOutport<T>::getDataSizeInBytes() const {
+    return data_ ? util::sizeInBytes(*data_) : 0;
+}
+
 template <typename T>
 void DataOutport<T>::clear() {
     data_.reset();
@@ -100,6 +100,12 @@ public:
      */
     virtual bool hasData() const = 0;
 
+    /**
+     * An estimate of the number of bytes held by the data in the port, 0 if there is no data or
+     * if the size is unknown.
+     */
+    virtual size_t getDataSizeInBytes() const;
+
     /**
      * Clear the outport of any data
      */
@@ -43,6 +43,7 @@
 #include <inviwo/core/util/fileextension.h>
 #include <inviwo/core/network/networkvisitor.h>
 #include <inviwo/core/processors/exporter.h>
+#include <inviwo/core/io/layerwritequeue.h>
 
 namespace inviwo {
 
@@ -72,6 +73,15 @@ public:
     void saveImageLayer();
     void saveImageLayer(const std::filesystem::path& filePath,
                         const FileExtension& extension = FileExtension());
+    /**
+     * Save the visible layer to @p filePath without waiting for the file to be written. The
+     * layer is copied right away, but encoding and writing happens on the thread pool.
+     * @see waitForSavedImageLayers
+     */
+    void saveImageLayerAsync(const std::filesystem::path& filePath,
+                             const FileExtension& extension = FileExtension());
+    /// Block until all layers queued by saveImageLayerAsync have been written to disk
+    void waitForSavedImageLayers();
     const Layer* getVisibleLayer() const;
 
     virtual std::shared_ptr<const Image> getImage() const override;
@@ -126,10 +136,12 @@ public:
 
 private:
     void sizeChanged();
+    std::filesystem::path snapshotPath();
     static size2_t calcScaledSize(size2_t size, float scale);
 
     size2_t previousImageSize_;
     ProcessorWidgetMetaData* widgetMetaData_;
+    LayerWriteQueue saveQueue_;
 };
 
 }  // namespace inviwo
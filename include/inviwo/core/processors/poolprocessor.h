@@ -39,6 +39,7 @@
 #include <inviwo/core/util/assertion.h>
 #include <inviwo/core/util/rendercontext.h>
 #include <inviwo/core/util/raiiutils.h>
+#include <inviwo/core/network/instrumentation.h>
 
 #include <atomic>
 #include <chrono>
@@ -301,6 +302,12 @@ private:
 
     bool removeState(const std::shared_ptr<pool::detail::State>& state);
 
+    /**
+     * The instrumentation of the network evaluator, used to record the background jobs.
+     * Might be null if the processor is not in a network.
+     */
+    std::shared_ptr<Instrumentation> getInstrumentation();
+
     template <typename Result, typename Job>
     std::shared_ptr<std::packaged_task<Result()>> makeTask(Job&& job, pool::Stop stop,
                                                            pool::Progress progress);
@@ -446,14 +453,17 @@ void PoolProcessor::dispatchMany(std::vector<Job> jobs, Done&& done) {
     Submission sub{state, {}, [this]() { setupProgress<Job>(); }};
 
     auto app = getInviwoApplication();
+    auto instrumentation = getInstrumentation();
     size_t i = 0;
     for (auto& job : jobs) {
         auto task = makeTask<Result>(std::move(job), state->getStop(), state->getProgress(i++));
         state->futures.push_back(task->get_future());
-        sub.tasks.emplace_back([state, task, app]() {
+        sub.tasks.emplace_back([state, task, app, instrumentation, id = getIdentifier()]() {
             if (!state->stop) {
                 // This code will run in a background thread, make sure the local context is active
                 RenderContext::getPtr()->activateLocalRenderContext();
+                const Instrumentation::Scope scope{instrumentation.get(),
+                                                   Instrumentation::Kind::BackgroundJob, id};
                 (*task)();
             }
             callDone(app, state);
@@ -499,9 +509,12 @@ void PoolProcessor::dispatchOne(Job&& job, Done&& done) {
     auto app = getInviwoApplication();
 
     Submission sub{state,
-                   {[state, task, app]() {
+                   {[state, task, app, instrumentation = getInstrumentation(),
+                     id = getIdentifier()]() {
                        if (!state->stop) {
                            RenderContext::getPtr()->activateLocalRenderContext();
+                           const Instrumentation::Scope scope{
+                               instrumentation.get(), Instrumentation::Kind::BackgroundJob, id};
                            (*task)();
                        }
                        callDone(app, state);
@@ -105,6 +105,14 @@ public:
     int getARGC() const;
     char** getARGV() const;
 
+    /**
+     * Set the code the application should return when quitting after startup, i.e. when
+     * getQuitApplicationAfterStartup() is true. Command line callbacks use this to report that
+     * the work they were asked to do failed. Defaults to 0.
+     */
+    void setExitCode(int code);
+    int getExitCode() const;
+
     void processCallbacks();
     void add(TCLAP::Arg* arg);
     void add(TCLAP::Arg* arg, std::function<void()> callback, int priority = 0);
@@ -129,6 +137,7 @@ private:
     TCLAP::SwitchArg disableResourceManager_;
 
     std::vector<std::tuple<int, TCLAP::Arg*, std::function<void()>>> callbacks_;
+    int exitCode_ = 0;
 };
 
 inline bool WildCardArg::processArg(int* i, std::vector<std::string>& args) {
@@ -0,0 +1,214 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/glmconvert.h>
+#include <inviwo/core/util/glmutils.h>
+#include <inviwo/core/util/glmvec.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace inviwo {
+
+class DataFormatBase;
+
+namespace util {
+
+/**
+ * Conversion kernels between arrays of data format types, i.e. scalars and glm vectors of any of
+ * the DataFormat component types. All kernels split large arrays into chunks that are processed
+ * in parallel using the thread pool. When the source and destination have the same number of
+ * components the data is processed as flat arrays of components, giving tight loops that the
+ * compiler can vectorize. Otherwise the conversion falls back to one element at a time, padding
+ * with zeros or dropping components like glm_convert.
+ */
+
+namespace detail {
+
+/** Smallest number of elements worth handing to a separate thread */
+constexpr size_t conversionChunkSize = size_t{1} << 16;
+
+template <typename T>
+constexpr bool isFlat =
+    sizeof(T) == util::flat_extent_v<T> * sizeof(util::value_type_t<T>);
+
+template <typename To, typename From>
+constexpr bool isComponentWise =
+    util::flat_extent_v<To> == util::flat_extent_v<From> && isFlat<To> && isFlat<From>;
+
+template <typename Func>
+void forEachConversionChunk(size_t size, Func&& func) {
+    util::forEachChunkParallel(size, util::parallelChunkCount(size, conversionChunkSize),
+                               [&](size_t, size_t begin, size_t end) { func(begin, end); });
+}
+
+/**
+ * Call `func(src, dst, size)` for chunks of the input, either with flat component pointers or
+ * with the element pointers depending on isComponentWise.
+ */
+template <typename To, typename From, typename Func>
+void convertChunked(const From* src, To* dst, size_t size, Func&& func) {
+    if constexpr (isComponentWise<To, From>) {
+        using ToComp = util::value_type_t<To>;
+        using FromComp = util::value_type_t<From>;
+        constexpr size_t n = util::flat_extent_v<From>;
+        const auto* srcComp = reinterpret_cast<const FromComp*>(src);
+        auto* dstComp = reinterpret_cast<ToComp*>(dst);
+        forEachConversionChunk(size * n, [&](size_t begin, size_t end) {
+            func(srcComp + begin, dstComp + begin, end - begin);
+        });
+    } else {
+        forEachConversionChunk(size, [&](size_t begin, size_t end) {
+            func(src + begin, dst + begin, end - begin);
+        });
+    }
+}
+
+template <typename To>
+double clampToRange(double value) {
+    using Comp = util::value_type_t<To>;
+    if constexpr (std::is_integral_v<Comp>) {
+        return std::clamp(value, static_cast<double>(std::numeric_limits<Comp>::lowest()),
+                          static_cast<double>(std::numeric_limits<Comp>::max()));
+    } else {
+        return value;
+    }
+}
+
+}  // namespace detail
+
+// disable conversion warning
+#include <warn/push>
+#include <warn/ignore/conversion>
+
+/**
+ * Convert @p size elements from @p src into @p dst by casting each component, the same as
+ * util::glm_convert.
+ */
+template <typename To, typename From>
+void convertData(const From* src, To* dst, size_t size) {
+    detail::convertChunked(src, dst, size, [](const auto* s, auto* d, size_t n) {
+        using T = std::remove_pointer_t<decltype(d)>;
+        if constexpr (std::is_same_v<T, std::remove_cv_t<std::remove_pointer_t<decltype(s)>>>) {
+            std::copy(s, s + n, d);
+        } else {
+            for (size_t i = 0; i < n; ++i) d[i] = util::glm_convert<T>(s[i]);
+        }
+    });
+}
+
+/**
+ * Convert @p size elements from @p src into @p dst by normalizing each component, the same as
+ * util::glm_convert_normalized.
+ */
+template <typename To, typename From>
+void convertDataNormalized(const From* src, To* dst, size_t size) {
+    detail::convertChunked(src, dst, size, [](const auto* s, auto* d, size_t n) {
+        using T = std::remove_pointer_t<decltype(d)>;
+        if constexpr (std::is_same_v<T, std::remove_cv_t<std::remove_pointer_t<decltype(s)>>>) {
+            std::copy(s, s + n, d);
+        } else {
+            for (size_t i = 0; i < n; ++i) d[i] = util::glm_convert_normalized<T>(s[i]);
+        }
+    });
+}
+
+/**
+ * Convert @p size elements from @p src into @p dst by linearly mapping each component from
+ * @p srcRange to @p dstRange, i.e.
+ *     dst = (src - srcRange.x) / (srcRange.y - srcRange.x) * (dstRange.y - dstRange.x) + dstRange.x
+ * The mapping is evaluated in double precision, and clamped to the range of the destination
+ * type for integer destinations. If @p srcRange is empty all values are mapped to dstRange.x.
+ * Components that only exist in the destination are set to zero.
+ */
+template <typename To, typename From>
+void convertDataMapped(const From* src, To* dst, size_t size, dvec2 srcRange, dvec2 dstRange) {
+    const double scale = srcRange.y != srcRange.x
+                             ? (dstRange.y - dstRange.x) / (srcRange.y - srcRange.x)
+                             : 0.0;
+    const double offset = dstRange.x - srcRange.x * scale;
+
+    detail::convertChunked(src, dst, size, [scale, offset](const auto* s, auto* d, size_t n) {
+        using T = std::remove_pointer_t<decltype(d)>;
+        if constexpr (util::rank_v<T> == 0) {
+            for (size_t i = 0; i < n; ++i) {
+                d[i] = static_cast<T>(
+                    detail::clampToRange<T>(util::glm_convert<double>(s[i]) * scale + offset));
+            }
+        } else {
+            // Only map the components present in both types, padding is left as zero
+            using D = util::same_extent_t<T, double>;
+            using S = std::remove_cv_t<std::remove_pointer_t<decltype(s)>>;
+            constexpr size_t m = std::min(util::extent_v<T>, util::extent_v<S>);
+            for (size_t i = 0; i < n; ++i) {
+                auto v = util::glm_convert<D>(s[i]);
+                for (size_t c = 0; c < m; ++c) {
+                    v[c] = detail::clampToRange<T>(v[c] * scale + offset);
+                }
+                d[i] = static_cast<T>(v);
+            }
+        }
+    });
+}
+
+#include <warn/pop>
+
+/**
+ * Runtime versions of the conversion kernels above. Converts @p size elements of @p srcFormat
+ * at @p src into @p dstFormat at @p dst. Any pair of formats with the same number of
+ * components is supported.
+ * @throws Exception if the number of components differs
+ */
+IVW_CORE_API void convertData(const void* src, const DataFormatBase* srcFormat, void* dst,
+                              const DataFormatBase* dstFormat, size_t size);
+
+/**
+ * \copydoc convertData(const void*, const DataFormatBase*, void*, const DataFormatBase*, size_t)
+ * @see convertDataNormalized
+ */
+IVW_CORE_API void convertDataNormalized(const void* src, const DataFormatBase* srcFormat,
+                                        void* dst, const DataFormatBase* dstFormat, size_t size);
+
+/**
+ * \copydoc convertData(const void*, const DataFormatBase*, void*, const DataFormatBase*, size_t)
+ * @see convertDataMapped
+ */
+IVW_CORE_API void convertDataMapped(const void* src, const DataFormatBase* srcFormat, void* dst,
+                                    const DataFormatBase* dstFormat, size_t size, dvec2 srcRange,
+                                    dvec2 dstRange);
+
+}  // namespace util
+
+}  // namespace inviwo
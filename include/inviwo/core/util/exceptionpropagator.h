@@ -0,0 +1,86 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace inviwo {
+
+/**
+ * Carries an exception from a worker thread back to the thread that owns the work. Workers call
+ * setException() from within a catch block, and the owner calls throwOnError() to rethrow the
+ * first captured exception. Workers should hold on to the state returned by get(), any exception
+ * that is never rethrown is logged when the last reference goes away.
+ */
+class IVW_CORE_API ExceptionPropagator {
+    class IVW_CORE_API State {
+    public:
+        State() = default;
+        State(const State&) = delete;
+        State(State&&) = delete;
+        State& operator=(const State&) = delete;
+        State& operator=(State&&) = delete;
+        ~State() noexcept;
+
+        void setException() {
+            std::scoped_lock lock{exceptionMutex_};
+            if (!exception_) {
+                exception_ = std::current_exception();
+            }
+        }
+        void throwOnError() {
+            std::scoped_lock lock{exceptionMutex_};
+            if (exception_) {
+                std::rethrow_exception(std::exchange(exception_, nullptr));
+            }
+        }
+
+    private:
+        std::mutex exceptionMutex_;
+        std::exception_ptr exception_;
+    };
+
+public:
+    ExceptionPropagator() : state_{std::make_shared<State>()} {}
+
+    void setException() { state_->setException(); }
+    void throwOnError() { state_->throwOnError(); }
+
+    std::shared_ptr<State> get() { return state_; }
+
+private:
+    std::shared_ptr<State> state_;
+};
+
+}  // namespace inviwo
@@ -33,7 +33,14 @@
 #include <inviwo/core/util/settings/systemsettings.h>
 #include <inviwo/core/util/threadutil.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 namespace inviwo {
 
@@ -140,6 +147,85 @@ void forEachParallel(const Iterable& iterable, Callback&& callback, size_t jobs
     }
 }
 
+/**
+ * Suggest a number of chunks to use for processing @p size elements in parallel with
+ * forEachChunkParallel. Uses 4 chunks per thread in the pool, but never chunks with less than
+ * @p minChunkSize elements. Returns 1 if the pool size is zero.
+ */
+inline size_t parallelChunkCount(size_t size, size_t minChunkSize) {
+    const auto poolSize = util::getPoolSize();
+    if (poolSize == 0) return 1;
+    return std::clamp(size / std::max(minChunkSize, size_t{1}), size_t{1}, 4 * poolSize);
+}
+
+/**
+ * Split the index range [0, size) into @p chunks equally sized parts and call
+ * `callback(size_t chunk, size_t begin, size_t end)` for each part, using the Inviwo thread
+ * pool. The calling thread takes part in the work: once it has queued the jobs, it processes any
+ * chunk that has not yet been picked up by a pool thread, and then waits only for chunks that are
+ * being processed. Hence it is safe to call from within a pool job, even if all pool threads are
+ * busy. If the pool size is zero all chunks are processed by the calling thread.
+ * The function will return once all chunks are processed. If the callback throws, the first
+ * exception is rethrown in the calling thread after all chunks are done.
+ *
+ * @param size the number of elements to process
+ * @param chunks number of parts to split the range into, @see parallelChunkCount
+ * @param callback to call for each chunk
+ */
+template <typename Callback>
+void forEachChunkParallel(size_t size, size_t chunks, Callback&& callback) {
+    chunks = std::max(chunks, size_t{1});
+    const auto range = [&](size_t chunk) {
+        return std::make_pair((size * chunk) / chunks, (size * (chunk + 1)) / chunks);
+    };
+
+    if (chunks == 1 || util::getPoolSize() == 0) {
+        for (size_t chunk = 0; chunk < chunks; ++chunk) {
+            const auto [begin, end] = range(chunk);
+            callback(chunk, begin, end);
+        }
+        return;
+    }
+
+    struct State {
+        explicit State(size_t chunks) : claimed(chunks), remaining{chunks} {}
+        std::vector<std::atomic<bool>> claimed;
+        std::atomic<size_t> remaining;
+        std::mutex mutex;
+        std::condition_variable done;
+        std::exception_ptr exception;
+    };
+    auto state = std::make_shared<State>(chunks);
+
+    // Only called for chunks that are successfully claimed, which happens before this function
+    // returns, hence it is safe to capture the callback by reference.
+    const auto run = [state, &range, &callback](size_t chunk) {
+        if (state->claimed[chunk].exchange(true)) return;
+        try {
+            const auto [begin, end] = range(chunk);
+            callback(chunk, begin, end);
+        } catch (...) {
+            std::scoped_lock lock{state->mutex};
+            if (!state->exception) state->exception = std::current_exception();
+        }
+        if (--state->remaining == 0) {
+            std::scoped_lock lock{state->mutex};
+            state->done.notify_all();
+        }
+    };
+
+    for (size_t chunk = 1; chunk < chunks; ++chunk) {
+        getThreadPool().enqueueRaw([run, chunk]() { run(chunk); });
+    }
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        run(chunk);
+    }
+
+    std::unique_lock lock{state->mutex};
+    state->done.wait(lock, [&]() { return state->remaining == 0; });
+    if (state->exception) std::rethrow_exception(state->exception);
+}
+
 }  // namespace util
 
 }  // namespace inviwo
@@ -40,6 +40,7 @@
 #include <type_traits>
 #include <iostream>
 #include <string>
+#include <vector>
 #include <warn/pop>
 
 namespace inviwo {
@@ -69,6 +70,13 @@ using dataInfoType = decltype(std::declval<T>().getDataInfo());
 template <typename T>
 using infoType = decltype(std::declval<T>().getInfo());
 
+template <typename T>
+using sizeInBytesType = decltype(std::declval<T>().getSizeInBytes());
+
+template <typename T>
+using formatSizeType =
+    decltype(std::declval<T>().getDimensions(), std::declval<T>().getDataFormat()->getSize());
+
 }  // namespace detail
 
 template <class T>
@@ -159,6 +167,45 @@ Document info(const T& data) {
     }
 }
 
+template <typename T>
+using HasSizeInBytes = is_detected_convertible<size_t, detail::sizeInBytesType, T>;
+
+template <typename T>
+using HasFormatSize = is_detected_convertible<size_t, detail::formatSizeType, T>;
+
+/**
+ * Estimate the number of bytes held by \p data. Uses `T::getSizeInBytes()` if available,
+ * otherwise the product of `T::getDimensions()` and the size of `T::getDataFormat()`, and for
+ * vectors of trivially copyable types the size of the elements. Returns 0 if no estimate can be
+ * made.
+ */
+template <typename T>
+size_t sizeInBytes(const T& data) {
+    if constexpr (HasSizeInBytes<T>::value) {
+        return static_cast<size_t>(data.getSizeInBytes());
+    } else if constexpr (HasFormatSize<T>::value) {
+        const auto dims = data.getDimensions();
+        size_t size = data.getDataFormat()->getSize();
+        for (glm::length_t i = 0; i < dims.length(); ++i) {
+            size *= static_cast<size_t>(dims[i]);
+        }
+        return size;
+    } else if constexpr (std::is_trivially_copyable_v<T>) {
+        return sizeof(T);
+    } else {
+        return 0;
+    }
+}
+
+template <typename T, typename A>
+size_t sizeInBytes(const std::vector<T, A>& data) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        return data.size() * sizeof(T);
+    } else {
+        return 0;
+    }
+}
+
 }  // namespace util
 
 }  // namespace inviwo
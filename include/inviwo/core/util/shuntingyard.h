@@ -63,10 +63,18 @@ THE SOFTWARE.
 #include <map>
 #include <stack>
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <sstream>
 #include <queue>
 #include <memory>
+#include <vector>
+#include <array>
+#include <span>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
 
 namespace inviwo {
 namespace shuntingyard {
@@ -86,6 +94,8 @@ using TokenQueue = std::queue<std::unique_ptr<TokenBase>>;
 
 class IVW_CORE_API Calculator {
 public:
+    friend class Expression;
+
     static double calculate(std::string expression, std::map<std::string, double>& vars);
     static std::string shaderCode(std::string expression, std::map<std::string, double>& vars,
                                   std::map<std::string, std::string>& symbols);
@@ -121,5 +131,156 @@ private:
     }
 };
 
+/**
+ * \brief An expression compiled once into a flat instruction list with resolved variable slots.
+ *
+ * The expression is parsed with the same grammar as Calculator (+, -, *, /, ^, parenthesis,
+ * numeric constants, and variables). Variables are bound to slots at construction time, given by
+ * their position in the list of variable names. Evaluation does not need to do any parsing or
+ * string lookups and can be done either for a single set of values or in batches over whole
+ * arrays. The batch evaluation runs each instruction over a block of values at a time, resulting
+ * in tight loops that the compiler can vectorize.
+ *
+ * Example:
+ * \code{.cpp}
+ * shuntingyard::Expression expr{"a * 2 + b", {"a", "b"}};
+ * double res = expr.evaluate(std::array{1.0, 3.0}); // 5.0
+ * expr.evaluate<float, float>(std::array{a.data(), b.data()}, dest.data(), dest.size());
+ * \endcode
+ */
+class IVW_CORE_API Expression {
+public:
+    enum class OpCode : std::uint8_t { Constant, Variable, Add, Sub, Mul, Div, Pow };
+    struct Instruction {
+        OpCode op;
+        std::uint32_t index;  ///< Index into the constants for Constant, the slot for Variable
+    };
+    /// Number of elements evaluated per instruction in the batch evaluation
+    static constexpr size_t blockSize = 256;
+
+    /**
+     * Compile the @p expression. All variables used in the expression has to be in @p variables.
+     * @throw Exception if the expression is invalid or references unknown variables.
+     */
+    Expression(std::string_view expression, std::vector<std::string> variables);
+
+    const std::string& expression() const { return expression_; }
+    const std::vector<std::string>& variables() const { return variables_; }
+    const std::vector<Instruction>& instructions() const { return instructions_; }
+    const std::vector<double>& constants() const { return constants_; }
+    /// The maximum number of intermediate values needed while evaluating the expression
+    size_t stackDepth() const { return stackDepth_; }
+
+    /// Returns the slot for variable @p name if used in the expression.
+    std::optional<size_t> slot(std::string_view name) const;
+    /// Returns true if variable slot @p slot is referenced by the expression
+    bool uses(size_t slot) const;
+
+    /**
+     * Evaluate the expression for a single set of values. @p values is indexed by slot and should
+     * have the same size as variables()
+     */
+    double evaluate(std::span<const double> values) const;
+
+    /**
+     * Evaluate the expression for @p count elements, in blocks of blockSize.
+     * @param count the number of elements to evaluate.
+     * @param load a callable `void(size_t slot, size_t offset, size_t n, double* dest)` that
+     * should write the @p n values starting at element @p offset of variable @p slot to @p dest.
+     * @param store a callable `void(size_t offset, size_t n, const double* result)` that receives
+     * the results for elements [offset, offset + n).
+     */
+    template <typename Load, typename Store>
+    void evaluate(size_t count, Load&& load, Store&& store) const;
+
+    /**
+     * Evaluate the expression element-wise over contiguous arrays. @p inputs holds a pointer per
+     * variable slot, each pointing to at least @p count elements. Unused slots may be nullptr.
+     */
+    template <typename Src, typename Dst>
+    void evaluate(std::span<const Src* const> inputs, Dst* dest, size_t count) const;
+
+private:
+    std::string expression_;
+    std::vector<std::string> variables_;
+    std::vector<Instruction> instructions_;
+    std::vector<double> constants_;
+    size_t stackDepth_;
+};
+
+template <typename Load, typename Store>
+void Expression::evaluate(size_t count, Load&& load, Store&& store) const {
+    // The evaluation stack holds a block of values per level. Variables are loaded lazily directly
+    // into the stack to avoid keeping a separate buffer per slot. The stack memory is reused
+    // between calls on the same thread. It is moved out while in use so that a nested evaluation
+    // from within load or store gets its own buffer.
+    thread_local std::vector<std::array<double, blockSize>> scratch;
+    auto stack = std::move(scratch);
+    if (stack.size() < stackDepth_) stack.resize(stackDepth_);
+    struct Release {
+        std::vector<std::array<double, blockSize>>& stack;
+        ~Release() {
+            if (stack.capacity() > scratch.capacity()) scratch = std::move(stack);
+        }
+    } release{stack};
+
+    for (size_t offset = 0; offset < count; offset += blockSize) {
+        const size_t n = std::min(blockSize, count - offset);
+        size_t top = 0;
+        for (const auto& inst : instructions_) {
+            switch (inst.op) {
+                case OpCode::Constant: {
+                    const auto val = constants_[inst.index];
+                    auto* dst = stack[top++].data();
+                    for (size_t i = 0; i < n; ++i) dst[i] = val;
+                    break;
+                }
+                case OpCode::Variable:
+                    load(static_cast<size_t>(inst.index), offset, n, stack[top++].data());
+                    break;
+                default: {
+                    --top;
+                    auto* lhs = stack[top - 1].data();
+                    const auto* rhs = stack[top].data();
+                    switch (inst.op) {
+                        case OpCode::Add:
+                            for (size_t i = 0; i < n; ++i) lhs[i] += rhs[i];
+                            break;
+                        case OpCode::Sub:
+                            for (size_t i = 0; i < n; ++i) lhs[i] -= rhs[i];
+                            break;
+                        case OpCode::Mul:
+                            for (size_t i = 0; i < n; ++i) lhs[i] *= rhs[i];
+                            break;
+                        case OpCode::Div:
+                            for (size_t i = 0; i < n; ++i) lhs[i] /= rhs[i];
+                            break;
+                        case OpCode::Pow:
+                            for (size_t i = 0; i < n; ++i) lhs[i] = std::pow(lhs[i], rhs[i]);
+                            break;
+                        default:
+                            break;
+                    }
+                }
+            }
+        }
+        store(offset, n, stack[0].data());
+    }
+}
+
+template <typename Src, typename Dst>
+void Expression::evaluate(std::span<const Src* const> inputs, Dst* dest, size_t count) const {
+    evaluate(
+        count,
+        [&](size_t slot, size_t offset, size_t n, double* values) {
+            const Src* src = inputs[slot] + offset;
+            for (size_t i = 0; i < n; ++i) values[i] = static_cast<double>(src[i]);
+        },
+        [&](size_t offset, size_t n, const double* result) {
+            Dst* dst = dest + offset;
+            for (size_t i = 0; i < n; ++i) dst[i] = static_cast<Dst>(result[i]);
+        });
+}
+
 }  // namespace shuntingyard
 }  // namespace inviwo
@@ -0,0 +1,123 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \brief A linear undo/redo history of text snapshots, e.g. serialized workspaces, stored as
+ * deltas.
+ *
+ * Each pushed snapshot is stored as the difference to the previous one, a list of hunks found by a
+ * line based diff of the two snapshots, where each hunk is further trimmed to the characters that
+ * differ. Edits in several places, like changes to two different processors of a workspace, hence
+ * only store the edited regions and not the text between them. The deltas are reversible, so
+ * moving one step in either direction only costs a copy of the current state and memory scales
+ * with the size of the edits rather than the size of the snapshots. Every `keyframeInterval`
+ * entries a full snapshot is also kept, which bounds the work of reconstructing an arbitrary entry
+ * with get().
+ */
+class IVW_CORE_API SnapshotHistory {
+public:
+    explicit SnapshotHistory(size_t keyframeInterval = 32);
+
+    /**
+     * Add \p snapshot after the current position, discarding any states that could be redone.
+     * @return false if \p snapshot is equal to the current state and nothing was added.
+     */
+    bool push(std::string snapshot);
+
+    bool canUndo() const;
+    bool canRedo() const;
+
+    /**
+     * Step one state back and return it.
+     * @pre canUndo()
+     */
+    std::shared_ptr<const std::string> undo();
+
+    /**
+     * Step one state forward and return it.
+     * @pre canRedo()
+     */
+    std::shared_ptr<const std::string> redo();
+
+    /**
+     * The state at the current position, nullptr if the history is empty.
+     */
+    const std::shared_ptr<const std::string>& current() const;
+
+    /**
+     * Reconstruct the state at \p index, starting from the closest keyframe or the current state.
+     * @throws RangeException if \p index is out of range
+     */
+    std::string get(size_t index) const;
+
+    size_t size() const;
+    bool empty() const;
+    /**
+     * The index of the current state, only valid if the history is not empty.
+     */
+    size_t position() const;
+
+    /**
+     * The approximate number of bytes held by the history.
+     */
+    size_t memoryUsage() const;
+
+    void clear();
+
+private:
+    struct Hunk {
+        size_t offset = 0;     // Position in the previous state
+        std::string removed;   // Text of the previous state that was replaced
+        std::string inserted;  // Text of this state that replaced it
+    };
+    struct Entry {
+        std::vector<Hunk> hunks;  // Ordered by offset and non-overlapping
+        std::shared_ptr<const std::string> keyframe;
+    };
+    static std::vector<Hunk> diff(std::string_view prev, std::string_view next);
+    static void forward(std::string& state, const Entry& entry);
+    static void backward(std::string& state, const Entry& entry);
+
+    size_t keyframeInterval_;
+    size_t position_;
+    std::vector<Entry> entries_;
+    std::shared_ptr<const std::string> current_;
+};
+
+}  // namespace inviwo
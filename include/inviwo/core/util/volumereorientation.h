@@ -0,0 +1,129 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/glmmat.h>
+#include <inviwo/core/util/glmvec.h>
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * Describes a reorientation of a volume, i.e. a permutation and/or flip of its axes.
+ * Axis `i` of the reoriented volume corresponds to axis `permutation[i]` of the source volume,
+ * and is traversed in reverse order if `flip[i]` is set.
+ */
+struct IVW_CORE_API VolumeReorientation {
+    std::array<size_t, 3> permutation{0, 1, 2};
+    std::array<bool, 3> flip{false, false, false};
+
+    /**
+     * True if the reorientation does not change the data
+     */
+    bool isIdentity() const;
+    /**
+     * True if the reorientation only flips axes and hence can be done in place without any
+     * additional memory
+     */
+    bool isFlipOnly() const;
+    /**
+     * True if the permutation is a valid permutation of the three axes
+     */
+    bool isValid() const;
+
+    /**
+     * Dimensions of the reoriented volume given the dimensions of the source volume
+     */
+    size3_t reorientedDimensions(size3_t sourceDims) const;
+    /**
+     * Dimensions of the source volume given the dimensions of the reoriented volume
+     */
+    size3_t sourceDimensions(size3_t reorientedDims) const;
+    /**
+     * The region of the source volume holding the voxels of the region @p offset, @p extent in the
+     * reoriented volume with dimensions @p reorientedDims. Reorienting the source region with the
+     * same reorientation gives the requested region.
+     * @return the offset and extent of the region in the source volume
+     */
+    std::pair<size3_t, size3_t> sourceRegion(size3_t reorientedDims, size3_t offset,
+                                             size3_t extent) const;
+
+    /**
+     * Apply the reorientation to a model matrix basis, such that the reoriented volume occupies
+     * the same space as the source volume. The offset is updated for the flipped axes.
+     */
+    void reorientBasis(mat3& basis, vec3& offset) const;
+
+    bool operator==(const VolumeReorientation&) const = default;
+};
+
+/**
+ * \brief Reorient the volume data in @p data in place
+ *
+ * Flips are done in place by swapping voxels and require no additional memory. A permutation of
+ * the axes requires a temporary copy of the data. The work is distributed over z-slabs of the
+ * reoriented volume using the thread pool.
+ *
+ * @param data pointer to the voxel data, x is the fastest changing index
+ * @param elementSize size of one voxel in bytes
+ * @param dims the dimensions of the source volume
+ * @param reorientation the reorientation to apply
+ * @return the dimensions of the reoriented volume
+ * @throw Exception if the permutation is invalid
+ */
+IVW_CORE_API size3_t reorientVolume(void* data, size_t elementSize, size3_t dims,
+                                    const VolumeReorientation& reorientation);
+
+/**
+ * \brief Copy the volume data in @p src into @p dst while reorienting it
+ *
+ * Whenever the x-axis is kept, whole rows are copied at a time, otherwise voxels are gathered
+ * row by row. The work is distributed over z-slabs of the reoriented volume using the thread pool.
+ *
+ * @param src pointer to the source voxel data, x is the fastest changing index
+ * @param dst pointer to the destination, has to hold as many voxels as @p src and must not
+ *            overlap with @p src
+ * @param elementSize size of one voxel in bytes
+ * @param dims the dimensions of the source volume
+ * @param reorientation the reorientation to apply
+ * @return the dimensions of the reoriented volume
+ * @throw Exception if the permutation is invalid
+ */
+IVW_CORE_API size3_t reorientVolume(const void* src, void* dst, size_t elementSize, size3_t dims,
+                                    const VolumeReorientation& reorientation);
+
+}  // namespace util
+
+}  // namespace inviwo
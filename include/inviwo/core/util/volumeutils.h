@@ -39,6 +39,7 @@
 namespace inviwo {
 
 class Volume;
+class VolumeDisk;
 
 namespace util {
 
@@ -70,6 +71,17 @@ size3_t IVW_CORE_API getVolumeDimensions(const std::shared_ptr<const Volume>& vo
  */
 double IVW_CORE_API voxelVolume(const Volume& volume);
 
+/**
+ * \brief returns the disk representation of the volume if regions can be read from it directly
+ *
+ * That is the case if the volume has not been loaded into RAM and its loader supports reading
+ * sub-regions, \see VolumeRegionLoader. Reading a region then only reads the bytes needed instead
+ * of loading the whole volume.
+ *
+ * @return the disk representation or nullptr
+ */
+const VolumeDisk* IVW_CORE_API getRegionReader(const Volume& volume);
+
 }  // namespace util
 
 }  // namespace inviwo
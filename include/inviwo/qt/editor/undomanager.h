@@ -47,6 +47,7 @@ namespace inviwo {
 
 class InviwoMainWindow;
 class AutoSaver;
+class HistoryWorker;
 
 /**
  * \class UndoManager
@@ -77,9 +78,10 @@ public:
     bool eventFilter(QObject* watched, QEvent* event) override;
 
 private:
-    using DiffType = std::vector<std::string>::iterator::difference_type;
-
+    bool canUndo() const;
+    bool canRedo() const;
     void updateActions();
+    void load(std::shared_ptr<const std::string> state);
 
     // ProcessorNetworkObserver overrides;
     virtual void onProcessorNetworkChange() override;
@@ -96,8 +98,13 @@ private:
 
     bool dirty_ = true;
     bool isRestoring = false;
-    DiffType head_ = -1;
-    std::vector<std::shared_ptr<const std::string>> undoBuffer_;
+
+    // The diffing of the states happens in history_ on a background thread, current_, position_
+    // and size_ mirror the state of the history on the GUI thread.
+    std::unique_ptr<HistoryWorker> history_;
+    std::shared_ptr<const std::string> current_;
+    size_t position_ = 0;
+    size_t size_ = 0;
 
     QAction* undoAction_;
     QAction* redoAction_;
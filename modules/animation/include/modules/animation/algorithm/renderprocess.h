@@ -0,0 +1,98 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/animation/animationmoduledefine.h>  // for IVW_MODULE_ANIMATION_API
+
+#include <filesystem>  // for path
+#include <optional>    // for optional
+#include <string>      // for string
+#include <utility>     // for pair
+#include <vector>      // for vector
+
+namespace inviwo {
+
+namespace animation {
+
+/**
+ * Split the frames [0, numFrames - 1] into consecutive, inclusive ranges [first, last] of
+ * (almost) equal size. The number of parts is clamped to [1, numFrames], such that no range is
+ * empty. Returns an empty list if numFrames < 1.
+ */
+IVW_MODULE_ANIMATION_API std::vector<std::pair<int, int>> splitFrameRange(int numFrames,
+                                                                         int parts);
+
+/**
+ * Returns the executable to use for rendering frames in a separate process. Prefers one of the
+ * minimal applications (inviwo_qtminimum, inviwo_glfwminimum) next to the current executable,
+ * since they do not bring up the editor, and falls back to the current executable.
+ */
+IVW_MODULE_ANIMATION_API std::filesystem::path renderWorkerExecutable();
+
+/**
+ * A child process running an executable with a list of arguments. Unlike std::system, starting
+ * a RenderProcess does not block, and the process can be polled for its exit status and be
+ * terminated. A process still running when the RenderProcess is destroyed is terminated.
+ */
+class IVW_MODULE_ANIMATION_API RenderProcess {
+public:
+    /**
+     * Start @p executable with @p args.
+     * @throw Exception if the process could not be started
+     */
+    RenderProcess(const std::filesystem::path& executable, const std::vector<std::string>& args);
+    RenderProcess(const RenderProcess&) = delete;
+    RenderProcess(RenderProcess&& rhs) noexcept;
+    RenderProcess& operator=(const RenderProcess&) = delete;
+    RenderProcess& operator=(RenderProcess&& rhs) noexcept;
+    ~RenderProcess();
+
+    /**
+     * Check whether the process has finished, without blocking.
+     * @return the exit status if the process has finished, std::nullopt otherwise. A process
+     * that was terminated, or crashed, reports a nonzero status.
+     */
+    std::optional<int> poll();
+
+    /// Terminate the process if it is still running.
+    void kill();
+
+private:
+#ifdef WIN32
+    void* handle_ = nullptr;
+#else
+    int pid_ = -1;
+#endif
+    std::optional<int> status_;
+};
+
+}  // namespace animation
+
+}  // namespace inviwo
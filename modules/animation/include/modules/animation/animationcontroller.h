@@ -51,6 +51,7 @@
 #include <functional>   // for __base
 #include <string>       // for operator==, string
 #include <string_view>  // for operator==
+#include <utility>      // for pair
 #include <vector>       // for operator!=, vector, operator==
 
 namespace inviwo {
@@ -80,8 +81,19 @@ public:
     void play();
     /// Pause animation
     void pause();
-    /// Render the animation into an image sequence
+    /// Render the animation, split over renderProcesses separate processes if more than one
     void render();
+    /**
+     * Render the frames [firstFrame, lastFrame] of the render window. The frames are numbered
+     * globally over the whole render window, such that several processes can each render a part
+     * of the animation into one common image sequence.
+     * @return true if all frames in the range were rendered and recorded, false if the range was
+     * invalid, no exporters were selected, rendering failed or was stopped.
+     * @see getNumberOfRenderFrames
+     */
+    bool render(int firstFrame, int lastFrame);
+    /// Returns the number of frames in the render window at the current render frame rate.
+    int getNumberOfRenderFrames() const;
     // Pause and reset to start
     void stop();
 
@@ -126,6 +138,7 @@ public:
     DoubleMinMaxProperty renderWindow;
 
     DoubleProperty renderFPS;
+    IntProperty renderProcesses;
     ButtonProperty renderAction;
     ButtonProperty renderActionStop;
 
@@ -143,6 +156,16 @@ protected:
     /// Low-level setting of currentTime_. Use eval() to set time in the public interface.
     void setTime(Seconds time);
 
+    /// Returns the first and last time of the render window
+    std::pair<Seconds, Seconds> getRenderTimeWindow() const;
+
+    /**
+     * Split the render window into equally sized frame ranges and render each of them in a
+     * separate process running the current workspace, see render(int, int). The processes are
+     * terminated if rendering is stopped.
+     */
+    void renderInProcesses(int processes);
+
     /// The animation to control, non-owning reference.
     Animation* animation_;
 
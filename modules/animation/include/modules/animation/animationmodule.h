@@ -33,12 +33,14 @@
 #include <inviwo/core/common/inviwomodule.h>                // for InviwoModule
 #include <inviwo/core/io/serialization/ticpp.h>             // for TxElement
 #include <inviwo/core/io/serialization/versionconverter.h>  // for VersionConverter
+#include <inviwo/core/util/commandlineparser.h>             // for CommandLineArgHolder
 #include <modules/animation/animationmanager.h>             // for AnimationManager
 #include <modules/animation/animationsupplier.h>            // for AnimationSupplier
 #include <modules/animation/demo/democontroller.h>          // for DemoController
 #include <modules/animation/workspaceanimations.h>          // for WorkspaceAnimations
 
 #include <memory>  // for unique_ptr
+#include <string>  // for string
 
 namespace inviwo {
 class InviwoApplication;
@@ -89,6 +91,9 @@ private:
     animation::WorkspaceAnimations
         animations_;  /// Used by Animation Editor and stored with workspace.
     animation::DemoController demoController_;
+    /// Renders a frame range of the main animation, used by split renderings
+    TCLAP::ValueArg<std::string> renderFramesArg_;
+    CommandLineArgHolder renderFramesArgHolder_;
 };
 
 }  // namespace inviwo
@@ -59,6 +59,12 @@ struct IVW_MODULE_ANIMATION_API RecorderOptions {
     int frameRate = 25;
     int expectedNumberOfFrames = 1000;
     std::string sourceName = "";
+    /// Global index of the first frame passed to the recorder, non-zero when only a part of the
+    /// animation is rendered. Frame sequences should be numbered from here.
+    int firstFrame = 0;
+    /// True when the recorder only receives a part of the animation, i.e. when the rendering is
+    /// split over several processes. Recorders writing a single file should write one per part.
+    bool partial = false;
 };
 
 class IVW_MODULE_ANIMATION_API RecorderFactory {
@@ -0,0 +1,244 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/animation/algorithm/renderprocess.h>
+
+#include <inviwo/core/util/exception.h>         // for Exception
+#include <inviwo/core/util/filesystem.h>        // for getExecutablePath
+#include <inviwo/core/util/sourcecontext.h>     // for IVW_CONTEXT_CUSTOM
+#include <inviwo/core/util/stringconversion.h>  // for toWstring
+
+#include <algorithm>  // for clamp
+#include <array>      // for array
+#include <utility>    // for exchange
+
+#include <fmt/format.h>  // for format
+
+#ifdef WIN32
+struct IUnknown;  // Workaround for "combaseapi.h(229): error C2187: syntax error: 'identifier' was
+                  // unexpected here" when using /permissive-
+#include <windows.h>
+#else
+#include <csignal>     // for kill, SIGKILL
+#include <spawn.h>     // for posix_spawn
+#include <sys/wait.h>  // for waitpid
+#ifdef __APPLE__
+#include <crt_externs.h>  // for _NSGetEnviron
+#else
+extern char** environ;
+#endif
+#endif
+
+namespace inviwo {
+
+namespace animation {
+
+std::vector<std::pair<int, int>> splitFrameRange(int numFrames, int parts) {
+    if (numFrames < 1) return {};
+    parts = std::clamp(parts, 1, numFrames);
+
+    std::vector<std::pair<int, int>> ranges;
+    ranges.reserve(parts);
+    for (int i = 0; i < parts; ++i) {
+        ranges.emplace_back(static_cast<int>(static_cast<long long>(numFrames) * i / parts),
+                            static_cast<int>(static_cast<long long>(numFrames) * (i + 1) / parts) -
+                                1);
+    }
+    return ranges;
+}
+
+std::filesystem::path renderWorkerExecutable() {
+    const auto executable = filesystem::getExecutablePath();
+
+    // Application bundles on macOS place the executable in name.app/Contents/MacOS/name
+    const bool bundle = executable.parent_path().filename() == "MacOS" &&
+                        executable.parent_path().parent_path().filename() == "Contents";
+    const auto dir = bundle ? executable.parent_path().parent_path().parent_path().parent_path()
+                            : executable.parent_path();
+
+    for (std::string_view name : {"inviwo_qtminimum", "inviwo_glfwminimum"}) {
+        auto candidate = bundle ? dir / fmt::format("{}.app", name) / "Contents" / "MacOS" / name
+                                : dir / name;
+        candidate.replace_extension(executable.extension());
+        std::error_code ec;
+        if (std::filesystem::is_regular_file(candidate, ec)) return candidate;
+    }
+    return executable;
+}
+
+#ifdef WIN32
+namespace {
+
+// Quote an argument such that CommandLineToArgvW will give back the original string
+std::wstring quoteArgument(const std::wstring& arg) {
+    std::wstring quoted = L"\"";
+    size_t backslashes = 0;
+    for (auto c : arg) {
+        if (c == L'\\') {
+            ++backslashes;
+        } else if (c == L'"') {
+            quoted.append(2 * backslashes + 1, L'\\');
+            backslashes = 0;
+        } else {
+            quoted.append(backslashes, L'\\');
+            backslashes = 0;
+        }
+        if (c != L'\\') quoted.push_back(c);
+    }
+    quoted.append(2 * backslashes, L'\\');
+    quoted.push_back(L'"');
+    return quoted;
+}
+
+}  // namespace
+
+RenderProcess::RenderProcess(const std::filesystem::path& executable,
+                             const std::vector<std::string>& args) {
+    auto commandLine = quoteArgument(executable.wstring());
+    for (const auto& arg : args) {
+        commandLine += L' ';
+        commandLine += quoteArgument(util::toWstring(arg));
+    }
+
+    STARTUPINFOW startupInfo{};
+    startupInfo.cb = sizeof(startupInfo);
+    PROCESS_INFORMATION processInfo{};
+    if (!CreateProcessW(executable.wstring().c_str(), commandLine.data(), nullptr, nullptr, FALSE,
+                        0, nullptr, nullptr, &startupInfo, &processInfo)) {
+        throw Exception(IVW_CONTEXT_CUSTOM("RenderProcess"), "Unable to start {} (error {})",
+                        executable.string(), GetLastError());
+    }
+    CloseHandle(processInfo.hThread);
+    handle_ = processInfo.hProcess;
+}
+
+RenderProcess::RenderProcess(RenderProcess&& rhs) noexcept
+    : handle_{std::exchange(rhs.handle_, nullptr)}, status_{rhs.status_} {}
+
+RenderProcess& RenderProcess::operator=(RenderProcess&& rhs) noexcept {
+    if (this != &rhs) {
+        kill();
+        if (handle_) CloseHandle(handle_);
+        handle_ = std::exchange(rhs.handle_, nullptr);
+        status_ = rhs.status_;
+    }
+    return *this;
+}
+
+RenderProcess::~RenderProcess() {
+    kill();
+    if (handle_) CloseHandle(handle_);
+}
+
+std::optional<int> RenderProcess::poll() {
+    if (!status_ && handle_ && WaitForSingleObject(handle_, 0) == WAIT_OBJECT_0) {
+        DWORD code = 1;
+        GetExitCodeProcess(handle_, &code);
+        status_ = static_cast<int>(code);
+    }
+    return status_;
+}
+
+void RenderProcess::kill() {
+    if (handle_ && !poll()) {
+        TerminateProcess(handle_, 1);
+        WaitForSingleObject(handle_, INFINITE);
+        status_ = 1;
+    }
+}
+
+#else
+
+RenderProcess::RenderProcess(const std::filesystem::path& executable,
+                             const std::vector<std::string>& args) {
+    auto path = executable.string();
+    std::vector<char*> argv;
+    argv.reserve(args.size() + 2);
+    argv.push_back(path.data());
+    for (const auto& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+#ifdef __APPLE__
+    char** env = *_NSGetEnviron();
+#else
+    char** env = environ;
+#endif
+
+    pid_t pid{};
+    if (const auto err = posix_spawn(&pid, path.c_str(), nullptr, nullptr, argv.data(), env)) {
+        throw Exception(IVW_CONTEXT_CUSTOM("RenderProcess"), "Unable to start {} (error {})",
+                        executable.string(), err);
+    }
+    pid_ = static_cast<int>(pid);
+}
+
+RenderProcess::RenderProcess(RenderProcess&& rhs) noexcept
+    : pid_{std::exchange(rhs.pid_, -1)}, status_{rhs.status_} {}
+
+RenderProcess& RenderProcess::operator=(RenderProcess&& rhs) noexcept {
+    if (this != &rhs) {
+        kill();
+        pid_ = std::exchange(rhs.pid_, -1);
+        status_ = rhs.status_;
+    }
+    return *this;
+}
+
+RenderProcess::~RenderProcess() { kill(); }
+
+std::optional<int> RenderProcess::poll() {
+    if (!status_ && pid_ > 0) {
+        int status = 0;
+        const auto res = ::waitpid(static_cast<pid_t>(pid_), &status, WNOHANG);
+        if (res == static_cast<pid_t>(pid_)) {
+            // Report processes killed by a signal with the shell convention 128 + signal
+            status_ = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+        } else if (res == -1) {
+            status_ = -1;
+        }
+    }
+    return status_;
+}
+
+void RenderProcess::kill() {
+    if (pid_ > 0 && !poll()) {
+        ::kill(static_cast<pid_t>(pid_), SIGKILL);
+        int status = 0;
+        ::waitpid(static_cast<pid_t>(pid_), &status, 0);
+        status_ = 128 + SIGKILL;
+    }
+}
+
+#endif
+
+}  // namespace animation
+
+}  // namespace inviwo
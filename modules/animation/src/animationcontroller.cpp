@@ -38,6 +38,7 @@
 #include <inviwo/core/io/serialization/serializer.h>              // for Serializer
 #include <inviwo/core/io/datawriterutil.h>
 #include <inviwo/core/network/networklock.h>         // for NetworkLock
+#include <inviwo/core/network/workspacemanager.h>    // for WorkspaceManager
 #include <inviwo/core/network/processornetwork.h>    // for ProcessorNetwork
 #include <inviwo/core/processors/canvasprocessor.h>  // for CanvasProcessor
 #include <inviwo/core/processors/processor.h>        // for Processor
@@ -57,6 +58,7 @@
 #include <inviwo/core/properties/stringproperty.h>      // for StringProperty
 #include <inviwo/core/properties/valuewrapper.h>        // for PropertySerializationMode
 #include <inviwo/core/util/assertion.h>                 // for ivwAssert
+#include <inviwo/core/util/exception.h>                 // for RangeException
 #include <inviwo/core/util/fileextension.h>             // for FileExtension, operator<<
 #include <inviwo/core/util/glmvec.h>                    // for ivec2, dvec2
 #include <inviwo/core/util/staticstring.h>              // for operator+
@@ -71,6 +73,7 @@
 #include <modules/animation/datastructures/controltrack.h>       // for ControlTrack
 #include <modules/animation/datastructures/invalidationtrack.h>  // for InvalidationTrack
 #include <modules/animation/datastructures/track.h>              // for Track
+#include <modules/animation/algorithm/renderprocess.h>  // for RenderProcess, splitFrameRange
 #include <modules/animation/animationmanager.h>
 #include <modules/animation/factories/recorderfactory.h>
 #include <modules/animation/factories/recorderfactories.h>
@@ -78,13 +81,16 @@
 #include <algorithm>      // for max, copy_if, find_if, min
 #include <chrono>         // for milliseconds, duration
 #include <cstdlib>        // for abs, size_t
+#include <filesystem>     // for temp_directory_path
 #include <iomanip>        // for operator<<, setfill, setw
 #include <iterator>       // for back_insert_iterator
 #include <map>            // for map
 #include <memory>         // for make_unique
+#include <optional>       // for optional
 #include <ratio>          // for ratio
 #include <sstream>        // for operator<<, basic_ostream
 #include <string_view>    // for string_view, operator==
+#include <thread>         // for sleep_for, yield
 #include <unordered_map>  // for unordered_map
 #include <utility>        // for move
 #include <variant>
@@ -121,6 +127,12 @@ AnimationController::AnimationController(Animation& animation, AnimationManager&
     , renderFPS("renderFPS", "Frames per Second", 24.0, {0.001, ConstraintBehavior::Immutable},
                 {1000.0, ConstraintBehavior::Immutable}, 1.0, InvalidationLevel::InvalidOutput,
                 PropertySemantics::Text)
+    , renderProcesses("renderProcesses", "Processes",
+                      util::ordinalCount<int>(1, 16).setMin(1).set(
+                          "Split the frames into this many ranges, each rendered by a separate "
+                          "process that loads the current workspace. Recorders receive global "
+                          "frame numbers, so image sequences are numbered as if rendered in one "
+                          "go"_help))
     , renderAction("renderAction", "Render")
     , renderActionStop("renderActionStop", "Stop")
 
@@ -185,8 +197,8 @@ AnimationController::AnimationController(Animation& animation, AnimationManager&
     renderAction.setReadOnly(state_ == AnimationState::Rendering);
     renderActionStop.setReadOnly(state_ != AnimationState::Rendering);
 
-    renderOptions.addProperties(renderWindowMode, renderWindow, renderFPS, renderAction,
-                                renderActionStop);
+    renderOptions.addProperties(renderWindowMode, renderWindow, renderFPS, renderProcesses,
+                                renderAction, renderActionStop);
     renderOptions.setCollapsed(true);
 
     const auto& recorders = manager.getRecorderFactories();
@@ -331,7 +343,28 @@ void AnimationController::tick() {
     setState(newState);
 }
 
+std::pair<Seconds, Seconds> AnimationController::getRenderTimeWindow() const {
+    if (renderWindowMode.get() == 0) {
+        return {animation_->getFirstTime(), animation_->getLastTime()};
+    } else {
+        return {Seconds(renderWindow.get()[0]), Seconds(renderWindow.get()[1])};
+    }
+}
+
+int AnimationController::getNumberOfRenderFrames() const {
+    const auto [firstTime, lastTime] = getRenderTimeWindow();
+    return std::max(2, static_cast<int>((lastTime - firstTime) / Seconds{1.0 / renderFPS.get()}));
+}
+
 void AnimationController::render() {
+    if (renderProcesses.get() > 1) {
+        renderInProcesses(renderProcesses.get());
+    } else {
+        render(0, getNumberOfRenderFrames() - 1);
+    }
+}
+
+bool AnimationController::render(int firstFrame, int lastFrame) {
     auto start = std::chrono::high_resolution_clock::now();
 
     auto network = app_->getProcessorNetwork();
@@ -350,12 +383,13 @@ void AnimationController::render() {
     try {
 
         // Gather rendering info
-        const Seconds firstTime = (renderWindowMode.get() == 0) ? animation_->getFirstTime()
-                                                                : Seconds(renderWindow.get()[0]);
-        const Seconds lastTime = (renderWindowMode.get() == 0) ? animation_->getLastTime()
-                                                               : Seconds(renderWindow.get()[1]);
-        const int numFrames =
-            std::max(2, static_cast<int>((lastTime - firstTime) / Seconds{1.0 / renderFPS.get()}));
+        const auto [firstTime, lastTime] = getRenderTimeWindow();
+        const int numFrames = getNumberOfRenderFrames();
+        if (firstFrame < 0 || lastFrame >= numFrames || firstFrame > lastFrame) {
+            throw RangeException(IVW_CONTEXT, "Invalid frame range [{}, {}], expected [0, {}]",
+                                 firstFrame, lastFrame, numFrames - 1);
+        }
+        const bool partial = firstFrame != 0 || lastFrame != numFrames - 1;
 
         std::vector<std::function<void()>> recordingFunctors;
         const auto& recorderFactories = manager_->getRecorderFactories();
@@ -370,7 +404,9 @@ void AnimationController::render() {
                                 {.dimensions = imageExporter->getImage()->getDimensions(),
                                  .frameRate = static_cast<int>(framesPerSecond.get()),
                                  .expectedNumberOfFrames = numFrames,
-                                 .sourceName = p->getIdentifier()});
+                                 .sourceName = p->getIdentifier(),
+                                 .firstFrame = firstFrame,
+                                 .partial = partial});
 
                             recordingFunctors.emplace_back(
                                 [recorder = std::move(recorder), imageExporter]() {
@@ -392,7 +428,7 @@ void AnimationController::render() {
                             [exporter, writer = exportWriter_.get(),
                              dir = exportOutputDirectory_.get(), base,
                              overwrite = exportOverwrite_ ? Overwrite::Yes : Overwrite::No,
-                             counter = size_t{0}, digits]() mutable {
+                             counter = static_cast<size_t>(firstFrame), digits]() mutable {
                                 auto name = fmt::format("{}{:0{}}", base, counter, digits);
                                 exporter->exportFile(dir, name, {writer}, overwrite);
                                 ++counter;
@@ -405,11 +441,12 @@ void AnimationController::render() {
         if (recordingFunctors.empty()) {
             util::log(IVW_CONTEXT, "No applicable exporters selected for rendering",
                       LogLevel::Warn);
-            return;
+            return false;
         }
 
         // render frames
-        for (int currentFrame = 0; currentFrame < numFrames; ++currentFrame) {
+        int renderedFrames = 0;
+        for (int currentFrame = firstFrame; currentFrame <= lastFrame; ++currentFrame) {
             // Evaluate animation
             Seconds newTime = firstTime + (lastTime - firstTime) / (numFrames - 1) * currentFrame;
             eval(currentTime_, newTime);
@@ -428,6 +465,7 @@ void AnimationController::render() {
             }
 
             lock.emplace(network);
+            ++renderedFrames;
 
             if (state_ != AnimationState::Rendering) break;
         }
@@ -438,7 +476,9 @@ void AnimationController::render() {
                            .count();
 
         util::logInfo(IVW_CONTEXT, "Rendered {} frames in {:.3f} seconds, {:.3f} per frame",
-                      numFrames, seconds, seconds / numFrames);
+                      renderedFrames, seconds, seconds / std::max(renderedFrames, 1));
+
+        return renderedFrames == lastFrame - firstFrame + 1;
 
     } catch (const Exception& e) {
         util::log(IVW_CONTEXT, "Rendering aborted", LogLevel::Error);
@@ -449,6 +489,89 @@ void AnimationController::render() {
     } catch (...) {
         util::log(IVW_CONTEXT, "Rendering aborted", LogLevel::Error);
     }
+    return false;
+}
+
+void AnimationController::renderInProcesses(int processes) {
+    const int numFrames = getNumberOfRenderFrames();
+
+    setState(AnimationState::Rendering);
+    renderAction.setReadOnly(true);
+    renderActionStop.setReadOnly(false);
+
+    util::OnScopeExit reset{[&]() {
+        setState(AnimationState::Paused);
+        renderAction.setReadOnly(false);
+        renderActionStop.setReadOnly(true);
+    }};
+
+    try {
+        const auto start = std::chrono::high_resolution_clock::now();
+
+        // All processes load a snapshot of the current workspace, including any unsaved changes
+        const auto workspace =
+            std::filesystem::temp_directory_path() /
+            fmt::format("inviwo-render-{}.inv", start.time_since_epoch().count());
+        app_->getWorkspaceManager()->save(workspace);
+        util::OnScopeExit removeWorkspace{[&]() {
+            std::error_code ec;
+            std::filesystem::remove(workspace, ec);
+        }};
+
+        const auto executable = renderWorkerExecutable();
+
+        struct Worker {
+            int firstFrame;
+            int lastFrame;
+            RenderProcess process;
+        };
+        std::vector<Worker> workers;
+        for (const auto& [first, last] : splitFrameRange(numFrames, processes)) {
+            util::logInfo(IVW_CONTEXT, "Rendering frames {} to {} in a separate process", first,
+                          last);
+            workers.push_back(
+                {first, last,
+                 RenderProcess{executable,
+                               {"--workspace", workspace.string(), "--animation-frames",
+                                fmt::format("{}:{}", first, last), "-n", "-q"}}});
+        }
+
+        int failed = 0;
+        for (auto& worker : workers) {
+            std::optional<int> status;
+            while (!(status = worker.process.poll())) {
+                app_->processEvents();
+                // Stop sets the state to paused
+                if (state_ != AnimationState::Rendering) {
+                    for (auto& w : workers) w.process.kill();
+                    util::logInfo(IVW_CONTEXT, "Rendering stopped, terminated all processes");
+                    return;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds{50});
+            }
+            if (*status != 0) {
+                util::logError(IVW_CONTEXT,
+                               "Rendering of frames {} to {} failed with exit status {}",
+                               worker.firstFrame, worker.lastFrame, *status);
+                ++failed;
+            }
+        }
+
+        using duration_double = std::chrono::duration<double, std::ratio<1>>;
+        auto seconds = std::chrono::duration_cast<duration_double>(
+                           std::chrono::high_resolution_clock::now() - start)
+                           .count();
+
+        util::logInfo(IVW_CONTEXT, "Rendered {} frames in {} of {} processes in {:.3f} seconds",
+                      numFrames, workers.size() - failed, workers.size(), seconds);
+
+    } catch (const Exception& e) {
+        util::log(IVW_CONTEXT, "Rendering aborted", LogLevel::Error);
+        util::log(e.getContext(), e.getMessage(), LogLevel::Error);
+    } catch (const std::exception& e) {
+        util::log(IVW_CONTEXT, "Rendering aborted", LogLevel::Error);
+        util::log(IVW_CONTEXT, e.what(), LogLevel::Error);
+    }
 }
 
 void AnimationController::eval(Seconds oldTime, Seconds newTime) {
@@ -29,6 +29,7 @@
 
 #include <modules/animation/animationmodule.h>
 
+#include <inviwo/core/common/inviwoapplication.h>                          // for InviwoApplic...
 #include <inviwo/core/common/inviwomodule.h>                               // for InviwoModule
 #include <inviwo/core/datastructures/camera/camera.h>                      // for mat4
 #include <inviwo/core/io/serialization/deserializer.h>                     // for ContainerWrapp...
@@ -45,6 +46,7 @@
 #include <inviwo/core/properties/ordinalrefproperty.h>                     // for OrdinalRefProp...
 #include <inviwo/core/properties/property.h>                               // for PropertyTraits
 #include <inviwo/core/properties/stringproperty.h>                         // for StringProperty
+#include <inviwo/core/util/commandlineparser.h>                            // for CommandLineP...
 #include <inviwo/core/util/exception.h>                                    // for Exception
 #include <inviwo/core/util/foreacharg.h>                                   // for for_each_type
 #include <inviwo/core/util/glmmat.h>                                       // for dmat2, dmat3
@@ -52,6 +54,7 @@
 #include <inviwo/core/util/glmvec.h>                                       // for dvec2, dvec3
 #include <inviwo/core/util/staticstring.h>                                 // for operator+
 #include <inviwo/core/util/stringconversion.h>                             // for replaceInString
+#include <inviwo/core/util/logcentral.h>                                   // for LogError
 #include <modules/animation/animationmanager.h>                            // for AnimationManager
 #include <modules/animation/animationsupplier.h>                           // for AnimationSupplier
 #include <modules/animation/datastructures/animationtime.h>                // for animation
@@ -78,12 +81,14 @@
 #include <modules/animation/workspaceanimations.h>                         // for WorkspaceAnima...
 #include <modules/animation/factories/imagerecorderfactory.h>
 
-#include <cstddef>     // for size_t
-#include <functional>  // for __base
-#include <map>         // for map
-#include <string>      // for string, basic_...
-#include <tuple>       // for tuple
-#include <vector>      // for vector
+#include <charconv>     // for from_chars
+#include <cstddef>      // for size_t
+#include <functional>   // for __base
+#include <map>          // for map
+#include <string>       // for string, basic_...
+#include <string_view>  // for string_view
+#include <tuple>        // for tuple
+#include <vector>       // for vector
 
 #include <glm/common.hpp>        // for clamp, max, min
 #include <glm/gtc/type_ptr.hpp>  // for value_ptr
@@ -183,7 +188,34 @@ AnimationModule::AnimationModule(InviwoApplication* app)
     , animation::AnimationSupplier(manager_)
     , manager_(app)
     , animations_(app, manager_, *this)
-    , demoController_(app) {
+    , demoController_(app)
+    , renderFramesArg_("", "animation-frames",
+                       "Render the frames first:last of the main animation, numbered over the "
+                       "whole render window",
+                       false, "", "first:last")
+    , renderFramesArgHolder_{app, renderFramesArg_,
+                             [this]() {
+                                 const std::string_view range = renderFramesArg_.getValue();
+                                 const auto sep = range.find(':');
+                                 int first = 0;
+                                 int last = 0;
+                                 if (sep == std::string_view::npos ||
+                                     std::from_chars(range.data(), range.data() + sep, first).ec !=
+                                         std::errc{} ||
+                                     std::from_chars(range.data() + sep + 1,
+                                                     range.data() + range.size(), last)
+                                             .ec != std::errc{}) {
+                                     LogError("Invalid frame range '" << range
+                                                                      << "', expected first:last");
+                                     app_->getCommandLineParser().setExitCode(1);
+                                     return;
+                                 }
+                                 // Let the process calling us detect failed ranges
+                                 if (!getMainAnimation().getController().render(first, last)) {
+                                     app_->getCommandLineParser().setExitCode(1);
+                                 }
+                             },
+                             1100} {
 
     using namespace animation;
 
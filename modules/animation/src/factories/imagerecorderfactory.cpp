@@ -32,7 +32,7 @@
 #include <inviwo/core/datastructures/image/layerram.h>
 #include <inviwo/core/io/datawriterfactory.h>
 #include <inviwo/core/io/datawriter.h>
-#include <inviwo/core/util/threadutil.h>
+#include <inviwo/core/io/layerwritequeue.h>
 #include <inviwo/core/util/stringconversion.h>
 #include <inviwo/core/common/factoryutil.h>
 
@@ -40,97 +40,32 @@
 
 namespace inviwo::animation {
 
-class ExceptionPropagator {
-    class State {
-    public:
-        State() = default;
-        State(const State&) = delete;
-        State(State&&) = delete;
-        State& operator=(const State&) = delete;
-        State& operator=(State&&) = delete;
-        ~State() noexcept {
-            try {
-                throwOnError();
-            } catch (const Exception& e) {
-                util::log(e.getContext(), e.getMessage());
-            } catch (const std::exception& e) {
-                util::log(IVW_CONTEXT, e.what());
-            } catch (...) {
-                util::log(IVW_CONTEXT, "unknown error");
-            }
-        }
-        void setException() {
-            std::scoped_lock lock{exceptionMutex_};
-            if (!exception_) {
-                exception_ = std::current_exception();
-            }
-        }
-        void throwOnError() {
-            std::scoped_lock lock{exceptionMutex_};
-            if (exception_) {
-                std::rethrow_exception(std::exchange(exception_, nullptr));
-            }
-        }
-
-    private:
-        std::mutex exceptionMutex_;
-        std::exception_ptr exception_;
-    };
-
-public:
-    ExceptionPropagator() : state_{std::make_shared<State>()} {}
-
-    void setException() { state_->setException(); }
-    void throwOnError() { state_->throwOnError(); }
-
-    std::shared_ptr<State> get() { return state_; }
-
-private:
-    std::shared_ptr<State> state_;
-};
-
 namespace {
 class ImageRecorder : public Recorder {
 public:
     ImageRecorder(InviwoApplication* app, const std::filesystem::path& dir, std::string_view format,
-                  std::shared_ptr<DataWriterType<Layer>> writer)
+                  std::shared_ptr<DataWriterType<Layer>> writer, size_t firstFrame)
         : Recorder{}
-        , app_{app}
         , dir_{dir}
         , format_{format}
         , writer_{std::move(writer)}
-        , count_{1} {}
+        , count_{firstFrame + 1}
+        , queue_{app} {}
 
     virtual ~ImageRecorder() = default;
     virtual void record(const Layer& layer) override;
 
 private:
-    InviwoApplication* app_;
     std::filesystem::path dir_;
     std::string format_;
     std::shared_ptr<DataWriterType<Layer>> writer_;
     size_t count_;
-    ExceptionPropagator exceptionProp_;
+    LayerWriteQueue queue_;
 };
 
 void ImageRecorder::record(const Layer& layer) {
-    exceptionProp_.throwOnError();
-
-    // Hackish: Make sure LayerRAM is the last valid rep, so
-    // that it is the one that will be cloned. This also
-    // forces the download to happen on the main thread
-    // instead of in the background.
-    layer.getRepresentation<LayerRAM>();
-    util::dispatchPool(
-        app_, [writer = writer_, file = dir_ / fmt::format(fmt::runtime(format_), count_),
-               copy = std::shared_ptr<Layer>(layer.clone()), exception = exceptionProp_.get()]() {
-            try {
-                writer->writeData(copy.get(), file);
-            } catch (...) {
-                exception->setException();
-            }
-        });
-
+    // The layer is copied here, encoding and writing happen on the thread pool
+    queue_.write(layer, writer_, dir_ / fmt::format(fmt::runtime(format_), count_));
     ++count_;
 }
 }  // namespace
@@ -183,7 +118,8 @@ std::unique_ptr<Recorder> ImageRecorderFactory::create(const RecorderOptions& op
                               writer_.getSelectedValue().extension_);
     replaceInString(format, "UPN", opts.sourceName);
 
-    return std::make_unique<ImageRecorder>(app_, outputDirectory_.get(), format, std::move(writer));
+    return std::make_unique<ImageRecorder>(app_, outputDirectory_.get(), format, std::move(writer),
+                                           static_cast<size_t>(opts.firstFrame));
 }
 
 }  // namespace inviwo::animation
@@ -0,0 +1,97 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/animation/algorithm/renderprocess.h>
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+namespace animation {
+
+TEST(AnimationTests, SplitFrameRangeCoversAllFrames) {
+    for (int numFrames : {1, 2, 3, 7, 10, 24, 101}) {
+        for (int parts : {1, 2, 3, 4, 8}) {
+            const auto ranges = splitFrameRange(numFrames, parts);
+            ASSERT_EQ(ranges.size(), static_cast<size_t>(std::min(parts, numFrames)));
+
+            int next = 0;
+            for (const auto& [first, last] : ranges) {
+                EXPECT_EQ(first, next);
+                EXPECT_LE(first, last);
+                // parts differ by at most one frame
+                EXPECT_LE(last - first + 1, numFrames / static_cast<int>(ranges.size()) + 1);
+                EXPECT_GE(last - first + 1, numFrames / static_cast<int>(ranges.size()));
+                next = last + 1;
+            }
+            EXPECT_EQ(next, numFrames);
+        }
+    }
+}
+
+TEST(AnimationTests, SplitFrameRange) {
+    using Ranges = std::vector<std::pair<int, int>>;
+    EXPECT_EQ(splitFrameRange(10, 1), (Ranges{{0, 9}}));
+    EXPECT_EQ(splitFrameRange(10, 2), (Ranges{{0, 4}, {5, 9}}));
+    EXPECT_EQ(splitFrameRange(10, 3), (Ranges{{0, 2}, {3, 5}, {6, 9}}));
+    EXPECT_EQ(splitFrameRange(3, 5), (Ranges{{0, 0}, {1, 1}, {2, 2}}));
+    EXPECT_EQ(splitFrameRange(10, 0), (Ranges{{0, 9}}));
+    EXPECT_TRUE(splitFrameRange(0, 4).empty());
+}
+
+#ifndef WIN32
+TEST(AnimationTests, RenderProcessExitStatus) {
+    RenderProcess process{"/bin/sh", {"-c", "exit 3"}};
+    std::optional<int> status;
+    while (!(status = process.poll())) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    EXPECT_EQ(*status, 3);
+}
+
+TEST(AnimationTests, RenderProcessKill) {
+    RenderProcess process{"/bin/sh", {"-c", "sleep 60"}};
+    EXPECT_FALSE(process.poll());
+    process.kill();
+    ASSERT_TRUE(process.poll());
+    EXPECT_NE(*process.poll(), 0);
+}
+#endif
+
+}  // namespace animation
+}  // namespace inviwo
@@ -31,21 +31,24 @@
 
 #include <modules/base/basemoduledefine.h>  // for IVW_MODULE_BASE_API
 
+#include <inviwo/core/util/foreach.h>                 // for forEachChunkParallel
 #include <inviwo/core/util/formats.h>                 // for DataFormat
-#include <inviwo/core/util/glm.h>                     // for isfinite
 #include <inviwo/core/util/glmcomp.h>                 // for glmcomp
-#include <inviwo/core/util/glmconvert.h>              // for glm_convert
 #include <inviwo/core/util/glmutils.h>                // for is_floating_point, flat_extent
 #include <inviwo/core/util/glmvec.h>                  // for dvec4
 #include <modules/base/algorithm/algorithmoptions.h>  // for IgnoreSpecialValues, IgnoreSpecialV...
 
-#include <algorithm>    // for max, min
+#include <algorithm>    // for max, min, transform
+#include <array>        // for array
+#include <cmath>        // for abs
 #include <cstddef>      // for size_t
-#include <numeric>      // for accumulate
-#include <type_traits>  // for enable_if
+#include <limits>       // for numeric_limits
+#include <type_traits>  // for conditional_t, is_same_v
 #include <utility>      // for pair
+#include <vector>       // for vector
 
 #include <glm/common.hpp>  // for max, min
+#include <half/half.hpp>   // for half
 
 namespace inviwo {
 
@@ -58,9 +61,17 @@ class VolumeRAM;
 
 namespace util {
 
+/**
+ * Compute the component-wise minimum and maximum values of a volume. The result is cached on the
+ * representation until its data is accessed for writing, @see VolumeRAM::getData
+ */
 IVW_MODULE_BASE_API std::pair<dvec4, dvec4> volumeMinMax(
     const VolumeRAM* volume, IgnoreSpecialValues ignore = IgnoreSpecialValues::No);
 
+/**
+ * Compute the component-wise minimum and maximum values of a layer. The result is cached on the
+ * representation until its data is accessed for writing, @see LayerRAM::getData
+ */
 IVW_MODULE_BASE_API std::pair<dvec4, dvec4> layerMinMax(
     const LayerRAM* layer, IgnoreSpecialValues ignore = IgnoreSpecialValues::No);
 
@@ -78,56 +89,102 @@ IVW_MODULE_BASE_API std::pair<dvec4, dvec4> bufferMinMax(
 
 namespace detail {
 
-// Specialization for double, float, half
-template <typename ValueType,
-          typename std::enable_if<util::is_floating_point<ValueType>::value, int>::type = 0>
-std::pair<dvec4, dvec4> dataMinMax(const ValueType* data, size_t size,
-                                   IgnoreSpecialValues ignore = IgnoreSpecialValues::No) {
-    using Res = std::pair<ValueType, ValueType>;
-    Res minmax{DataFormat<ValueType>::max(), DataFormat<ValueType>::lowest()};
-
-    if (ignore == IgnoreSpecialValues::Yes) {
-        minmax = std::accumulate(
-            data, data + size, minmax, [](const Res& mm, const ValueType& v) -> Res {
-                Res res(mm);
-                for (size_t i = 0; i < util::flat_extent<ValueType>::value; ++i) {
-                    if (util::isfinite(util::glmcomp(v, i))) {
-                        util::glmcomp(res.first, i) =
-                            std::min(util::glmcomp(mm.first, i), util::glmcomp(v, i));
-                        util::glmcomp(res.second, i) =
-                            std::max(util::glmcomp(mm.second, i), util::glmcomp(v, i));
-                    }
-                }
-                return res;
-            });
+/*
+ * Values are reduced into a set of lanes. The number of lanes is a multiple of the number of
+ * components, hence each lane always sees the same component and the inner loop has no dependencies
+ * between iterations, which allows it to be vectorized.
+ */
+template <size_t Components>
+constexpr size_t minMaxLaneCount = Components * (16 / Components);
+
+template <typename T, size_t Lanes, bool IgnoreSpecial>
+void minMaxLanes(const T* values, size_t count, std::array<T, Lanes>& min,
+                 std::array<T, Lanes>& max) {
+    const auto update = [&](size_t l, T v) {
+        if constexpr (IgnoreSpecial) {
+            const bool finite = std::abs(v) <= std::numeric_limits<T>::max();
+            min[l] = (finite && v < min[l]) ? v : min[l];
+            max[l] = (finite && v > max[l]) ? v : max[l];
+        } else {
+            min[l] = v < min[l] ? v : min[l];
+            max[l] = v > max[l] ? v : max[l];
+        }
+    };
+
+    const size_t full = count - count % Lanes;
+    for (size_t i = 0; i < full; i += Lanes) {
+        for (size_t l = 0; l < Lanes; ++l) {
+            update(l, values[i + l]);
+        }
+    }
+    for (size_t i = full; i < count; ++i) {
+        update(i - full, values[i]);
+    }
+}
+
+/**
+ * Serial component-wise min/max of @p size values. Half precision values are converted to float
+ * in blocks before the reduction.
+ */
+template <typename ValueType>
+std::pair<dvec4, dvec4> dataMinMaxSerial(const ValueType* data, size_t size,
+                                         IgnoreSpecialValues ignore) {
+    using Comp = typename util::value_type<ValueType>::type;
+    using Calc = std::conditional_t<std::is_same_v<Comp, half_float::half>, float, Comp>;
+    constexpr size_t components = util::flat_extent<ValueType>::value;
+    constexpr size_t lanes = minMaxLaneCount<components>;
+
+    std::array<Calc, lanes> min;
+    std::array<Calc, lanes> max;
+    min.fill(static_cast<Calc>(std::numeric_limits<Comp>::max()));
+    max.fill(static_cast<Calc>(std::numeric_limits<Comp>::lowest()));
+
+    const auto reduce = [&](const Calc* values, size_t count) {
+        if constexpr (util::is_floating_point<Comp>::value) {
+            if (ignore == IgnoreSpecialValues::Yes) {
+                minMaxLanes<Calc, lanes, true>(values, count, min, max);
+                return;
+            }
+        }
+        minMaxLanes<Calc, lanes, false>(values, count, min, max);
+    };
+
+    const auto* comps = reinterpret_cast<const Comp*>(data);
+    const size_t count = size * components;
+    if constexpr (std::is_same_v<Comp, Calc>) {
+        reduce(comps, count);
     } else {
-        minmax = std::accumulate(data, data + size, minmax,
-                                 [](const Res& mm, const ValueType& v) -> Res {
-                                     return {glm::min(mm.first, v), glm::max(mm.second, v)};
-                                 });
+        // blocks are a multiple of the number of lanes to keep the lanes and components aligned
+        constexpr size_t blockSize = lanes * 64;
+        std::array<Calc, blockSize> block;
+        for (size_t offset = 0; offset < count; offset += blockSize) {
+            const size_t n = std::min(blockSize, count - offset);
+            std::transform(comps + offset, comps + offset + n, block.begin(),
+                           [](Comp v) { return static_cast<Calc>(v); });
+            reduce(block.data(), n);
+        }
     }
 
-    return {util::glm_convert<dvec4>(minmax.first), util::glm_convert<dvec4>(minmax.second)};
-}
-// Specialization for integer types. They do not have special values
-template <typename ValueType,
-          typename std::enable_if<!util::is_floating_point<ValueType>::value, int>::type = 0>
-std::pair<dvec4, dvec4> dataMinMax(const ValueType* data, size_t size,
-                                   IgnoreSpecialValues = IgnoreSpecialValues::No) {
-    using Res = std::pair<ValueType, ValueType>;
-    Res minmax{DataFormat<ValueType>::max(), DataFormat<ValueType>::lowest()};
-    minmax =
-        std::accumulate(data, data + size, minmax, [](const Res& mm, const ValueType& v) -> Res {
-            return {glm::min(mm.first, v), glm::max(mm.second, v)};
-        });
-
-    return {util::glm_convert<dvec4>(minmax.first), util::glm_convert<dvec4>(minmax.second)};
+    std::pair<dvec4, dvec4> res{dvec4{0.0}, dvec4{0.0}};
+    for (size_t c = 0; c < components; ++c) {
+        auto& resMin = util::glmcomp(res.first, c);
+        auto& resMax = util::glmcomp(res.second, c);
+        resMin = static_cast<double>(min[c]);
+        resMax = static_cast<double>(max[c]);
+        for (size_t l = c + components; l < lanes; l += components) {
+            resMin = std::min(resMin, static_cast<double>(min[l]));
+            resMax = std::max(resMax, static_cast<double>(max[l]));
+        }
+    }
+    return res;
 }
 
 }  // namespace detail
 
 /**
  * Compute component-wise minimum and maximum values scalar and glm::vec types.
+ * The computation is split into chunks that are processed in parallel on the Inviwo thread pool,
+ * each chunk using a vectorizable reduction.
  *
  * @param data pointer to values
  * @param size of data
@@ -137,7 +194,21 @@ std::pair<dvec4, dvec4> dataMinMax(const ValueType* data, size_t size,
 template <typename ValueType>
 std::pair<dvec4, dvec4> dataMinMax(const ValueType* data, size_t size,
                                    IgnoreSpecialValues ignore = IgnoreSpecialValues::No) {
-    return detail::dataMinMax<ValueType>(data, size, ignore);
+    constexpr size_t minChunkSize = size_t{1} << 16;
+    const auto chunks = util::parallelChunkCount(size, minChunkSize);
+    if (chunks == 1) return detail::dataMinMaxSerial(data, size, ignore);
+
+    std::vector<std::pair<dvec4, dvec4>> results(chunks);
+    util::forEachChunkParallel(size, chunks, [&](size_t chunk, size_t begin, size_t end) {
+        results[chunk] = detail::dataMinMaxSerial(data + begin, end - begin, ignore);
+    });
+
+    auto res = results.front();
+    for (size_t i = 1; i < results.size(); ++i) {
+        res.first = glm::min(res.first, results[i].first);
+        res.second = glm::max(res.second, results[i].second);
+    }
+    return res;
 }
 
 }  // namespace util
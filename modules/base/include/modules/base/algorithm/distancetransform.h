@@ -0,0 +1,273 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/util/foreach.h>   // for forEachChunkParallel, parallelChunkCount
+#include <inviwo/core/util/glmutils.h>  // for Vector
+
+#include <algorithm>   // for min, max
+#include <cmath>       // for sqrt
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint32_t
+#include <functional>  // for function
+#include <limits>      // for numeric_limits
+#include <vector>      // for vector
+
+#include <glm/fwd.hpp>                 // for int64
+#include <glm/gtx/component_wise.hpp>  // for compMul
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * Options for layerRAMDistanceTransform and volumeRAMDistanceTransform
+ */
+struct DistanceTransformOptions {
+    /**
+     * Also compute the distance from each feature to the closest non-feature and store it
+     * negated, i.e. features (inside) get negative distances and non-features (outside) positive
+     * ones. The value transform is applied to the unsigned squared distance before negation.
+     */
+    bool signedDistance = false;
+    /**
+     * Checked between passes and work chunks, the calculation is aborted if it returns true.
+     * Might be called from several threads at once.
+     */
+    std::function<bool()> stop;
+};
+
+/**
+ * Index written to the closest feature output for positions without any feature in the input.
+ */
+constexpr std::uint32_t noClosestFeature = std::numeric_limits<std::uint32_t>::max();
+
+namespace detail {
+
+/**
+ * N-dimensional Euclidean distance transform according to Saito's algorithm shared by
+ * layerRAMDistanceTransform and volumeRAMDistanceTransform. Each pass scans all lines along one
+ * axis, the lines are processed in parallel on the Inviwo thread pool. The signed distance and
+ * the closest feature are computed in the same passes as the distance.
+ *
+ * @param srcDim dimensions of the input
+ * @param dstDim dimensions of the output, a multiple of srcDim
+ * @param squareVoxelSize squared size of an output voxel along each axis
+ * @param isFeature function of type (size_t srcIndex) -> bool
+ * @param dst output distances, compMul(dstDim) elements
+ * @param closest optional output, compMul(dstDim) elements, receives the linear index into the
+ *        input of the closest feature or noClosestFeature.
+ * @param valueTransform function of type (const U& squaredDist) -> U
+ * @param callback function of type (double progress) -> void
+ * @param options signed distance and cancellation
+ * @return false if the calculation was stopped, the content of the outputs is then undefined
+ */
+template <size_t N, typename U, typename IsFeature, typename ValueTransform,
+          typename ProgressCallback>
+bool distanceTransform(const Vector<N, glm::int64>& srcDim, const Vector<N, glm::int64>& dstDim,
+                       const Vector<N, U>& squareVoxelSize, IsFeature isFeature, U* dst,
+                       std::uint32_t* closest, ValueTransform valueTransform,
+                       ProgressCallback callback, const DistanceTransformOptions& options) {
+    using int64 = glm::int64;
+
+    // Distance for positions without any feature, never added to in the scans to not overflow
+    constexpr U far = std::numeric_limits<U>::max();
+    // Smallest number of elements processed by a single job
+    constexpr int64 minElementsPerJob = int64{1} << 14;
+
+    const auto stopped = [&]() { return options.stop && options.stop(); };
+
+    const int64 size = glm::compMul(dstDim);
+    const Vector<N, int64> sm = dstDim / srcDim;
+    Vector<N, int64> dstStride{1};
+    Vector<N, int64> srcStride{1};
+    for (size_t i = 1; i < N; ++i) {
+        dstStride[i] = dstStride[i - 1] * dstDim[i - 1];
+        srcStride[i] = srcStride[i - 1] * srcDim[i - 1];
+    }
+
+    // Distance to the closest non-feature, only needed for the signed distance
+    std::vector<U> inside(options.signedDistance ? static_cast<size_t>(size) : 0);
+
+    // Call func(lineOffset, srcLineOffset) for all lines along axis in parallel, each chunk of
+    // lines uses its own copy of func
+    const auto forEachLine = [&](size_t axis, auto func) {
+        const auto lines = static_cast<size_t>(size / dstDim[axis]);
+        const auto minLines =
+            static_cast<size_t>(std::max(minElementsPerJob / dstDim[axis], int64{1}));
+        util::forEachChunkParallel(
+            lines, util::parallelChunkCount(lines, minLines),
+            [&](size_t, size_t begin, size_t end) {
+                if (stopped()) return;
+                auto lineFunc = func;
+                for (size_t line = begin; line < end; ++line) {
+                    int64 rest = static_cast<int64>(line);
+                    int64 offset = 0;
+                    int64 srcOffset = 0;
+                    for (size_t i = 0; i < N; ++i) {
+                        if (i == axis) continue;
+                        const auto pos = rest % dstDim[i];
+                        rest /= dstDim[i];
+                        offset += pos * dstStride[i];
+                        srcOffset += (pos / sm[i]) * srcStride[i];
+                    }
+                    lineFunc(offset, srcOffset);
+                }
+            });
+    };
+
+    callback(0.0);
+
+    // First pass, forward and backward scan along x
+    // result: min squared distance in x direction
+    const auto width = dstDim[0];
+    forEachLine(0, [&](int64 offset, int64 srcOffset) {
+        U* data = dst + offset;
+        std::uint32_t* index = closest ? closest + offset : nullptr;
+        U* in = options.signedDistance ? inside.data() + offset : nullptr;
+
+        // the position of the last feature and non-feature seen, -1 if none
+        int64 feature = -1;
+        int64 background = -1;
+        for (int64 x = 0; x < width; ++x) {
+            if (isFeature(static_cast<size_t>(srcOffset + x / sm[0]))) {
+                feature = x;
+            } else {
+                background = x;
+            }
+            data[x] = feature < 0 ? far : squareVoxelSize[0] * U((x - feature) * (x - feature));
+            if (index) {
+                index[x] = feature < 0 ? noClosestFeature
+                                       : static_cast<std::uint32_t>(srcOffset + feature / sm[0]);
+            }
+            if (in) {
+                in[x] = background < 0
+                            ? far
+                            : squareVoxelSize[0] * U((x - background) * (x - background));
+            }
+        }
+        feature = -1;
+        background = -1;
+        for (int64 x = width - 1; x >= 0; --x) {
+            if (isFeature(static_cast<size_t>(srcOffset + x / sm[0]))) {
+                feature = x;
+            } else {
+                background = x;
+            }
+            if (feature >= 0) {
+                const auto d = squareVoxelSize[0] * U((feature - x) * (feature - x));
+                if (d < data[x]) {
+                    data[x] = d;
+                    if (index) index[x] = static_cast<std::uint32_t>(srcOffset + feature / sm[0]);
+                }
+            }
+            if (in && background >= 0) {
+                in[x] = std::min(in[x],
+                                 squareVoxelSize[0] * U((background - x) * (background - x)));
+            }
+        }
+    });
+    if (stopped()) return false;
+
+    // Remaining passes, for each axis scan all lines along it
+    // for each position i find min_j(data(j) + (i - j)^2), 0 <= j < len
+    // result: min squared distance in all directions up to axis
+    for (size_t axis = 1; axis < N; ++axis) {
+        callback(static_cast<double>(axis) / (N + 1));
+
+        const auto stride = dstStride[axis];
+        const auto len = dstDim[axis];
+        const auto voxelSize = squareVoxelSize[axis];
+        const auto invVoxelSize = 1.0 / static_cast<double>(voxelSize);
+
+        // scan a single line of data, and update index accordingly if given
+        const auto scan = [&](U* data, std::uint32_t* index, std::vector<U>& buff,
+                              std::vector<std::uint32_t>& indexBuff) {
+            // cache line data in temporary buffers
+            for (int64 i = 0; i < len; ++i) buff[i] = data[i * stride];
+            if (index) {
+                for (int64 i = 0; i < len; ++i) indexBuff[i] = index[i * stride];
+            }
+
+            for (int64 i = 0; i < len; ++i) {
+                auto d = buff[i];
+                if (d == U(0)) continue;
+
+                // only features closer than the current distance along this axis can be closer
+                const auto r = std::sqrt(static_cast<double>(d) * invVoxelSize);
+                const auto rMax = r >= static_cast<double>(len) ? len : static_cast<int64>(r) + 1;
+                const auto jBegin = std::max(i - rMax, int64{0});
+                const auto jEnd = std::min(i + rMax, len);
+                auto j0 = i;
+                for (int64 j = jBegin; j < jEnd; ++j) {
+                    if (buff[j] >= d) continue;
+                    const auto w = buff[j] + voxelSize * U((i - j) * (i - j));
+                    if (w < d) {
+                        d = w;
+                        j0 = j;
+                    }
+                }
+                data[i * stride] = d;
+                if (index) index[i * stride] = indexBuff[j0];
+            }
+        };
+
+        forEachLine(axis, [&, buff = std::vector<U>{}, indexBuff = std::vector<std::uint32_t>{}](
+                              int64 offset, int64) mutable {
+            buff.resize(static_cast<size_t>(len));
+            if (closest) indexBuff.resize(static_cast<size_t>(len));
+            scan(dst + offset, closest ? closest + offset : nullptr, buff, indexBuff);
+            if (options.signedDistance) scan(inside.data() + offset, nullptr, buff, indexBuff);
+        });
+        if (stopped()) return false;
+    }
+
+    // Apply the value transform and combine with the distance inside the features
+    callback(static_cast<double>(N) / (N + 1));
+    util::forEachChunkParallel(
+        static_cast<size_t>(size),
+        util::parallelChunkCount(static_cast<size_t>(size), minElementsPerJob),
+        [&](size_t, size_t begin, size_t end) {
+            if (options.signedDistance) {
+                for (size_t i = begin; i < end; ++i) {
+                    dst[i] = dst[i] != U(0) ? valueTransform(dst[i]) : -valueTransform(inside[i]);
+                }
+            } else {
+                for (size_t i = begin; i < end; ++i) dst[i] = valueTransform(dst[i]);
+            }
+        });
+    callback(1.0);
+    return true;
+}
+
+}  // namespace detail
+
+}  // namespace util
+
+}  // namespace inviwo
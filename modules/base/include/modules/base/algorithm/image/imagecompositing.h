@@ -0,0 +1,85 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <modules/base/basemoduledefine.h>  // for IVW_MODULE_BASE_API
+
+#include <inviwo/core/util/glmvec.h>  // for ivec4, vec4
+
+#include <iosfwd>  // for ostream
+
+namespace inviwo {
+
+class Image;
+
+enum class ImageBlendMode {
+    Replace,  //!< Overwrite color, depth, and picking
+    Over      //!< Blend color using (src alpha, 1 - src alpha), skip fully transparent pixels
+};
+
+IVW_MODULE_BASE_API std::ostream& operator<<(std::ostream& ss, ImageBlendMode mode);
+
+namespace util {
+
+/**
+ * Depth based compositing of two images on the CPU, the counterpart of ImageCompositor. For each
+ * pixel the fragment closest to the viewer is blended over the other one, and the depth and
+ * picking of the closest fragment are used. The color, depth, and picking layers are converted
+ * from and to any data format. Sources with other dimensions than @p destination are sampled
+ * using nearest neighbor, missing depth and picking layers are treated as cleared.
+ * The work is split into bands of rows which are processed in parallel using the thread pool.
+ */
+IVW_MODULE_BASE_API void compositeImages(const Image& source0, const Image& source1,
+                                         Image& destination);
+
+/**
+ * Draw @p source into the @p viewport (x, y, width, height) of @p destination, sampling it
+ * using nearest neighbor. Pixels outside of @p destination are discarded. Runs in parallel over
+ * bands of rows using the thread pool.
+ * @see ImageBlendMode
+ */
+IVW_MODULE_BASE_API void drawImage(const Image& source, Image& destination, const ivec4& viewport,
+                                   ImageBlendMode mode = ImageBlendMode::Replace);
+
+/**
+ * Fill the @p rect (x, y, width, height) of @p destination with @p color. Depth is set to 1 and
+ * picking to zero, unless the blend mode is ImageBlendMode::Over in which case only the color is
+ * blended.
+ */
+IVW_MODULE_BASE_API void fillImage(Image& destination, const ivec4& rect, const vec4& color,
+                                   ImageBlendMode mode = ImageBlendMode::Replace);
+
+/**
+ * Clear all of @p destination, i.e. zero color and picking and a depth of 1.
+ */
+IVW_MODULE_BASE_API void clearImage(Image& destination);
+
+}  // namespace util
+
+}  // namespace inviwo
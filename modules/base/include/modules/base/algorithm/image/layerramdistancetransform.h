@@ -36,26 +36,20 @@
 #include <inviwo/core/util/glmconvert.h>                // for glm_convert_normalized
 #include <inviwo/core/util/glmutils.h>                  // for Vector, Matrix
 #include <inviwo/core/util/glmvec.h>                    // for i64vec2, size2_t
-#include <inviwo/core/util/indexmapper.h>               // for IndexMapper
 #include <inviwo/core/util/logcentral.h>                // for LogCentral, LogWarnCustom
 #include <inviwo/core/util/sourcecontext.h>             // for IVW_CONTEXT_CUSTOM
 #include <inviwo/core/util/stringconversion.h>          // for toString
+#include <modules/base/algorithm/distancetransform.h>   // for distanceTransform, DistanceTr...
 
-#include <stdlib.h>   // for size_t, abs
-#include <algorithm>  // for min
-#include <cmath>      // for sqrt
-#include <string>     // for operator+, basic_string, string
-#include <vector>     // for vector
+#include <stdlib.h>  // for size_t, abs
+#include <cmath>     // for sqrt
+#include <cstdint>   // for uint32_t
+#include <string>    // for operator+, basic_string, string
 
-#include <glm/fwd.hpp>     // for int64
-#include <glm/matrix.hpp>  // for transpose
-#include <glm/vec2.hpp>    // for vec<>::(anonymous), operator*, opera...
-
-#ifdef IVW_USE_OPENMP
-#include <thread>
-
-#include <omp.h>
-#endif
+#include <glm/fwd.hpp>                 // for int64
+#include <glm/gtx/component_wise.hpp>  // for compMax, compMul
+#include <glm/matrix.hpp>              // for transpose
+#include <glm/vec2.hpp>                // for vec<>::(anonymous), operator*, opera...
 
 namespace inviwo {
 
@@ -75,7 +69,22 @@ namespace util {
  *       squared distance values at the end of the calculation.
  *     * ProcessCallback is a function of type (double progress) -> void that is called with a value
  *       from 0 to 1 to indicate the progress of the calculation.
+ *
+ * The calculation runs on the Inviwo thread pool. If @p outClosestFeature is not null it
+ * receives the linear index into @p inLayer of the closest feature pixel for each output pixel,
+ * or noClosestFeature if there are no features. @p options enables the signed distance, with
+ * negative distances inside the features, and cancellation.
+ * @return false if the calculation was stopped by @p options.
  */
+template <typename T, typename U, typename Predicate, typename ValueTransform,
+          typename ProgressCallback>
+bool layerRAMDistanceTransform(const LayerRAMPrecision<T>* inLayer,
+                               LayerRAMPrecision<U>* outDistanceField,
+                               LayerRAMPrecision<std::uint32_t>* outClosestFeature,
+                               const Matrix<2, U> basis, const size2_t upsample,
+                               Predicate predicate, ValueTransform valueTransform,
+                               ProgressCallback callback, const DistanceTransformOptions& options);
+
 template <typename T, typename U, typename Predicate, typename ValueTransform,
           typename ProgressCallback>
 void layerRAMDistanceTransform(const LayerRAMPrecision<T>* inLayer,
@@ -84,7 +93,7 @@ void layerRAMDistanceTransform(const LayerRAMPrecision<T>* inLayer,
                                ValueTransform valueTransform, ProgressCallback callback);
 
 template <typename T, typename U>
-void layerRAMDistanceTransform(const LayerRAMPrecision<T>* inVolume,
+void layerRAMDistanceTransform(const LayerRAMPrecision<T>* inLayer,
                                LayerRAMPrecision<U>* outDistanceField, const Matrix<2, U> basis,
                                const size2_t upsample);
 
@@ -93,6 +102,19 @@ void layerDistanceTransform(const Layer* inLayer, LayerRAMPrecision<U>* outDista
                             const size2_t upsample, Predicate predicate,
                             ValueTransform valueTransform, ProgressCallback callback);
 
+/**
+ * Distance transform of @p inLayer where pixels larger than @p threshold, or smaller if
+ * @p flip is set, are features, see layerRAMDistanceTransform for the closest feature output and
+ * options.
+ * @return false if the calculation was stopped by @p options.
+ */
+template <typename U, typename ProgressCallback>
+bool layerDistanceTransform(const Layer* inLayer, LayerRAMPrecision<U>* outDistanceField,
+                            LayerRAMPrecision<std::uint32_t>* outClosestFeature,
+                            const size2_t upsample, double threshold, bool normalize, bool flip,
+                            bool square, double scale, ProgressCallback callback,
+                            const DistanceTransformOptions& options);
+
 template <typename U, typename ProgressCallback>
 void layerDistanceTransform(const Layer* inLayer, LayerRAMPrecision<U>* outDistanceField,
                             const size2_t upsample, double threshold, bool normalize, bool flip,
@@ -107,24 +129,19 @@ void layerDistanceTransform(const Layer* inLayer, LayerRAMPrecision<U>* outDista
 
 template <typename T, typename U, typename Predicate, typename ValueTransform,
           typename ProgressCallback>
-void util::layerRAMDistanceTransform(const LayerRAMPrecision<T>* inLayer,
+bool util::layerRAMDistanceTransform(const LayerRAMPrecision<T>* inLayer,
                                      LayerRAMPrecision<U>* outDistanceField,
+                                     LayerRAMPrecision<std::uint32_t>* outClosestFeature,
                                      const Matrix<2, U> basis, const size2_t upsample,
                                      Predicate predicate, ValueTransform valueTransform,
-                                     ProgressCallback callback) {
-
-#ifdef IVW_USE_OPENMP
-    omp_set_num_threads(std::thread::hardware_concurrency());
-#endif
+                                     ProgressCallback callback,
+                                     const DistanceTransformOptions& options) {
 
     using int64 = glm::int64;
 
-    auto square = [](auto a) { return a * a; };
-
-    callback(0.0);
-
     const T* src = inLayer->getDataTyped();
     U* dst = outDistanceField->getDataTyped();
+    std::uint32_t* closest = outClosestFeature ? outClosestFeature->getDataTyped() : nullptr;
 
     const i64vec2 srcDim{inLayer->getDimensions()};
     const i64vec2 dstDim{outDistanceField->getDimensions()};
@@ -133,7 +150,6 @@ void util::layerRAMDistanceTransform(const LayerRAMPrecision<T>* inLayer,
     const auto squareBasis = glm::transpose(basis) * basis;
     const Vector<2, U> squareBasisDiag{squareBasis[0][0], squareBasis[1][1]};
     const Vector<2, U> squareVoxelSize{squareBasisDiag / Vector<2, U>{dstDim * dstDim}};
-    const Vector<2, U> invSquareVoxelSize{Vector<2, U>{1.0f} / squareVoxelSize};
 
     {
         const auto maxdist = glm::compMax(squareBasisDiag);
@@ -162,89 +178,33 @@ void util::layerRAMDistanceTransform(const LayerRAMPrecision<T>* inLayer,
                 " dst = " + toString(dstDim) + " scaling = " + toString(sm),
             IVW_CONTEXT_CUSTOM("layerRAMDistanceTransform"));
     }
-
-    util::IndexMapper<2, int64> srcInd(srcDim);
-    util::IndexMapper<2, int64> dstInd(dstDim);
-
-    auto is_feature = [&](const int64 x, const int64 y) {
-        return predicate(src[srcInd(x / sm.x, y / sm.y)]);
-    };
-
-// first pass, forward and backward scan along x
-// result: min distance in x direction
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel for
-#endif
-    for (int64 y = 0; y < dstDim.y; ++y) {
-        // forward
-        U dist = static_cast<U>(dstDim.x);
-        for (int64 x = 0; x < dstDim.x; ++x) {
-            if (!is_feature(x, y)) {
-                ++dist;
-            } else {
-                dist = U(0);
-            }
-            dst[dstInd(x, y)] = squareVoxelSize.x * square(dist);
+    if (outClosestFeature) {
+        if (i64vec2{outClosestFeature->getDimensions()} != dstDim) {
+            throw Exception("DistanceTransformRAM: Closest feature dimensions does not match "
+                            "dst = " + toString(dstDim) +
+                                " closest = " + toString(outClosestFeature->getDimensions()),
+                            IVW_CONTEXT_CUSTOM("layerRAMDistanceTransform"));
         }
-
-        // backward
-        dist = static_cast<U>(dstDim.x);
-        for (int64 x = dstDim.x - 1; x >= 0; --x) {
-            if (!is_feature(x, y)) {
-                ++dist;
-            } else {
-                dist = U(0);
-            }
-            dst[dstInd(x, y)] = std::min<U>(dst[dstInd(x, y)], squareVoxelSize.x * square(dist));
+        if (glm::compMul(srcDim) >= static_cast<int64>(noClosestFeature)) {
+            throw Exception("DistanceTransformRAM: Too many pixels for the closest feature index",
+                            IVW_CONTEXT_CUSTOM("layerRAMDistanceTransform"));
         }
     }
 
-    // second pass, scan y direction
-    // for each voxel v(x,y,z) find min_i(data(x,i,z) + (y - i)^2), 0 <= i < dimY
-    // result: min distance in x and y direction
-    callback(0.45);
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel
-#endif
-    {
-        std::vector<U> buff;
-        buff.resize(dstDim.y);
-#ifdef IVW_USE_OPENMP
-#pragma omp for
-#endif
-        for (int64 x = 0; x < dstDim.x; ++x) {
-
-            // cache column data into temporary buffer
-            for (int64 y = 0; y < dstDim.y; ++y) {
-                buff[y] = dst[dstInd(x, y)];
-            }
-
-            for (int64 y = 0; y < dstDim.y; ++y) {
-                auto d = buff[y];
-                if (d != U(0)) {
-                    const auto rMax = static_cast<int64>(std::sqrt(d * invSquareVoxelSize.y)) + 1;
-                    const auto rStart = std::min(rMax, y - 1);
-                    const auto rEnd = std::min(rMax, dstDim.y - y);
-                    for (int64 n = -rStart; n < rEnd; ++n) {
-                        const auto w = buff[y + n] + squareVoxelSize.y * square(n);
-                        if (w < d) d = w;
-                    }
-                }
-                dst[dstInd(x, y)] = d;
-            }
-        }
-    }
+    return detail::distanceTransform<2>(
+        srcDim, dstDim, squareVoxelSize, [&](size_t i) { return predicate(src[i]); }, dst,
+        closest, valueTransform, callback, options);
+}
 
-    // scale data
-    callback(0.9);
-    const int64 layerSize = dstDim.x * dstDim.y;
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel for
-#endif
-    for (int64 i = 0; i < layerSize; ++i) {
-        dst[i] = valueTransform(dst[i]);
-    }
-    callback(1.0);
+template <typename T, typename U, typename Predicate, typename ValueTransform,
+          typename ProgressCallback>
+void util::layerRAMDistanceTransform(const LayerRAMPrecision<T>* inLayer,
+                                     LayerRAMPrecision<U>* outDistanceField,
+                                     const Matrix<2, U> basis, const size2_t upsample,
+                                     Predicate predicate, ValueTransform valueTransform,
+                                     ProgressCallback callback) {
+    util::layerRAMDistanceTransform(inLayer, outDistanceField, nullptr, basis, upsample, predicate,
+                                    valueTransform, callback, DistanceTransformOptions{});
 }
 
 template <typename T, typename U>
@@ -274,12 +234,14 @@ void util::layerDistanceTransform(const Layer* inLayer, LayerRAMPrecision<U>* ou
 }
 
 template <typename U, typename ProgressCallback>
-void util::layerDistanceTransform(const Layer* inLayer, LayerRAMPrecision<U>* outDistanceField,
+bool util::layerDistanceTransform(const Layer* inLayer, LayerRAMPrecision<U>* outDistanceField,
+                                  LayerRAMPrecision<std::uint32_t>* outClosestFeature,
                                   const size2_t upsample, double threshold, bool normalize,
-                                  bool flip, bool square, double scale, ProgressCallback progress) {
+                                  bool flip, bool square, double scale, ProgressCallback progress,
+                                  const DistanceTransformOptions& options) {
 
     const auto inputLayerRep = inLayer->getRepresentation<LayerRAM>();
-    inputLayerRep->dispatch<void, dispatching::filter::Scalars>([&](const auto lrprecision) {
+    const auto dispatch = [&](const auto lrprecision) {
         using ValueType = util::PrecisionValueType<decltype(lrprecision)>;
 
         const auto predicateIn = [threshold](const ValueType& val) { return val < threshold; };
@@ -299,32 +261,33 @@ void util::layerDistanceTransform(const Layer* inLayer, LayerRAMPrecision<U>* ou
             return static_cast<float>(scale * std::sqrt(squareDist));
         };
 
-        if (normalize && square && flip) {
-            util::layerRAMDistanceTransform(lrprecision, outDistanceField, inLayer->getBasis(),
-                                            upsample, normPredicateIn, valTransIdent, progress);
-        } else if (normalize && square && !flip) {
-            util::layerRAMDistanceTransform(lrprecision, outDistanceField, inLayer->getBasis(),
-                                            upsample, normPredicateOut, valTransIdent, progress);
-        } else if (normalize && !square && flip) {
-            util::layerRAMDistanceTransform(lrprecision, outDistanceField, inLayer->getBasis(),
-                                            upsample, normPredicateIn, valTransSqrt, progress);
-        } else if (normalize && !square && !flip) {
-            util::layerRAMDistanceTransform(lrprecision, outDistanceField, inLayer->getBasis(),
-                                            upsample, normPredicateOut, valTransSqrt, progress);
-        } else if (!normalize && square && flip) {
-            util::layerRAMDistanceTransform(lrprecision, outDistanceField, inLayer->getBasis(),
-                                            upsample, predicateIn, valTransIdent, progress);
-        } else if (!normalize && square && !flip) {
-            util::layerRAMDistanceTransform(lrprecision, outDistanceField, inLayer->getBasis(),
-                                            upsample, predicateOut, valTransIdent, progress);
-        } else if (!normalize && !square && flip) {
-            util::layerRAMDistanceTransform(lrprecision, outDistanceField, inLayer->getBasis(),
-                                            upsample, predicateIn, valTransSqrt, progress);
-        } else if (!normalize && !square && !flip) {
-            util::layerRAMDistanceTransform(lrprecision, outDistanceField, inLayer->getBasis(),
-                                            upsample, predicateOut, valTransSqrt, progress);
+        const auto transform = [&](const auto& predicate) {
+            if (square) {
+                return util::layerRAMDistanceTransform(
+                    lrprecision, outDistanceField, outClosestFeature, inLayer->getBasis(),
+                    upsample, predicate, valTransIdent, progress, options);
+            } else {
+                return util::layerRAMDistanceTransform(
+                    lrprecision, outDistanceField, outClosestFeature, inLayer->getBasis(),
+                    upsample, predicate, valTransSqrt, progress, options);
+            }
+        };
+
+        if (normalize) {
+            return flip ? transform(normPredicateIn) : transform(normPredicateOut);
+        } else {
+            return flip ? transform(predicateIn) : transform(predicateOut);
         }
-    });
+    };
+    return inputLayerRep->dispatch<bool, dispatching::filter::Scalars>(dispatch);
+}
+
+template <typename U, typename ProgressCallback>
+void util::layerDistanceTransform(const Layer* inLayer, LayerRAMPrecision<U>* outDistanceField,
+                                  const size2_t upsample, double threshold, bool normalize,
+                                  bool flip, bool square, double scale, ProgressCallback progress) {
+    util::layerDistanceTransform(inLayer, outDistanceField, nullptr, upsample, threshold, normalize,
+                                 flip, square, scale, progress, DistanceTransformOptions{});
 }
 
 template <typename U>
@@ -0,0 +1,157 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>  // for IVW_MODULE_BASE_API
+
+#include <inviwo/core/util/glmvec.h>  // for size3_t
+
+#include <cstddef>     // for size_t
+#include <functional>  // for function
+#include <iosfwd>      // for ostream
+#include <memory>      // for shared_ptr
+#include <vector>      // for vector
+
+namespace inviwo {
+
+class Volume;
+class VolumeRAM;
+
+enum class DownsampleFilter {
+    Box,      //!< Average of 2 voxels along each axis
+    Gaussian  //!< Binomial [1 3 3 1] / 8 kernel along each axis
+};
+
+IVW_MODULE_BASE_API std::ostream& operator<<(std::ostream& ss, DownsampleFilter filter);
+
+namespace util {
+
+/**
+ * Downsample @p volume by a factor of two along each axis, using the separable @p filter. Axes
+ * with only one voxel are kept as is and odd dimensions are rounded up, border voxels are
+ * clamped. The result has the same format, swizzle mask, interpolation and wrapping as the input.
+ * The work is split over the z-slices of the result using the thread pool.
+ */
+IVW_MODULE_BASE_API std::shared_ptr<VolumeRAM> volumeDownsample(const VolumeRAM& volume,
+                                                                DownsampleFilter filter);
+
+/**
+ * Pick every @p factors voxel of @p volume without any filtering. Much cheaper than
+ * volumeDownsample and volumeSubSample, and intended for quick previews.
+ * The resulting dimensions are rounded up, i.e. `(dims + factors - 1) / factors`.
+ */
+IVW_MODULE_BASE_API std::shared_ptr<VolumeRAM> volumePointSample(const VolumeRAM& volume,
+                                                                 size3_t factors);
+
+}  // namespace util
+
+/**
+ * \brief A multi-resolution pyramid of a Volume
+ *
+ * Level 0 corresponds to the full resolution volume, and each following level is downsampled by
+ * a factor of two using util::volumeDownsample. Levels are added until the largest dimension is
+ * at most Settings::minDimension. The full resolution volume itself is not stored by the pyramid.
+ * Every coarse level covers the same spatial extent as the source and shares its model and world
+ * matrix, data map, axes and meta data.
+ *
+ * Pyramids are expensive to build, use VolumePyramid::get to share them between processors. The
+ * cache only keeps a pyramid alive as long as its source volume is alive, and assumes that the
+ * data of a volume is not modified once it has been used to build a pyramid.
+ */
+class IVW_MODULE_BASE_API VolumePyramid {
+public:
+    struct Settings {
+        DownsampleFilter filter = DownsampleFilter::Box;
+        size_t minDimension = 32;  //!< Stop when the largest dimension is at most this
+        bool operator==(const Settings&) const = default;
+    };
+
+    /**
+     * Build all coarse levels of @p volume. @p stop is checked between levels, if it returns true
+     * the construction is cancelled and the pyramid will only contain the levels built so far.
+     * @p progress is called with the fraction of the work done after each level.
+     */
+    VolumePyramid(const Volume& volume, const Settings& settings,
+                  const std::function<bool()>& stop = {},
+                  const std::function<void(float)>& progress = {});
+
+    /**
+     * Return the cached pyramid of @p volume for @p settings, or build and cache a new one.
+     * Returns nullptr if the construction was cancelled by @p stop, in which case nothing is
+     * cached.
+     */
+    static std::shared_ptr<const VolumePyramid> get(
+        const std::shared_ptr<const Volume>& volume, const Settings& settings,
+        const std::function<bool()>& stop = {}, const std::function<void(float)>& progress = {});
+
+    /**
+     * Return the cached pyramid of @p volume for @p settings if there is one, otherwise nullptr.
+     */
+    static std::shared_ptr<const VolumePyramid> find(const std::shared_ptr<const Volume>& volume,
+                                                     const Settings& settings);
+
+    /**
+     * The number of levels, including the full resolution level 0.
+     */
+    size_t getNumberOfLevels() const;
+
+    /**
+     * Return the volume for @p level, level 0 will return nullptr since the full resolution
+     * volume is not owned by the pyramid.
+     * @throws RangeException if level is larger or equal to getNumberOfLevels()
+     */
+    std::shared_ptr<const Volume> getLevel(size_t level) const;
+
+    /**
+     * The dimensions of @p level, level 0 is the full resolution dimensions.
+     * @throws RangeException if level is larger or equal to getNumberOfLevels()
+     */
+    size3_t getDimensions(size_t level) const;
+
+    /**
+     * Dimensions of the level following a level with dimensions @p dims.
+     */
+    static size3_t downsampledDimensions(size3_t dims);
+
+    /**
+     * The number of levels, including level 0, a pyramid of a volume with dimensions @p dims
+     * would have for the given @p minDimension.
+     */
+    static size_t numberOfLevels(size3_t dims, size_t minDimension);
+
+    const Settings& getSettings() const;
+
+private:
+    Settings settings_;
+    size3_t dimensions_;
+    std::vector<std::shared_ptr<const Volume>> levels_;  //!< levels_[i] is level i + 1
+};
+
+}  // namespace inviwo
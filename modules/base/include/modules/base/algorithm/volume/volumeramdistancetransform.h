@@ -35,26 +35,20 @@
 #include <inviwo/core/util/glmconvert.h>               // for glm_convert_normalized
 #include <inviwo/core/util/glmutils.h>                 // for Vector, Matrix
 #include <inviwo/core/util/glmvec.h>                   // for i64vec3, size3_t
-#include <inviwo/core/util/indexmapper.h>              // for IndexMapper
 #include <inviwo/core/util/logcentral.h>               // for LogCentral, LogWarnCustom
 #include <inviwo/core/util/sourcecontext.h>            // for IVW_CONTEXT_CUSTOM
 #include <inviwo/core/util/stringconversion.h>         // for toString
+#include <modules/base/algorithm/distancetransform.h>  // for distanceTransform, DistanceTr...
 
-#include <stdlib.h>   // for size_t, abs
-#include <algorithm>  // for min
-#include <cmath>      // for sqrt
-#include <string>     // for operator+, basic_string, string
-#include <vector>     // for vector
+#include <stdlib.h>  // for size_t, abs
+#include <cmath>     // for sqrt
+#include <cstdint>   // for uint32_t
+#include <string>    // for operator+, basic_string, string
 
-#include <glm/fwd.hpp>     // for int64
-#include <glm/matrix.hpp>  // for transpose
-#include <glm/vec3.hpp>    // for vec<>::(anonymous), operator*, ope...
-
-#ifdef IVW_USE_OPENMP
-#include <thread>
-
-#include <omp.h>
-#endif
+#include <glm/fwd.hpp>                 // for int64
+#include <glm/gtx/component_wise.hpp>  // for compMax, compMul
+#include <glm/matrix.hpp>              // for transpose
+#include <glm/vec3.hpp>                // for vec<>::(anonymous), operator*, ope...
 
 namespace inviwo {
 class VolumeRAM;
@@ -77,7 +71,22 @@ namespace util {
  *       squared distance values at the end of the calculation.
  *     * ProcessCallback is a function of type (double progress) -> void that is called with a value
  *       from 0 to 1 to indicate the progress of the calculation.
+ *
+ * The calculation runs on the Inviwo thread pool. If @p outClosestFeature is not null it
+ * receives the linear index into @p inVolume of the closest feature voxel for each output voxel,
+ * or noClosestFeature if there are no features. @p options enables the signed distance, with
+ * negative distances inside the features, and cancellation.
+ * @return false if the calculation was stopped by @p options.
  */
+template <typename T, typename U, typename Predicate, typename ValueTransform,
+          typename ProgressCallback>
+bool volumeRAMDistanceTransform(const VolumeRAMPrecision<T>* inVolume,
+                                VolumeRAMPrecision<U>* outDistanceField,
+                                VolumeRAMPrecision<std::uint32_t>* outClosestFeature,
+                                const Matrix<3, U> basis, const size3_t upsample,
+                                Predicate predicate, ValueTransform valueTransform,
+                                ProgressCallback callback, const DistanceTransformOptions& options);
+
 template <typename T, typename U, typename Predicate, typename ValueTransform,
           typename ProgressCallback>
 void volumeRAMDistanceTransform(const VolumeRAMPrecision<T>* inVolume,
@@ -95,6 +104,19 @@ void volumeDistanceTransform(const Volume* inVolume, VolumeRAMPrecision<U>* outD
                              const size3_t upsample, Predicate predicate,
                              ValueTransform valueTransform, ProgressCallback callback);
 
+/**
+ * Distance transform of @p inVolume where voxels larger than @p threshold, or smaller if
+ * @p flip is set, are features, see volumeRAMDistanceTransform for the closest feature output and
+ * options.
+ * @return false if the calculation was stopped by @p options.
+ */
+template <typename U, typename ProgressCallback>
+bool volumeDistanceTransform(const Volume* inVolume, VolumeRAMPrecision<U>* outDistanceField,
+                             VolumeRAMPrecision<std::uint32_t>* outClosestFeature,
+                             const size3_t upsample, double threshold, bool normalize, bool flip,
+                             bool square, double scale, ProgressCallback callback,
+                             const DistanceTransformOptions& options);
+
 template <typename U, typename ProgressCallback>
 void volumeDistanceTransform(const Volume* inVolume, VolumeRAMPrecision<U>* outDistanceField,
                              const size3_t upsample, double threshold, bool normalize, bool flip,
@@ -109,24 +131,19 @@ void volumeDistanceTransform(const Volume* inVolume, VolumeRAMPrecision<U>* outD
 
 template <typename T, typename U, typename Predicate, typename ValueTransform,
           typename ProgressCallback>
-void util::volumeRAMDistanceTransform(const VolumeRAMPrecision<T>* inVolume,
+bool util::volumeRAMDistanceTransform(const VolumeRAMPrecision<T>* inVolume,
                                       VolumeRAMPrecision<U>* outDistanceField,
+                                      VolumeRAMPrecision<std::uint32_t>* outClosestFeature,
                                       const Matrix<3, U> basis, const size3_t upsample,
                                       Predicate predicate, ValueTransform valueTransform,
-                                      ProgressCallback callback) {
-
-#ifdef IVW_USE_OPENMP
-    omp_set_num_threads(std::thread::hardware_concurrency());
-#endif
+                                      ProgressCallback callback,
+                                      const DistanceTransformOptions& options) {
 
     using int64 = glm::int64;
 
-    auto square = [](auto a) { return a * a; };
-
-    callback(0.0);
-
     const T* src = inVolume->getDataTyped();
     U* dst = outDistanceField->getDataTyped();
+    std::uint32_t* closest = outClosestFeature ? outClosestFeature->getDataTyped() : nullptr;
 
     const i64vec3 srcDim{inVolume->getDimensions()};
     const i64vec3 dstDim{outDistanceField->getDimensions()};
@@ -135,7 +152,6 @@ void util::volumeRAMDistanceTransform(const VolumeRAMPrecision<T>* inVolume,
     const auto squareBasis = glm::transpose(basis) * basis;
     const Vector<3, U> squareBasisDiag{squareBasis[0][0], squareBasis[1][1], squareBasis[2][2]};
     const Vector<3, U> squareVoxelSize{squareBasisDiag / Vector<3, U>{dstDim * dstDim}};
-    const Vector<3, U> invSquareVoxelSize{Vector<3, U>{1.0f} / squareVoxelSize};
 
     {
         const auto maxdist = glm::compMax(squareBasisDiag);
@@ -164,134 +180,34 @@ void util::volumeRAMDistanceTransform(const VolumeRAMPrecision<T>* inVolume,
                 " dst = " + toString(dstDim) + " scaling = " + toString(sm),
             IVW_CONTEXT_CUSTOM("volumeRAMDistanceTransform"));
     }
-
-    util::IndexMapper<3, int64> srcInd(srcDim);
-    util::IndexMapper<3, int64> dstInd(dstDim);
-
-    auto is_feature = [&](const int64 x, const int64 y, const int64 z) {
-        return predicate(src[srcInd(x / sm.x, y / sm.y, z / sm.z)]);
-    };
-
-// first pass, forward and backward scan along x
-// result: min distance in x direction
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel for
-#endif
-    for (int64 z = 0; z < dstDim.z; ++z) {
-        for (int64 y = 0; y < dstDim.y; ++y) {
-            // forward
-            U dist = static_cast<U>(dstDim.x);
-            for (int64 x = 0; x < dstDim.x; ++x) {
-                if (!is_feature(x, y, z)) {
-                    ++dist;
-                } else {
-                    dist = U(0);
-                }
-                dst[dstInd(x, y, z)] = squareVoxelSize.x * square(dist);
-            }
-
-            // backward
-            dist = static_cast<U>(dstDim.x);
-            for (int64 x = dstDim.x - 1; x >= 0; --x) {
-                if (!is_feature(x, y, z)) {
-                    ++dist;
-                } else {
-                    dist = U(0);
-                }
-                dst[dstInd(x, y, z)] =
-                    std::min<U>(dst[dstInd(x, y, z)], squareVoxelSize.x * square(dist));
-            }
+    if (outClosestFeature) {
+        if (i64vec3{outClosestFeature->getDimensions()} != dstDim) {
+            throw Exception("DistanceTransformRAM: Closest feature dimensions does not match "
+                            "dst = " + toString(dstDim) +
+                                " closest = " + toString(outClosestFeature->getDimensions()),
+                            IVW_CONTEXT_CUSTOM("volumeRAMDistanceTransform"));
         }
-    }
-
-    // second pass, scan y direction
-    // for each voxel v(x,y,z) find min_i(data(x,i,z) + (y - i)^2), 0 <= i < dimY
-    // result: min distance in x and y direction
-    callback(0.3);
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel
-#endif
-    {
-        std::vector<U> buff;
-        buff.resize(dstDim.y);
-#ifdef IVW_USE_OPENMP
-#pragma omp for
-#endif
-        for (int64 z = 0; z < dstDim.z; ++z) {
-            for (int64 x = 0; x < dstDim.x; ++x) {
-
-                // cache column data into temporary buffer
-                for (int64 y = 0; y < dstDim.y; ++y) {
-                    buff[y] = dst[dstInd(x, y, z)];
-                }
-
-                for (int64 y = 0; y < dstDim.y; ++y) {
-                    auto d = buff[y];
-                    if (d != U(0)) {
-                        const auto rMax =
-                            static_cast<int64>(std::sqrt(d * invSquareVoxelSize.y)) + 1;
-                        const auto rStart = std::min(rMax, y - 1);
-                        const auto rEnd = std::min(rMax, dstDim.y - y);
-                        for (int64 n = -rStart; n < rEnd; ++n) {
-                            const auto w = buff[y + n] + squareVoxelSize.y * square(n);
-                            if (w < d) d = w;
-                        }
-                    }
-                    dst[dstInd(x, y, z)] = d;
-                }
-            }
+        if (glm::compMul(srcDim) >= static_cast<int64>(noClosestFeature)) {
+            throw Exception("DistanceTransformRAM: Too many voxels for the closest feature index",
+                            IVW_CONTEXT_CUSTOM("volumeRAMDistanceTransform"));
         }
     }
 
-    // third pass, scan z direction
-    // for each voxel v(x,y,z) find min_i(data(x,y,i) + (z - i)^2), 0 <= i < dimZ
-    // result: min distance in x and y direction
-    callback(0.6);
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel
-#endif
-    {
-        std::vector<U> buff;
-        buff.resize(dstDim.z);
-#ifdef IVW_USE_OPENMP
-#pragma omp for
-#endif
-        for (int64 y = 0; y < dstDim.y; ++y) {
-            for (int64 x = 0; x < dstDim.x; ++x) {
-
-                // cache column data into temporary buffer
-                for (int64 z = 0; z < dstDim.z; ++z) {
-                    buff[z] = dst[dstInd(x, y, z)];
-                }
-
-                for (int64 z = 0; z < dstDim.z; ++z) {
-                    auto d = buff[z];
-                    if (d != U(0)) {
-                        const auto rMax =
-                            static_cast<int64>(std::sqrt(d * invSquareVoxelSize.z)) + 1;
-                        const auto rStart = std::min(rMax, z - 1);
-                        const auto rEnd = std::min(rMax, dstDim.z - z);
-                        for (int64 n = -rStart; n < rEnd; ++n) {
-                            const auto w = buff[z + n] + squareVoxelSize.z * square(n);
-                            if (w < d) d = w;
-                        }
-                    }
-                    dst[dstInd(x, y, z)] = d;
-                }
-            }
-        }
-    }
+    return detail::distanceTransform<3>(
+        srcDim, dstDim, squareVoxelSize, [&](size_t i) { return predicate(src[i]); }, dst,
+        closest, valueTransform, callback, options);
+}
 
-    // scale data
-    callback(0.9);
-    const int64 volSize = dstDim.x * dstDim.y * dstDim.z;
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel for
-#endif
-    for (int64 i = 0; i < volSize; ++i) {
-        dst[i] = valueTransform(dst[i]);
-    }
-    callback(1.0);
+template <typename T, typename U, typename Predicate, typename ValueTransform,
+          typename ProgressCallback>
+void util::volumeRAMDistanceTransform(const VolumeRAMPrecision<T>* inVolume,
+                                      VolumeRAMPrecision<U>* outDistanceField,
+                                      const Matrix<3, U> basis, const size3_t upsample,
+                                      Predicate predicate, ValueTransform valueTransform,
+                                      ProgressCallback callback) {
+    util::volumeRAMDistanceTransform(inVolume, outDistanceField, nullptr, basis, upsample,
+                                     predicate, valueTransform, callback,
+                                     DistanceTransformOptions{});
 }
 
 template <typename T, typename U>
@@ -321,13 +237,14 @@ void util::volumeDistanceTransform(const Volume* inVolume, VolumeRAMPrecision<U>
 }
 
 template <typename U, typename ProgressCallback>
-void util::volumeDistanceTransform(const Volume* inVolume, VolumeRAMPrecision<U>* outDistanceField,
+bool util::volumeDistanceTransform(const Volume* inVolume, VolumeRAMPrecision<U>* outDistanceField,
+                                   VolumeRAMPrecision<std::uint32_t>* outClosestFeature,
                                    const size3_t upsample, double threshold, bool normalize,
-                                   bool flip, bool square, double scale,
-                                   ProgressCallback progress) {
+                                   bool flip, bool square, double scale, ProgressCallback progress,
+                                   const DistanceTransformOptions& options) {
 
     const auto inputVolumeRep = inVolume->getRepresentation<VolumeRAM>();
-    inputVolumeRep->dispatch<void, dispatching::filter::Scalars>([&](const auto vrprecision) {
+    const auto dispatch = [&](const auto vrprecision) {
         using ValueType = util::PrecisionValueType<decltype(vrprecision)>;
 
         const auto predicateIn = [threshold](const ValueType& val) { return val < threshold; };
@@ -347,32 +264,35 @@ void util::volumeDistanceTransform(const Volume* inVolume, VolumeRAMPrecision<U>
             return static_cast<float>(scale * std::sqrt(squareDist));
         };
 
-        if (normalize && square && flip) {
-            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, inVolume->getBasis(),
-                                             upsample, normPredicateIn, valTransIdent, progress);
-        } else if (normalize && square && !flip) {
-            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, inVolume->getBasis(),
-                                             upsample, normPredicateOut, valTransIdent, progress);
-        } else if (normalize && !square && flip) {
-            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, inVolume->getBasis(),
-                                             upsample, normPredicateIn, valTransSqrt, progress);
-        } else if (normalize && !square && !flip) {
-            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, inVolume->getBasis(),
-                                             upsample, normPredicateOut, valTransSqrt, progress);
-        } else if (!normalize && square && flip) {
-            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, inVolume->getBasis(),
-                                             upsample, predicateIn, valTransIdent, progress);
-        } else if (!normalize && square && !flip) {
-            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, inVolume->getBasis(),
-                                             upsample, predicateOut, valTransIdent, progress);
-        } else if (!normalize && !square && flip) {
-            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, inVolume->getBasis(),
-                                             upsample, predicateIn, valTransSqrt, progress);
-        } else if (!normalize && !square && !flip) {
-            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, inVolume->getBasis(),
-                                             upsample, predicateOut, valTransSqrt, progress);
+        const auto transform = [&](const auto& predicate) {
+            if (square) {
+                return util::volumeRAMDistanceTransform(
+                    vrprecision, outDistanceField, outClosestFeature, inVolume->getBasis(),
+                    upsample, predicate, valTransIdent, progress, options);
+            } else {
+                return util::volumeRAMDistanceTransform(
+                    vrprecision, outDistanceField, outClosestFeature, inVolume->getBasis(),
+                    upsample, predicate, valTransSqrt, progress, options);
+            }
+        };
+
+        if (normalize) {
+            return flip ? transform(normPredicateIn) : transform(normPredicateOut);
+        } else {
+            return flip ? transform(predicateIn) : transform(predicateOut);
         }
-    });
+    };
+    return inputVolumeRep->dispatch<bool, dispatching::filter::Scalars>(dispatch);
+}
+
+template <typename U, typename ProgressCallback>
+void util::volumeDistanceTransform(const Volume* inVolume, VolumeRAMPrecision<U>* outDistanceField,
+                                   const size3_t upsample, double threshold, bool normalize,
+                                   bool flip, bool square, double scale,
+                                   ProgressCallback progress) {
+    util::volumeDistanceTransform(inVolume, outDistanceField, nullptr, upsample, threshold,
+                                  normalize, flip, square, scale, progress,
+                                  DistanceTransformOptions{});
 }
 
 template <typename U>
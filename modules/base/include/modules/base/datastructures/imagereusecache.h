@@ -54,6 +54,13 @@ public:
 
     std::shared_ptr<Image> getUnused();
 
+    /**
+     * Returns an unused image with dimensions @p dim and color format @p format, including depth
+     * and picking layers. A new image is created if there is no matching unused image.
+     * Add the image back to the cache once it has been handed out to make it reusable.
+     */
+    std::shared_ptr<Image> getUnused(const size2_t& dim, const DataFormatBase* format);
+
     template <typename T>
     std::pair<std::shared_ptr<Image>, LayerRAMPrecision<T>*> getTypedUnused(const size2_t& dim);
     void add(std::shared_ptr<Image> image);
@@ -0,0 +1,313 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <modules/base/basemoduledefine.h>  // for IVW_MODULE_BASE_API
+
+#include <inviwo/core/datastructures/image/imagetypes.h>  // for LayerType
+#include <inviwo/core/datastructures/image/layerram.h>    // for LayerRAM, LayerRAMPrecision
+#include <inviwo/core/datastructures/volume/volumeram.h>  // for VolumeRAM, VolumeRAMPrecision
+#include <inviwo/core/util/formats.h>                     // for DataFormatId, DataFormat
+#include <inviwo/core/util/glmvec.h>                      // for size2_t, size3_t
+
+#include <algorithm>      // for sort, find_if, remove_if
+#include <cstddef>        // for size_t
+#include <iterator>       // for next
+#include <memory>         // for shared_ptr, static_pointer_cast
+#include <mutex>          // for mutex, scoped_lock
+#include <unordered_map>  // for unordered_map
+#include <utility>        // for move, pair
+#include <vector>         // for vector
+
+namespace inviwo {
+
+/**
+ * Statistics of a LayerRAMPool or VolumeRAMPool
+ */
+struct IVW_MODULE_BASE_API RepresentationPoolStats {
+    size_t hits = 0;         //!< requests served by an unused pooled representation
+    size_t misses = 0;       //!< requests that required a new allocation
+    size_t evictions = 0;    //!< unused representations released to stay within the budget
+    size_t inUse = 0;        //!< pooled representations currently handed out
+    size_t unused = 0;       //!< pooled representations available for reuse
+    size_t bytesInUse = 0;   //!< size of the data of the representations in use
+    size_t bytesUnused = 0;  //!< size of the data of the representations available for reuse
+};
+
+namespace detail {
+
+struct IVW_MODULE_BASE_API RepresentationPoolKey {
+    DataFormatId format;
+    LayerType type;
+    size3_t dims;
+
+    bool operator==(const RepresentationPoolKey& rhs) const {
+        return format == rhs.format && type == rhs.type && dims == rhs.dims;
+    }
+    bool operator!=(const RepresentationPoolKey& rhs) const { return !(*this == rhs); }
+};
+
+struct IVW_MODULE_BASE_API RepresentationPoolKeyHash {
+    size_t operator()(const RepresentationPoolKey& key) const;
+};
+
+/**
+ * Thread safe pool of representations keyed on format, layer type and dimensions. All handed out
+ * representations are kept by the pool, a representation becomes available for reuse again as
+ * soon as the pool holds the only reference to it, i.e. when the data it was handed out to has
+ * been released. Whenever a new representation is allocated, unused representations exceeding the
+ * byte budget are released, least recently used first.
+ */
+template <typename Repr>
+class RepresentationPool {
+public:
+    using Key = RepresentationPoolKey;
+
+    explicit RepresentationPool(size_t maxUnusedBytes) : maxUnusedBytes_{maxUnusedBytes} {}
+    RepresentationPool(const RepresentationPool&) = delete;
+    RepresentationPool& operator=(const RepresentationPool&) = delete;
+
+    /**
+     * Returns an unused representation matching @p key or one created by @p create. The
+     * allocation is done without holding the lock.
+     * @return the representation and whether it was reused
+     */
+    template <typename Create>
+    std::pair<std::shared_ptr<Repr>, bool> get(const Key& key, size_t bytes, Create&& create) {
+        {
+            std::scoped_lock lock{mutex_};
+            if (auto it = pool_.find(key); it != pool_.end()) {
+                for (auto& entry : it->second) {
+                    // Only the pool can add references to a representation with a single owner,
+                    // so this check is reliable while holding the lock
+                    if (entry.repr.use_count() == 1) {
+                        entry.lastUsed = ++tick_;
+                        ++stats_.hits;
+                        return {entry.repr, true};
+                    }
+                }
+            }
+            ++stats_.misses;
+        }
+
+        std::shared_ptr<Repr> repr = create();
+
+        std::scoped_lock lock{mutex_};
+        pool_[key].push_back(Entry{repr, bytes, ++tick_});
+        trim();
+        return {std::move(repr), false};
+    }
+
+    void setMaxUnusedBytes(size_t maxUnusedBytes) {
+        std::scoped_lock lock{mutex_};
+        maxUnusedBytes_ = maxUnusedBytes;
+        trim();
+    }
+    size_t getMaxUnusedBytes() const {
+        std::scoped_lock lock{mutex_};
+        return maxUnusedBytes_;
+    }
+
+    RepresentationPoolStats getStats() const {
+        std::scoped_lock lock{mutex_};
+        auto stats = stats_;
+        for (const auto& [key, entries] : pool_) {
+            for (const auto& entry : entries) {
+                if (entry.repr.use_count() == 1) {
+                    ++stats.unused;
+                    stats.bytesUnused += entry.bytes;
+                } else {
+                    ++stats.inUse;
+                    stats.bytesInUse += entry.bytes;
+                }
+            }
+        }
+        return stats;
+    }
+
+    /**
+     * Release all unused representations. Representations in use are kept and can be reused once
+     * they are released.
+     */
+    void clear() {
+        std::scoped_lock lock{mutex_};
+        for (auto it = pool_.begin(); it != pool_.end();) {
+            auto& entries = it->second;
+            entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                         [](const Entry& e) { return e.repr.use_count() == 1; }),
+                          entries.end());
+            it = entries.empty() ? pool_.erase(it) : std::next(it);
+        }
+    }
+
+private:
+    struct Entry {
+        std::shared_ptr<Repr> repr;
+        size_t bytes;
+        size_t lastUsed;
+    };
+
+    // Release the least recently used unused representations until within budget, requires lock
+    void trim() {
+        struct Candidate {
+            size_t lastUsed;
+            const Key* key;
+            const Repr* repr;
+        };
+        std::vector<Candidate> candidates;
+        size_t unusedBytes = 0;
+        for (const auto& [key, entries] : pool_) {
+            for (const auto& entry : entries) {
+                if (entry.repr.use_count() == 1) {
+                    unusedBytes += entry.bytes;
+                    candidates.push_back({entry.lastUsed, &key, entry.repr.get()});
+                }
+            }
+        }
+        if (unusedBytes <= maxUnusedBytes_) return;
+
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Candidate& a, const Candidate& b) { return a.lastUsed < b.lastUsed; });
+
+        // Removing entries does not invalidate the key pointers as long as no key is erased
+        std::vector<Key> emptied;
+        for (const auto& candidate : candidates) {
+            if (unusedBytes <= maxUnusedBytes_) break;
+            auto& entries = pool_[*candidate.key];
+            auto it = std::find_if(entries.begin(), entries.end(), [&](const Entry& e) {
+                return e.repr.get() == candidate.repr;
+            });
+            unusedBytes -= it->bytes;
+            entries.erase(it);
+            ++stats_.evictions;
+            if (entries.empty()) emptied.push_back(*candidate.key);
+        }
+        for (const auto& key : emptied) pool_.erase(key);
+    }
+
+    mutable std::mutex mutex_;
+    std::unordered_map<Key, std::vector<Entry>, RepresentationPoolKeyHash> pool_;
+    size_t maxUnusedBytes_;
+    size_t tick_ = 0;
+    RepresentationPoolStats stats_;
+};
+
+}  // namespace detail
+
+/**
+ * \ingroup datastructures
+ * A thread safe pool of LayerRAM representations to avoid allocating new layers every evaluation
+ * in processors that produce layers of the same format and size repeatedly, for example:
+ * ```{.cpp}
+ * auto repr = pool_->getTyped<float>(dims);
+ * // ... fill repr
+ * outport_.setData(std::make_shared<Image>(std::make_shared<Layer>(repr)));
+ * ```
+ * The representation is returned to the pool once the layer holding it is destroyed. Reused
+ * representations have the swizzle mask, interpolation and wrapping reset to the defaults of
+ * createLayerRAM, the content of the data is left as is. Any LayerRAM returned from the pool must
+ * be handed to a new Layer, adding it to an existing one may make it appear unused while in use.
+ * The pool can be used from several threads at once, for example from the jobs of a
+ * PoolProcessor. Hold the pool in a shared_ptr to keep it alive for any running jobs.
+ *
+ * Only layer and volume outputs are pooled. Processors that merely read a LayerRAM, like
+ * ImageContourProcessor (outputs a Mesh), PixelToBufferProcessor (appends to one Buffer kept
+ * between evaluations), and ImageToDataFrame (outputs a DataFrame), do not benefit since the
+ * representation they read is owned and cached by the input layer.
+ */
+class IVW_MODULE_BASE_API LayerRAMPool {
+public:
+    static constexpr size_t defaultMaxUnusedBytes = size_t{256} << 20;
+
+    explicit LayerRAMPool(size_t maxUnusedBytes = defaultMaxUnusedBytes);
+
+    std::shared_ptr<LayerRAM> get(const size2_t& dims, const DataFormatBase* format,
+                                  LayerType type = LayerType::Color);
+
+    template <typename T>
+    std::shared_ptr<LayerRAMPrecision<T>> getTyped(const size2_t& dims,
+                                                   LayerType type = LayerType::Color) {
+        return std::static_pointer_cast<LayerRAMPrecision<T>>(
+            get(dims, DataFormat<T>::get(), type));
+    }
+
+    /**
+     * Set the maximum number of bytes of unused representations that is kept for reuse
+     */
+    void setMaxUnusedBytes(size_t maxUnusedBytes);
+    size_t getMaxUnusedBytes() const;
+
+    RepresentationPoolStats getStats() const;
+
+    /**
+     * Release all unused representations
+     */
+    void clear();
+
+private:
+    detail::RepresentationPool<LayerRAM> pool_;
+};
+
+/**
+ * \ingroup datastructures
+ * A thread safe pool of VolumeRAM representations, see LayerRAMPool.
+ * Reused representations have the swizzle mask, interpolation and wrapping reset to the defaults
+ * of createVolumeRAM.
+ */
+class IVW_MODULE_BASE_API VolumeRAMPool {
+public:
+    static constexpr size_t defaultMaxUnusedBytes = size_t{1} << 30;
+
+    explicit VolumeRAMPool(size_t maxUnusedBytes = defaultMaxUnusedBytes);
+
+    std::shared_ptr<VolumeRAM> get(const size3_t& dims, const DataFormatBase* format);
+
+    template <typename T>
+    std::shared_ptr<VolumeRAMPrecision<T>> getTyped(const size3_t& dims) {
+        return std::static_pointer_cast<VolumeRAMPrecision<T>>(get(dims, DataFormat<T>::get()));
+    }
+
+    /**
+     * Set the maximum number of bytes of unused representations that is kept for reuse
+     */
+    void setMaxUnusedBytes(size_t maxUnusedBytes);
+    size_t getMaxUnusedBytes() const;
+
+    RepresentationPoolStats getStats() const;
+
+    /**
+     * Release all unused representations
+     */
+    void clear();
+
+private:
+    detail::RepresentationPool<VolumeRAM> pool_;
+};
+
+}  // namespace inviwo
@@ -69,6 +69,14 @@ protected:
 
     virtual const DataType* getData() = 0;
 
+    /**
+     * Write @p data to @p file using @p writer. The default writes synchronously, derived
+     * exporters can override this to defer the writing.
+     * @throws Exception if anything goes wrong
+     */
+    virtual void write(std::unique_ptr<DataWriterType<DataType>> writer, const DataType& data,
+                       const std::filesystem::path& file);
+
     DataWriterFactory* wf_;
     PortType port_;
     FileProperty file_;
@@ -132,14 +140,12 @@ void DataExport<DataType, PortType>::exportData() {
 
         try {
             writer->setOverwrite(overwrite_ ? Overwrite::Yes : Overwrite::No);
-            writer->writeData(data, file_.get());
-            util::log(IVW_CONTEXT, "Data exported to disk: {}" + file_.get().string(),
-                      LogLevel::Info, LogAudience::User);
+            write(std::move(writer), *data, file_.get());
 
             // update widgets as the file might now exist
             file_.clearInitiatingWidget();
             file_.updateWidgets();
-        } catch (DataWriterException const& e) {
+        } catch (Exception const& e) {
             util::log(e.getContext(), e.getMessage(), LogLevel::Error, LogAudience::User);
         }
 
@@ -150,6 +156,15 @@ void DataExport<DataType, PortType>::exportData() {
     }
 }
 
+template <typename DataType, typename PortType>
+void DataExport<DataType, PortType>::write(std::unique_ptr<DataWriterType<DataType>> writer,
+                                           const DataType& data,
+                                           const std::filesystem::path& file) {
+    writer->writeData(&data, file);
+    util::log(IVW_CONTEXT, "Data exported to disk: " + file.string(), LogLevel::Info,
+              LogAudience::User);
+}
+
 template <typename DataType, typename PortType>
 void DataExport<DataType, PortType>::process() {
     if (exportQueued_) exportData();
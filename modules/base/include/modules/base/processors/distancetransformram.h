@@ -31,17 +31,19 @@
 
 #include <modules/base/basemoduledefine.h>  // for IVW_MODULE_BASE_API
 
-#include <inviwo/core/ports/volumeport.h>            // for VolumeInport, VolumeOutport
-#include <inviwo/core/processors/poolprocessor.h>    // for PoolProcessor
-#include <inviwo/core/processors/processorinfo.h>    // for ProcessorInfo
-#include <inviwo/core/properties/boolproperty.h>     // for BoolProperty
-#include <inviwo/core/properties/minmaxproperty.h>   // for DoubleMinMaxProperty
-#include <inviwo/core/properties/optionproperty.h>   // for OptionProperty
-#include <inviwo/core/properties/ordinalproperty.h>  // for DoubleProperty, IntProperty, IntSize...
-#include <inviwo/core/util/staticstring.h>           // for operator+
+#include <inviwo/core/ports/volumeport.h>                     // for VolumeInport, VolumeOutport
+#include <inviwo/core/processors/poolprocessor.h>             // for PoolProcessor
+#include <inviwo/core/processors/processorinfo.h>             // for ProcessorInfo
+#include <inviwo/core/properties/boolproperty.h>              // for BoolProperty
+#include <inviwo/core/properties/minmaxproperty.h>            // for DoubleMinMaxProperty
+#include <inviwo/core/properties/optionproperty.h>            // for OptionProperty
+#include <inviwo/core/properties/ordinalproperty.h>           // for DoubleProperty, IntProperty
+#include <inviwo/core/util/staticstring.h>                    // for operator+
+#include <modules/base/datastructures/representationpool.h>  // for VolumeRAMPool
 
 #include <functional>   // for __base
 #include <iosfwd>       // for ostream
+#include <memory>       // for shared_ptr
 #include <string>       // for operator==, string
 #include <string_view>  // for operator==
 #include <vector>       // for operator!=, vector, operator==
@@ -63,12 +65,16 @@ public:
 private:
     VolumeInport volumePort_;
     VolumeOutport outport_;
+    VolumeOutport closestFeature_;
+
+    std::shared_ptr<VolumeRAMPool> volumePool_;
 
     DoubleProperty threshold_;
     BoolProperty flip_;
     BoolProperty normalize_;
     DoubleProperty resultDistScale_;  // scaling factor for distances
     BoolProperty resultSquaredDist_;  // determines whether output uses squared euclidean distances
+    BoolProperty resultSignedDist_;   // negative distances inside the features
     BoolProperty uniformUpsampling_;
     IntProperty upsampleFactorUniform_;    // uniform upscaling of the output field
     IntSize3Property upsampleFactorVec3_;  // non-uniform upscaling of the output field
@@ -34,6 +34,7 @@
 #include <inviwo/core/datastructures/image/layer.h>        // for Layer
 #include <inviwo/core/io/datawriter.h>                     // for DataWriterType
 #include <inviwo/core/io/datawriterexception.h>            // for DataWriterException
+#include <inviwo/core/io/layerwritequeue.h>                // for LayerWriteQueue
 #include <inviwo/core/network/processornetworkobserver.h>  // for ProcessorNetworkObserver
 #include <inviwo/core/ports/imageport.h>                   // for ImageInport
 #include <inviwo/core/processors/processorinfo.h>          // for ProcessorInfo
@@ -42,7 +43,9 @@
 #include <inviwo/core/util/glmvec.h>                       // for size2_t
 #include <modules/base/processors/dataexport.h>            // for DataExport
 
-#include <map>  // for operator!=, map
+#include <filesystem>  // for path
+#include <map>         // for operator!=, map
+#include <memory>      // for unique_ptr
 
 namespace inviwo {
 class PortConnection;
@@ -66,10 +69,13 @@ protected:
     void sendResizeEvent();
 
     virtual const Layer* getData() override;
+    virtual void write(std::unique_ptr<DataWriterType<Layer>> writer, const Layer& data,
+                       const std::filesystem::path& file) override;
     virtual void onProcessorNetworkDidAddConnection(const PortConnection&) override;
     virtual void onProcessorNetworkDidRemoveConnection(const PortConnection&) override;
 
     size2_t prevSize_;
+    LayerWriteQueue queue_;
 };
 
 }  // namespace inviwo
@@ -0,0 +1,82 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <modules/base/basemoduledefine.h>  // for IVW_MODULE_BASE_API
+
+#include <inviwo/core/ports/imageport.h>                  // for ImageMultiInport, ImageOutport
+#include <inviwo/core/processors/processor.h>             // for Processor
+#include <inviwo/core/processors/processorinfo.h>         // for ProcessorInfo
+#include <inviwo/core/properties/optionproperty.h>        // for OptionProperty
+#include <inviwo/core/util/glmvec.h>                      // for ivec2, ivec4
+#include <modules/base/datastructures/imagereusecache.h>  // for ImageReuseCache
+
+#include <iosfwd>  // for ostream
+#include <vector>  // for vector
+
+namespace inviwo {
+class Event;
+class Outport;
+
+/**
+ * Puts multiple input images next to each other on the CPU, the CPU counterpart of the
+ * ColumnLayout and RowLayout processors with evenly distributed views.
+ */
+class IVW_MODULE_BASE_API ImageLayoutRAM : public Processor {
+public:
+    enum class Direction { Columns, Rows };
+
+    ImageLayoutRAM();
+    virtual ~ImageLayoutRAM() = default;
+
+    virtual void process() override;
+    virtual void propagateEvent(Event* event, Outport* source) override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    /**
+     * Viewports (x, y, width, height) of each connected image for an output of size @p dims
+     */
+    std::vector<ivec4> getViewports(const ivec2& dims) const;
+    void resizeInports();
+
+    ImageMultiInport inport_;
+    ImageOutport outport_;
+
+    OptionProperty<Direction> direction_;
+
+    ImageReuseCache cache_;
+    ivec2 currentDim_;
+};
+
+IVW_MODULE_BASE_API std::ostream& operator<<(std::ostream& ss, ImageLayoutRAM::Direction d);
+
+}  // namespace inviwo
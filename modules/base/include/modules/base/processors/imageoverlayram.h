@@ -0,0 +1,88 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <modules/base/basemoduledefine.h>  // for IVW_MODULE_BASE_API
+
+#include <inviwo/core/ports/imageport.h>                    // for ImageInport, ImageOutport
+#include <inviwo/core/processors/processor.h>               // for Processor
+#include <inviwo/core/processors/processorinfo.h>           // for ProcessorInfo
+#include <inviwo/core/properties/boolcompositeproperty.h>   // for BoolCompositeProperty
+#include <inviwo/core/properties/boolproperty.h>            // for BoolProperty
+#include <inviwo/core/properties/optionproperty.h>          // for OptionProperty
+#include <inviwo/core/properties/ordinalproperty.h>         // for FloatVec2Property, IntProperty
+#include <inviwo/core/util/glmvec.h>                        // for ivec2, ivec4
+#include <modules/base/algorithm/image/imagecompositing.h>  // for ImageBlendMode
+#include <modules/base/datastructures/imagereusecache.h>    // for ImageReuseCache
+
+namespace inviwo {
+class Event;
+class Outport;
+
+/**
+ * Places an overlay image on top of the input image on the CPU, the CPU counterpart of the
+ * ImageOverlayGL processor with relative positioning.
+ */
+class IVW_MODULE_BASE_API ImageOverlayRAM : public Processor {
+public:
+    ImageOverlayRAM();
+    virtual ~ImageOverlayRAM() = default;
+
+    virtual void process() override;
+    virtual void propagateEvent(Event* event, Outport* source) override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    /**
+     * Viewport (x, y, width, height) of the overlay, excluding the border, for an output of
+     * size @p dims
+     */
+    ivec4 getViewport(const ivec2& dims) const;
+    void updateOverlaySize();
+
+    ImageInport inport_;
+    ImageInport overlayPort_;
+    ImageOutport outport_;
+
+    BoolProperty enabled_;
+    FloatVec2Property position_;
+    FloatVec2Property size_;
+    FloatVec2Property anchor_;
+    OptionProperty<ImageBlendMode> blendMode_;
+    BoolCompositeProperty border_;
+    FloatVec4Property borderColor_;
+    IntProperty borderWidth_;
+
+    ImageReuseCache cache_;
+    ivec2 currentDim_;
+};
+
+}  // namespace inviwo
@@ -32,7 +32,7 @@
 #include <modules/base/basemoduledefine.h>  // for IVW_MODULE_BASE_API
 
 #include <inviwo/core/ports/volumeport.h>                       // for VolumeOutport
-#include <inviwo/core/processors/processor.h>                   // for Processor
+#include <inviwo/core/processors/poolprocessor.h>               // for PoolProcessor
 #include <inviwo/core/processors/processorinfo.h>               // for ProcessorInfo
 #include <inviwo/core/properties/boolproperty.h>                // for BoolProperty
 #include <inviwo/core/properties/buttonproperty.h>              // for ButtonProperty
@@ -42,6 +42,7 @@
 
 #include <memory>  // for shared_ptr
 #include <string>  // for string
+#include <vector>  // for vector
 
 namespace inviwo {
 
@@ -62,6 +63,9 @@ class Volume;
  * Single channels, i.e. red, green, blue, alpha, and grayscale, will result in a scalar volume
  * whereas rgb and rgba will yield a vec3 or vec4 volume, respectively.
  *
+ * The images are decoded in the background using the thread pool, each thread decodes one slice
+ * at a time and writes it directly into the volume.
+ *
  * ### Outports
  *   * __volume__ Volume generated from a stack of input images.
  *
@@ -75,7 +79,7 @@ class Volume;
  *   * __Data Information__       Metadata of the generated volume data set.
  *
  */
-class IVW_MODULE_BASE_API ImageStackVolumeSource : public Processor {
+class IVW_MODULE_BASE_API ImageStackVolumeSource : public PoolProcessor {
 public:
     ImageStackVolumeSource(InviwoApplication* app);
     void addFileNameFilters();
@@ -87,12 +91,13 @@ public:
     static const ProcessorInfo processorInfo_;
 
 protected:
-    std::shared_ptr<Volume> load();
     bool isValidImageFile(std::string);
 
     virtual void deserialize(Deserializer& d) override;
 
 private:
+    void setVolume(std::shared_ptr<Volume> volume);
+
     VolumeOutport outport_;
     FilePatternProperty filePattern_;
     ButtonProperty reload_;
@@ -31,14 +31,15 @@
 
 #include <modules/base/basemoduledefine.h>  // for IVW_MODULE_BASE_API
 
-#include <inviwo/core/ports/imageport.h>                  // for ImageInport, ImageOutport
-#include <inviwo/core/processors/poolprocessor.h>         // for PoolProcessor
-#include <inviwo/core/processors/processorinfo.h>         // for ProcessorInfo
-#include <inviwo/core/properties/boolproperty.h>          // for BoolProperty
-#include <inviwo/core/properties/ordinalproperty.h>       // for DoubleProperty, IntProperty
-#include <modules/base/datastructures/imagereusecache.h>  // for ImageReuseCache
+#include <inviwo/core/ports/imageport.h>                     // for ImageInport, ImageOutport
+#include <inviwo/core/processors/poolprocessor.h>            // for PoolProcessor
+#include <inviwo/core/processors/processorinfo.h>            // for ProcessorInfo
+#include <inviwo/core/properties/boolproperty.h>             // for BoolProperty
+#include <inviwo/core/properties/ordinalproperty.h>          // for DoubleProperty, IntProperty
+#include <modules/base/datastructures/representationpool.h>  // for LayerRAMPool
 
 #include <iosfwd>  // for ostream
+#include <memory>  // for shared_ptr
 
 namespace inviwo {
 
@@ -54,6 +55,8 @@ namespace inviwo {
 *
 * ### Outports
 *   * __outputImage__ Scalar image representing the distance transform (float)
+*   * __closestFeature__ Scalar image with the linear index into the input layer of the closest
+*     feature pixel (uint32). Only computed when connected.
 *
 * ### Properties
 *   * __Threshold__ Pixels with a value  __larger___ then the then the threshold will be considered
@@ -62,6 +65,8 @@ namespace inviwo {
 *   * __Use normalized threshold__ Use normalized values when comparing to the threshold.
 *   * __Scaling Factor__ Scaling factor to apply to the output distance field.
 *   * __Squared Distance__ Output the squared distance field
+*   * __Signed Distance__ Output a signed distance field with negative distances inside the
+*     features, i.e. the distance from each feature pixel to the closest non-feature pixel.
 *   * __Up sample__ Make the output volume have a higher resolution.
 *   * __Data Range__ Data range to use for the output volume:
 *       * Diagonal use [0, volume diagonal].
@@ -87,14 +92,16 @@ protected:
 private:
     ImageInport imagePort_;
     ImageOutport outport_;
+    ImageOutport closestFeature_;
 
-    ImageReuseCache imageCache_;
+    std::shared_ptr<LayerRAMPool> layerPool_;
 
     DoubleProperty threshold_;
     BoolProperty flip_;
     BoolProperty normalize_;
     DoubleProperty resultDistScale_;  // scaling factor for distances
     BoolProperty resultSquaredDist_;  // determines whether output uses squared euclidean distances
+    BoolProperty resultSignedDist_;   // negative distances inside the features
     BoolProperty uniformUpsampling_;
     IntProperty upsampleFactorUniform_;    // uniform upscaling of the output field
     IntSize2Property upsampleFactorVec2_;  // non-uniform upscaling of the output field
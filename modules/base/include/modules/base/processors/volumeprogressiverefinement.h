@@ -0,0 +1,77 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>  // for IVW_MODULE_BASE_API
+
+#include <inviwo/core/ports/volumeport.h>                 // for VolumeInport, VolumeOutport
+#include <inviwo/core/processors/poolprocessor.h>         // for PoolProcessor
+#include <inviwo/core/processors/processorinfo.h>         // for ProcessorInfo
+#include <inviwo/core/properties/boolproperty.h>          // for BoolProperty
+#include <inviwo/core/properties/optionproperty.h>        // for OptionProperty
+#include <inviwo/core/properties/ordinalproperty.h>       // for IntSizeTProperty
+#include <modules/base/algorithm/volume/volumepyramid.h>  // for DownsampleFilter, VolumePyramid
+
+#include <memory>  // for shared_ptr
+
+namespace inviwo {
+class Volume;
+
+/**
+ * \brief Outputs a level of a cached VolumePyramid, refining the output progressively
+ *
+ * If the pyramid of the input volume is not yet cached, a point-sampled preview is output first
+ * followed by the requested level once the pyramid has been built in the background.
+ */
+class IVW_MODULE_BASE_API VolumeProgressiveRefinement : public PoolProcessor {
+public:
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+    VolumeProgressiveRefinement();
+    virtual ~VolumeProgressiveRefinement() = default;
+
+protected:
+    virtual void process() override;
+
+private:
+    void buildPyramid(std::shared_ptr<const Volume> volume, VolumePyramid::Settings settings,
+                      size_t level);
+
+    VolumeInport inport_;
+    VolumeOutport outport_;
+
+    OptionProperty<DownsampleFilter> filter_;
+    IntSizeTProperty minDimension_;
+    IntSizeTProperty level_;
+    BoolProperty progressive_;
+};
+
+}  // namespace inviwo
@@ -46,7 +46,9 @@
 #include <inviwo/core/util/staticstring.h>                     // for operator+
 #include <modules/base/datastructures/imagereusecache.h>       // for ImageReuseCache
 
+#include <cstddef>      // for size_t
 #include <functional>   // for __base
+#include <memory>       // for shared_ptr, weak_ptr
 #include <string>       // for operator==
 #include <string_view>  // for operator==
 #include <vector>       // for operator!=, vector, operat...
@@ -101,6 +103,15 @@ private:
     EventProperty gestureShiftSlice_;
 
     ImageReuseCache imageCache_;
+
+    /// The last slice read from disk, for inputs that have not been loaded into memory
+    struct DiskSlice {
+        std::weak_ptr<const Volume> volume;
+        size_t axis = 0;
+        size_t index = 0;
+        std::shared_ptr<const Volume> slab;
+    };
+    DiskSlice diskSlice_;
 };
 
 }  // namespace inviwo
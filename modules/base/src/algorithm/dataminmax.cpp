@@ -47,17 +47,44 @@
 
 namespace inviwo {
 
+namespace {
+
+template <typename Repr, typename Compute>
+std::pair<dvec4, dvec4> cachedMinMax(const Repr* repr, IgnoreSpecialValues ignore,
+                                     Compute&& compute) {
+    auto& cache = repr->getMinMaxCache();
+    const bool ignoreSpecial = ignore == IgnoreSpecialValues::Yes;
+    if (auto minMax = cache.get(ignoreSpecial)) return *minMax;
+
+    const auto modificationCount = cache.getModificationCount();
+    const auto minMax = compute();
+    cache.set(ignoreSpecial, minMax, modificationCount);
+    // Only floating point types have special values
+    if (repr->getDataFormat()->getNumericType() != NumericType::Float) {
+        cache.set(!ignoreSpecial, minMax, modificationCount);
+    }
+    return minMax;
+}
+
+}  // namespace
+
 std::pair<dvec4, dvec4> util::volumeMinMax(const VolumeRAM* volume, IgnoreSpecialValues ignore) {
-    return volume->dispatch<std::pair<dvec4, dvec4>>([&ignore](auto vr) -> std::pair<dvec4, dvec4> {
-        const auto dim = vr->getDimensions();
-        return dataMinMax(vr->getDataTyped(), dim.x * dim.y * dim.z, ignore);
+    return cachedMinMax(volume, ignore, [&]() {
+        return volume->dispatch<std::pair<dvec4, dvec4>>(
+            [&ignore](auto vr) -> std::pair<dvec4, dvec4> {
+                const auto dim = vr->getDimensions();
+                return dataMinMax(vr->getDataTyped(), dim.x * dim.y * dim.z, ignore);
+            });
     });
 }
 
 std::pair<dvec4, dvec4> util::layerMinMax(const LayerRAM* layer, IgnoreSpecialValues ignore) {
-    return layer->dispatch<std::pair<dvec4, dvec4>>([&ignore](auto lr) -> std::pair<dvec4, dvec4> {
-        const auto dim = lr->getDimensions();
-        return dataMinMax(lr->getDataTyped(), dim.x * dim.y, ignore);
+    return cachedMinMax(layer, ignore, [&]() {
+        return layer->dispatch<std::pair<dvec4, dvec4>>(
+            [&ignore](auto lr) -> std::pair<dvec4, dvec4> {
+                const auto dim = lr->getDimensions();
+                return dataMinMax(lr->getDataTyped(), dim.x * dim.y, ignore);
+            });
     });
 }
 
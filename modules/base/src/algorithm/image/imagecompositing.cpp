@@ -0,0 +1,325 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <modules/base/algorithm/image/imagecompositing.h>
+
+#include <inviwo/core/datastructures/image/image.h>     // for Image
+#include <inviwo/core/datastructures/image/layer.h>     // for Layer
+#include <inviwo/core/datastructures/image/layerram.h>  // for LayerRAM
+#include <inviwo/core/util/assertion.h>                 // for IVW_ASSERT
+#include <inviwo/core/util/foreach.h>                   // for forEachChunkParallel
+#include <inviwo/core/util/formatdispatching.h>         // for PrecisionValueType
+#include <inviwo/core/util/formats.h>                   // for DataFormat
+#include <inviwo/core/util/glmconvert.h>                // for glm_convert_normalized
+#include <inviwo/core/util/glmutils.h>                  // for value_type_t, is_floating_point
+#include <inviwo/core/util/glmvec.h>                    // for ivec2, ivec4, vec4, size2_t
+
+#include <algorithm>  // for max, min, fill_n
+#include <cstddef>    // for size_t
+#include <ostream>    // for operator<<, basic_ostream
+#include <vector>     // for vector
+
+#include <glm/common.hpp>                // for clamp
+#include <glm/gtx/component_wise.hpp>  // for compMul
+
+namespace inviwo {
+
+std::ostream& operator<<(std::ostream& ss, ImageBlendMode mode) {
+    switch (mode) {
+        case ImageBlendMode::Replace:
+            return ss << "Replace";
+        case ImageBlendMode::Over:
+            return ss << "Over";
+    }
+    return ss;
+}
+
+namespace {
+
+// Smallest number of pixels processed by a single job
+constexpr size_t minPixelsPerJob = size_t{1} << 14;
+
+const vec4 clearedColor{0.0f};
+const vec4 clearedDepth{1.0f};
+const vec4 clearedPicking{0.0f};
+
+template <typename LayerPtr>
+struct ImageLayers {
+    LayerPtr color;
+    LayerPtr depth;
+    LayerPtr picking;
+};
+
+// Empty images are treated as cleared
+ImageLayers<const LayerRAM*> getLayers(const Image& image) {
+    if (glm::compMul(image.getDimensions()) == 0) return {};
+    const auto get = [](const Layer* layer) -> const LayerRAM* {
+        return layer ? layer->getRepresentation<LayerRAM>() : nullptr;
+    };
+    return {get(image.getColorLayer()), get(image.getDepthLayer()), get(image.getPickingLayer())};
+}
+
+// The data pointer is retrieved up front since LayerRAM::getData() clears the min/max cache and
+// can thus not be called from several threads
+struct LayerTarget {
+    const LayerRAM* layer = nullptr;
+    void* data = nullptr;
+};
+
+ImageLayers<LayerTarget> getEditableLayers(Image& image) {
+    const auto get = [](Layer* layer) -> LayerTarget {
+        if (!layer) return {};
+        auto* layerRAM = layer->getEditableRepresentation<LayerRAM>();
+        return {layerRAM, layerRAM->getData()};
+    };
+    return {get(image.getColorLayer()), get(image.getDepthLayer()), get(image.getPickingLayer())};
+}
+
+// Nearest neighbor index into a source of size srcSize for position pos of a region of size size
+size_t sampleIndex(int pos, int size, size_t srcSize) {
+    const auto index = static_cast<size_t>((pos + 0.5) * static_cast<double>(srcSize) / size);
+    return std::min(index, srcSize - 1);
+}
+
+std::vector<size_t> sampleIndices(int begin, int end, int offset, int size, size_t srcSize) {
+    std::vector<size_t> indices(static_cast<size_t>(std::max(end - begin, 0)));
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = sampleIndex(begin + static_cast<int>(i) - offset, size, srcSize);
+    }
+    return indices;
+}
+
+// Read the given columns of a row of layer as normalized values, components missing in the
+// layer format are set to 0 and alpha to 1 as in a texture lookup
+void readRow(const LayerRAM* layer, size_t row, const std::vector<size_t>& columns, vec4* dst,
+             const vec4& cleared) {
+    if (!layer) {
+        std::fill_n(dst, columns.size(), cleared);
+        return;
+    }
+    layer->dispatch<void>([&](const auto* lrprecision) {
+        using ValueType = util::PrecisionValueType<decltype(lrprecision)>;
+        const ValueType* data = lrprecision->getDataTyped() + row * lrprecision->getDimensions().x;
+        for (size_t i = 0; i < columns.size(); ++i) {
+            dst[i] = util::glm_convert_normalized<vec4>(data[columns[i]]);
+            if constexpr (DataFormat<ValueType>::comp < 4) dst[i].a = 1.0f;
+        }
+    });
+}
+
+void writeRow(const LayerTarget& target, size_t row, size_t column, const vec4* src,
+              size_t count) {
+    if (!target.layer) return;
+    target.layer->dispatch<void>([&](const auto* lrprecision) {
+        using ValueType = util::PrecisionValueType<decltype(lrprecision)>;
+        ValueType* data = static_cast<ValueType*>(target.data) +
+                          row * lrprecision->getDimensions().x + column;
+        for (size_t i = 0; i < count; ++i) {
+            if constexpr (util::is_floating_point<util::value_type_t<ValueType>>::value) {
+                data[i] = util::glm_convert_normalized<ValueType>(src[i]);
+            } else {
+                data[i] = util::glm_convert_normalized<ValueType>(glm::clamp(src[i], 0.0f, 1.0f));
+            }
+        }
+    });
+}
+
+// Call callback(rowBegin, rowEnd) for bands of the rows [begin, end) in parallel
+template <typename Callback>
+void forEachRowBand(int begin, int end, int width, Callback&& callback) {
+    const auto rows = static_cast<size_t>(std::max(end - begin, 0));
+    const auto minRows = minPixelsPerJob / static_cast<size_t>(std::max(width, 1));
+    util::forEachChunkParallel(rows, util::parallelChunkCount(rows, minRows),
+                               [&](size_t, size_t bandBegin, size_t bandEnd) {
+                                   callback(begin + static_cast<int>(bandBegin),
+                                            begin + static_cast<int>(bandEnd));
+                               });
+}
+
+// Same as composite.frag
+vec4 compositeOver(const vec4& front, const vec4& back) {
+    return {vec3(front) * front.a + vec3(back) * (1.0f - front.a),
+            front.a + back.a * (1.0f - front.a)};
+}
+
+// Same as glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA)
+vec4 blendOver(const vec4& src, const vec4& dst) { return src * src.a + dst * (1.0f - src.a); }
+
+// Clip the rect (x, y, width, height) against dims, returns (xBegin, yBegin, xEnd, yEnd)
+ivec4 clip(const ivec4& rect, const ivec2& dims) {
+    return {std::max(rect.x, 0), std::max(rect.y, 0), std::min(rect.x + rect.z, dims.x),
+            std::min(rect.y + rect.w, dims.y)};
+}
+
+}  // namespace
+
+void util::compositeImages(const Image& source0, const Image& source1, Image& destination) {
+    IVW_ASSERT(&source0 != &destination, "source0 can not be same as destination");
+    IVW_ASSERT(&source1 != &destination, "source1 can not be same as destination");
+
+    const auto src0 = getLayers(source0);
+    const auto src1 = getLayers(source1);
+    const auto dst = getEditableLayers(destination);
+
+    const ivec2 dims(destination.getDimensions());
+    const size2_t srcDims0 = source0.getDimensions();
+    const size2_t srcDims1 = source1.getDimensions();
+    const auto columns0 = sampleIndices(0, dims.x, 0, dims.x, srcDims0.x);
+    const auto columns1 = sampleIndices(0, dims.x, 0, dims.x, srcDims1.x);
+    const auto width = static_cast<size_t>(dims.x);
+
+    forEachRowBand(0, dims.y, dims.x, [&](int begin, int end) {
+        std::vector<vec4> color0(width), depth0(width), picking0(width);
+        std::vector<vec4> color1(width), depth1(width), picking1(width);
+
+        for (int y = begin; y < end; ++y) {
+            const auto row0 = sampleIndex(y, dims.y, srcDims0.y);
+            const auto row1 = sampleIndex(y, dims.y, srcDims1.y);
+            readRow(src0.color, row0, columns0, color0.data(), clearedColor);
+            readRow(src0.depth, row0, columns0, depth0.data(), clearedDepth);
+            readRow(src0.picking, row0, columns0, picking0.data(), clearedPicking);
+            readRow(src1.color, row1, columns1, color1.data(), clearedColor);
+            readRow(src1.depth, row1, columns1, depth1.data(), clearedDepth);
+            readRow(src1.picking, row1, columns1, picking1.data(), clearedPicking);
+
+            // composite into the buffers of source0
+            for (size_t x = 0; x < width; ++x) {
+                if (depth1[x].x <= depth0[x].x) {
+                    picking0[x] = picking1[x].a > 0.0f
+                                      ? picking1[x]
+                                      : (color1[x].a < 0.95f ? picking0[x] : vec4(0.0f));
+                    color0[x] = compositeOver(color1[x], color0[x]);
+                    depth0[x] = depth1[x];
+                } else {
+                    picking0[x] = picking0[x].a > 0.0f
+                                      ? picking0[x]
+                                      : (color0[x].a < 0.95f ? picking1[x] : vec4(0.0f));
+                    color0[x] = compositeOver(color0[x], color1[x]);
+                }
+            }
+
+            writeRow(dst.color, y, 0, color0.data(), width);
+            writeRow(dst.depth, y, 0, depth0.data(), width);
+            writeRow(dst.picking, y, 0, picking0.data(), width);
+        }
+    });
+}
+
+void util::drawImage(const Image& source, Image& destination, const ivec4& viewport,
+                     ImageBlendMode mode) {
+    IVW_ASSERT(&source != &destination, "source can not be same as destination");
+
+    const auto region = clip(viewport, ivec2(destination.getDimensions()));
+    if (region.x >= region.z || region.y >= region.w) return;
+
+    const auto src = getLayers(source);
+    const auto dst = getEditableLayers(destination);
+
+    const size2_t srcDims = source.getDimensions();
+    const auto columns = sampleIndices(region.x, region.z, viewport.x, viewport.z, srcDims.x);
+    const auto width = columns.size();
+    const auto column = static_cast<size_t>(region.x);
+
+    // the destination columns of the region, used when reading the destination for blending
+    std::vector<size_t> dstColumns(width);
+    for (size_t i = 0; i < width; ++i) dstColumns[i] = column + i;
+
+    forEachRowBand(region.y, region.w, static_cast<int>(width), [&](int begin, int end) {
+        std::vector<vec4> color(width), depth(width), picking(width);
+        std::vector<vec4> dstColor, dstDepth, dstPicking;
+        if (mode == ImageBlendMode::Over) {
+            dstColor.resize(width);
+            dstDepth.resize(width);
+            dstPicking.resize(width);
+        }
+
+        for (int y = begin; y < end; ++y) {
+            const auto row = sampleIndex(y - viewport.y, viewport.w, srcDims.y);
+            readRow(src.color, row, columns, color.data(), clearedColor);
+            readRow(src.depth, row, columns, depth.data(), clearedDepth);
+            readRow(src.picking, row, columns, picking.data(), clearedPicking);
+
+            if (mode == ImageBlendMode::Over) {
+                readRow(dst.color.layer, y, dstColumns, dstColor.data(), clearedColor);
+                readRow(dst.depth.layer, y, dstColumns, dstDepth.data(), clearedDepth);
+                readRow(dst.picking.layer, y, dstColumns, dstPicking.data(), clearedPicking);
+                for (size_t x = 0; x < width; ++x) {
+                    // fully transparent pixels leave the destination untouched
+                    if (color[x].a == 0.0f) {
+                        color[x] = dstColor[x];
+                        depth[x] = dstDepth[x];
+                        picking[x] = dstPicking[x];
+                    } else {
+                        color[x] = blendOver(color[x], dstColor[x]);
+                    }
+                }
+            }
+
+            writeRow(dst.color, y, column, color.data(), width);
+            writeRow(dst.depth, y, column, depth.data(), width);
+            writeRow(dst.picking, y, column, picking.data(), width);
+        }
+    });
+}
+
+void util::fillImage(Image& destination, const ivec4& rect, const vec4& color,
+                     ImageBlendMode mode) {
+    const auto region = clip(rect, ivec2(destination.getDimensions()));
+    if (region.x >= region.z || region.y >= region.w) return;
+
+    const auto dst = getEditableLayers(destination);
+    const auto width = static_cast<size_t>(region.z - region.x);
+    const auto column = static_cast<size_t>(region.x);
+
+    std::vector<size_t> dstColumns(width);
+    for (size_t i = 0; i < width; ++i) dstColumns[i] = column + i;
+
+    forEachRowBand(region.y, region.w, static_cast<int>(width), [&](int begin, int end) {
+        std::vector<vec4> colorRow(width, color);
+        const std::vector<vec4> depthRow(width, clearedDepth);
+        const std::vector<vec4> pickingRow(width, clearedPicking);
+
+        for (int y = begin; y < end; ++y) {
+            if (mode == ImageBlendMode::Over) {
+                readRow(dst.color.layer, y, dstColumns, colorRow.data(), clearedColor);
+                for (auto& c : colorRow) c = blendOver(color, c);
+            } else {
+                writeRow(dst.depth, y, column, depthRow.data(), width);
+                writeRow(dst.picking, y, column, pickingRow.data(), width);
+            }
+            writeRow(dst.color, y, column, colorRow.data(), width);
+        }
+    });
+}
+
+void util::clearImage(Image& destination) {
+    const ivec2 dims(destination.getDimensions());
+    fillImage(destination, ivec4(0, 0, dims), clearedColor, ImageBlendMode::Replace);
+}
+
+}  // namespace inviwo
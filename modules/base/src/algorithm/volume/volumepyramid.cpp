@@ -0,0 +1,316 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/volume/volumepyramid.h>
+
+#include <inviwo/core/datastructures/volume/volume.h>     // for Volume
+#include <inviwo/core/datastructures/volume/volumeram.h>  // for VolumeRAM, VolumeRAMPrecision
+#include <inviwo/core/util/exception.h>                   // for RangeException
+#include <inviwo/core/util/foreach.h>                     // for forEachChunkParallel
+#include <inviwo/core/util/formatdispatching.h>           // for PrecisionValueType
+#include <inviwo/core/util/glmutils.h>                    // for same_extent_t, value_type_t
+
+#include <algorithm>    // for clamp, fill, find_if, max
+#include <array>        // for array
+#include <mutex>        // for mutex, scoped_lock
+#include <ostream>      // for operator<<, basic_ostream
+#include <type_traits>  // for is_integral_v
+#include <vector>       // for vector, erase_if
+
+#include <glm/common.hpp>              // for round, max
+#include <glm/gtx/component_wise.hpp>  // for compMax, compMul
+
+namespace inviwo {
+
+namespace {
+
+struct Taps {
+    std::array<std::ptrdiff_t, 4> offsets{};
+    std::array<double, 4> weights{};
+    size_t count = 0;
+};
+
+Taps taps(DownsampleFilter filter, size_t srcDim) {
+    if (srcDim == 1) return {{0, 0, 0, 0}, {1.0, 0.0, 0.0, 0.0}, 1};
+    switch (filter) {
+        case DownsampleFilter::Gaussian:
+            return {{-1, 0, 1, 2}, {0.125, 0.375, 0.375, 0.125}, 4};
+        case DownsampleFilter::Box:
+        default:
+            return {{0, 1, 0, 0}, {0.5, 0.5, 0.0, 0.0}, 2};
+    }
+}
+
+size_t sourceIndex(size_t dstIndex, std::ptrdiff_t offset, size_t srcDim) {
+    const auto i = static_cast<std::ptrdiff_t>(2 * dstIndex) + offset;
+    const auto last = static_cast<std::ptrdiff_t>(srcDim) - 1;
+    return static_cast<size_t>(std::clamp(i, std::ptrdiff_t{0}, last));
+}
+
+template <typename T>
+void downsample(const VolumeRAMPrecision<T>& srcVol, VolumeRAMPrecision<T>& dstVol,
+                DownsampleFilter filter) {
+    // use a double type to perform the summation
+    using P = util::same_extent_t<T, double>;
+
+    const auto sd = srcVol.getDimensions();
+    const auto dd = dstVol.getDimensions();
+    const std::array<Taps, 3> t{taps(filter, sd.x), taps(filter, sd.y), taps(filter, sd.z)};
+
+    const T* src = srcVol.getDataTyped();
+    T* dst = dstVol.getDataTyped();
+
+    util::forEachChunkParallel(dd.z, util::parallelChunkCount(dd.z, 1), [&](size_t, size_t zBegin,
+                                                                             size_t zEnd) {
+        // Filter along z into a full source slice, then along y into dd.y source rows, and
+        // finally along x into the destination.
+        std::vector<P> slice(sd.x * sd.y);
+        std::vector<P> rows(sd.x * dd.y);
+
+        for (size_t z = zBegin; z < zEnd; ++z) {
+            std::fill(slice.begin(), slice.end(), P{0.0});
+            for (size_t k = 0; k < t[2].count; ++k) {
+                const auto w = t[2].weights[k];
+                const T* s = src + sourceIndex(z, t[2].offsets[k], sd.z) * sd.x * sd.y;
+                for (size_t i = 0; i < slice.size(); ++i) {
+                    slice[i] += w * static_cast<P>(s[i]);
+                }
+            }
+
+            std::fill(rows.begin(), rows.end(), P{0.0});
+            for (size_t y = 0; y < dd.y; ++y) {
+                P* r = rows.data() + y * sd.x;
+                for (size_t k = 0; k < t[1].count; ++k) {
+                    const auto w = t[1].weights[k];
+                    const P* s = slice.data() + sourceIndex(y, t[1].offsets[k], sd.y) * sd.x;
+                    for (size_t x = 0; x < sd.x; ++x) {
+                        r[x] += w * s[x];
+                    }
+                }
+            }
+
+            T* out = dst + z * dd.x * dd.y;
+            for (size_t y = 0; y < dd.y; ++y) {
+                const P* r = rows.data() + y * sd.x;
+                for (size_t x = 0; x < dd.x; ++x) {
+                    P val{0.0};
+                    for (size_t k = 0; k < t[0].count; ++k) {
+                        val += t[0].weights[k] * r[sourceIndex(x, t[0].offsets[k], sd.x)];
+                    }
+                    if constexpr (std::is_integral_v<util::value_type_t<T>>) {
+                        val = glm::round(val);
+                    }
+#include <warn/push>
+#include <warn/ignore/conversion>
+                    out[y * dd.x + x] = static_cast<T>(val);
+#include <warn/pop>
+                }
+            }
+        }
+    });
+}
+
+std::shared_ptr<Volume> createLevel(std::shared_ptr<VolumeRAM> ram, const Volume& source) {
+    auto level = std::make_shared<Volume>(ram);
+    level->copyMetaDataFrom(source);
+    level->dataMap_ = source.dataMap_;
+    level->axes = source.axes;
+    level->setModelMatrix(source.getModelMatrix());
+    level->setWorldMatrix(source.getWorldMatrix());
+    return level;
+}
+
+struct CacheEntry {
+    std::weak_ptr<const Volume> volume;
+    VolumePyramid::Settings settings;
+    std::shared_ptr<const VolumePyramid> pyramid;
+
+    bool matches(const std::shared_ptr<const Volume>& v, const VolumePyramid::Settings& s) const {
+        return settings == s && !volume.owner_before(v) && !v.owner_before(volume);
+    }
+};
+
+struct Cache {
+    std::mutex mutex;
+    std::vector<CacheEntry> entries;
+
+    std::shared_ptr<const VolumePyramid> find(const std::shared_ptr<const Volume>& volume,
+                                              const VolumePyramid::Settings& settings) {
+        std::erase_if(entries, [](const CacheEntry& e) { return e.volume.expired(); });
+        auto it = std::find_if(entries.begin(), entries.end(),
+                               [&](const CacheEntry& e) { return e.matches(volume, settings); });
+        return it != entries.end() ? it->pyramid : nullptr;
+    }
+};
+
+Cache& cache() {
+    static Cache cache;
+    return cache;
+}
+
+}  // namespace
+
+std::ostream& operator<<(std::ostream& ss, DownsampleFilter filter) {
+    switch (filter) {
+        case DownsampleFilter::Box:
+            return ss << "Box";
+        case DownsampleFilter::Gaussian:
+            return ss << "Gaussian";
+    }
+    return ss;
+}
+
+std::shared_ptr<VolumeRAM> util::volumeDownsample(const VolumeRAM& volume,
+                                                  DownsampleFilter filter) {
+    return volume.dispatch<std::shared_ptr<VolumeRAM>>(
+        [filter](auto srcVol) -> std::shared_ptr<VolumeRAM> {
+            using ValueType = util::PrecisionValueType<decltype(srcVol)>;
+            auto dstVol = std::make_shared<VolumeRAMPrecision<ValueType>>(
+                VolumePyramid::downsampledDimensions(srcVol->getDimensions()),
+                srcVol->getSwizzleMask(), srcVol->getInterpolation(), srcVol->getWrapping());
+            downsample(*srcVol, *dstVol, filter);
+            return dstVol;
+        });
+}
+
+std::shared_ptr<VolumeRAM> util::volumePointSample(const VolumeRAM& volume, size3_t factors) {
+    factors = glm::max(factors, size3_t{1});
+    return volume.dispatch<std::shared_ptr<VolumeRAM>>(
+        [factors](auto srcVol) -> std::shared_ptr<VolumeRAM> {
+            using ValueType = util::PrecisionValueType<decltype(srcVol)>;
+            const auto sd = srcVol->getDimensions();
+            const auto dd = (sd + factors - size3_t{1}) / factors;
+            auto dstVol = std::make_shared<VolumeRAMPrecision<ValueType>>(
+                dd, srcVol->getSwizzleMask(), srcVol->getInterpolation(), srcVol->getWrapping());
+
+            const auto src = srcVol->getDataTyped();
+            auto dst = dstVol->getDataTyped();
+            util::forEachChunkParallel(
+                dd.z, util::parallelChunkCount(dd.z, 1), [&](size_t, size_t zBegin, size_t zEnd) {
+                    for (size_t z = zBegin; z < zEnd; ++z) {
+                        for (size_t y = 0; y < dd.y; ++y) {
+                            const auto s = src + (z * factors.z * sd.y + y * factors.y) * sd.x;
+                            auto d = dst + (z * dd.y + y) * dd.x;
+                            for (size_t x = 0; x < dd.x; ++x) {
+                                d[x] = s[x * factors.x];
+                            }
+                        }
+                    }
+                });
+            return dstVol;
+        });
+}
+
+VolumePyramid::VolumePyramid(const Volume& volume, const Settings& settings,
+                             const std::function<bool()>& stop,
+                             const std::function<void(float)>& progress)
+    : settings_{settings}, dimensions_{volume.getDimensions()}, levels_{} {
+
+    const auto levels = numberOfLevels(dimensions_, settings_.minDimension);
+    if (levels <= 1) return;
+
+    // Weight the progress by the number of voxels read for each level
+    double total = 0.0;
+    auto dims = dimensions_;
+    for (size_t level = 1; level < levels; ++level) {
+        total += static_cast<double>(glm::compMul(dims));
+        dims = downsampledDimensions(dims);
+    }
+
+    const VolumeRAM* src = volume.getRepresentation<VolumeRAM>();
+    double done = 0.0;
+    for (size_t level = 1; level < levels; ++level) {
+        if (stop && stop()) return;
+        done += static_cast<double>(glm::compMul(src->getDimensions()));
+        auto ram = util::volumeDownsample(*src, settings_.filter);
+        src = ram.get();
+        levels_.push_back(createLevel(std::move(ram), volume));
+        if (progress) progress(static_cast<float>(done / total));
+    }
+}
+
+std::shared_ptr<const VolumePyramid> VolumePyramid::get(
+    const std::shared_ptr<const Volume>& volume, const Settings& settings,
+    const std::function<bool()>& stop, const std::function<void(float)>& progress) {
+
+    if (auto pyramid = find(volume, settings)) return pyramid;
+
+    // Build without holding the lock, if someone else finished the same pyramid in the meantime
+    // we use that one instead.
+    auto pyramid = std::make_shared<const VolumePyramid>(*volume, settings, stop, progress);
+    if (stop && stop()) return nullptr;
+
+    auto& c = cache();
+    const std::scoped_lock lock{c.mutex};
+    if (auto existing = c.find(volume, settings)) return existing;
+    c.entries.push_back(CacheEntry{volume, settings, pyramid});
+    return pyramid;
+}
+
+std::shared_ptr<const VolumePyramid> VolumePyramid::find(
+    const std::shared_ptr<const Volume>& volume, const Settings& settings) {
+    auto& c = cache();
+    const std::scoped_lock lock{c.mutex};
+    return c.find(volume, settings);
+}
+
+size_t VolumePyramid::getNumberOfLevels() const { return levels_.size() + 1; }
+
+std::shared_ptr<const Volume> VolumePyramid::getLevel(size_t level) const {
+    if (level >= getNumberOfLevels()) {
+        throw RangeException(IVW_CONTEXT, "Invalid pyramid level {}, the pyramid has {} levels",
+                             level, getNumberOfLevels());
+    }
+    return level == 0 ? nullptr : levels_[level - 1];
+}
+
+size3_t VolumePyramid::getDimensions(size_t level) const {
+    if (level >= getNumberOfLevels()) {
+        throw RangeException(IVW_CONTEXT, "Invalid pyramid level {}, the pyramid has {} levels",
+                             level, getNumberOfLevels());
+    }
+    return level == 0 ? dimensions_ : levels_[level - 1]->getDimensions();
+}
+
+size3_t VolumePyramid::downsampledDimensions(size3_t dims) {
+    return (dims + size3_t{1}) / size3_t{2};
+}
+
+size_t VolumePyramid::numberOfLevels(size3_t dims, size_t minDimension) {
+    size_t levels = 1;
+    while (glm::compMax(dims) > std::max(minDimension, size_t{1})) {
+        dims = downsampledDimensions(dims);
+        ++levels;
+    }
+    return levels;
+}
+
+const VolumePyramid::Settings& VolumePyramid::getSettings() const { return settings_; }
+
+}  // namespace inviwo
@@ -30,6 +30,7 @@
 #include <modules/base/algorithm/volume/volumeramsubsample.h>
 
 #include <inviwo/core/datastructures/volume/volumeram.h>  // for VolumeRAM
+#include <inviwo/core/util/foreach.h>                      // for forEachChunkParallel
 #include <inviwo/core/util/formatdispatching.h>           // for PrecisionValueType
 #include <inviwo/core/util/glmutils.h>                    // for same_extent
 #include <inviwo/core/util/glmvec.h>                      // for size3_t
@@ -41,10 +42,6 @@
 #include <glm/vec3.hpp>  // for operator*, vec<>::(anonymous)
 #include <glm/vec4.hpp>  // for operator*
 
-#ifdef IVW_USE_OPENMP
-#include <omp.h>
-#endif
-
 namespace inviwo {
 
 std::shared_ptr<VolumeRAM> util::volumeSubSample(const VolumeRAM* volume, size3_t f) {
@@ -71,33 +68,33 @@ std::shared_ptr<VolumeRAM> util::volumeSubSample(const VolumeRAM* volume, size3_
 
             const double samplesInv = 1.0 / (f.x * f.y * f.z);
 
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel for
-#endif
-            for (long long z_ = 0; z_ < static_cast<long long>(destDims.z); ++z_) {
-                const size_t z = static_cast<size_t>(z_);  // OpenMP need signed integral type.
-                for (size_t y = 0; y < destDims.y; ++y) {
-                    for (size_t x = 0; x < destDims.x; ++x) {
-                        const size_t px{x * f.x};
-                        const size_t py{y * f.y};
-                        const size_t pz{z * f.z};
-                        P val{0.0};
-
-                        for (size_t oz = 0; oz < f.z; ++oz) {
-                            for (size_t oy = 0; oy < f.y; ++oy) {
-                                for (size_t ox = 0; ox < f.x; ++ox) {
-                                    val += src[o(px + ox, py + oy, pz + oz)];
+            util::forEachChunkParallel(
+                destDims.z, util::parallelChunkCount(destDims.z, 1),
+                [&](size_t, size_t zBegin, size_t zEnd) {
+                    for (size_t z = zBegin; z < zEnd; ++z) {
+                        for (size_t y = 0; y < destDims.y; ++y) {
+                            for (size_t x = 0; x < destDims.x; ++x) {
+                                const size_t px{x * f.x};
+                                const size_t py{y * f.y};
+                                const size_t pz{z * f.z};
+                                P val{0.0};
+
+                                for (size_t oz = 0; oz < f.z; ++oz) {
+                                    for (size_t oy = 0; oy < f.y; ++oy) {
+                                        for (size_t ox = 0; ox < f.x; ++ox) {
+                                            val += src[o(px + ox, py + oy, pz + oz)];
+                                        }
+                                    }
                                 }
-                            }
-                        }
 
 #include <warn/push>
 #include <warn/ignore/conversion>
-                        dst[n(x, y, z)] = static_cast<ValueType>(val * samplesInv);
+                                dst[n(x, y, z)] = static_cast<ValueType>(val * samplesInv);
 #include <warn/pop>
+                            }
+                        }
                     }
-                }
-            }
+                });
 
             return destVol;
         });
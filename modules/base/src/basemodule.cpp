@@ -74,9 +74,12 @@
 #include <modules/base/processors/distancetransformram.h>                    // for DistanceTran...
 #include <modules/base/processors/gridplanes.h>                              // for GridPlanes
 #include <modules/base/processors/heightfieldmapper.h>                       // for HeightFieldM...
+#include <modules/base/processors/imagecompositeram.h>                       // for ImageCompos...
 #include <modules/base/processors/imagecontourprocessor.h>                   // for ImageContour...
 #include <modules/base/processors/imageexport.h>                             // for ImageExport
 #include <modules/base/processors/imageinformation.h>                        // for ImageInforma...
+#include <modules/base/processors/imagelayoutram.h>                          // for ImageLayoutRAM
+#include <modules/base/processors/imageoverlayram.h>                         // for ImageOverlay...
 #include <modules/base/processors/imagesequenceelementselectorprocessor.h>   // for ImageSequenc...
 #include <modules/base/processors/imagesnapshot.h>                           // for ImageSnapshot
 #include <modules/base/processors/imagesource.h>                             // for ImageSource
@@ -124,6 +127,7 @@
 #include <modules/base/processors/volumegradientcpuprocessor.h>              // for VolumeGradie...
 #include <modules/base/processors/volumeinformation.h>                       // for VolumeInform...
 #include <modules/base/processors/volumelaplacianprocessor.h>                // for VolumeLaplac...
+#include <modules/base/processors/volumeprogressiverefinement.h>             // for VolumeProgre...
 #include <modules/base/processors/volumesequenceelementselectorprocessor.h>  // for VolumeSequen...
 #include <modules/base/processors/volumesequencesingletimestepsampler.h>     // for VolumeSequen...
 #include <modules/base/processors/volumesequencesource.h>                    // for VolumeSequen...
@@ -188,8 +192,11 @@ BaseModule::BaseModule(InviwoApplication* app) : InviwoModule(app, "Base") {
     registerProcessor<GridPlanes>();
     registerProcessor<MeshSource>();
     registerProcessor<HeightFieldMapper>();
+    registerProcessor<ImageCompositeRAM>();
     registerProcessor<ImageExport>();
     registerProcessor<ImageInformation>();
+    registerProcessor<ImageLayoutRAM>();
+    registerProcessor<ImageOverlayRAM>();
     registerProcessor<ImageSnapshot>();
     registerProcessor<ImageSource>();
     registerProcessor<ImageSourceSeries>();
@@ -227,6 +234,7 @@ BaseModule::BaseModule(InviwoApplication* app) : InviwoModule(app, "Base") {
     registerProcessor<VolumeSliceExtractor>();
     registerProcessor<VolumeSubsample>();
     registerProcessor<VolumeSubset>();
+    registerProcessor<VolumeProgressiveRefinement>();
     registerProcessor<ImageContourProcessor>();
     registerProcessor<VolumeSequenceSource>();
     registerProcessor<VolumeSequenceElementSelectorProcessor>();
@@ -46,6 +46,17 @@ std::shared_ptr<Image> ImageReuseCache::getUnused() {
     }
 }
 
+std::shared_ptr<Image> ImageReuseCache::getUnused(const size2_t& dim,
+                                                  const DataFormatBase* format) {
+    auto reuse = getUnused();
+    if (reuse && reuse->getDataFormat() == format && reuse->getDimensions() == dim &&
+        reuse->getDepthLayer() && reuse->getPickingLayer()) {
+        return reuse;
+    } else {
+        return std::make_shared<Image>(dim, format);
+    }
+}
+
 void ImageReuseCache::add(std::shared_ptr<Image> image) { imageCache_.push_back(image); }
 
 }  // namespace inviwo
@@ -0,0 +1,97 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <modules/base/datastructures/representationpool.h>
+
+#include <inviwo/core/datastructures/image/imagetypes.h>  // for LayerType, swizzlemasks, ...
+#include <inviwo/core/datastructures/image/layerram.h>    // for createLayerRAM, LayerRAM
+#include <inviwo/core/datastructures/volume/volumeram.h>  // for createVolumeRAM, VolumeRAM
+#include <inviwo/core/util/hashcombine.h>                 // for hash_combine
+
+#include <glm/gtx/component_wise.hpp>  // for compMul
+
+namespace inviwo {
+
+size_t detail::RepresentationPoolKeyHash::operator()(const RepresentationPoolKey& key) const {
+    size_t h = 0;
+    util::hash_combine(h, static_cast<int>(key.format));
+    util::hash_combine(h, static_cast<int>(key.type));
+    util::hash_combine(h, key.dims.x);
+    util::hash_combine(h, key.dims.y);
+    util::hash_combine(h, key.dims.z);
+    return h;
+}
+
+LayerRAMPool::LayerRAMPool(size_t maxUnusedBytes) : pool_{maxUnusedBytes} {}
+
+std::shared_ptr<LayerRAM> LayerRAMPool::get(const size2_t& dims, const DataFormatBase* format,
+                                            LayerType type) {
+    const detail::RepresentationPoolKey key{format->getId(), type, size3_t{dims, 1}};
+    auto [repr, reused] = pool_.get(key, glm::compMul(dims) * format->getSize(),
+                                    [&]() { return createLayerRAM(dims, type, format); });
+    if (reused) {
+        repr->setSwizzleMask(swizzlemasks::rgba);
+        repr->setInterpolation(InterpolationType::Linear);
+        repr->setWrapping(wrapping2d::clampAll);
+    }
+    return repr;
+}
+
+void LayerRAMPool::setMaxUnusedBytes(size_t maxUnusedBytes) {
+    pool_.setMaxUnusedBytes(maxUnusedBytes);
+}
+size_t LayerRAMPool::getMaxUnusedBytes() const { return pool_.getMaxUnusedBytes(); }
+
+RepresentationPoolStats LayerRAMPool::getStats() const { return pool_.getStats(); }
+
+void LayerRAMPool::clear() { pool_.clear(); }
+
+VolumeRAMPool::VolumeRAMPool(size_t maxUnusedBytes) : pool_{maxUnusedBytes} {}
+
+std::shared_ptr<VolumeRAM> VolumeRAMPool::get(const size3_t& dims, const DataFormatBase* format) {
+    const detail::RepresentationPoolKey key{format->getId(), LayerType::Color, dims};
+    auto [repr, reused] = pool_.get(key, glm::compMul(dims) * format->getSize(),
+                                    [&]() { return createVolumeRAM(dims, format); });
+    if (reused) {
+        repr->setSwizzleMask(swizzlemasks::rgba);
+        repr->setInterpolation(InterpolationType::Linear);
+        repr->setWrapping(wrapping3d::clampAll);
+    }
+    return repr;
+}
+
+void VolumeRAMPool::setMaxUnusedBytes(size_t maxUnusedBytes) {
+    pool_.setMaxUnusedBytes(maxUnusedBytes);
+}
+size_t VolumeRAMPool::getMaxUnusedBytes() const { return pool_.getMaxUnusedBytes(); }
+
+RepresentationPoolStats VolumeRAMPool::getStats() const { return pool_.getStats(); }
+
+void VolumeRAMPool::clear() { pool_.clear(); }
+
+}  // namespace inviwo
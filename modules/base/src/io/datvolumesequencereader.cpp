@@ -48,6 +48,7 @@
 #include <inviwo/core/util/logcentral.h>                   // for LogCentral, LogInfo, LogWarn
 #include <inviwo/core/util/sourcecontext.h>                // for IVW_CONTEXT
 #include <inviwo/core/util/stringconversion.h>             // for toLower, trim, splitByFirst
+#include <inviwo/core/util/volumereorientation.h>          // for VolumeReorientation
 #include <modules/base/algorithm/algorithmoptions.h>       // for IgnoreSpecialValues, IgnoreSpe...
 #include <modules/base/algorithm/dataminmax.h>             // for volumeMinMax
 
@@ -113,6 +114,7 @@ std::shared_ptr<DatVolumeSequenceReader::VolumeSequence> DatVolumeSequenceReader
         std::optional<vec3> c = std::nullopt;
 
         std::array<Axis, 3> axes = util::defaultAxes<3>();
+        util::VolumeReorientation reorientation{};
 
         mat4 wtm{1.0f};
 
@@ -239,6 +241,16 @@ std::shared_ptr<DatVolumeSequenceReader::VolumeSequence> DatVolumeSequenceReader
          [](State& state, std::stringstream& ss) {
              ss >> state.axes[0].name >> state.axes[1].name >> state.axes[2].name;
          }},
+        {"axisorder",
+         [](State& state, std::stringstream& ss) {
+             auto& p = state.reorientation.permutation;
+             ss >> p[0] >> p[1] >> p[2];
+         }},
+        {"axisflip",
+         [](State& state, std::stringstream& ss) {
+             auto& f = state.reorientation.flip;
+             ss >> f[0] >> f[1] >> f[2];
+         }},
         {"axis1name", [](State& state, std::stringstream& ss) { ss >> state.axes[0].name; }},
         {"axis2name", [](State& state, std::stringstream& ss) { ss >> state.axes[1].name; }},
         {"axis3name", [](State& state, std::stringstream& ss) { ss >> state.axes[2].name; }},
@@ -346,6 +358,9 @@ std::shared_ptr<DatVolumeSequenceReader::VolumeSequence> DatVolumeSequenceReader
             throw DataReaderException(
                 IVW_CONTEXT, "Error: Unable to find \"ObjectFilename\" tag in .dat file: {}",
                 filePath);
+        } else if (!state.reorientation.isValid()) {
+            throw DataReaderException(
+                IVW_CONTEXT, "Error: Invalid \"AxisOrder\" tag in .dat file: {}", filePath);
         }
 
         if (state.spacing) {
@@ -371,7 +386,18 @@ std::shared_ptr<DatVolumeSequenceReader::VolumeSequence> DatVolumeSequenceReader
             state.offset = -0.5f * (state.basis[0] + state.basis[1] + state.basis[2]);
         }
 
-        auto volume = std::make_shared<Volume>(state.dimensions, state.format, state.swizzleMask,
+        // "AxisOrder" and "AxisFlip" reorient the data while loading. The dimensions, spacing and
+        // basis refer to the layout of the raw file and are permuted to match the loaded volume.
+        const auto dimensions = state.reorientation.reorientedDimensions(state.dimensions);
+        if (!state.reorientation.isIdentity()) {
+            state.reorientation.reorientBasis(state.basis, *state.offset);
+            const auto axes = state.axes;
+            for (size_t i = 0; i < 3; ++i) {
+                state.axes[i] = axes[state.reorientation.permutation[i]];
+            }
+        }
+
+        auto volume = std::make_shared<Volume>(dimensions, state.format, state.swizzleMask,
                                                state.interpolation, state.wrapping);
         volume->setBasis(state.basis);
         volume->setOffset(*state.offset);
@@ -402,13 +428,13 @@ std::shared_ptr<DatVolumeSequenceReader::VolumeSequence> DatVolumeSequenceReader
             } else {
                 volumes->push_back(std::shared_ptr<Volume>(volumes->front()->clone()));
             }
-            auto diskRepr = std::make_shared<VolumeDisk>(filePath, state.dimensions, state.format,
-                                                         state.swizzleMask, state.interpolation,
-                                                         state.wrapping);
+            auto diskRepr =
+                std::make_shared<VolumeDisk>(filePath, dimensions, state.format, state.swizzleMask,
+                                             state.interpolation, state.wrapping);
             const auto filePos = t * bytes + state.byteOffset;
 
-            auto loader = std::make_unique<RawVolumeRAMLoader>(fileDirectory / state.rawFile,
-                                                               filePos, state.littleEndian);
+            auto loader = std::make_unique<RawVolumeRAMLoader>(
+                fileDirectory / state.rawFile, filePos, state.littleEndian, state.reorientation);
             diskRepr->setLoader(loader.release());
             volumes->back()->addRepresentation(diskRepr);
             // Compute data range if not specified
@@ -32,6 +32,7 @@
 #include <inviwo/core/algorithm/markdown.h>                            // for operator""_help
 #include <inviwo/core/datastructures/data.h>                           // for noData
 #include <inviwo/core/datastructures/datamapper.h>                     // for DataMapper
+#include <inviwo/core/datastructures/image/imagetypes.h>               // for InterpolationType
 #include <inviwo/core/datastructures/unitsystem.h>                     // for Axis, Unit
 #include <inviwo/core/datastructures/volume/volume.h>                  // for Volume
 #include <inviwo/core/datastructures/volume/volumeram.h>               // for VolumeRAMPrecision
@@ -52,8 +53,10 @@
 #include <inviwo/core/util/staticstring.h>                             // for operator+
 #include <modules/base/algorithm/dataminmax.h>                         // for dataMinMax
 #include <modules/base/algorithm/volume/volumeramdistancetransform.h>  // for volumeDistanceTran...
+#include <modules/base/datastructures/representationpool.h>            // for VolumeRAMPool
 
 #include <array>        // for array
+#include <cstdint>      // for uint32_t
 #include <limits>       // for numeric_limits
 #include <memory>       // for shared_ptr, make_s...
 #include <ostream>      // for operator<<
@@ -79,7 +82,8 @@ const ProcessorInfo DistanceTransformRAM::processorInfo_{
     R"(Computes the distance transform of a volume dataset using a threshold value
     The result is the distance from each voxel to the closest feature. It will only work correctly
     for volumes with an orthogonal basis. It uses the Saito's algorithm to compute the Euclidean
-    distance.
+    distance. Optionally the distance is signed, and the closest feature of each voxel is
+    computed in the same passes.
     
     Example Network:
     [basegl/distance_transform.inv](file:~modulePath~/tests/regression/distance_transform.inv)
@@ -90,6 +94,10 @@ DistanceTransformRAM::DistanceTransformRAM()
     : PoolProcessor(pool::Option::DelayDispatch)
     , volumePort_("inputVolume", "Input volume"_help)
     , outport_("outputVolume", "Scalar volume representing the distance transform (float)"_help)
+    , closestFeature_("closestFeature",
+                      "Scalar volume with the linear index into the input volume of the closest "
+                      "feature voxel (uint32). Only computed when connected."_help)
+    , volumePool_(std::make_shared<VolumeRAMPool>())
     , threshold_("threshold", "Threshold",
                  "Voxels with a value  __larger___ than the threshold will be considered "
                  "as features, i.e. have a zero distance"_help,
@@ -105,6 +113,10 @@ DistanceTransformRAM::DistanceTransformRAM()
                        0.05f)
     , resultSquaredDist_("distSquared", "Squared Distance",
                          "Output the squared distance field"_help, false)
+    , resultSignedDist_("distSigned", "Signed Distance",
+                        "Output a signed distance field with negative distances inside the "
+                        "features, i.e. the distance from each feature voxel to the closest "
+                        "non-feature voxel"_help, false)
     , uniformUpsampling_("uniformUpsampling", "Uniform Upsampling",
                          "Make the output volume have a higher resolution."_help, false)
     , upsampleFactorUniform_("upsampleFactorUniform", "Sampling Factor", 1, 1, 10)
@@ -123,12 +135,13 @@ DistanceTransformRAM::DistanceTransformRAM()
                        0.0, 1.0, 0.0, std::numeric_limits<double>::max(), 0.01, 0.0,
                        InvalidationLevel::InvalidOutput, PropertySemantics::Text) {
 
-    addPort(volumePort_);
-    addPort(outport_);
+    addPorts(volumePort_, outport_, closestFeature_);
+    // the closest feature is only computed when needed
+    closestFeature_.onConnect([this]() { invalidate(InvalidationLevel::InvalidOutput); });
 
     addProperties(threshold_, flip_, normalize_, resultDistScale_, resultSquaredDist_,
-                  uniformUpsampling_, upsampleFactorVec3_, upsampleFactorUniform_, dataRangeMode_,
-                  customDataRange_, dataRangeOutput_);
+                  resultSignedDist_, uniformUpsampling_, upsampleFactorVec3_,
+                  upsampleFactorUniform_, dataRangeMode_, customDataRange_, dataRangeOutput_);
 
     upsampleFactorVec3_.visibilityDependsOn(uniformUpsampling_,
                                             [](const auto& p) { return !p.get(); });
@@ -146,19 +159,30 @@ DistanceTransformRAM::DistanceTransformRAM()
 DistanceTransformRAM::~DistanceTransformRAM() = default;
 
 void DistanceTransformRAM::process() {
+    using Result = std::pair<std::shared_ptr<Volume>, std::shared_ptr<Volume>>;
+
     auto calc = [upsample = uniformUpsampling_.get() ? size3_t(upsampleFactorUniform_.get())
                                                      : upsampleFactorVec3_.get(),
                  threshold = threshold_.get(), normalize = normalize_.get(), flip = flip_.get(),
                  square = resultSquaredDist_.get(), scale = resultDistScale_.get(),
+                 signedDist = resultSignedDist_.get(), closest = closestFeature_.isConnected(),
                  dataRangeMode = dataRangeMode_.get(), customDataRange = customDataRange_.get(),
-                 volume =
-                     volumePort_.getData()](pool::Progress fprogress) -> std::shared_ptr<Volume> {
+                 volume = volumePort_.getData(),
+                 volumePool = volumePool_](pool::Stop stop, pool::Progress fprogress) -> Result {
         auto volDim = glm::max(volume->getDimensions(), size3_t(1u));
-        auto dstRepr = std::make_shared<VolumeRAMPrecision<float>>(upsample * volDim);
+        auto dstRepr = volumePool->getTyped<float>(upsample * volDim);
+        auto closestRepr =
+            closest ? volumePool->getTyped<std::uint32_t>(upsample * volDim) : nullptr;
 
         const auto progress = [&](double f) { fprogress(static_cast<float>(f)); };
-        util::volumeDistanceTransform(volume.get(), dstRepr.get(), upsample, threshold, normalize,
-                                      flip, square, scale, progress);
+        util::DistanceTransformOptions options;
+        options.signedDistance = signedDist;
+        options.stop = [&stop]() -> bool { return stop; };
+        if (!util::volumeDistanceTransform(volume.get(), dstRepr.get(), closestRepr.get(), upsample,
+                                           threshold, normalize, flip, square, scale, progress,
+                                           options)) {
+            return {};
+        }
 
         auto dstVol = std::make_shared<Volume>(*volume, noData);
         dstVol->addRepresentation(dstRepr);
@@ -170,8 +194,9 @@ void DistanceTransformRAM::process() {
                 const auto basis = volume->getBasis();
                 const auto diagonal = basis[0] + basis[1] + basis[2];
                 const auto maxDist = square ? glm::length2(diagonal) : glm::length(diagonal);
-                dstVol->dataMap_.dataRange = dvec2(0.0, maxDist);
-                dstVol->dataMap_.valueRange = dvec2(0.0, maxDist);
+                const auto minDist = signedDist ? -maxDist : 0.0;
+                dstVol->dataMap_.dataRange = dvec2(minDist, maxDist);
+                dstVol->dataMap_.valueRange = dvec2(minDist, maxDist);
                 break;
             }
             case DistanceTransformRAM::DataRangeMode::MinMax: {
@@ -190,12 +215,27 @@ void DistanceTransformRAM::process() {
             default:
                 break;
         }
-        return dstVol;
+
+        std::shared_ptr<Volume> closestVol;
+        if (closestRepr) {
+            closestRepr->setInterpolation(InterpolationType::Nearest);
+            closestVol = std::make_shared<Volume>(*volume, noData);
+            closestVol->addRepresentation(closestRepr);
+            closestVol->dataMap_.valueAxis.name = "closest feature";
+            closestVol->dataMap_.valueAxis.unit = Unit{};
+            const dvec2 range{0.0, static_cast<double>(glm::compMul(volDim) - 1)};
+            closestVol->dataMap_.dataRange = range;
+            closestVol->dataMap_.valueRange = range;
+        }
+
+        return {dstVol, closestVol};
     };
 
     outport_.setData(nullptr);
-    dispatchOne(calc, [this](std::shared_ptr<Volume> result) {
-        outport_.setData(result);
+    closestFeature_.setData(nullptr);
+    dispatchOne(calc, [this](Result result) {
+        outport_.setData(result.first);
+        closestFeature_.setData(result.second);
         newResults();
     });
 }
@@ -0,0 +1,78 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <modules/base/processors/imagecompositeram.h>
+
+#include <inviwo/core/algorithm/markdown.h>                 // for operator""_help, operator"...
+#include <inviwo/core/datastructures/image/image.h>         // for Image
+#include <inviwo/core/ports/imageport.h>                    // for ImageInport, ImageOutport
+#include <inviwo/core/processors/processor.h>               // for Processor
+#include <inviwo/core/processors/processorinfo.h>           // for ProcessorInfo
+#include <inviwo/core/processors/processorstate.h>          // for CodeState, CodeState::Stable
+#include <inviwo/core/processors/processortags.h>           // for Tags
+#include <modules/base/algorithm/image/imagecompositing.h>  // for compositeImages
+#include <modules/base/datastructures/imagereusecache.h>    // for ImageReuseCache
+
+#include <memory>       // for shared_ptr
+#include <string>       // for string
+#include <string_view>  // for string_view
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo ImageCompositeRAM::processorInfo_{
+    "org.inviwo.ImageCompositeRAM",  // Class identifier
+    "Image Composite CPU",           // Display name
+    "Image Operation",               // Category
+    CodeState::Stable,               // Code state
+    "CPU, Image, Composite",         // Tags
+    R"(
+    Depth based compositing of two images, including the depth and picking layers, on the CPU.
+    For each pixel the fragment closest to the viewer is blended over the other one, matching
+    the Image Composite processor. Runs in parallel over bands of rows and does not require
+    OpenGL.
+    )"_unindentHelp};
+const ProcessorInfo ImageCompositeRAM::getProcessorInfo() const { return processorInfo_; }
+
+ImageCompositeRAM::ImageCompositeRAM()
+    : Processor()
+    , imageInport1_("imageInport1", "First image"_help)
+    , imageInport2_("imageInport2", "Second image"_help)
+    , outport_("outport", "Composited image"_help) {
+
+    addPorts(imageInport1_, imageInport2_, outport_);
+}
+
+void ImageCompositeRAM::process() {
+    auto image = cache_.getUnused(outport_.getDimensions(), outport_.getDataFormat());
+    util::compositeImages(*imageInport1_.getData(), *imageInport2_.getData(), *image);
+    outport_.setData(image);
+    cache_.add(image);
+}
+
+}  // namespace inviwo
@@ -34,6 +34,7 @@
 #include <inviwo/core/interaction/events/resizeevent.h>  // for ResizeEvent
 #include <inviwo/core/io/datawriter.h>                   // for DataWriterType
 #include <inviwo/core/io/datawriterexception.h>          // for DataWriterException
+#include <inviwo/core/io/layerwritequeue.h>              // for LayerWriteQueue
 #include <inviwo/core/network/networkutils.h>            // for getSuccessors
 #include <inviwo/core/network/portconnection.h>          // for PortConnection
 #include <inviwo/core/network/processornetwork.h>        // for ProcessorNetwork
@@ -47,9 +48,11 @@
 #include <inviwo/core/properties/boolproperty.h>         // for BoolProperty
 #include <inviwo/core/properties/ordinalproperty.h>      // for IntSize2Property, OrdinalProperty
 #include <inviwo/core/util/glmvec.h>                     // for size2_t, uvec3
+#include <inviwo/core/util/logcentral.h>                 // for log, LogLevel
 #include <inviwo/core/util/stdextensions.h>              // for contains
 #include <modules/base/processors/dataexport.h>          // for DataExport
 
+#include <filesystem>     // for path
 #include <functional>     // for __base
 #include <memory>         // for shared_ptr
 #include <string>         // for string
@@ -77,7 +80,8 @@ ImageExport::ImageExport(InviwoApplication* app)
     , outportDeterminesSize_{"outportDeterminesSize", "Let Outport Determine Size", false}
     , imageSize_{"imageSize",   "Image Size",        size2_t(1024, 1024),
                  size2_t(1, 1), size2_t(4096, 4096), size2_t(1, 1)}
-    , prevSize_{0} {
+    , prevSize_{0}
+    , queue_{app} {
 
     addProperties(outportDeterminesSize_, imageSize_);
     imageSize_.visibilityDependsOn(outportDeterminesSize_,
@@ -117,6 +121,15 @@ const Layer* ImageExport::getData() {
     return nullptr;
 }
 
+void ImageExport::write(std::unique_ptr<DataWriterType<Layer>> writer, const Layer& data,
+                        const std::filesystem::path& file) {
+    // Only the copy of the layer is made here, the image is encoded and written in the background
+    queue_.write(data, std::move(writer), file, [](const std::filesystem::path& path) {
+        util::log(IVW_CONTEXT_CUSTOM("ImageExport"), "Data exported to disk: " + path.string(),
+                  LogLevel::Info, LogAudience::User);
+    });
+}
+
 void ImageExport::onProcessorNetworkDidAddConnection(const PortConnection& con) {
     const auto successors = util::getSuccessors(con.getInport()->getProcessor());
     if (util::contains(successors, this)) {
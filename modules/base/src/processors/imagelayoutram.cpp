@@ -0,0 +1,153 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <modules/base/processors/imagelayoutram.h>
+
+#include <inviwo/core/algorithm/markdown.h>                 // for operator""_help, operator"...
+#include <inviwo/core/datastructures/image/image.h>         // for Image
+#include <inviwo/core/interaction/events/event.h>           // for Event
+#include <inviwo/core/interaction/events/resizeevent.h>     // for ResizeEvent
+#include <inviwo/core/ports/imageport.h>                    // for ImageMultiInport, ImageOutport
+#include <inviwo/core/ports/outport.h>                      // for Outport
+#include <inviwo/core/processors/processor.h>               // for Processor
+#include <inviwo/core/processors/processorinfo.h>           // for ProcessorInfo
+#include <inviwo/core/processors/processorstate.h>          // for CodeState, CodeState::Exper...
+#include <inviwo/core/processors/processortags.h>           // for Tags
+#include <inviwo/core/util/glmvec.h>                        // for ivec2, ivec4, size2_t
+#include <modules/base/algorithm/image/imagecompositing.h>  // for clearImage, drawImage
+
+#include <algorithm>    // for min
+#include <cstddef>      // for size_t
+#include <memory>       // for shared_ptr
+#include <ostream>      // for operator<<, basic_ostream
+#include <string>       // for string
+#include <string_view>  // for string_view
+
+#include <glm/common.hpp>  // for max
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo ImageLayoutRAM::processorInfo_{
+    "org.inviwo.ImageLayoutRAM",  // Class identifier
+    "Image Layout CPU",           // Display name
+    "Image Operation",            // Category
+    CodeState::Experimental,      // Code state
+    "CPU, Image, Layout",         // Tags
+    R"(
+    Puts multiple input images, including their depth and picking layers, next to each other
+    on the CPU. The output is split evenly into columns, from left to right, or rows, from top
+    to bottom, and each connected port is resized to its view. Interaction events are not
+    forwarded to the inputs. Runs in parallel over bands of rows and does not require OpenGL.
+    )"_unindentHelp};
+const ProcessorInfo ImageLayoutRAM::getProcessorInfo() const { return processorInfo_; }
+
+ImageLayoutRAM::ImageLayoutRAM()
+    : Processor()
+    , inport_("inport", "Images to put next to each other"_help)
+    , outport_("outport", "Resulting layout of the input images"_help)
+    , direction_("direction", "Direction",
+                 {{"columns", "Columns", Direction::Columns}, {"rows", "Rows", Direction::Rows}},
+                 0)
+    , currentDim_(0, 0) {
+
+    addPorts(inport_, outport_);
+    addProperty(direction_);
+
+    inport_.onConnect([this]() { resizeInports(); });
+    inport_.onDisconnect([this]() { resizeInports(); });
+    direction_.onChange([this]() { resizeInports(); });
+}
+
+std::vector<ivec4> ImageLayoutRAM::getViewports(const ivec2& dims) const {
+    const auto numViews = static_cast<int>(inport_.getConnectedOutports().size());
+
+    std::vector<ivec4> viewports;
+    for (int i = 0; i < numViews; ++i) {
+        if (direction_.get() == Direction::Columns) {
+            const int begin = i * dims.x / numViews;
+            const int end = (i + 1) * dims.x / numViews;
+            viewports.emplace_back(begin, 0, end - begin, dims.y);
+        } else {
+            const int begin = dims.y - (i + 1) * dims.y / numViews;
+            const int end = dims.y - i * dims.y / numViews;
+            viewports.emplace_back(0, begin, dims.x, end - begin);
+        }
+    }
+    return viewports;
+}
+
+void ImageLayoutRAM::resizeInports() {
+    const auto viewports = getViewports(currentDim_);
+    const auto& outports = inport_.getConnectedOutports();
+    for (size_t i = 0; i < std::min(outports.size(), viewports.size()); ++i) {
+        ResizeEvent e(size2_t(glm::max(ivec2(viewports[i].z, viewports[i].w), ivec2(1))));
+        outports[i]->propagateEvent(&e, &inport_);
+    }
+}
+
+void ImageLayoutRAM::propagateEvent(Event* event, Outport*) {
+    if (event->hasVisitedProcessor(this)) return;
+    event->markAsVisited(this);
+
+    invokeEvent(event);
+    if (event->hasBeenUsed()) return;
+
+    if (event->hash() == ResizeEvent::chash()) {
+        currentDim_ = ivec2(static_cast<ResizeEvent*>(event)->size());
+        resizeInports();
+    }
+}
+
+void ImageLayoutRAM::process() {
+    const auto images = inport_.getVectorData();
+    const ivec2 dims(outport_.getDimensions());
+
+    auto image = cache_.getUnused(outport_.getDimensions(), outport_.getDataFormat());
+    util::clearImage(*image);
+
+    const auto viewports = getViewports(dims);
+    for (size_t i = 0; i < std::min(images.size(), viewports.size()); ++i) {
+        util::drawImage(*images[i], *image, viewports[i]);
+    }
+
+    outport_.setData(image);
+    cache_.add(image);
+}
+
+std::ostream& operator<<(std::ostream& ss, ImageLayoutRAM::Direction d) {
+    switch (d) {
+        case ImageLayoutRAM::Direction::Columns:
+            return ss << "Columns";
+        case ImageLayoutRAM::Direction::Rows:
+            return ss << "Rows";
+    }
+    return ss;
+}
+
+}  // namespace inviwo
@@ -0,0 +1,171 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <modules/base/processors/imageoverlayram.h>
+
+#include <inviwo/core/algorithm/markdown.h>                 // for operator""_help, operator"...
+#include <inviwo/core/datastructures/image/image.h>         // for Image
+#include <inviwo/core/interaction/events/event.h>           // for Event
+#include <inviwo/core/interaction/events/resizeevent.h>     // for ResizeEvent
+#include <inviwo/core/ports/imageport.h>                    // for ImageInport, ImageOutport
+#include <inviwo/core/processors/processor.h>               // for Processor
+#include <inviwo/core/processors/processorinfo.h>           // for ProcessorInfo
+#include <inviwo/core/processors/processorstate.h>          // for CodeState, CodeState::Exper...
+#include <inviwo/core/processors/processortags.h>           // for Tags
+#include <inviwo/core/properties/invalidationlevel.h>       // for InvalidationLevel
+#include <inviwo/core/properties/propertysemantics.h>       // for PropertySemantics
+#include <inviwo/core/util/glmvec.h>                        // for vec2, ivec2, ivec4, vec4
+#include <modules/base/algorithm/image/imagecompositing.h>  // for drawImage, fillImage
+
+#include <memory>       // for shared_ptr
+#include <string>       // for string
+#include <string_view>  // for string_view
+
+#include <glm/common.hpp>  // for max
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo ImageOverlayRAM::processorInfo_{
+    "org.inviwo.ImageOverlayRAM",  // Class identifier
+    "Image Overlay CPU",           // Display name
+    "Image Operation",             // Category
+    CodeState::Experimental,       // Code state
+    "CPU, Image, Overlay",         // Tags
+    R"(
+    Places an overlay image, including its depth and picking layers, on top of the input image
+    on the CPU. Position and size are given relative to the output, the anchor determines which
+    point of the overlay is placed at the position. The overlay port is resized to the size of
+    the overlay. Runs in parallel over bands of rows and does not require OpenGL.
+    )"_unindentHelp};
+const ProcessorInfo ImageOverlayRAM::getProcessorInfo() const { return processorInfo_; }
+
+ImageOverlayRAM::ImageOverlayRAM()
+    : Processor()
+    , inport_("inport", "Input image"_help)
+    , overlayPort_("overlay", "Image placed on top of the input"_help)
+    , outport_("outport", "Input image with the overlay"_help)
+    , enabled_("enabled", "Overlay Enabled", true)
+    , position_("position", "Position", vec2(0.25f), vec2(0.0f), vec2(1.0f), vec2(0.01f))
+    , size_("size", "Size", vec2(0.48f), vec2(0.0f), vec2(1.0f), vec2(0.01f))
+    , anchor_("anchor", "Anchor", vec2(0.0f), vec2(-1.0f), vec2(1.0f), vec2(0.01f))
+    , blendMode_("blendMode", "Blending Mode",
+                 {{"replace", "Replace", ImageBlendMode::Replace},
+                  {"over", "Blend", ImageBlendMode::Over}},
+                 1)
+    , border_("border", "Border", true)
+    , borderColor_("borderColor", "Color", vec4(0.0f, 0.0f, 0.0f, 1.0f), vec4(0.0f), vec4(1.0f))
+    , borderWidth_("borderWidth", "Width", 2, 0, 100)
+    , currentDim_(0, 0) {
+
+    overlayPort_.setOptional(true);
+    addPorts(inport_, overlayPort_, outport_);
+
+    borderColor_.setSemantics(PropertySemantics::Color);
+    border_.addProperties(borderColor_, borderWidth_);
+    addProperties(enabled_, position_, size_, anchor_, blendMode_, border_);
+
+    overlayPort_.onConnect([this]() { updateOverlaySize(); });
+    position_.onChange([this]() { updateOverlaySize(); });
+    size_.onChange([this]() { updateOverlaySize(); });
+    anchor_.onChange([this]() { updateOverlaySize(); });
+}
+
+ivec4 ImageOverlayRAM::getViewport(const ivec2& dims) const {
+    const vec2 viewDim(dims);
+    vec2 pos = position_.get() * viewDim;
+    const vec2 size = size_.get() * viewDim;
+
+    // consider anchor position
+    const vec2 shift = 0.5f * size * (anchor_.get() + vec2(1.0f, 1.0f));
+    pos.x -= shift.x;
+    // negate y axis
+    pos.y = viewDim.y - (pos.y + shift.y);
+
+    // use pixel aligned positions
+    return ivec4(pos.x, pos.y, size.x, size.y);
+}
+
+void ImageOverlayRAM::updateOverlaySize() {
+    if (!overlayPort_.isConnected()) return;
+
+    const ivec4 viewport = getViewport(currentDim_);
+    ResizeEvent e(size2_t(glm::max(ivec2(viewport.z, viewport.w), ivec2(1))));
+    overlayPort_.propagateEvent(&e, overlayPort_.getConnectedOutport());
+}
+
+void ImageOverlayRAM::propagateEvent(Event* event, Outport* source) {
+    if (event->hasVisitedProcessor(this)) return;
+    event->markAsVisited(this);
+
+    invokeEvent(event);
+    if (event->hasBeenUsed()) return;
+
+    if (event->hash() == ResizeEvent::chash()) {
+        auto resizeEvent = static_cast<ResizeEvent*>(event);
+
+        currentDim_ = ivec2(resizeEvent->size());
+        inport_.propagateEvent(resizeEvent);
+        updateOverlaySize();
+    } else if (event->shouldPropagateTo(&inport_, this, source)) {
+        inport_.propagateEvent(event);
+    }
+}
+
+void ImageOverlayRAM::process() {
+    if (!enabled_.get() || !overlayPort_.isReady()) {
+        outport_.setData(inport_.getData());
+        return;
+    }
+
+    const auto input = inport_.getData();
+    const ivec2 dims(input->getDimensions());
+
+    auto image = cache_.getUnused(input->getDimensions(), input->getDataFormat());
+    util::drawImage(*input, *image, ivec4(0, 0, dims));
+
+    const ivec4 viewport = getViewport(dims);
+    if (border_.isChecked() && borderWidth_.get() > 0) {
+        // draw the border as four strips around the viewport
+        const int w = borderWidth_.get();
+        const vec4 color = borderColor_.get();
+        const auto mode = blendMode_.get();
+        const ivec4 outer = viewport + ivec4(-w, -w, 2 * w, 2 * w);
+        util::fillImage(*image, ivec4(outer.x, outer.y, outer.z, w), color, mode);
+        util::fillImage(*image, ivec4(outer.x, viewport.y + viewport.w, outer.z, w), color, mode);
+        util::fillImage(*image, ivec4(outer.x, viewport.y, w, viewport.w), color, mode);
+        util::fillImage(*image, ivec4(viewport.x + viewport.z, viewport.y, w, viewport.w), color,
+                        mode);
+    }
+    util::drawImage(*overlayPort_.getData(), *image, viewport, blendMode_.get());
+
+    outport_.setData(image);
+    cache_.add(image);
+}
+
+}  // namespace inviwo
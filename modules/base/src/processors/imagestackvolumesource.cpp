@@ -39,7 +39,7 @@
 #include <inviwo/core/io/datareaderexception.h>                         // for DataReaderException
 #include <inviwo/core/io/datareaderfactory.h>                           // for DataReaderFactory
 #include <inviwo/core/ports/volumeport.h>                               // for VolumeOutport
-#include <inviwo/core/processors/processor.h>                           // for Processor
+#include <inviwo/core/processors/poolprocessor.h>                       // for PoolProcessor
 #include <inviwo/core/processors/processorinfo.h>                       // for ProcessorInfo
 #include <inviwo/core/processors/processorstate.h>                      // for CodeState, CodeSt...
 #include <inviwo/core/processors/processortags.h>                       // for Tags
@@ -47,25 +47,26 @@
 #include <inviwo/core/properties/buttonproperty.h>                      // for ButtonProperty
 #include <inviwo/core/properties/filepatternproperty.h>                 // for FilePatternProperty
 #include <inviwo/core/properties/property.h>                            // for OverwriteState
+#include <inviwo/core/util/dataconversion.h>                            // for convertDataNormal...
 #include <inviwo/core/util/exception.h>                                 // for Exception
 #include <inviwo/core/util/fileextension.h>                             // for FileExtension
+#include <inviwo/core/util/foreach.h>                                   // for forEachChunkPa...
 #include <inviwo/core/util/formatdispatching.h>                         // for PrecisionValueType
 #include <inviwo/core/util/formats.h>                                   // for DataFormat, DataF...
-#include <inviwo/core/util/glmconvert.h>                                // for glm_convert_norma...
 #include <inviwo/core/util/glmvec.h>                                    // for vec3, dvec2, size2_t
 #include <inviwo/core/util/logcentral.h>                                // for LogCentral, LogPr...
-#include <inviwo/core/util/raiiutils.h>                                 // for OnScopeExit, OnSc...
 #include <inviwo/core/util/sourcecontext.h>                             // for IVW_CONTEXT
 #include <inviwo/core/util/statecoordinator.h>                          // for StateCoordinator
-#include <inviwo/core/util/zip.h>                                       // for zipper, enumerate
 #include <modules/base/properties/basisproperty.h>                      // for BasisProperty
 #include <modules/base/properties/volumeinformationproperty.h>          // for VolumeInformation...
 
 #include <algorithm>      // for fill, transform
+#include <atomic>         // for atomic
 #include <cstddef>        // for size_t
 #include <functional>     // for __base
 #include <iterator>       // for back_insert_iterator
 #include <map>            // for map, operator!=
+#include <mutex>          // for mutex, scoped_lock
 #include <string_view>    // for string_view
 #include <type_traits>    // for integral_constant
 #include <unordered_set>  // for unordered_set
@@ -96,6 +97,139 @@ struct FloatOrIntMax32
     : std::integral_constant<bool, Format::numtype == NumericType::Float || Format::compsize <= 4> {
 };
 
+using Slice = std::pair<std::filesystem::path, std::unique_ptr<DataReaderType<Layer>>>;
+
+struct LoadResult {
+    std::shared_ptr<Volume> volume;
+    std::vector<std::string> warnings;
+};
+
+bool isSupportedFormat(const DataFormatBase* format) {
+    return format->getNumericType() == NumericType::Float || format->getPrecision() <= 32;
+}
+
+/*
+ * Decode all slices on the thread pool. The slices are split into contiguous ranges, and each job
+ * decodes one image at a time directly into its z-slab of the volume. Hence at most one decoded
+ * image per thread is kept in memory.
+ */
+LoadResult load(const std::vector<Slice>& slices, const std::filesystem::path& pattern,
+                pool::Stop stop, pool::Progress progress) {
+    constexpr std::string_view context = "ImageStackVolumeSource";
+
+    // identify first slice with a reader
+    const auto first = std::find_if(slices.begin(), slices.end(),
+                                    [](auto& item) { return item.second != nullptr; });
+    if (first == slices.end()) {  // could not find any suitable data reader for the images
+        throw Exception(fmt::format("No supported images found in '{}'", pattern),
+                        IVW_CONTEXT_CUSTOM(context));
+    }
+    const auto firstIndex = static_cast<size_t>(std::distance(slices.begin(), first));
+
+    const std::shared_ptr<Layer> referenceLayer = first->second->readData(first->first);
+
+    // Call getRepresentation here to enforce creating a ram representation.
+    // Otherwise the default image size, i.e. 256x256, will be reported since the LayerDisk
+    // does not provide meta data for all image formats.
+    const auto referenceRAM = referenceLayer->getRepresentation<LayerRAM>();
+    if (glm::compMul(referenceRAM->getDimensions()) == 0) {
+        throw Exception(
+            fmt::format("Could not extract valid image dimensions from {}", first->first),
+            IVW_CONTEXT_CUSTOM(context));
+    }
+
+    const auto refFormat = referenceRAM->getDataFormat();
+    if (!isSupportedFormat(refFormat)) {
+        throw DataReaderException(
+            fmt::format("Unsupported integer bit depth ({})", refFormat->getPrecision()),
+            IVW_CONTEXT_CUSTOM(context));
+    }
+
+    return referenceRAM->dispatch<LoadResult, FloatOrIntMax32>([&](auto reflayerprecision) {
+        using ValueType = util::PrecisionValueType<decltype(reflayerprecision)>;
+        using PrimitiveType = typename DataFormat<ValueType>::primitive;
+
+        const size2_t layerDims = reflayerprecision->getDimensions();
+        const size_t sliceOffset = glm::compMul(layerDims);
+
+        // create matching volume representation
+        auto volumeRAM =
+            std::make_shared<VolumeRAMPrecision<ValueType>>(size3_t{layerDims, slices.size()});
+        auto volData = volumeRAM->getDataTyped();
+
+        // one entry per slice, the jobs never write to the same element
+        std::vector<std::string> warnings(slices.size());
+
+        const auto loadSlice = [&](size_t slice) {
+            const auto dest = volData + slice * sliceOffset;
+            const auto fill = [&]() { std::fill(dest, dest + sliceOffset, ValueType{0}); };
+
+            const auto& [file, reader] = slices[slice];
+            if (!reader) return fill();
+
+            std::shared_ptr<Layer> layer;
+            if (slice == firstIndex) {
+                layer = referenceLayer;
+            } else {
+                try {
+                    layer = reader->readData(file);
+                } catch (DataReaderException const& e) {
+                    warnings[slice] =
+                        fmt::format("Could not load image: {}, {}", file, e.getMessage());
+                    return fill();
+                }
+            }
+            const auto layerRAM = layer->template getRepresentation<LayerRAM>();
+
+            const auto format = layerRAM->getDataFormat();
+            if (!isSupportedFormat(format)) {
+                warnings[slice] = fmt::format("Unsupported integer bit depth: {}, for image: {}",
+                                              format->getPrecision(), file);
+                return fill();
+            }
+
+            if (layerRAM->getDimensions() != layerDims) {
+                warnings[slice] =
+                    fmt::format("Unexpected dimensions: {}, expected: {}, for image: {}",
+                                layerRAM->getDimensions(), layerDims, file);
+                return fill();
+            }
+            layerRAM->template dispatch<void, FloatOrIntMax32>([&](auto layerpr) {
+                util::convertDataNormalized(layerpr->getDataTyped(), dest, sliceOffset);
+            });
+        };
+
+        std::atomic<size_t> finished{0};
+        std::mutex progressMutex;
+        util::forEachChunkParallel(
+            slices.size(), util::parallelChunkCount(slices.size(), 1),
+            [&](size_t, size_t begin, size_t end) {
+                for (size_t slice = begin; slice < end; ++slice) {
+                    if (stop) return;
+                    loadSlice(slice);
+
+                    const auto count = ++finished;
+                    const std::scoped_lock lock{progressMutex};
+                    progress(count, slices.size());
+                }
+            });
+        if (stop) return LoadResult{};
+
+        auto volume = std::make_shared<Volume>(volumeRAM);
+        volume->dataMap_.dataRange =
+            dvec2{DataFormat<PrimitiveType>::lowest(), DataFormat<PrimitiveType>::max()};
+        volume->dataMap_.valueRange =
+            dvec2{DataFormat<PrimitiveType>::lowest(), DataFormat<PrimitiveType>::max()};
+
+        const auto size = vec3(0.01f) * static_cast<vec3>(volumeRAM->getDimensions());
+        volume->setBasis(glm::diagonal3x3(size));
+        volume->setOffset(-0.5 * size);
+
+        std::erase_if(warnings, [](const std::string& warning) { return warning.empty(); });
+        return LoadResult{volume, std::move(warnings)};
+    });
+}
+
 }  // namespace
 
 // The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
@@ -109,7 +243,7 @@ const ProcessorInfo ImageStackVolumeSource::processorInfo_{
 const ProcessorInfo ImageStackVolumeSource::getProcessorInfo() const { return processorInfo_; }
 
 ImageStackVolumeSource::ImageStackVolumeSource(InviwoApplication* app)
-    : Processor()
+    : PoolProcessor()
     , outport_("volume")
     , filePattern_("filePattern", "File Pattern", "####.jpeg", "")
     , reload_("reload", "Reload data")
@@ -139,159 +273,62 @@ void ImageStackVolumeSource::addFileNameFilters() {
 }
 
 void ImageStackVolumeSource::process() {
-    util::OnScopeExit guard{[&]() { outport_.setData(nullptr); }};
-
     if (filePattern_.isModified() || reload_.isModified() || skipUnsupportedFiles_.isModified()) {
-        volume_ = load();
-        if (volume_) {
-            basis_.updateForNewEntity(*volume_, deserialized_);
-            const auto overwrite =
-                deserialized_ ? util::OverwriteState::Yes : util::OverwriteState::No;
-            information_.updateForNewVolume(*volume_, overwrite);
+        const auto files = filePattern_.getFileList();
+
+        std::vector<Slice> slices;
+        slices.reserve(files.size());
+        std::transform(files.begin(), files.end(), std::back_inserter(slices),
+                       [&](const auto& file) -> Slice {
+                           return {file, readerFactory_->getReaderForTypeAndExtension<Layer>(
+                                             filePattern_.getSelectedExtension(), file)};
+                       });
+        if (skipUnsupportedFiles_) {
+            std::erase_if(slices, [](auto& elem) { return elem.second == nullptr; });
         }
-        deserialized_ = false;
-    }
 
-    if (volume_) {
-        basis_.updateEntity(*volume_);
-        information_.updateVolume(*volume_);
-    }
-    outport_.setData(volume_);
-    guard.release();
-}
-
-bool ImageStackVolumeSource::isValidImageFile(std::string fileName) {
-    return readerFactory_->hasReaderForTypeAndExtension<Layer>(fileName);
-}
-
-std::shared_ptr<Volume> ImageStackVolumeSource::load() {
-    const auto files = filePattern_.getFileList();
-    if (files.empty()) {
-        return nullptr;
-    }
-
-    std::vector<std::pair<std::filesystem::path, std::unique_ptr<DataReaderType<Layer>>>> slices;
-    slices.reserve(files.size());
-
-    std::transform(files.begin(), files.end(), std::back_inserter(slices),
-                   [&](const auto& file)
-                       -> std::pair<std::filesystem::path, std::unique_ptr<DataReaderType<Layer>>> {
-                       return {file, std::move(readerFactory_->getReaderForTypeAndExtension<Layer>(
-                                         filePattern_.getSelectedExtension(), file))};
-                   });
-    if (skipUnsupportedFiles_) {
-        slices.erase(std::remove_if(slices.begin(), slices.end(),
-                                    [](auto& elem) { return elem.second == nullptr; }),
-                     slices.end());
+        outport_.clear();
+        volume_.reset();
+        if (slices.empty()) return;
+
+        dispatchOne(
+            [slices = std::move(slices), pattern = filePattern_.getFilePatternPath()](
+                pool::Stop stop, pool::Progress progress) {
+                return load(slices, pattern, stop, progress);
+            },
+            [this](LoadResult result) {
+                for (const auto& warning : result.warnings) LogProcessorWarn(warning);
+
+                volume_ = result.volume;
+                if (volume_) {
+                    basis_.updateForNewEntity(*volume_, deserialized_);
+                    const auto overwrite =
+                        deserialized_ ? util::OverwriteState::Yes : util::OverwriteState::No;
+                    information_.updateForNewVolume(*volume_, overwrite);
+                }
+                deserialized_ = false;
+                setVolume(volume_);
+                newResults();
+            });
+        return;
     }
 
-    // identify first slice with a reader
-    const auto first = std::find_if(slices.begin(), slices.end(),
-                                    [](auto& item) { return item.second != nullptr; });
-    if (first == slices.end()) {  // could not find any suitable data reader for the images
-        throw Exception(
-            fmt::format("No supported images found in '{}'", filePattern_.getFilePatternPath()),
-            IVW_CONTEXT);
-    }
+    // A new volume is being loaded, the outport will be set once it is done
+    if (hasJobs()) return;
 
-    const auto referenceLayer = first->second->readData(first->first);
+    setVolume(volume_);
+}
 
-    // Call getRepresentation here to enforce creating a ram representation.
-    // Otherwise the default image size, i.e. 256x256, will be reported since the LayerDisk
-    // does not provide meta data for all image formats.
-    const auto referenceRAM = referenceLayer->getRepresentation<LayerRAM>();
-    if (glm::compMul(referenceRAM->getDimensions()) == 0) {
-        throw Exception(
-            fmt::format("Could not extract valid image dimensions from {}", first->first),
-            IVW_CONTEXT);
+void ImageStackVolumeSource::setVolume(std::shared_ptr<Volume> volume) {
+    if (volume) {
+        basis_.updateEntity(*volume);
+        information_.updateVolume(*volume);
     }
+    outport_.setData(volume);
+}
 
-    const auto refFormat = referenceRAM->getDataFormat();
-    if ((refFormat->getNumericType() != NumericType::Float) && (refFormat->getPrecision() > 32)) {
-        throw DataReaderException(
-            fmt::format("Unsupported integer bit depth ({})", refFormat->getPrecision()),
-            IVW_CONTEXT);
-    }
-
-    return referenceRAM->dispatch<std::shared_ptr<Volume>, FloatOrIntMax32>(
-        [&](auto reflayerprecision) {
-            using ValueType = util::PrecisionValueType<decltype(reflayerprecision)>;
-            using PrimitiveType = typename DataFormat<ValueType>::primitive;
-
-            const size2_t layerDims = reflayerprecision->getDimensions();
-            const size_t sliceOffset = glm::compMul(layerDims);
-
-            // create matching volume representation
-            auto volumeRAM =
-                std::make_shared<VolumeRAMPrecision<ValueType>>(size3_t{layerDims, slices.size()});
-            auto volData = volumeRAM->getDataTyped();
-
-            const auto fill = [&](size_t s) {
-                std::fill(volData + s * sliceOffset, volData + (s + 1) * sliceOffset, ValueType{0});
-            };
-
-            const auto read = [&](const auto& file, auto reader) -> std::shared_ptr<Layer> {
-                try {
-                    return reader->readData(file);
-                } catch (DataReaderException const& e) {
-                    LogProcessorWarn(
-                        fmt::format("Could not load image: {}, {}", file, e.getMessage()));
-                    return nullptr;
-                }
-            };
-
-            for (auto&& elem : util::enumerate(slices)) {
-                const auto slice = elem.first();
-                const auto file = elem.second().first;
-                const auto reader = elem.second().second.get();
-                if (!reader) {
-                    fill(slice);
-                    continue;
-                }
-
-                const auto layer = read(file, reader);
-                if (!layer) {
-                    fill(slice);
-                    continue;
-                }
-                const auto layerRAM = layer->template getRepresentation<LayerRAM>();
-
-                const auto format = layerRAM->getDataFormat();
-                if ((format->getNumericType() != NumericType::Float) &&
-                    (format->getPrecision() > 32)) {
-                    LogProcessorWarn(fmt::format("Unsupported integer bit depth: {}, for image: {}",
-                                                 format->getPrecision(), file));
-                    fill(slice);
-                    continue;
-                }
-
-                if (layerRAM->getDimensions() != layerDims) {
-                    LogProcessorWarn(
-                        fmt::format("Unexpected dimensions: {}, expected: {}, for image: {}",
-                                    layer->getDimensions(), layerDims, file));
-                    fill(slice);
-                    continue;
-                }
-                layerRAM->template dispatch<void, FloatOrIntMax32>([&](auto layerpr) {
-                    const auto data = layerpr->getDataTyped();
-                    std::transform(
-                        data, data + sliceOffset, volData + slice * sliceOffset,
-                        [](auto value) { return util::glm_convert_normalized<ValueType>(value); });
-                });
-            }
-
-            auto volume = std::make_shared<Volume>(volumeRAM);
-            volume->dataMap_.dataRange =
-                dvec2{DataFormat<PrimitiveType>::lowest(), DataFormat<PrimitiveType>::max()};
-            volume->dataMap_.valueRange =
-                dvec2{DataFormat<PrimitiveType>::lowest(), DataFormat<PrimitiveType>::max()};
-
-            const auto size = vec3(0.01f) * static_cast<vec3>(volumeRAM->getDimensions());
-            volume->setBasis(glm::diagonal3x3(size));
-            volume->setOffset(-0.5 * size);
-
-            return volume;
-        });
+bool ImageStackVolumeSource::isValidImageFile(std::string fileName) {
+    return readerFactory_->hasReaderForTypeAndExtension<Layer>(fileName);
 }
 
 void ImageStackVolumeSource::deserialize(Deserializer& d) {
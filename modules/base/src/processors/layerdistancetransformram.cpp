@@ -30,6 +30,7 @@
 #include <modules/base/processors/layerdistancetransformram.h>
 
 #include <inviwo/core/datastructures/image/image.h>                  // for Image
+#include <inviwo/core/datastructures/image/imagetypes.h>             // for InterpolationType
 #include <inviwo/core/datastructures/image/layer.h>                  // for Layer
 #include <inviwo/core/datastructures/image/layerram.h>               // for LayerRAMPrecision
 #include <inviwo/core/ports/imageport.h>                             // for ImageOutport, ImageI...
@@ -38,18 +39,21 @@
 #include <inviwo/core/processors/processorstate.h>                   // for CodeState, CodeState...
 #include <inviwo/core/processors/processortags.h>                    // for Tags, Tags::CPU
 #include <inviwo/core/properties/boolproperty.h>                     // for BoolProperty
+#include <inviwo/core/properties/invalidationlevel.h>                // for InvalidationLevel
 #include <inviwo/core/properties/ordinalproperty.h>                  // for IntProperty, IntSize...
 #include <inviwo/core/util/formats.h>                                // for DataFormat, DataVec4...
 #include <inviwo/core/util/glmvec.h>                                 // for size2_t, size3_t
 #include <modules/base/algorithm/image/layerramdistancetransform.h>  // for layerDistanceTransform
-#include <modules/base/datastructures/imagereusecache.h>             // for ImageReuseCache
+#include <modules/base/datastructures/representationpool.h>          // for LayerRAMPool
 
+#include <cstdint>      // for uint32_t
 #include <functional>   // for __base
 #include <memory>       // for shared_ptr, shared_p...
 #include <ostream>      // for operator<<
 #include <string>       // for string
 #include <string_view>  // for string_view
 #include <type_traits>  // for remove_extent_t
+#include <utility>      // for pair
 
 #include <glm/common.hpp>              // for max
 #include <glm/gtx/component_wise.hpp>  // for compMax, compMul
@@ -71,11 +75,14 @@ LayerDistanceTransformRAM::LayerDistanceTransformRAM()
     : PoolProcessor()
     , imagePort_("inputImage")
     , outport_("outputImage", DataVec4UInt8::get(), false)
+    , closestFeature_("closestFeature", DataUInt32::get(), false)
+    , layerPool_(std::make_shared<LayerRAMPool>())
     , threshold_("threshold", "Threshold", 0.5, 0.0, 1.0)
     , flip_("flip", "Flip", false)
     , normalize_("normalize", "Use normalized threshold", true)
     , resultDistScale_("distScale", "Scaling Factor", 1.0f, 0.0f, 1.0e3, 0.05f)
     , resultSquaredDist_("distSquared", "Squared Distance", false)
+    , resultSignedDist_("distSigned", "Signed Distance", false)
     , uniformUpsampling_("uniformUpsampling", "Uniform Upsampling", false)
     , upsampleFactorUniform_("upsampleFactorUniform", "Sampling Factor", 1, 1, 10)
     , upsampleFactorVec2_("upsampleFactorVec2", "Sampling Factor", size2_t(1), size2_t(1),
@@ -83,9 +90,13 @@ LayerDistanceTransformRAM::LayerDistanceTransformRAM()
 
     addPort(imagePort_);
     addPort(outport_);
+    addPort(closestFeature_);
+    // the closest feature is only computed when needed
+    closestFeature_.onConnect([this]() { invalidate(InvalidationLevel::InvalidOutput); });
 
     addProperties(threshold_, flip_, normalize_, resultDistScale_, resultSquaredDist_,
-                  uniformUpsampling_, upsampleFactorVec2_, upsampleFactorUniform_);
+                  resultSignedDist_, uniformUpsampling_, upsampleFactorVec2_,
+                  upsampleFactorUniform_);
 
     upsampleFactorVec2_.visibilityDependsOn(uniformUpsampling_,
                                             [](const auto& p) { return !p.get(); });
@@ -96,32 +107,53 @@ LayerDistanceTransformRAM::LayerDistanceTransformRAM()
 LayerDistanceTransformRAM::~LayerDistanceTransformRAM() = default;
 
 void LayerDistanceTransformRAM::process() {
+    using Result = std::pair<std::shared_ptr<Image>, std::shared_ptr<Image>>;
+
     const auto calc = [image = imagePort_.getData(),
                        upsample = uniformUpsampling_.get() ? size3_t(upsampleFactorUniform_.get())
                                                            : upsampleFactorVec2_.get(),
                        threshold = threshold_.get(), normalize = normalize_.get(),
                        flip = flip_.get(), square = resultSquaredDist_.get(),
-                       scale = resultDistScale_.get(),
-                       &cache = imageCache_](pool::Progress progress) -> std::shared_ptr<Image> {
+                       scale = resultDistScale_.get(), signedDist = resultSignedDist_.get(),
+                       closest = closestFeature_.isConnected(),
+                       layerPool = layerPool_](pool::Stop stop, pool::Progress progress) -> Result {
         auto imgDim = glm::max(image->getDimensions(), size2_t(1u));
 
-        auto [dstImage, dstRepr] = cache.getTypedUnused<float>(upsample * imgDim);
-
-        // pass meta data on
-        dstImage->getColorLayer()->setModelMatrix(image->getColorLayer()->getModelMatrix());
-        dstImage->getColorLayer()->setWorldMatrix(image->getColorLayer()->getWorldMatrix());
-        dstImage->copyMetaDataFrom(*image);
+        auto dstRepr = layerPool->getTyped<float>(upsample * imgDim);
+        auto closestRepr =
+            closest ? layerPool->getTyped<std::uint32_t>(upsample * imgDim) : nullptr;
 
-        util::layerDistanceTransform(image->getColorLayer(), dstRepr, upsample, threshold,
-                                     normalize, flip, square, scale, progress);
+        util::DistanceTransformOptions options;
+        options.signedDistance = signedDist;
+        options.stop = [&stop]() -> bool { return stop; };
+        if (!util::layerDistanceTransform(image->getColorLayer(), dstRepr.get(), closestRepr.get(),
+                                          upsample, threshold, normalize, flip, square, scale,
+                                          progress, options)) {
+            return {};
+        }
 
-        cache.add(dstImage);
-        return dstImage;
+        // pass meta data on
+        const auto createImage = [&](std::shared_ptr<LayerRAM> repr) {
+            auto dstImage = std::make_shared<Image>(std::make_shared<Layer>(repr));
+            dstImage->getColorLayer()->setModelMatrix(image->getColorLayer()->getModelMatrix());
+            dstImage->getColorLayer()->setWorldMatrix(image->getColorLayer()->getWorldMatrix());
+            dstImage->copyMetaDataFrom(*image);
+            return dstImage;
+        };
+
+        std::shared_ptr<Image> closestImage;
+        if (closestRepr) {
+            closestRepr->setInterpolation(InterpolationType::Nearest);
+            closestImage = createImage(closestRepr);
+        }
+        return {createImage(dstRepr), closestImage};
     };
 
     outport_.clear();
-    dispatchOne(calc, [this](std::shared_ptr<Image> result) {
-        outport_.setData(result);
+    closestFeature_.clear();
+    dispatchOne(calc, [this](Result result) {
+        outport_.setData(result.first);
+        closestFeature_.setData(result.second);
         newResults();
     });
 }
@@ -46,6 +46,7 @@
 #include <inviwo/core/properties/propertysemantics.h>                   // for PropertySemantics
 #include <inviwo/core/properties/stringproperty.h>                      // for StringProperty
 #include <inviwo/core/properties/valuewrapper.h>                        // for PropertySerializa...
+#include <inviwo/core/util/dataconversion.h>                            // for convertData, conv...
 #include <inviwo/core/util/foreacharg.h>                                // for for_each_type
 #include <inviwo/core/util/formatdispatching.h>                         // for dispatch, Precisi...
 #include <inviwo/core/util/formats.h>                                   // for DataFormatBase
@@ -54,7 +55,6 @@
 #include <inviwo/core/util/staticstring.h>                              // for operator+
 #include <modules/base/properties/datarangeproperty.h>                  // for DataRangeProperty
 
-#include <algorithm>      // for transform
 #include <limits>         // for numeric_limits
 #include <memory>         // for shared_ptr, share...
 #include <tuple>          // for tuple
@@ -88,7 +88,6 @@ struct CopyVol {
                 const auto dims = vrprecision->getDimensions();
                 const ValueType* srcData = vrprecision->getDataTyped();
                 using T = typename util::same_extent<ValueType, typename Format::type>::type;
-                using Tdouble = typename util::same_extent<ValueType, double>::type;
 
                 auto dstVol = std::make_shared<VolumeRAMPrecision<T>>(
                     dims, src->getSwizzleMask(), src->getInterpolation(), src->getWrapping());
@@ -99,17 +98,10 @@ struct CopyVol {
                         (src->getDataFormat()->getNumericType() != NumericType::Float)
                             ? src->dataMap_.dataRange
                             : dvec2{0.0, 1.0}};
-                    std::transform(srcData, srcData + glm::compMul(dims), dstData,
-                                   [srcRange, dstRange](auto& v) {
-                                       const auto result = (static_cast<Tdouble>(v) - srcRange.x) /
-                                                               (srcRange.y - srcRange.x) *
-                                                               (dstRange.y - dstRange.x) +
-                                                           dstRange.x;
-                                       return static_cast<T>(result);
-                                   });
+                    util::convertDataMapped(srcData, dstData, glm::compMul(dims), srcRange,
+                                            dstRange);
                 } else {
-                    std::transform(srcData, srcData + glm::compMul(dims), dstData,
-                                   [](auto& v) { return static_cast<T>(v); });
+                    util::convertData(srcData, dstData, glm::compMul(dims));
                 }
 
                 auto vol = std::make_shared<Volume>(dstVol);
@@ -0,0 +1,156 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/processors/volumeprogressiverefinement.h>
+
+#include <inviwo/core/datastructures/volume/volume.h>     // for Volume
+#include <inviwo/core/datastructures/volume/volumeram.h>  // for VolumeRAM
+#include <inviwo/core/ports/volumeport.h>                 // for VolumeInport, VolumeOutport
+#include <inviwo/core/processors/poolprocessor.h>         // for PoolProcessor, Progress, Stop
+#include <inviwo/core/processors/processorinfo.h>         // for ProcessorInfo
+#include <inviwo/core/processors/processorstate.h>        // for CodeState, CodeState::Experim...
+#include <inviwo/core/processors/processortags.h>         // for Tags, Tags::CPU
+#include <inviwo/core/properties/constraintbehavior.h>    // for ConstraintBehavior
+#include <inviwo/core/util/glmvec.h>                      // for size3_t
+#include <inviwo/core/util/staticstring.h>                // for operator+
+#include <modules/base/algorithm/volume/volumepyramid.h>  // for VolumePyramid, DownsampleFilter
+
+#include <algorithm>  // for min
+
+namespace inviwo {
+
+const ProcessorInfo VolumeProgressiveRefinement::processorInfo_{
+    "org.inviwo.VolumeProgressiveRefinement",  // Class identifier
+    "Volume Progressive Refinement",           // Display name
+    "Volume Operation",                        // Category
+    CodeState::Experimental,                   // Code state
+    Tags::CPU,                                 // Tags
+    R"(Outputs a level of a multi-resolution pyramid of the input volume. The pyramid is built in
+    the background and cached for as long as the input volume is alive, hence changing the level
+    or connecting several processors to the same volume will not rebuild it.
+    When progressive refinement is enabled and the pyramid is not yet available, a cheap
+    point-sampled preview at the resolution of the coarsest level is output first, followed by
+    the requested level once the pyramid is ready.)"_unindentHelp};
+const ProcessorInfo VolumeProgressiveRefinement::getProcessorInfo() const {
+    return processorInfo_;
+}
+
+namespace {
+
+std::shared_ptr<Volume> pointSample(const Volume& volume, size_t factor) {
+    auto sample = std::make_shared<Volume>(
+        util::volumePointSample(*volume.getRepresentation<VolumeRAM>(), size3_t{factor}));
+    sample->copyMetaDataFrom(volume);
+    sample->dataMap_ = volume.dataMap_;
+    sample->axes = volume.axes;
+    sample->setModelMatrix(volume.getModelMatrix());
+    sample->setWorldMatrix(volume.getWorldMatrix());
+    return sample;
+}
+
+}  // namespace
+
+VolumeProgressiveRefinement::VolumeProgressiveRefinement()
+    : PoolProcessor()
+    , inport_("inputVolume", "Input volume"_help)
+    , outport_("outputVolume", "The selected level of the volume pyramid"_help)
+    , filter_("filter", "Filter",
+              "Filter used when downsampling a level, __Box__ averages 2 voxels along each axis "
+              "while __Gaussian__ uses a [1 3 3 1] kernel which gives less aliasing"_help,
+              {{"box", "Box", DownsampleFilter::Box},
+               {"gaussian", "Gaussian", DownsampleFilter::Gaussian}},
+              0)
+    , minDimension_("minDimension", "Coarsest Size",
+                    "Levels are added until the largest dimension is at most this size"_help, 32,
+                    {1, ConstraintBehavior::Immutable}, {1024, ConstraintBehavior::Ignore})
+    , level_("level", "Level",
+             "The level to output, 0 is the full resolution volume. Levels beyond the coarsest "
+             "one will output the coarsest level"_help,
+             0, {0, ConstraintBehavior::Immutable}, {16, ConstraintBehavior::Ignore})
+    , progressive_("progressive", "Progressive Refinement",
+                   "Output a point-sampled preview while the pyramid is being built"_help, true) {
+
+    addPort(inport_);
+    addPort(outport_);
+
+    addProperties(filter_, minDimension_, level_, progressive_);
+}
+
+void VolumeProgressiveRefinement::process() {
+    auto volume = inport_.getData();
+    const VolumePyramid::Settings settings{filter_.get(), minDimension_.get()};
+    const auto levels =
+        VolumePyramid::numberOfLevels(volume->getDimensions(), settings.minDimension);
+    const auto level = std::min(level_.get(), levels - 1);
+
+    if (levels == 1 || (level == 0 && !progressive_)) {
+        outport_.setData(volume);
+        return;
+    }
+    if (auto pyramid = VolumePyramid::find(volume, settings)) {
+        outport_.setData(level == 0 ? volume : pyramid->getLevel(level));
+        return;
+    }
+
+    outport_.clear();
+    if (!progressive_) {
+        buildPyramid(volume, settings, level);
+        return;
+    }
+
+    dispatchOne(
+        [volume, factor = size_t{1} << (levels - 1)](pool::Stop stop) -> std::shared_ptr<Volume> {
+            if (stop) return nullptr;
+            return pointSample(*volume, factor);
+        },
+        [this, volume, settings, level](std::shared_ptr<Volume> preview) {
+            outport_.setData(preview);
+            newResults();
+            buildPyramid(volume, settings, level);
+        });
+}
+
+void VolumeProgressiveRefinement::buildPyramid(std::shared_ptr<const Volume> volume,
+                                               VolumePyramid::Settings settings, size_t level) {
+    dispatchOne(
+        [volume, settings, level](pool::Stop stop,
+                                  pool::Progress progress) -> std::shared_ptr<const Volume> {
+            const auto pyramid = VolumePyramid::get(
+                volume, settings, [&stop]() -> bool { return stop; },
+                [&progress](float f) { progress(f); });
+            if (!pyramid) return nullptr;
+            return level == 0 ? volume : pyramid->getLevel(level);
+        },
+        [this](std::shared_ptr<const Volume> result) {
+            outport_.setData(result);
+            newResults();
+        });
+}
+
+}  // namespace inviwo
@@ -35,6 +35,8 @@
 #include <inviwo/core/datastructures/image/imagetypes.h>                // for ImageChannel, Ima...
 #include <inviwo/core/datastructures/representationconverter.h>         // for RepresentationCon...
 #include <inviwo/core/datastructures/representationconverterfactory.h>  // for RepresentationCon...
+#include <inviwo/core/datastructures/volume/volume.h>                   // for Volume
+#include <inviwo/core/datastructures/volume/volumedisk.h>               // for VolumeDisk
 #include <inviwo/core/datastructures/volume/volumeram.h>                // for VolumeRAM
 #include <inviwo/core/interaction/events/eventmatcher.h>                // for GestureEventMatcher
 #include <inviwo/core/interaction/events/gestureevent.h>                // for GestureEvent
@@ -58,6 +60,7 @@
 #include <inviwo/core/util/glmvec.h>                                    // for size2_t, dvec2
 #include <inviwo/core/util/indexmapper.h>                               // for IndexMapper, Inde...
 #include <inviwo/core/util/staticstring.h>                              // for operator+
+#include <inviwo/core/util/volumeutils.h>                               // for getRegionReader
 #include <inviwo/core/util/document.h>                                  // for Document
 #include <modules/base/datastructures/imagereusecache.h>                // for ImageReuseCache
 
@@ -359,9 +362,42 @@ void VolumeSliceExtractor::process() {
             break;
     }
 
-    detail::SliceState state{sliceAlongAxis_,     static_cast<size_t>(sliceNumber_.get() - 1),
-                             &imageCache_,        flipHorizontal_,
-                             flipVertical_,       &transferFunction_.get(),
+    auto slice = static_cast<size_t>(sliceNumber_.get() - 1);
+
+    // Read only the slice from disk if the input has not been loaded yet
+    if (const auto* disk = util::getRegionReader(*vol)) {
+        const auto axis = static_cast<size_t>(sliceAlongAxis_.get());
+        const auto index = std::min(slice, dims[axis] - 1);
+
+        // Changing the transfer function or flipping should not read the slice again
+        if (diskSlice_.volume.lock() != vol || diskSlice_.axis != axis ||
+            diskSlice_.index != index) {
+            size3_t offset{0};
+            size3_t extent{dims};
+            offset[axis] = index;
+            extent[axis] = 1;
+
+            // The slab is one voxel thick, shrink and move it to cover the slice in world space
+            auto slab = std::make_shared<Volume>(*vol, NoData{});
+            auto basis = vol->getBasis();
+            auto worldOffset = vol->getOffset();
+            const auto voxel = basis[axis] / static_cast<float>(dims[axis]);
+            worldOffset += voxel * static_cast<float>(index);
+            basis[axis] = voxel;
+            slab->setBasis(basis);
+            slab->setOffset(worldOffset);
+            slab->setDimensions(extent);
+            slab->addRepresentation(disk->readRegion(offset, extent));
+            diskSlice_ = {vol, axis, index, slab};
+        }
+        vol = diskSlice_.slab;
+        slice = 0;
+    } else {
+        diskSlice_ = {};
+    }
+
+    detail::SliceState state{sliceAlongAxis_, slice,         &imageCache_,
+                             flipHorizontal_, flipVertical_, &transferFunction_.get(),
                              tfAlphaOffset_.get()};
 
     std::shared_ptr<Image> image;
@@ -0,0 +1,154 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/algorithm/dataminmax.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/image/layerram.h>
+
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace inviwo {
+
+TEST(DataMinMax, scalar) {
+    std::vector<int> data(1001);
+    std::iota(data.begin(), data.end(), -500);
+    const auto [min, max] = util::dataMinMax(data.data(), data.size());
+    EXPECT_EQ(dvec4(-500.0, 0.0, 0.0, 0.0), min);
+    EXPECT_EQ(dvec4(500.0, 0.0, 0.0, 0.0), max);
+}
+
+TEST(DataMinMax, vec3) {
+    std::vector<vec3> data;
+    for (int i = 0; i < 37; ++i) {
+        data.emplace_back(static_cast<float>(i), static_cast<float>(-i), 2.0f);
+    }
+    const auto [min, max] = util::dataMinMax(data.data(), data.size());
+    EXPECT_EQ(dvec4(0.0, -36.0, 2.0, 0.0), min);
+    EXPECT_EQ(dvec4(36.0, 0.0, 2.0, 0.0), max);
+}
+
+TEST(DataMinMax, half) {
+    std::vector<half_float::half> data(100, half_float::half(1.0f));
+    data[17] = half_float::half(-3.0f);
+    data[55] = half_float::half(8.0f);
+    const auto [min, max] = util::dataMinMax(data.data(), data.size());
+    EXPECT_DOUBLE_EQ(-3.0, min.x);
+    EXPECT_DOUBLE_EQ(8.0, max.x);
+}
+
+TEST(DataMinMax, ignoreSpecialValues) {
+    std::vector<double> data(50, 1.0);
+    data[3] = std::numeric_limits<double>::infinity();
+    data[7] = -std::numeric_limits<double>::infinity();
+    data[9] = std::numeric_limits<double>::quiet_NaN();
+    data[11] = -2.0;
+    data[49] = 5.0;
+
+    const auto [min, max] = util::dataMinMax(data.data(), data.size(), IgnoreSpecialValues::Yes);
+    EXPECT_DOUBLE_EQ(-2.0, min.x);
+    EXPECT_DOUBLE_EQ(5.0, max.x);
+
+    const auto [minAll, maxAll] = util::dataMinMax(data.data(), data.size());
+    EXPECT_EQ(-std::numeric_limits<double>::infinity(), minAll.x);
+    EXPECT_EQ(std::numeric_limits<double>::infinity(), maxAll.x);
+}
+
+TEST(DataMinMax, volumeCache) {
+    VolumeRAMPrecision<float> volume(size3_t{4, 4, 4});
+    volume.getDataTyped()[5] = 3.0f;
+
+    const VolumeRAM* constVolume = &volume;
+    EXPECT_DOUBLE_EQ(3.0, util::volumeMinMax(constVolume).second.x);
+    EXPECT_TRUE(volume.getMinMaxCache().get(false));
+
+    volume.getDataTyped()[6] = 7.0f;
+    EXPECT_FALSE(volume.getMinMaxCache().get(false));
+    EXPECT_DOUBLE_EQ(7.0, util::volumeMinMax(constVolume).second.x);
+}
+
+TEST(DataMinMax, volumeCacheWriteDuringComputation) {
+    VolumeRAMPrecision<float> volume(size3_t{4, 4, 4});
+    auto& cache = volume.getMinMaxCache();
+
+    // A result computed while the data was accessed for writing is discarded
+    const auto modificationCount = cache.getModificationCount();
+    volume.getDataTyped()[5] = 3.0f;
+    cache.set(false, {dvec4{0.0}, dvec4{0.0}}, modificationCount);
+    EXPECT_FALSE(cache.get(false));
+
+    const VolumeRAM* constVolume = &volume;
+    EXPECT_DOUBLE_EQ(3.0, util::volumeMinMax(constVolume).second.x);
+    ASSERT_TRUE(cache.get(false));
+    EXPECT_DOUBLE_EQ(3.0, cache.get(false)->second.x);
+
+    // Const access keeps the values, an explicit invalidation drops them
+    EXPECT_NE(nullptr, constVolume->getData());
+    EXPECT_TRUE(cache.get(false));
+    cache.invalidate();
+    EXPECT_FALSE(cache.get(false));
+}
+
+TEST(DataMinMax, volumeCacheCopy) {
+    VolumeRAMPrecision<float> volume(size3_t{4, 4, 4});
+    volume.getDataTyped()[5] = 3.0f;
+    const VolumeRAM* constVolume = &volume;
+    util::volumeMinMax(constVolume);
+
+    // The copy has identical data and keeps the cached values, writes to it do not affect the
+    // source
+    VolumeRAMPrecision<float> copy(volume);
+    ASSERT_TRUE(copy.getMinMaxCache().get(false));
+    copy.getDataTyped()[6] = 7.0f;
+    EXPECT_FALSE(copy.getMinMaxCache().get(false));
+    EXPECT_TRUE(volume.getMinMaxCache().get(false));
+    EXPECT_DOUBLE_EQ(7.0, util::volumeMinMax(static_cast<const VolumeRAM*>(&copy)).second.x);
+    EXPECT_DOUBLE_EQ(3.0, util::volumeMinMax(constVolume).second.x);
+}
+
+TEST(DataMinMax, layerCache) {
+    LayerRAMPrecision<float> layer(size2_t{8, 8});
+    layer.getDataTyped()[5] = -3.0f;
+
+    const LayerRAM* constLayer = &layer;
+    EXPECT_DOUBLE_EQ(-3.0, util::layerMinMax(constLayer).first.x);
+    EXPECT_TRUE(layer.getMinMaxCache().get(false));
+
+    layer.getDataTyped()[6] = -7.0f;
+    EXPECT_FALSE(layer.getMinMaxCache().get(false));
+    EXPECT_DOUBLE_EQ(-7.0, util::layerMinMax(constLayer).first.x);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,183 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/algorithm/volume/volumeramdistancetransform.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <glm/geometric.hpp>
+#include <glm/gtx/component_wise.hpp>
+
+namespace inviwo {
+
+namespace {
+
+struct Result {
+    bool done;
+    std::vector<float> dist;
+    std::vector<std::uint32_t> closest;
+};
+
+Result distanceTransform(const VolumeRAMPrecision<float>& volume, size3_t upsample = size3_t{1},
+                         const util::DistanceTransformOptions& options = {}) {
+    const auto dims = volume.getDimensions() * upsample;
+    VolumeRAMPrecision<float> dist(dims);
+    VolumeRAMPrecision<std::uint32_t> closest(dims);
+
+    // a basis with unit sized input voxels
+    mat3 basis{1.0f};
+    for (int i = 0; i < 3; ++i) basis[i][i] = static_cast<float>(volume.getDimensions()[i]);
+
+    const bool done = util::volumeRAMDistanceTransform(
+        &volume, &dist, &closest, basis, upsample, [](const float& v) { return v > 0.5f; },
+        [](const float& squaredDist) { return std::sqrt(squaredDist); }, [](double) {}, options);
+
+    const auto size = glm::compMul(dims);
+    return {done, std::vector<float>(dist.getDataTyped(), dist.getDataTyped() + size),
+            std::vector<std::uint32_t>(closest.getDataTyped(), closest.getDataTyped() + size)};
+}
+
+VolumeRAMPrecision<float> randomVolume(size3_t dims, double fraction) {
+    VolumeRAMPrecision<float> volume(dims);
+    std::mt19937 gen(0);
+    std::bernoulli_distribution feature(fraction);
+    auto* data = volume.getDataTyped();
+    for (size_t i = 0; i < glm::compMul(dims); ++i) data[i] = feature(gen) ? 1.0f : 0.0f;
+    return volume;
+}
+
+// Brute force distance from each voxel to the closest voxel where isFeature is true
+template <typename IsFeature>
+std::vector<float> bruteForce(const VolumeRAMPrecision<float>& volume, IsFeature isFeature) {
+    const auto dims = volume.getDimensions();
+    const util::IndexMapper3D im(dims);
+    const auto* data = volume.getDataTyped();
+    std::vector<float> res(glm::compMul(dims), std::numeric_limits<float>::max());
+    for (size_t i = 0; i < res.size(); ++i) {
+        for (size_t j = 0; j < res.size(); ++j) {
+            if (!isFeature(data[j])) continue;
+            res[i] = std::min(res[i], glm::distance(vec3(im(i)), vec3(im(j))));
+        }
+    }
+    return res;
+}
+
+}  // namespace
+
+TEST(DistanceTransform, singleFeature) {
+    VolumeRAMPrecision<float> volume(size3_t{5, 4, 3});
+    const util::IndexMapper3D im(volume.getDimensions());
+    const size3_t feature{1, 2, 0};
+    volume.getDataTyped()[im(feature)] = 1.0f;
+
+    const auto res = distanceTransform(volume);
+    ASSERT_TRUE(res.done);
+    for (size_t i = 0; i < res.dist.size(); ++i) {
+        EXPECT_NEAR(glm::distance(vec3(im(i)), vec3(feature)), res.dist[i], 1.0e-5f);
+        EXPECT_EQ(im(feature), res.closest[i]);
+    }
+}
+
+TEST(DistanceTransform, matchesBruteForce) {
+    const auto volume = randomVolume(size3_t{9, 7, 6}, 0.05);
+    const util::IndexMapper3D im(volume.getDimensions());
+
+    const auto res = distanceTransform(volume);
+    ASSERT_TRUE(res.done);
+    const auto expected = bruteForce(volume, [](float v) { return v > 0.5f; });
+    for (size_t i = 0; i < res.dist.size(); ++i) {
+        EXPECT_NEAR(expected[i], res.dist[i], 1.0e-5f);
+        ASSERT_NE(util::noClosestFeature, res.closest[i]);
+        EXPECT_GT(volume.getDataTyped()[res.closest[i]], 0.5f);
+        EXPECT_NEAR(expected[i], glm::distance(vec3(im(i)), vec3(im(res.closest[i]))), 1.0e-5f);
+    }
+}
+
+TEST(DistanceTransform, signedDistance) {
+    const auto volume = randomVolume(size3_t{8, 6, 5}, 0.5);
+
+    util::DistanceTransformOptions options;
+    options.signedDistance = true;
+    const auto res = distanceTransform(volume, size3_t{1}, options);
+    ASSERT_TRUE(res.done);
+
+    const auto outside = bruteForce(volume, [](float v) { return v > 0.5f; });
+    const auto inside = bruteForce(volume, [](float v) { return v <= 0.5f; });
+    const auto* data = volume.getDataTyped();
+    for (size_t i = 0; i < res.dist.size(); ++i) {
+        if (data[i] > 0.5f) {
+            EXPECT_NEAR(-inside[i], res.dist[i], 1.0e-5f);
+            EXPECT_EQ(i, res.closest[i]);
+        } else {
+            EXPECT_NEAR(outside[i], res.dist[i], 1.0e-5f);
+        }
+    }
+}
+
+TEST(DistanceTransform, upsample) {
+    VolumeRAMPrecision<float> volume(size3_t{3, 1, 1});
+    volume.getDataTyped()[0] = 1.0f;
+
+    const auto res = distanceTransform(volume, size3_t{2, 1, 1});
+    ASSERT_TRUE(res.done);
+    const std::vector<float> expected{0.0f, 0.0f, 0.5f, 1.0f, 1.5f, 2.0f};
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_NEAR(expected[i], res.dist[i], 1.0e-5f);
+        EXPECT_EQ(0, res.closest[i]);
+    }
+}
+
+TEST(DistanceTransform, noFeatures) {
+    const VolumeRAMPrecision<float> volume(size3_t{4, 3, 2});
+
+    const auto res = distanceTransform(volume);
+    ASSERT_TRUE(res.done);
+    for (auto closest : res.closest) EXPECT_EQ(util::noClosestFeature, closest);
+}
+
+TEST(DistanceTransform, stop) {
+    const auto volume = randomVolume(size3_t{4, 4, 4}, 0.1);
+    util::DistanceTransformOptions options;
+    options.stop = []() { return true; };
+    EXPECT_FALSE(distanceTransform(volume, size3_t{1}, options).done);
+}
+
+}  // namespace inviwo
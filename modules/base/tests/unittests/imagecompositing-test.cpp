@@ -0,0 +1,145 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/algorithm/image/imagecompositing.h>
+#include <inviwo/core/datastructures/image/image.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/util/formats.h>
+
+#include <memory>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<Image> createImage(size2_t dims, const vec4& color, float depth,
+                                   const vec4& picking = vec4(0.0f)) {
+    auto image = std::make_shared<Image>(dims, DataVec4Float32::get());
+    auto colorRAM = image->getColorLayer()->getEditableRepresentation<LayerRAM>();
+    auto depthRAM = image->getDepthLayer()->getEditableRepresentation<LayerRAM>();
+    auto pickingRAM = image->getPickingLayer()->getEditableRepresentation<LayerRAM>();
+    for (size_t y = 0; y < dims.y; ++y) {
+        for (size_t x = 0; x < dims.x; ++x) {
+            colorRAM->setFromDVec4({x, y}, dvec4(color));
+            depthRAM->setFromDouble({x, y}, depth);
+            pickingRAM->setFromNormalizedDVec4({x, y}, dvec4(picking));
+        }
+    }
+    return image;
+}
+
+dvec4 color(const Image& image, size2_t pos) {
+    return image.getColorLayer()->getRepresentation<LayerRAM>()->getAsDVec4(pos);
+}
+double depth(const Image& image, size2_t pos) {
+    return image.getDepthLayer()->getRepresentation<LayerRAM>()->getAsDouble(pos);
+}
+
+}  // namespace
+
+TEST(ImageCompositing, composite) {
+    auto back = createImage(size2_t(2, 1), vec4(1.0f, 0.0f, 0.0f, 1.0f), 0.5f);
+    auto front = createImage(size2_t(2, 1), vec4(0.0f, 0.0f, 1.0f, 0.5f), 0.25f);
+    // the second pixel of the front image is behind the back image
+    front->getDepthLayer()->getEditableRepresentation<LayerRAM>()->setFromDouble({1, 0}, 0.75);
+
+    Image result(size2_t(2, 1), DataVec4Float32::get());
+    util::compositeImages(*back, *front, result);
+
+    EXPECT_EQ(dvec4(0.5, 0.0, 0.5, 1.0), color(result, {0, 0}));
+    EXPECT_DOUBLE_EQ(0.25, depth(result, {0, 0}));
+    EXPECT_EQ(dvec4(1.0, 0.0, 0.0, 1.0), color(result, {1, 0}));
+    EXPECT_DOUBLE_EQ(0.5, depth(result, {1, 0}));
+}
+
+TEST(ImageCompositing, compositeResamples) {
+    auto small = createImage(size2_t(1, 1), vec4(0.0f, 1.0f, 0.0f, 1.0f), 0.5f);
+    auto empty = createImage(size2_t(4, 4), vec4(0.0f), 1.0f);
+
+    Image result(size2_t(4, 4), DataVec4UInt8::get());
+    util::compositeImages(*small, *empty, result);
+
+    for (size_t y = 0; y < 4; ++y) {
+        for (size_t x = 0; x < 4; ++x) {
+            EXPECT_EQ(dvec4(0.0, 255.0, 0.0, 255.0), color(result, {x, y}));
+            EXPECT_DOUBLE_EQ(0.5, depth(result, {x, y}));
+        }
+    }
+}
+
+TEST(ImageCompositing, drawImageClipped) {
+    auto source = createImage(size2_t(1, 1), vec4(1.0f), 0.25f);
+    auto dest = createImage(size2_t(3, 3), vec4(0.0f), 1.0f);
+
+    // the viewport extends outside of the destination
+    util::drawImage(*source, *dest, ivec4(1, 1, 4, 4), ImageBlendMode::Replace);
+
+    for (size_t y = 0; y < 3; ++y) {
+        for (size_t x = 0; x < 3; ++x) {
+            const bool inside = x >= 1 && y >= 1;
+            EXPECT_EQ(inside ? dvec4(1.0) : dvec4(0.0), color(*dest, {x, y}));
+            EXPECT_DOUBLE_EQ(inside ? 0.25 : 1.0, depth(*dest, {x, y}));
+        }
+    }
+}
+
+TEST(ImageCompositing, drawImageOver) {
+    auto source = createImage(size2_t(2, 1), vec4(1.0f, 1.0f, 1.0f, 0.5f), 0.25f);
+    // a fully transparent pixel leaves the destination untouched
+    source->getColorLayer()->getEditableRepresentation<LayerRAM>()->setFromDVec4({1, 0},
+                                                                                 dvec4(0.0));
+    auto dest = createImage(size2_t(2, 1), vec4(0.0f, 0.0f, 0.0f, 1.0f), 1.0f);
+
+    util::drawImage(*source, *dest, ivec4(0, 0, 2, 1), ImageBlendMode::Over);
+
+    EXPECT_EQ(dvec4(0.5, 0.5, 0.5, 0.75), color(*dest, {0, 0}));
+    EXPECT_DOUBLE_EQ(0.25, depth(*dest, {0, 0}));
+    EXPECT_EQ(dvec4(0.0, 0.0, 0.0, 1.0), color(*dest, {1, 0}));
+    EXPECT_DOUBLE_EQ(1.0, depth(*dest, {1, 0}));
+}
+
+TEST(ImageCompositing, clear) {
+    auto image = createImage(size2_t(2, 2), vec4(1.0f), 0.5f, vec4(1.0f));
+    util::clearImage(*image);
+
+    for (size_t y = 0; y < 2; ++y) {
+        for (size_t x = 0; x < 2; ++x) {
+            EXPECT_EQ(dvec4(0.0), color(*image, {x, y}));
+            EXPECT_DOUBLE_EQ(1.0, depth(*image, {x, y}));
+        }
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,119 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <modules/base/datastructures/representationpool.h>
+
+namespace inviwo {
+
+TEST(RepresentationPoolTests, reuseReleased) {
+    LayerRAMPool pool;
+
+    auto first = pool.getTyped<float>(size2_t{16, 8});
+    const auto* data = first->getDataTyped();
+    auto layer = std::make_shared<Layer>(first);
+    first.reset();
+
+    // still held by the layer
+    auto second = pool.getTyped<float>(size2_t{16, 8});
+    EXPECT_NE(data, second->getDataTyped());
+    second.reset();
+
+    layer.reset();
+    auto third = pool.getTyped<float>(size2_t{16, 8});
+    EXPECT_EQ(data, third->getDataTyped());
+
+    const auto stats = pool.getStats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 2);
+    EXPECT_EQ(stats.inUse, 1);
+    EXPECT_EQ(stats.unused, 1);
+    EXPECT_EQ(stats.bytesInUse, 16 * 8 * sizeof(float));
+}
+
+TEST(RepresentationPoolTests, keyedOnFormatAndDims) {
+    LayerRAMPool pool;
+
+    pool.getTyped<float>(size2_t{16, 8});
+    auto other = pool.getTyped<float>(size2_t{8, 16});
+    EXPECT_EQ(other->getDimensions(), size2_t(8, 16));
+    auto vec = pool.getTyped<vec4>(size2_t{16, 8});
+    EXPECT_EQ(vec->getDataFormat(), DataVec4Float32::get());
+    auto depth = pool.get(size2_t{16, 8}, DataFloat32::get(), LayerType::Depth);
+    EXPECT_EQ(depth->getLayerType(), LayerType::Depth);
+
+    const auto stats = pool.getStats();
+    EXPECT_EQ(stats.hits, 0);
+    EXPECT_EQ(stats.misses, 4);
+}
+
+TEST(RepresentationPoolTests, resetsState) {
+    LayerRAMPool pool;
+
+    pool.getTyped<float>(size2_t{4, 4})->setInterpolation(InterpolationType::Nearest);
+    auto reused = pool.getTyped<float>(size2_t{4, 4});
+    EXPECT_EQ(reused->getInterpolation(), InterpolationType::Linear);
+    EXPECT_EQ(pool.getStats().hits, 1);
+}
+
+TEST(RepresentationPoolTests, evictLeastRecentlyUsed) {
+    constexpr size_t bytes = 64 * sizeof(float);
+    VolumeRAMPool pool(bytes);
+
+    pool.getTyped<float>(size3_t{4, 4, 4});
+    pool.getTyped<float>(size3_t{8, 4, 2});
+    // exceeds the budget of unused volumes and evicts the least recently used one
+    auto held = pool.getTyped<float>(size3_t{2, 8, 4});
+
+    auto stats = pool.getStats();
+    EXPECT_EQ(stats.evictions, 1);
+    EXPECT_EQ(stats.unused, 1);
+    EXPECT_EQ(stats.inUse, 1);
+    EXPECT_EQ(stats.bytesUnused, bytes);
+
+    pool.getTyped<float>(size3_t{8, 4, 2});
+    pool.getTyped<float>(size3_t{4, 4, 4});
+    stats = pool.getStats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 4);
+
+    pool.clear();
+    stats = pool.getStats();
+    EXPECT_EQ(stats.unused, 0);
+    EXPECT_EQ(stats.inUse, 1);
+    EXPECT_EQ(stats.bytesUnused, 0);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,170 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/algorithm/volume/volumepyramid.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+
+#include <glm/gtx/component_wise.hpp>
+
+namespace inviwo {
+
+namespace {
+
+template <typename T>
+std::shared_ptr<VolumeRAMPrecision<T>> iotaVolume(size3_t dims) {
+    auto ram = std::make_shared<VolumeRAMPrecision<T>>(dims);
+    auto data = ram->getDataTyped();
+    std::iota(data, data + glm::compMul(dims), T{0});
+    return ram;
+}
+
+}  // namespace
+
+TEST(VolumePyramid, dimensions) {
+    EXPECT_EQ(size3_t(2, 1, 3), VolumePyramid::downsampledDimensions(size3_t(4, 1, 5)));
+    EXPECT_EQ(size_t{1}, VolumePyramid::numberOfLevels(size3_t(32, 32, 16), 32));
+    EXPECT_EQ(size_t{2}, VolumePyramid::numberOfLevels(size3_t(33, 32, 16), 32));
+    EXPECT_EQ(size_t{4}, VolumePyramid::numberOfLevels(size3_t(100, 20, 1), 16));
+    EXPECT_EQ(size_t{5}, VolumePyramid::numberOfLevels(size3_t(16, 1, 1), 0));
+}
+
+TEST(VolumePyramid, boxDownsample) {
+    auto ram = iotaVolume<float>(size3_t(4, 3, 1));
+    auto res = util::volumeDownsample(*ram, DownsampleFilter::Box);
+    ASSERT_EQ(size3_t(2, 2, 1), res->getDimensions());
+
+    // The last row is clamped at the border
+    const auto data = static_cast<const float*>(res->getData());
+    EXPECT_FLOAT_EQ((0.0f + 1.0f + 4.0f + 5.0f) / 4.0f, data[0]);
+    EXPECT_FLOAT_EQ((2.0f + 3.0f + 6.0f + 7.0f) / 4.0f, data[1]);
+    EXPECT_FLOAT_EQ((8.0f + 9.0f) / 2.0f, data[2]);
+    EXPECT_FLOAT_EQ((10.0f + 11.0f) / 2.0f, data[3]);
+}
+
+TEST(VolumePyramid, gaussianDownsample) {
+    auto ram = iotaVolume<double>(size3_t(8, 1, 1));
+    auto res = util::volumeDownsample(*ram, DownsampleFilter::Gaussian);
+    ASSERT_EQ(size3_t(4, 1, 1), res->getDimensions());
+
+    const auto data = static_cast<const double*>(res->getData());
+    EXPECT_DOUBLE_EQ(0.375 * 1.0 + 0.125 * 2.0, data[0]);
+    EXPECT_DOUBLE_EQ(2.5, data[1]);
+    EXPECT_DOUBLE_EQ(4.5, data[2]);
+    EXPECT_DOUBLE_EQ(0.125 * 5.0 + 0.375 * 6.0 + 0.5 * 7.0, data[3]);
+}
+
+TEST(VolumePyramid, gaussianPreservesConstant) {
+    auto ram = std::make_shared<VolumeRAMPrecision<unsigned char>>(size3_t(5, 6, 7));
+    std::fill_n(ram->getDataTyped(), 5 * 6 * 7, static_cast<unsigned char>(7));
+    auto res = util::volumeDownsample(*ram, DownsampleFilter::Gaussian);
+    ASSERT_EQ(size3_t(3, 3, 4), res->getDimensions());
+
+    const auto data = static_cast<const unsigned char*>(res->getData());
+    for (size_t i = 0; i < 3 * 3 * 4; ++i) {
+        EXPECT_EQ(7, data[i]);
+    }
+}
+
+TEST(VolumePyramid, pointSample) {
+    auto ram = iotaVolume<int>(size3_t(5, 4, 2));
+    auto res = util::volumePointSample(*ram, size3_t(2, 2, 2));
+    ASSERT_EQ(size3_t(3, 2, 1), res->getDimensions());
+
+    const auto data = static_cast<const int*>(res->getData());
+    EXPECT_EQ(0, data[0]);
+    EXPECT_EQ(2, data[1]);
+    EXPECT_EQ(4, data[2]);
+    EXPECT_EQ(10, data[3]);
+    EXPECT_EQ(12, data[4]);
+    EXPECT_EQ(14, data[5]);
+}
+
+TEST(VolumePyramid, levels) {
+    auto volume = std::make_shared<Volume>(iotaVolume<float>(size3_t(20, 10, 5)));
+    volume->dataMap_.dataRange = dvec2(0.0, 1000.0);
+
+    const VolumePyramid pyramid{*volume, {DownsampleFilter::Box, 4}};
+    ASSERT_EQ(size_t{4}, pyramid.getNumberOfLevels());
+    EXPECT_EQ(nullptr, pyramid.getLevel(0));
+    EXPECT_EQ(size3_t(20, 10, 5), pyramid.getDimensions(0));
+    EXPECT_EQ(size3_t(10, 5, 3), pyramid.getDimensions(1));
+    EXPECT_EQ(size3_t(5, 3, 2), pyramid.getDimensions(2));
+    EXPECT_EQ(size3_t(3, 2, 1), pyramid.getDimensions(3));
+    EXPECT_EQ(volume->dataMap_.dataRange, pyramid.getLevel(3)->dataMap_.dataRange);
+    EXPECT_EQ(volume->getBasis(), pyramid.getLevel(3)->getBasis());
+    EXPECT_THROW(pyramid.getLevel(4), RangeException);
+}
+
+TEST(VolumePyramid, cancel) {
+    auto volume = std::make_shared<Volume>(iotaVolume<float>(size3_t(20, 10, 5)));
+    const VolumePyramid pyramid{*volume, {DownsampleFilter::Box, 4}, []() { return true; }};
+    EXPECT_EQ(size_t{1}, pyramid.getNumberOfLevels());
+
+    EXPECT_EQ(nullptr, VolumePyramid::get(volume, {}, []() { return true; }));
+    EXPECT_EQ(nullptr, VolumePyramid::find(volume, {}));
+}
+
+TEST(VolumePyramid, cache) {
+    std::shared_ptr<const Volume> volume =
+        std::make_shared<Volume>(iotaVolume<float>(size3_t(64, 64, 64)));
+    const VolumePyramid::Settings box{DownsampleFilter::Box, 16};
+    const VolumePyramid::Settings gaussian{DownsampleFilter::Gaussian, 16};
+
+    EXPECT_EQ(nullptr, VolumePyramid::find(volume, box));
+    auto pyramid = VolumePyramid::get(volume, box);
+    ASSERT_NE(nullptr, pyramid);
+    EXPECT_EQ(size_t{3}, pyramid->getNumberOfLevels());
+    EXPECT_EQ(pyramid, VolumePyramid::get(volume, box));
+    EXPECT_EQ(pyramid, VolumePyramid::find(volume, box));
+    EXPECT_EQ(nullptr, VolumePyramid::find(volume, gaussian));
+
+    const std::weak_ptr<const VolumePyramid> weak = pyramid;
+    pyramid.reset();
+    EXPECT_FALSE(weak.expired());
+
+    // Pyramids are released once the source volume is gone
+    volume.reset();
+    auto other = std::make_shared<const Volume>(iotaVolume<float>(size3_t(8, 8, 8)));
+    EXPECT_EQ(nullptr, VolumePyramid::find(other, box));
+    EXPECT_TRUE(weak.expired());
+}
+
+}  // namespace inviwo
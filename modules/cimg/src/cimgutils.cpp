@@ -46,6 +46,7 @@
 #include <inviwo/core/util/safecstr.h>                                  // for SafeCStr
 #include <inviwo/core/util/sourcecontext.h>                             // for IVW_CONTEXT, IVW_...
 #include <inviwo/core/util/stringconversion.h>                          // for toLower
+#include <inviwo/core/util/volumereorientation.h>                       // for reorientVolume
 #include <modules/cimg/cimgsavebuffer.h>                                // for saveCImgToBuffer
 
 #include <algorithm>      // for min
@@ -477,10 +478,13 @@ struct CImgLoadVolumeDispatcher {
             throw Exception("Could not find proper data type", IVW_CONTEXT);
         }
 
+        auto data = CImgToVoidConvert<typename DF::primitive>::convert(dst, &img);
+
         // Image is up-side-down
-        img.mirror("y");
+        util::reorientVolume(data, sizeof(typename DF::primitive) * components, dimensions,
+                             {.flip = {false, true, false}});
 
-        return CImgToVoidConvert<typename DF::primitive>::convert(dst, &img);
+        return data;
     }
 };
 
@@ -31,21 +31,24 @@
 
 #include <inviwo/dataframe/dataframemoduledefine.h>  // for IVW_MODULE_DATAFRAME_API
 
-#include <inviwo/core/datastructures/datatraits.h>   // for DataTraits
-#include <inviwo/core/datastructures/unitsystem.h>   // for Unit
-#include <inviwo/core/metadata/metadataowner.h>      // for MetaDataOwner
-#include <inviwo/core/ports/datainport.h>            // for DataInport
-#include <inviwo/core/ports/dataoutport.h>           // for DataOutport
-#include <inviwo/core/util/document.h>               // for TableBuilder, Document, TableBuilder...
-#include <inviwo/core/util/exception.h>              // for Exception, ExceptionContext
-#include <inviwo/core/util/formats.h>                // for DataFormatBase
-#include <inviwo/core/util/glmvec.h>                 // for dvec2, uvec3
-#include <inviwo/core/util/stringconversion.h>       // for toString
-#include <inviwo/dataframe/datastructures/column.h>  // for Column
+#include <inviwo/core/datastructures/bitset.h>         // for BitSet
+#include <inviwo/core/datastructures/datatraits.h>     // for DataTraits
+#include <inviwo/core/datastructures/unitsystem.h>     // for Unit
+#include <inviwo/core/metadata/metadataowner.h>        // for MetaDataOwner
+#include <inviwo/core/ports/datainport.h>              // for DataInport
+#include <inviwo/core/ports/dataoutport.h>             // for DataOutport
+#include <inviwo/core/util/document.h>                 // for TableBuilder, Document, TableBuil...
+#include <inviwo/core/util/exception.h>                // for Exception, ExceptionContext
+#include <inviwo/core/util/formats.h>                  // for DataFormatBase
+#include <inviwo/core/util/glmvec.h>                   // for dvec2, uvec3
+#include <inviwo/core/util/stringconversion.h>         // for toString
+#include <inviwo/dataframe/datastructures/column.h>    // for Column
+#include <inviwo/dataframe/datastructures/rowindex.h>  // for RowIndex
 
 #include <cstddef>        // for size_t
 #include <cstdint>        // for uint32_t
 #include <memory>         // for shared_ptr, allocator, dynamic_point...
+#include <mutex>          // for mutex
 #include <optional>       // for optional, nullopt, optional<>::value...
 #include <string>         // for string, to_string, hash, operator+
 #include <string_view>    // for string_view
@@ -185,6 +188,25 @@ public:
     std::shared_ptr<IndexColumn> getIndexColumn();
     std::shared_ptr<const IndexColumn> getIndexColumn() const;
 
+    /**
+     * \brief mapping between the IDs of the index column and row indices
+     * The mapping is built on first use and cached until the DataFrame is modified through any of
+     * the non-const member functions. If the index column is modified through a previously
+     * obtained pointer, updateIndexBuffer() has to be called to reset the cache.
+     * Safe to call concurrently from multiple threads on a const DataFrame.
+     */
+    std::shared_ptr<const RowIndex> getRowIndex() const;
+    /**
+     * \brief translate IDs, for example from the BrushingAndLinkingManager, to row indices
+     * @see getRowIndex RowIndex::idsToRows
+     */
+    BitSet idsToRows(const BitSet& ids) const;
+    /**
+     * \brief translate row indices to IDs, for example for the BrushingAndLinkingManager
+     * @see getRowIndex RowIndex::rowsToIds
+     */
+    BitSet rowsToIds(const BitSet& rows) const;
+
     size_t getNumberOfColumns() const;
     /**
      * Returns the number of rows of the largest column, excluding the header, or zero if no columns
@@ -205,7 +227,11 @@ public:
     void updateIndexBuffer();
 
 private:
+    void resetRowIndex();
+
     std::vector<std::shared_ptr<Column>> columns_;
+    mutable std::mutex rowIndexMutex_;
+    mutable std::shared_ptr<const RowIndex> rowIndex_;
 };
 
 using DataFrameOutport = DataOutport<DataFrame>;
@@ -216,6 +242,7 @@ template <typename T>
 std::shared_ptr<TemplateColumn<T>> DataFrame::addColumn(std::string_view header, size_t size,
                                                         Unit unit, std::optional<dvec2> range) {
     auto col = std::make_shared<TemplateColumn<T>>(header, size, unit, range);
+    resetRowIndex();
     columns_.push_back(col);
     return col;
 }
@@ -225,6 +252,7 @@ std::shared_ptr<TemplateColumn<T>> DataFrame::addColumn(std::string_view header,
                                                         std::vector<T> data, Unit unit,
                                                         std::optional<dvec2> range) {
     auto col = std::make_shared<TemplateColumn<T>>(header, std::move(data), unit, range);
+    resetRowIndex();
     columns_.push_back(col);
     return col;
 }
@@ -0,0 +1,90 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>  // for IVW_MODULE_DATAFRAME_API
+
+#include <inviwo/core/datastructures/bitset.h>  // for BitSet
+
+#include <cstddef>        // for size_t
+#include <cstdint>        // for uint32_t
+#include <optional>       // for optional
+#include <span>           // for span
+#include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
+
+namespace inviwo {
+
+/**
+ * \brief Mapping between the IDs of an index column and zero-based row indices
+ * The IDs are the values used by the BrushingAndLinkingManager, i.e. the values of the index
+ * column of a DataFrame, while rows are positions in the DataFrame. Depending on the IDs the
+ * mapping is stored as
+ *   - nothing, if the IDs are equal to the row indices (the default index column),
+ *   - a dense lookup table, if the IDs cover a compact range,
+ *   - a hash map otherwise.
+ * If an ID occurs multiple times, it is mapped to the first row with that ID.
+ * @see DataFrame::getRowIndex DataFrame::idsToRows DataFrame::rowsToIds
+ */
+class IVW_MODULE_DATAFRAME_API RowIndex {
+public:
+    enum class Storage { Identity, Dense, Hash };
+
+    explicit RowIndex(std::span<const std::uint32_t> ids);
+
+    size_t getNumberOfRows() const;
+    Storage getStorage() const;
+
+    std::optional<std::uint32_t> idToRow(std::uint32_t id) const;
+    /**
+     * @pre @p row < getNumberOfRows()
+     */
+    std::uint32_t rowToId(std::uint32_t row) const;
+
+    /**
+     * Translate a set of IDs to the corresponding rows, IDs without a row are ignored.
+     */
+    BitSet idsToRows(const BitSet& ids) const;
+    /**
+     * Translate a set of rows to the corresponding IDs, rows outside of the index are ignored.
+     */
+    BitSet rowsToIds(const BitSet& rows) const;
+
+private:
+    static constexpr std::uint32_t npos = static_cast<std::uint32_t>(-1);
+
+    size_t rows_;
+    Storage storage_;
+    std::vector<std::uint32_t> ids_;  ///< row to ID, empty for Storage::Identity
+    std::uint32_t minId_ = 0;
+    std::vector<std::uint32_t> dense_;  ///< ID - minId_ to row or npos
+    std::unordered_map<std::uint32_t, std::uint32_t> hash_;
+};
+
+}  // namespace inviwo
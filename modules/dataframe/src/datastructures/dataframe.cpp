@@ -41,9 +41,11 @@
 #include <inviwo/core/util/stdextensions.h>                             // for find_if_or_null
 #include <inviwo/core/util/zip.h>                                       // for make_sequence
 #include <inviwo/dataframe/datastructures/column.h>                     // for Column, Categoric...
+#include <inviwo/dataframe/datastructures/rowindex.h>                   // for RowIndex
 
 #include <algorithm>      // for max, remove_if
 #include <iterator>       // for begin, end
+#include <mutex>          // for scoped_lock
 #include <numeric>        // for iota
 #include <unordered_set>  // for unordered_set
 #include <utility>        // for move
@@ -74,14 +76,28 @@ DataFrame& DataFrame::operator=(const DataFrame& that) {
     if (this != &that) {
         DataFrame tmp(that);
         std::swap(tmp.columns_, columns_);
+        resetRowIndex();
     }
     return *this;
 }
-DataFrame& DataFrame::operator=(DataFrame&&) = default;
-DataFrame::DataFrame(DataFrame&&) = default;
+DataFrame& DataFrame::operator=(DataFrame&& that) {
+    if (this != &that) {
+        MetaDataOwner::operator=(std::move(that));
+        columns_ = std::move(that.columns_);
+        std::scoped_lock lock{rowIndexMutex_, that.rowIndexMutex_};
+        rowIndex_ = std::move(that.rowIndex_);
+    }
+    return *this;
+}
+DataFrame::DataFrame(DataFrame&& rhs)
+    : MetaDataOwner(std::move(rhs)), columns_{std::move(rhs.columns_)}, rowIndex_{[&]() {
+        std::scoped_lock lock{rhs.rowIndexMutex_};
+        return std::move(rhs.rowIndex_);
+    }()} {}
 
 std::shared_ptr<Column> DataFrame::addColumn(std::shared_ptr<Column> column) {
     if (column) {
+        resetRowIndex();
         columns_.push_back(column);
     }
     return column;
@@ -100,6 +116,7 @@ std::shared_ptr<Column> DataFrame::addColumnFromBuffer(std::string_view identifi
 }
 
 void DataFrame::dropColumn(std::string_view header) {
+    resetRowIndex();
     columns_.erase(std::remove_if(std::begin(columns_), std::end(columns_),
                                   [&](std::shared_ptr<Column> col) -> bool {
                                       return col->getHeader() == header;
@@ -111,6 +128,7 @@ void DataFrame::dropColumn(const size_t index) {
     if (index >= columns_.size()) {
         return;
     }
+    resetRowIndex();
     columns_.erase(std::begin(columns_) + index);
 }
 
@@ -118,6 +136,7 @@ std::shared_ptr<CategoricalColumn> DataFrame::addCategoricalColumn(std::string_v
                                                                    size_t size) {
     auto col = std::make_shared<CategoricalColumn>(header);
     col->getTypedBuffer()->getEditableRAMRepresentation()->getDataContainer().resize(size);
+    resetRowIndex();
     columns_.push_back(col);
     return col;
 }
@@ -125,11 +144,13 @@ std::shared_ptr<CategoricalColumn> DataFrame::addCategoricalColumn(std::string_v
 std::shared_ptr<CategoricalColumn> DataFrame::addCategoricalColumn(
     std::string_view header, const std::vector<std::string>& values) {
     auto col = std::make_shared<CategoricalColumn>(header, values);
+    resetRowIndex();
     columns_.push_back(col);
     return col;
 }
 
 void DataFrame::updateIndexBuffer() {
+    resetRowIndex();
     const size_t nrows = getNumberOfRows();
 
     auto indexBuffer = std::static_pointer_cast<Buffer<std::uint32_t>>(columns_[0]->getBuffer());
@@ -163,6 +184,7 @@ std::vector<std::shared_ptr<Column>>::const_iterator DataFrame::end() const {
 std::shared_ptr<const Column> DataFrame::getColumn(size_t index) const { return columns_[index]; }
 
 std::shared_ptr<Column> DataFrame::getColumn(std::string_view name) {
+    resetRowIndex();
     return util::find_if_or_null(columns_, [name](auto c) { return c->getHeader() == name; });
 }
 
@@ -170,7 +192,10 @@ std::shared_ptr<const Column> DataFrame::getColumn(std::string_view name) const
     return util::find_if_or_null(columns_, [name](auto c) { return c->getHeader() == name; });
 }
 
-std::shared_ptr<Column> DataFrame::getColumn(size_t index) { return columns_[index]; }
+std::shared_ptr<Column> DataFrame::getColumn(size_t index) {
+    resetRowIndex();
+    return columns_[index];
+}
 
 std::shared_ptr<const IndexColumn> DataFrame::getIndexColumn() const {
     if (columns_[0]->getColumnType() == ColumnType::Index) {
@@ -181,6 +206,7 @@ std::shared_ptr<const IndexColumn> DataFrame::getIndexColumn() const {
 }
 
 std::shared_ptr<IndexColumn> DataFrame::getIndexColumn() {
+    resetRowIndex();
     if (columns_[0]->getColumnType() == ColumnType::Index) {
         return std::static_pointer_cast<IndexColumn>(columns_[0]);
     } else {
@@ -188,12 +214,44 @@ std::shared_ptr<IndexColumn> DataFrame::getIndexColumn() {
     }
 }
 
-std::vector<std::shared_ptr<Column>>::iterator DataFrame::begin() { return columns_.begin(); }
+std::vector<std::shared_ptr<Column>>::iterator DataFrame::begin() {
+    resetRowIndex();
+    return columns_.begin();
+}
 
 std::vector<std::shared_ptr<Column>>::const_iterator DataFrame::begin() const {
     return columns_.begin();
 }
 
-std::vector<std::shared_ptr<Column>>::iterator DataFrame::end() { return columns_.end(); }
+std::vector<std::shared_ptr<Column>>::iterator DataFrame::end() {
+    resetRowIndex();
+    return columns_.end();
+}
+
+std::shared_ptr<const RowIndex> DataFrame::getRowIndex() const {
+    std::scoped_lock lock{rowIndexMutex_};
+    if (!rowIndex_) {
+        if (auto indexCol = getIndexColumn()) {
+            rowIndex_ = std::make_shared<const RowIndex>(
+                indexCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer());
+        } else {
+            // without an index column, IDs are equal to row indices
+            auto seq = util::make_sequence<std::uint32_t>(
+                0, static_cast<std::uint32_t>(getNumberOfRows()));
+            const std::vector<std::uint32_t> ids(seq.begin(), seq.end());
+            rowIndex_ = std::make_shared<const RowIndex>(ids);
+        }
+    }
+    return rowIndex_;
+}
+
+BitSet DataFrame::idsToRows(const BitSet& ids) const { return getRowIndex()->idsToRows(ids); }
+
+BitSet DataFrame::rowsToIds(const BitSet& rows) const { return getRowIndex()->rowsToIds(rows); }
+
+void DataFrame::resetRowIndex() {
+    std::scoped_lock lock{rowIndexMutex_};
+    rowIndex_.reset();
+}
 
 }  // namespace inviwo
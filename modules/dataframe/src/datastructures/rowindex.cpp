@@ -0,0 +1,144 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <inviwo/dataframe/datastructures/rowindex.h>
+
+#include <algorithm>  // for minmax_element, lower_bound
+
+namespace inviwo {
+
+RowIndex::RowIndex(std::span<const std::uint32_t> ids)
+    : rows_{ids.size()}, storage_{Storage::Identity} {
+
+    const auto isIdentity = [&]() {
+        for (std::uint32_t row = 0; row < ids.size(); ++row) {
+            if (ids[row] != row) return false;
+        }
+        return true;
+    };
+    if (ids.empty() || isIdentity()) return;
+
+    ids_.assign(ids.begin(), ids.end());
+
+    const auto [minIt, maxIt] = std::minmax_element(ids.begin(), ids.end());
+    minId_ = *minIt;
+    const size_t range = static_cast<size_t>(*maxIt - *minIt) + 1;
+
+    // Use a lookup table as long as it is at most a few times larger than the index itself
+    if (range <= 4 * ids.size() + 1024) {
+        storage_ = Storage::Dense;
+        dense_.assign(range, npos);
+        for (std::uint32_t row = 0; row < ids.size(); ++row) {
+            auto& entry = dense_[ids[row] - minId_];
+            if (entry == npos) entry = row;
+        }
+    } else {
+        storage_ = Storage::Hash;
+        hash_.reserve(ids.size());
+        for (std::uint32_t row = 0; row < ids.size(); ++row) {
+            hash_.try_emplace(ids[row], row);
+        }
+    }
+}
+
+size_t RowIndex::getNumberOfRows() const { return rows_; }
+
+RowIndex::Storage RowIndex::getStorage() const { return storage_; }
+
+std::optional<std::uint32_t> RowIndex::idToRow(std::uint32_t id) const {
+    switch (storage_) {
+        case Storage::Identity:
+            if (id < rows_) return id;
+            return std::nullopt;
+        case Storage::Dense:
+            if (id >= minId_ && id - minId_ < dense_.size() && dense_[id - minId_] != npos) {
+                return dense_[id - minId_];
+            }
+            return std::nullopt;
+        case Storage::Hash:
+        default:
+            if (auto it = hash_.find(id); it != hash_.end()) return it->second;
+            return std::nullopt;
+    }
+}
+
+std::uint32_t RowIndex::rowToId(std::uint32_t row) const {
+    return storage_ == Storage::Identity ? row : ids_[row];
+}
+
+BitSet RowIndex::idsToRows(const BitSet& ids) const {
+    if (ids.empty() || rows_ == 0) return {};
+
+    if (storage_ == Storage::Identity) {
+        if (ids.max() < rows_) return ids;
+        BitSet valid;
+        valid.addRange(0, static_cast<std::uint32_t>(rows_));
+        return ids & valid;
+    }
+
+    const auto idVector = ids.toVector();
+    std::vector<std::uint32_t> rows;
+    rows.reserve(idVector.size());
+    if (storage_ == Storage::Dense) {
+        // toVector returns sorted IDs, skip the ones below and above the table directly
+        auto it = std::lower_bound(idVector.begin(), idVector.end(), minId_);
+        for (; it != idVector.end(); ++it) {
+            const auto offset = *it - minId_;
+            if (offset >= dense_.size()) break;
+            if (const auto row = dense_[offset]; row != npos) rows.push_back(row);
+        }
+    } else {
+        for (const auto id : idVector) {
+            if (auto it = hash_.find(id); it != hash_.end()) rows.push_back(it->second);
+        }
+    }
+    return BitSet(rows);
+}
+
+BitSet RowIndex::rowsToIds(const BitSet& rows) const {
+    if (rows.empty() || rows_ == 0) return {};
+
+    if (storage_ == Storage::Identity) {
+        if (rows.max() < rows_) return rows;
+        BitSet valid;
+        valid.addRange(0, static_cast<std::uint32_t>(rows_));
+        return rows & valid;
+    }
+
+    const auto rowVector = rows.toVector();
+    std::vector<std::uint32_t> ids;
+    ids.reserve(rowVector.size());
+    for (const auto row : rowVector) {
+        // rows are sorted, so all remaining rows are out of range
+        if (row >= rows_) break;
+        ids.push_back(ids_[row]);
+    }
+    return BitSet(ids);
+}
+
+}  // namespace inviwo
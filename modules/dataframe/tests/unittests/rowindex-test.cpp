@@ -0,0 +1,94 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/dataframe/datastructures/rowindex.h>
+
+#include <inviwo/core/datastructures/bitset.h>
+
+#include <vector>
+
+namespace inviwo {
+
+TEST(RowIndex, Identity) {
+    const std::vector<std::uint32_t> ids{0, 1, 2, 3, 4};
+    const RowIndex index{ids};
+    EXPECT_EQ(RowIndex::Storage::Identity, index.getStorage());
+
+    EXPECT_EQ(BitSet(1, 3), index.idsToRows(BitSet(1, 3, 7)));
+    EXPECT_EQ(BitSet(0, 4), index.rowsToIds(BitSet(0, 4, 5)));
+    EXPECT_EQ(2u, index.idToRow(2));
+    EXPECT_FALSE(index.idToRow(5));
+}
+
+TEST(RowIndex, Dense) {
+    const std::vector<std::uint32_t> ids{10, 14, 12, 11, 12};
+    const RowIndex index{ids};
+    EXPECT_EQ(RowIndex::Storage::Dense, index.getStorage());
+
+    EXPECT_EQ(BitSet(0, 2), index.idsToRows(BitSet(3, 10, 12, 13, 20)))
+        << "duplicated IDs map to the first row";
+    EXPECT_EQ(BitSet(11, 12, 14), index.rowsToIds(BitSet(1, 3, 4, 9)));
+    EXPECT_EQ(1u, index.idToRow(14));
+    EXPECT_FALSE(index.idToRow(13));
+    EXPECT_EQ(14u, index.rowToId(1));
+}
+
+TEST(RowIndex, Hash) {
+    const std::vector<std::uint32_t> ids{5, 1'000'000, 42, 3'000'000'000u};
+    const RowIndex index{ids};
+    EXPECT_EQ(RowIndex::Storage::Hash, index.getStorage());
+
+    EXPECT_EQ(BitSet(1, 3), index.idsToRows(BitSet(7, 1'000'000, 3'000'000'000u)));
+    EXPECT_EQ(BitSet(5, 42), index.rowsToIds(BitSet(0, 2)));
+    EXPECT_EQ(2u, index.idToRow(42));
+    EXPECT_FALSE(index.idToRow(6));
+}
+
+TEST(RowIndex, DataFrame) {
+    DataFrame dataframe;
+    dataframe.addColumn<float>("x", std::vector<float>{1.0f, 2.0f, 3.0f});
+    dataframe.updateIndexBuffer();
+    EXPECT_EQ(RowIndex::Storage::Identity, dataframe.getRowIndex()->getStorage());
+    EXPECT_EQ(BitSet(1, 2), dataframe.idsToRows(BitSet(1, 2)));
+
+    auto indexCol = dataframe.getIndexColumn();
+    indexCol->getTypedBuffer()->getEditableRAMRepresentation()->getDataContainer() = {7, 8, 9};
+    EXPECT_EQ(BitSet(0, 2), dataframe.idsToRows(BitSet(7, 9)));
+    EXPECT_EQ(BitSet(8), dataframe.rowsToIds(BitSet(1)));
+
+    const DataFrame copy{dataframe};
+    EXPECT_EQ(BitSet(1), copy.idsToRows(BitSet(8)));
+}
+
+}  // namespace inviwo
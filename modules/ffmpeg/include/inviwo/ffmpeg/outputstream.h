@@ -36,10 +36,6 @@
 #include <inviwo/ffmpeg/wrap/frame.h>
 #include <inviwo/ffmpeg/wrap/codec.h>
 #include <inviwo/ffmpeg/wrap/codecid.h>
-#include <inviwo/ffmpeg/wrap/swscale.h>
-
-#include <functional>
-#include <optional>
 
 extern "C" {
 #include <libavutil/avutil.h>
@@ -64,14 +60,9 @@ struct IVW_MODULE_FFMPEG_API OutputStream : NoMoveCopy {
 
     void openVideo(AVDictionary* opt_arg = nullptr);
 
-    Frame* fillFrame(Frame& dst, std::function<void(AVFrame* pict, int width, int height)> filler);
-
     enum AVPixelFormat sourceFormat;
     Codec codec;
     AVStream* stream;
-
-    std::optional<Frame> tmpFrame;
-    std::optional<SwScale> scaler;
 };
 
 }  // namespace inviwo::ffmpeg
@@ -32,6 +32,7 @@
 #include <inviwo/ffmpeg/ffmpegmoduledefine.h>
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/properties/fileproperty.h>
+#include <inviwo/core/properties/boolproperty.h>
 #include <inviwo/core/properties/buttonproperty.h>
 #include <inviwo/core/properties/ordinalproperty.h>
 #include <inviwo/core/properties/optionproperty.h>
@@ -68,6 +69,8 @@ private:
     OptionProperty<ffmpeg::Recorder::Mode> mode_;
     IntProperty frameRate_;
     IntProperty bitRate_;
+    BoolProperty waitForEncoder_;
+    IntProperty framesInFlight_;
     ButtonProperty start_;
     ButtonProperty stop_;
 
@@ -36,8 +36,10 @@
 #include <inviwo/ffmpeg/wrap/packet.h>
 #include <inviwo/ffmpeg/wrap/format.h>
 
+#include <atomic>
 #include <thread>
 #include <queue>
+#include <map>
 #include <vector>
 #include <filesystem>
 #include <mutex>
@@ -49,8 +51,31 @@ class IVW_MODULE_FFMPEG_API Recorder {
 public:
     enum class Mode { Time, Evaluation };
 
+    struct Settings {
+        /**
+         * Block in queueFrame until there is room for another frame instead of dropping it.
+         * Guarantees that every frame ends up in the output, at the cost of stalling the caller
+         * when frames are produced faster than they can be encoded.
+         */
+        bool waitWhenFull;
+        /**
+         * Maximum number of frames waiting for conversion or encoding.
+         */
+        size_t maxFramesInFlight;
+        /**
+         * Number of threads converting frames into the codec pixel format.
+         */
+        size_t conversionThreads;
+    };
+    static constexpr Settings defaultSettings{
+        .waitWhenFull = false, .maxFramesInFlight = 30, .conversionThreads = 2};
+
     Recorder(const std::filesystem::path& filename, OutputFormat format, Mode aMode,
-             OutputStream::Options opts);
+             OutputStream::Options opts, Settings settings = defaultSettings);
+    /**
+     * Stops the recording and waits for the queued frames. Errors that were not already
+     * rethrown by queueFrame are logged.
+     */
     ~Recorder();
 
     const OutputStream& getStream();
@@ -59,25 +84,45 @@ public:
     /**
      * Copies the image data in layer into a ffmpeg frames and enques that for encoding
      * The layer will not be used after the return of the function.
+     * If the maximum number of frames are in flight the frame is dropped, or if
+     * Settings::waitWhenFull is set the call blocks until a frame has been encoded.
      */
     void queueFrame(const LayerRAM& layer);
 
 private:
+    struct Job {
+        int64_t index;
+        Frame source;
+    };
+
     void run();
+    void convert();
+    void fail(std::exception_ptr e);
+    void recycle(Frame&& frame);
 
     Mode mode;
+    Settings settings_;
     Format out;
     OutputStream stream;
     Packet pkt;
+    bool needsConversion_;
 
-    std::queue<Frame> queue_;
+    std::queue<Job> jobs_;            // Frames waiting for conversion
+    std::map<int64_t, Frame> ready_;  // Frames waiting to be encoded, by index
+    std::vector<Frame> unusedSource_;
     std::vector<Frame> unused_;
+    size_t inFlight_;
+    int64_t queued_;
     std::mutex mutex_;
     std::condition_variable condition_;
+    std::condition_variable jobCondition_;
+    std::condition_variable spaceCondition_;
     std::atomic<bool> stop_;
+    std::atomic<bool> failed_;
     std::exception_ptr eptr;
     int frameRate;
 
+    std::vector<std::thread> converters_;
     std::thread worker;
 };
 
@@ -46,8 +46,13 @@ class FFmpegRecorder : public animation::Recorder {
 public:
     FFmpegRecorder(const std::filesystem::path& filename, ffmpeg::OutputFormat format,
                    ffmpeg::OutputStream::Options opts)
-        : recorder{std::make_unique<ffmpeg::Recorder>(filename, format,
-                                                      ffmpeg::Recorder::Mode::Evaluation, opts)} {
+        : recorder{std::make_unique<ffmpeg::Recorder>(
+              filename, format, ffmpeg::Recorder::Mode::Evaluation, opts,
+              // Animations are rendered offline, wait for the encoder rather than dropping frames
+              ffmpeg::Recorder::Settings{
+                  .waitWhenFull = true,
+                  .maxFramesInFlight = ffmpeg::Recorder::defaultSettings.maxFramesInFlight,
+                  .conversionThreads = ffmpeg::Recorder::defaultSettings.conversionThreads})} {
 
         util::logInfo(IVW_CONTEXT, "Recording to: {}", filename);
         util::logInfo(IVW_CONTEXT, "  - Format:   {}", recorder->getFormat().outputFormat().desc());
@@ -161,16 +166,22 @@ std::unique_ptr<animation::Recorder> FFmpegRecorderFactory::create(
 
     auto file = file_.get();
 
-    auto name = file.filename().string();
+    auto name = file.stem().string();
     replaceInString(name, "UPN", opts.sourceName);
-    file.replace_filename(name);
+    if (opts.partial) {
+        // Each part of a split rendering gets its own movie, named after its first frame
+        const auto digits =
+            std::max(fmt::formatted_size("{}", opts.expectedNumberOfFrames), size_t{4});
+        name = fmt::format("{}-{:0{}}", name, opts.firstFrame, digits);
+    }
+    file.replace_filename(name + file.extension().string());
 
     if (!overwrite_ && std::filesystem::is_regular_file(file)) {
         throw Exception(IVW_CONTEXT, "File already exists: {}", file);
     }
 
     return std::make_unique<FFmpegRecorder>(
-        file_.get(), format,
+        file, format,
         ffmpeg::OutputStream::Options{.codecId = codec_.getSelectedValue(),
                                       .width = static_cast<int>(opts.dimensions.x),
                                       .height = static_cast<int>(opts.dimensions.y),
@@ -35,7 +35,6 @@
 extern "C" {
 #include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
-#include <libswscale/swscale.h>
 }
 
 namespace inviwo::ffmpeg {
@@ -43,9 +42,7 @@ namespace inviwo::ffmpeg {
 OutputStream::OutputStream(Format& format, Options opts)
     : sourceFormat{opts.sourceFormat}
     , codec{opts.codecId ? opts.codecId : format.outputFormat().defaultVideoCodec()}
-    , stream{format.newStream()}
-    , tmpFrame{std::nullopt}
-    , scaler{std::nullopt} {
+    , stream{format.newStream()} {
 
     stream->id = format.ctx->nb_streams - 1;
 
@@ -93,31 +90,4 @@ void OutputStream::openVideo(AVDictionary* opt_arg) {
     }
 }
 
-Frame* OutputStream::fillFrame(Frame& dst,
-                               std::function<void(AVFrame* pict, int width, int height)> filler) {
-
-    /* when we pass a frame to the encoder, it may keep a reference to it
-     * internally; make sure we do not overwrite it here */
-    dst.makeWritable();
-
-    if (codec.ctx->pix_fmt != sourceFormat) {
-        if (!scaler) {
-            scaler.emplace(codec.ctx->width, codec.ctx->height, sourceFormat, codec.ctx->width,
-                           codec.ctx->height, codec.ctx->pix_fmt, SWS_BICUBIC, nullptr, nullptr,
-                           nullptr);
-        }
-        if (!tmpFrame) {
-            tmpFrame.emplace(sourceFormat, codec.ctx->width, codec.ctx->height);
-        }
-
-        filler(tmpFrame->frame, codec.ctx->width, codec.ctx->height);
-        scaler->scale((const uint8_t* const*)tmpFrame->frame->data, tmpFrame->frame->linesize, 0,
-                      codec.ctx->height, dst.frame->data, dst.frame->linesize);
-    } else {
-        filler(dst.frame, codec.ctx->width, codec.ctx->height);
-    }
-
-    return &dst;
-}
-
 }  // namespace inviwo::ffmpeg
@@ -91,12 +91,19 @@ MovieExport::MovieExport()
                util::ordinalCount<int>(8'000'000, 100'000'000)
                    .setMin(100'000)
                    .set("How many bits to spend per second"_help)}
+    , waitForEncoder_{"waitForEncoder", "Wait for Encoder",
+                      "Stall the network evaluation instead of dropping frames when the encoder "
+                      "can not keep up, makes sure that every frame ends up in the movie"_help,
+                      false}
+    , framesInFlight_{"framesInFlight", "Frames in Flight",
+                      util::ordinalCount<int>(30, 256).setMin(1).set(
+                          "Maximum number of frames waiting to be converted and encoded"_help)}
     , start_{"start", "Start"}
     , stop_{"stop", "Stop"} {
 
     addPorts(inport_);
     addProperties(file_, format_, activeFormat_, codec_, activeCodec_, mode_, frameRate_, bitRate_,
-                  start_, stop_);
+                  waitForEncoder_, framesInFlight_, start_, stop_);
 
     activeFormat_.setSerializationMode(PropertySerializationMode::None);
     activeFormat_.setReadOnly(true);
@@ -166,7 +173,11 @@ void MovieExport::process() {
                                           .width = static_cast<int>(img->getDimensions().x),
                                           .height = static_cast<int>(img->getDimensions().y),
                                           .frameRate = frameRate_,
-                                          .bitRate = bitRate_});
+                                          .bitRate = bitRate_},
+            ffmpeg::Recorder::Settings{
+                .waitWhenFull = waitForEncoder_.get(),
+                .maxFramesInFlight = static_cast<size_t>(framesInFlight_.get()),
+                .conversionThreads = ffmpeg::Recorder::defaultSettings.conversionThreads});
 
         notifyObserversStartBackgroundWork(this, 1);
 
@@ -29,14 +29,20 @@
 
 #include <inviwo/ffmpeg/recorder.h>
 
+#include <inviwo/core/util/exception.h>
 #include <inviwo/core/util/threadutil.h>
 #include <inviwo/core/util/logcentral.h>
 #include <inviwo/core/util/indexmapper.h>
 
+#include <inviwo/ffmpeg/wrap/swscale.h>
+
+#include <algorithm>
+
 extern "C" {
 
 #include <libavformat/avformat.h>
 #include <libavcodec/avcodec.h>
+#include <libswscale/swscale.h>
 }
 
 namespace inviwo::ffmpeg {
@@ -63,29 +69,88 @@ bool writeFrame(Format& format, Codec& codec, AVStream* st, const Frame& frame,
     return ret != AVERROR_EOF;
 }
 
+// this requires that .sourceFormat = AV_PIX_FMT_RGBA,
+void fillFrame(AVFrame* pict, int width, int height, const LayerRAM& layer) {
+    if (static_cast<int>(layer.getDimensions().x) != width ||
+        static_cast<int>(layer.getDimensions().y) != height) {
+        throw inviwo::Exception(IVW_CONTEXT_CUSTOM("ffmpeg::Recorder"),
+                                "Video dimensions do not match, expected: {}x{} got: {}x{}", width,
+                                height, layer.getDimensions().x, layer.getDimensions().y);
+    }
+
+    if (layer.getDataFormat()->getId() == DataFormatId::Vec4UInt8) {
+        auto* data = static_cast<const glm::tvec4<uint8_t>*>(layer.getData());
+        util::IndexMapper2D im{layer.getDimensions()};
+
+        if (pict->linesize[0] == 4 * width) {
+            auto imgStart = glm::value_ptr(data[im(0, 0)]);
+            std::copy(imgStart, imgStart + 4 * width * height, &pict->data[0][0]);
+        } else {
+            for (int y = 0; y < height; y++) {
+                auto rowStart = glm::value_ptr(data[im(0, y)]);
+                std::copy(rowStart, rowStart + 4 * width, &pict->data[0][y * pict->linesize[0]]);
+            }
+        }
+    } else {
+        layer.dispatch<void>([&](auto* rep) {
+            auto* data = rep->getDataTyped();
+            util::IndexMapper2D im{rep->getDimensions()};
+
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    auto pix = util::glm_convert_normalized<glm::tvec4<uint8_t>>(data[im(x, y)]);
+                    std::copy(glm::value_ptr(pix), glm::value_ptr(pix) + 4,
+                              &pict->data[0][y * pict->linesize[0] + x * 4]);
+                }
+            }
+        });
+    }
+}
+
 }  // namespace
 
 Recorder::Recorder(const std::filesystem::path& filename, OutputFormat format, Mode aMode,
-                   OutputStream::Options opts)
+                   OutputStream::Options opts, Settings settings)
     : mode{aMode}
+    , settings_{settings}
     , out{format, filename}
     , stream{out, opts}
     , pkt{}
-    , queue_{}
+    , needsConversion_{stream.codec.ctx->pix_fmt != stream.sourceFormat}
+    , jobs_{}
+    , ready_{}
+    , unusedSource_{}
     , unused_{}
+    , inFlight_{0}
+    , queued_{0}
     , mutex_{}
     , condition_{}
+    , jobCondition_{}
+    , spaceCondition_{}
     , stop_{false}
+    , failed_{false}
     , eptr{}
     , frameRate{opts.frameRate}
+    , converters_{}
     , worker{} {
 
+    settings_.maxFramesInFlight = std::max(settings_.maxFramesInFlight, size_t{1});
+
     /* Add the audio and video streams using the default format codecs
      * and initialize the codecs. */
     if (out.ctx->oformat->video_codec == AV_CODEC_ID_NONE) {
         throw inviwo::Exception(IVW_CONTEXT, "No video codec");
     }
 
+    if (needsConversion_) {
+        for (size_t i = 0; i < std::max(settings_.conversionThreads, size_t{1}); ++i) {
+            converters_.emplace_back([this]() {
+                util::setThreadDescription("Inviwo FFmpeg Conversion Thread");
+                convert();
+            });
+        }
+    }
+
     worker = std::thread{[this]() {
         util::setThreadDescription("Inviwo FFmpeg Thread");
         run();
@@ -93,11 +158,29 @@ Recorder::Recorder(const std::filesystem::path& filename, OutputFormat format, M
 }
 
 Recorder::~Recorder() {
-    stop_ = true;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    jobCondition_.notify_all();
     condition_.notify_all();
+    spaceCondition_.notify_all();
+    for (auto& converter : converters_) {
+        converter.join();
+    }
     worker.join();
+
+    // Errors that were never collected by queueFrame can not be thrown from here, log them
     if (eptr) {
-        std::rethrow_exception(eptr);
+        try {
+            std::rethrow_exception(eptr);
+        } catch (const Exception& e) {
+            util::log(e.getContext(), e.getMessage(), LogLevel::Error);
+        } catch (const std::exception& e) {
+            util::log(IVW_CONTEXT, e.what(), LogLevel::Error);
+        } catch (...) {
+            util::log(IVW_CONTEXT, "unknown error", LogLevel::Error);
+        }
     }
 }
 
@@ -105,72 +188,132 @@ const OutputStream& Recorder::getStream() { return stream; }
 const Format& Recorder::getFormat() { return out; }
 
 void Recorder::queueFrame(const LayerRAM& layer) {
-    std::optional<Frame> frame;
+    Frame frame;
     {
         std::unique_lock<std::mutex> lock(mutex_);
 
-        if (eptr) {
-            std::rethrow_exception(std::exchange(eptr, nullptr));
+        const auto checkFailed = [&]() {
+            if (eptr) {
+                std::rethrow_exception(std::exchange(eptr, nullptr));
+            } else if (failed_) {
+                throw inviwo::Exception(IVW_CONTEXT, "Recording has failed");
+            }
+        };
+        checkFailed();
+
+        if (inFlight_ >= settings_.maxFramesInFlight) {
+            if (settings_.waitWhenFull) {
+                spaceCondition_.wait(
+                    lock, [&]() { return failed_ || inFlight_ < settings_.maxFramesInFlight; });
+                checkFailed();
+            } else {
+                util::log(IVW_CONTEXT, "Queue saturated");
+                return;
+            }
+        }
+
+        ++inFlight_;
+        if (!unusedSource_.empty()) {
+            frame = std::move(unusedSource_.back());
+            unusedSource_.pop_back();
+        }
+    }
+
+    try {
+        if (!frame) {
+            frame = Frame{stream.sourceFormat, stream.codec.ctx->width, stream.codec.ctx->height};
+        }
+        /* when we pass a frame to the encoder, it may keep a reference to it
+         * internally; make sure we do not overwrite it here */
+        frame.makeWritable();
+        fillFrame(frame.frame, stream.codec.ctx->width, stream.codec.ctx->height, layer);
+    } catch (...) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            --inFlight_;
+            if (frame) unusedSource_.push_back(std::move(frame));
         }
+        spaceCondition_.notify_one();
+        throw;
+    }
 
-        if (!unused_.empty()) {
-            frame.emplace(std::move(unused_.back()));
-            unused_.pop_back();
-        } else if (queue_.size() < 30) {
-            frame.emplace(stream.codec.ctx->pix_fmt, stream.codec.ctx->width,
-                          stream.codec.ctx->height);
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        const auto index = queued_++;
+        if (needsConversion_) {
+            jobs_.push(Job{index, std::move(frame)});
         } else {
-            util::log(IVW_CONTEXT, "Queue saturated");
+            ready_.emplace(index, std::move(frame));
         }
     }
+    if (needsConversion_) {
+        jobCondition_.notify_one();
+    } else {
+        condition_.notify_one();
+    }
+}
 
-    if (frame) {
-        // this requires that .sourceFormat = AV_PIX_FMT_RGBA,
-        stream.fillFrame(*frame, [&](AVFrame* pict, int width, int height) {
-            if (static_cast<int>(layer.getDimensions().x) != width ||
-                static_cast<int>(layer.getDimensions().y) != height) {
-                throw inviwo::Exception(
-                    IVW_CONTEXT, "Video dimensions do not match, expected: {}x{} got: {}x{}", width,
-                    height, layer.getDimensions().x, layer.getDimensions().y);
-            }
+void Recorder::fail(std::exception_ptr e) {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!eptr) eptr = e;
+        failed_ = true;
+    }
+    jobCondition_.notify_all();
+    condition_.notify_all();
+    spaceCondition_.notify_all();
+}
 
-            if (layer.getDataFormat()->getId() == DataFormatId::Vec4UInt8) {
-                auto* data = static_cast<const glm::tvec4<uint8_t>*>(layer.getData());
-                util::IndexMapper2D im{layer.getDimensions()};
-
-                if (pict->linesize[0] == 4 * width) {
-                    auto imgStart = glm::value_ptr(data[im(0, 0)]);
-                    std::copy(imgStart, imgStart + 4 * width * height, &pict->data[0][0]);
-                } else {
-                    for (int y = 0; y < height; y++) {
-                        auto rowStart = glm::value_ptr(data[im(0, y)]);
-                        std::copy(rowStart, rowStart + 4 * width,
-                                  &pict->data[0][y * pict->linesize[0]]);
-                    }
+void Recorder::recycle(Frame&& frame) {
+    if (needsConversion_) {
+        unused_.push_back(std::move(frame));
+    } else {
+        unusedSource_.push_back(std::move(frame));
+    }
+}
+
+void Recorder::convert() {
+    const auto width = stream.codec.ctx->width;
+    const auto height = stream.codec.ctx->height;
+    const auto format = stream.codec.ctx->pix_fmt;
+
+    try {
+        // SwsContexts can not be shared between threads
+        SwScale scaler(width, height, stream.sourceFormat, width, height, format, SWS_BICUBIC,
+                       nullptr, nullptr, nullptr);
+
+        for (;;) {
+            Job job{};
+            Frame dst{};
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                jobCondition_.wait(lock, [&]() { return stop_ || failed_ || !jobs_.empty(); });
+                if (failed_ || jobs_.empty()) return;
+
+                job = std::move(jobs_.front());
+                jobs_.pop();
+                if (!unused_.empty()) {
+                    dst = std::move(unused_.back());
+                    unused_.pop_back();
                 }
-            } else {
-                layer.dispatch<void>([&](auto* rep) {
-                    auto* data = rep->getDataTyped();
-                    util::IndexMapper2D im{rep->getDimensions()};
-
-                    for (int y = 0; y < height; y++) {
-                        for (int x = 0; x < width; x++) {
-                            auto pix =
-                                util::glm_convert_normalized<glm::tvec4<uint8_t>>(data[im(x, y)]);
-                            std::copy(glm::value_ptr(pix), glm::value_ptr(pix) + 4,
-                                      &pict->data[0][y * pict->linesize[0] + x * 4]);
-                        }
-                    }
-                });
             }
-        });
 
-        {
-            std::unique_lock<std::mutex> lock(mutex_);
-            queue_.push(std::move(*frame));
+            if (!dst) dst = Frame{format, width, height};
+            dst.makeWritable();
+            scaler.scale((const uint8_t* const*)job.source.frame->data,
+                         job.source.frame->linesize, 0, height, dst.frame->data,
+                         dst.frame->linesize);
+
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                unusedSource_.push_back(std::move(job.source));
+                ready_.emplace(job.index, std::move(dst));
+            }
+            condition_.notify_one();
         }
+    } catch (...) {
+        fail(std::current_exception());
     }
-    condition_.notify_one();
 }
 
 void Recorder::run() {
@@ -191,56 +334,71 @@ void Recorder::run() {
 
         {
             std::unique_lock<std::mutex> lock(mutex_);
-            condition_.wait(lock, [&]() { return stop_ || !queue_.empty(); });
+            condition_.wait(lock, [&]() { return stop_ || failed_ || ready_.contains(0); });
         }
 
         int64_t frameCount = 0;
         Frame frame{};
 
+        // Take the next frame in order, if it is ready. Needs to hold the lock.
+        const auto takeNext = [&]() {
+            if (auto it = ready_.find(frameCount); it != ready_.end()) {
+                if (frame) recycle(std::move(frame));
+                frame = std::move(it->second);
+                ready_.erase(it);
+                --inFlight_;
+                return true;
+            }
+            return false;
+        };
+
         const auto start = clock::now();
 
         if (mode == Mode::Time) {
             const std::chrono::microseconds frameTime{1'000'000 / frameRate};
 
             auto next = start;
+            int64_t written = 0;
 
-            while (!stop_) {
+            while (!stop_ && !failed_) {
                 {
                     std::unique_lock<std::mutex> lock(mutex_);
                     condition_.wait_until(lock, next, [&]() {
-                        return stop_ || !queue_.empty() || clock::now() > next;
+                        return stop_ || failed_ || ready_.contains(frameCount) ||
+                               clock::now() > next;
                     });
-
-                    if (!queue_.empty()) {
-                        if (frame) unused_.emplace_back(std::move(frame));
-                        frame = std::move(queue_.front());
-                        queue_.pop();
-                    }
+                    if (takeNext()) ++frameCount;
                 }
+                spaceCondition_.notify_one();
 
-                frame.frame->pts = frameCount++;
-                writeFrame(out, stream.codec, stream.stream, frame, pkt);
+                if (frame) {
+                    frame.frame->pts = written++;
+                    writeFrame(out, stream.codec, stream.stream, frame, pkt);
+                }
                 next += frameTime;
             }
+            frameCount = written;
 
         } else if (mode == Mode::Evaluation) {
-            while (!stop_) {
+            for (;;) {
                 {
                     std::unique_lock<std::mutex> lock(mutex_);
-                    condition_.wait(lock, [&]() { return stop_ || !queue_.empty(); });
-
-                    if (!queue_.empty()) {
-                        if (frame) unused_.emplace_back(std::move(frame));
-                        frame = std::move(queue_.front());
-                        queue_.pop();
-                    }
+                    // Keep going until all queued frames are encoded, also after a stop
+                    condition_.wait(lock, [&]() {
+                        return failed_ || ready_.contains(frameCount) ||
+                               (stop_ && frameCount == queued_);
+                    });
+                    if (failed_ || !takeNext()) break;
                 }
+                spaceCondition_.notify_one();
 
                 frame.frame->pts = frameCount++;
                 writeFrame(out, stream.codec, stream.stream, frame, pkt);
             }
         }
 
+        if (failed_) return;
+
         // Flush the encoder
         writeFrame(out, stream.codec, stream.stream, Frame{}, pkt);
 
@@ -253,8 +411,7 @@ void Recorder::run() {
                                     << static_cast<double>(frameCount) / ms.count() * 1000);
 
     } catch (...) {
-        std::unique_lock<std::mutex> lock(mutex_);
-        eptr = std::current_exception();
+        fail(std::current_exception());
     }
 }
 
@@ -0,0 +1,279 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/ffmpeg/recorder.h>
+#include <inviwo/ffmpeg/wrap/codecid.h>
+#include <inviwo/ffmpeg/wrap/outputformat.h>
+#include <inviwo/ffmpeg/wrap/packet.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/raiiutils.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+}
+
+namespace inviwo {
+
+namespace {
+
+constexpr int width = 64;
+constexpr int height = 48;
+
+std::unique_ptr<LayerRAMPrecision<glm::u8vec4>> makeLayer(int index,
+                                                          size2_t dims = size2_t{width, height}) {
+    const auto value = static_cast<unsigned char>(10 + 6 * index);
+    auto layer = std::make_unique<LayerRAMPrecision<glm::u8vec4>>(dims);
+    std::fill_n(layer->getDataTyped(), dims.x * dims.y, glm::u8vec4{value, value, value, 255});
+    return layer;
+}
+
+/// The luma swscale produces for a gray frame from makeLayer, using limited range BT.601
+double expectedLuma(int index) { return 16.0 + 219.0 * (10.0 + 6.0 * index) / 255.0; }
+
+std::filesystem::path testDir() {
+    const auto dir = std::filesystem::temp_directory_path() / "inviwo-ffmpeg-recorder-test";
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+std::unique_ptr<ffmpeg::Recorder> makeRecorder(const std::filesystem::path& file,
+                                               ffmpeg::Recorder::Settings settings) {
+    ffmpeg::OutputStream::Options opts;
+    opts.codecId = ffmpeg::CodecID{AV_CODEC_ID_MPEG4};
+    opts.width = width;
+    opts.height = height;
+    opts.bitRate = 4'000'000;
+    // nut can be written to a pipe, which the tests use to stall the encoder
+    return std::make_unique<ffmpeg::Recorder>(file, ffmpeg::OutputFormat{"nut"},
+                                              ffmpeg::Recorder::Mode::Evaluation, opts, settings);
+}
+
+/// Decodes the video in file and returns the mean luma of each frame
+std::vector<double> decodeLuma(const std::filesystem::path& file) {
+    const auto context = IVW_CONTEXT_CUSTOM("decodeLuma");
+
+    AVFormatContext* format = nullptr;
+    if (avformat_open_input(&format, file.string().c_str(), nullptr, nullptr) < 0) {
+        throw Exception(context, "Could not open '{}'", file.string());
+    }
+    util::OnScopeExit closeFormat{[&]() { avformat_close_input(&format); }};
+    if (avformat_find_stream_info(format, nullptr) < 0) {
+        throw Exception(context, "Could not find stream info");
+    }
+
+    const AVCodec* decoder = nullptr;
+    const int streamIndex = av_find_best_stream(format, AVMEDIA_TYPE_VIDEO, -1, -1, &decoder, 0);
+    if (streamIndex < 0) throw Exception(context, "No video stream");
+
+    AVCodecContext* codec = avcodec_alloc_context3(decoder);
+    util::OnScopeExit freeCodec{[&]() { avcodec_free_context(&codec); }};
+    avcodec_parameters_to_context(codec, format->streams[streamIndex]->codecpar);
+    if (avcodec_open2(codec, decoder, nullptr) < 0) {
+        throw Exception(context, "Could not open decoder");
+    }
+
+    AVFrame* frame = av_frame_alloc();
+    util::OnScopeExit freeFrame{[&]() { av_frame_free(&frame); }};
+    ffmpeg::Packet packet;
+
+    std::vector<double> luma;
+    const auto receive = [&]() {
+        while (avcodec_receive_frame(codec, frame) == 0) {
+            double sum = 0.0;
+            for (int y = 0; y < frame->height; ++y) {
+                const auto* row = frame->data[0] + y * frame->linesize[0];
+                sum += std::accumulate(row, row + frame->width, 0.0);
+            }
+            luma.push_back(sum / (frame->width * frame->height));
+            av_frame_unref(frame);
+        }
+    };
+    while (av_read_frame(format, packet.pkt) >= 0) {
+        if (packet.pkt->stream_index == streamIndex) {
+            avcodec_send_packet(codec, packet.pkt);
+            receive();
+        }
+        av_packet_unref(packet.pkt);
+    }
+    avcodec_send_packet(codec, nullptr);
+    receive();
+
+    return luma;
+}
+
+}  // namespace
+
+TEST(FFmpegRecorder, framesAreEncodedInOrder) {
+    const auto file = testDir() / "order.nut";
+    constexpr int frames = 30;
+    {
+        // Several conversion threads and a small budget to make them finish out of order
+        auto recorder = makeRecorder(file, {.waitWhenFull = true,
+                                            .maxFramesInFlight = 4,
+                                            .conversionThreads = 4});
+        for (int i = 0; i < frames; ++i) {
+            recorder->queueFrame(*makeLayer(i));
+        }
+    }
+
+    const auto luma = decodeLuma(file);
+    ASSERT_EQ(static_cast<size_t>(frames), luma.size());
+    for (int i = 0; i < frames; ++i) {
+        EXPECT_NEAR(expectedLuma(i), luma[i], 2.0) << "frame " << i;
+    }
+    std::filesystem::remove(file);
+}
+
+TEST(FFmpegRecorder, wrongDimensionsThrowAndRecordingContinues) {
+    const auto file = testDir() / "dimensions.nut";
+    {
+        auto recorder = makeRecorder(file, ffmpeg::Recorder::defaultSettings);
+        recorder->queueFrame(*makeLayer(0));
+        EXPECT_THROW(recorder->queueFrame(*makeLayer(1, size2_t{width / 2, height})), Exception);
+        recorder->queueFrame(*makeLayer(2));
+    }
+
+    const auto luma = decodeLuma(file);
+    ASSERT_EQ(2u, luma.size());
+    EXPECT_NEAR(expectedLuma(0), luma[0], 2.0);
+    EXPECT_NEAR(expectedLuma(2), luma[1], 2.0);
+    std::filesystem::remove(file);
+}
+
+TEST(FFmpegRecorder, encoderErrorIsRethrownByQueueFrame) {
+    const auto file = testDir() / "missing" / "error.nut";
+    std::filesystem::remove_all(file.parent_path());
+
+    // The encoder fails to open the file. With a budget of one frame the second call has to
+    // wait for the encoder, so it sees the error even if the first call was too early.
+    auto recorder = makeRecorder(file, {.waitWhenFull = true,
+                                        .maxFramesInFlight = 1,
+                                        .conversionThreads = 1});
+    const auto layer = makeLayer(0);
+    EXPECT_THROW(
+        {
+            recorder->queueFrame(*layer);
+            recorder->queueFrame(*layer);
+        },
+        Exception);
+    EXPECT_THROW(recorder->queueFrame(*layer), Exception);
+    EXPECT_NO_THROW(recorder.reset());
+}
+
+TEST(FFmpegRecorder, uncollectedErrorIsNotThrownFromDestructor) {
+    const auto file = testDir() / "missing" / "error.nut";
+    std::filesystem::remove_all(file.parent_path());
+
+    auto recorder = makeRecorder(file, ffmpeg::Recorder::defaultSettings);
+    EXPECT_NO_THROW(recorder.reset());
+}
+
+#ifndef _WIN32
+// The encoder blocks when opening a fifo until there is a reader, which gives the tests full
+// control over when frames leave the queue.
+
+TEST(FFmpegRecorder, framesAreDroppedWhenQueueIsFull) {
+    const auto fifo = testDir() / "drop.nut";
+    std::filesystem::remove(fifo);
+    ASSERT_EQ(0, mkfifo(fifo.c_str(), 0600));
+
+    auto recorder = makeRecorder(fifo, {.waitWhenFull = false,
+                                        .maxFramesInFlight = 3,
+                                        .conversionThreads = 2});
+    for (int i = 0; i < 10; ++i) {
+        recorder->queueFrame(*makeLayer(i));
+    }
+
+    auto reader = std::async(std::launch::async, [&]() { return decodeLuma(fifo); });
+    recorder.reset();
+    const auto luma = reader.get();
+
+    ASSERT_EQ(3u, luma.size());
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_NEAR(expectedLuma(i), luma[i], 2.0) << "frame " << i;
+    }
+    std::filesystem::remove(fifo);
+}
+
+TEST(FFmpegRecorder, queueFrameWaitsWhenQueueIsFull) {
+    const auto fifo = testDir() / "wait.nut";
+    std::filesystem::remove(fifo);
+    ASSERT_EQ(0, mkfifo(fifo.c_str(), 0600));
+
+    constexpr int frames = 6;
+    auto recorder = makeRecorder(fifo, {.waitWhenFull = true,
+                                        .maxFramesInFlight = 2,
+                                        .conversionThreads = 2});
+    std::atomic<int> queued{0};
+    std::thread producer{[&]() {
+        for (int i = 0; i < frames; ++i) {
+            recorder->queueFrame(*makeLayer(i));
+            ++queued;
+        }
+    }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_EQ(2, queued.load());
+
+    auto reader = std::async(std::launch::async, [&]() { return decodeLuma(fifo); });
+    producer.join();
+    EXPECT_EQ(frames, queued.load());
+    recorder.reset();
+    const auto luma = reader.get();
+
+    ASSERT_EQ(static_cast<size_t>(frames), luma.size());
+    for (int i = 0; i < frames; ++i) {
+        EXPECT_NEAR(expectedLuma(i), luma[i], 2.0) << "frame " << i;
+    }
+    std::filesystem::remove(fifo);
+}
+#endif
+
+}  // namespace inviwo
@@ -34,10 +34,10 @@
 #include <inviwo/core/util/glmvec.h>                               // for vec4, ivec2, size2_t
 #include <modules/fontrendering/datastructures/textboundingbox.h>  // for TextBoundingBox
 #include <modules/fontrendering/util/fontutils.h>                  // for getFont, FontType, Fon...
+#include <modules/fontrendering/util/glyphtable.h>                 // for GlyphTable
 #include <modules/opengl/buffer/framebufferobject.h>               // for FrameBufferObject
 #include <modules/opengl/openglutils.h>                            // for BlendModeState (ptr only)
 
-#include <map>            // for map, map<>::value_compare
 #include <memory>         // for shared_ptr
 #include <string>         // for string
 #include <tuple>          // for tuple
@@ -297,7 +297,7 @@ protected:
 
     using FontFamilyStyle =
         std::tuple<std::string, std::string, int>;  // holds font family, style, and size
-    using GlyphMap = std::map<unsigned int, GlyphEntry>;
+    using GlyphMap = GlyphTable<GlyphEntry>;
 
     struct FontCache {
         std::shared_ptr<Texture2D> glyphTex;
@@ -0,0 +1,242 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <modules/fontrendering/fontrenderingmoduledefine.h>  // for IVW_MODULE_FONTRENDERI...
+
+#include <inviwo/core/datastructures/image/layerram.h>             // for LayerRAMPrecision
+#include <inviwo/core/util/glmvec.h>                               // for vec4, ivec2, size2_t
+#include <modules/fontrendering/datastructures/textboundingbox.h>  // for TextBoundingBox
+#include <modules/fontrendering/util/fontutils.h>                  // for getFont, FontType, Fon...
+#include <modules/fontrendering/util/glyphtable.h>                 // for GlyphTable
+
+#include <filesystem>     // for path
+#include <memory>         // for shared_ptr, unique_ptr
+#include <string>         // for string
+#include <string_view>    // for string_view
+#include <tuple>          // for tuple
+#include <unordered_map>  // for unordered_map
+
+#include <freetype/config/ftheader.h>  // for FT_FREETYPE_H
+
+namespace inviwo {
+class FontSettings;
+class Layer;
+}  // namespace inviwo
+
+#include FT_FREETYPE_H
+
+namespace inviwo {
+
+/**
+ * \class TextRendererCPU
+ *
+ * \brief Render text into a LayerRAM using the FreeType font library without OpenGL
+ *
+ * The CPU counterpart of the TextRenderer. Glyphs are rasterized by FreeType into a single
+ * channel glyph atlas per font, family, and size. Text is then composited into any LayerRAM by
+ * alpha blending the glyph coverage with premultiplied alpha, matching the blending of the
+ * TextRenderer. The text layout, i.e. line height, baseline, and bounding boxes, is identical to
+ * the one of the TextRenderer and it can hence be used in headless applications and in
+ * background jobs where no OpenGL context is available.
+ *
+ * Glyphs are looked up in a GlyphTable which directly indexes the Latin-1 range.
+ *
+ * \see TextRenderer
+ */
+class IVW_MODULE_FONTRENDERING_API TextRendererCPU {
+public:
+    TextRendererCPU(const std::filesystem::path& fontPath = font::getFont(font::FontType::Default,
+                                                                          font::FullPath::Yes));
+    TextRendererCPU(const TextRendererCPU& rhs) = delete;
+    TextRendererCPU(TextRendererCPU&& rhs) noexcept;
+    TextRendererCPU& operator=(const TextRendererCPU& rhs) = delete;
+    TextRendererCPU& operator=(TextRendererCPU&& rhs) noexcept;
+    ~TextRendererCPU();
+
+    /**
+     * \brief replace the currently loaded font face with a new one
+     *
+     * @param fontPath   full path to the new font face
+     * @throws Exception      if the font file could not be opened
+     * @throws FileException  if the font format is unsupported
+     */
+    void setFont(const std::filesystem::path& fontPath);
+
+    /**
+     * \brief renders the given string with the specified color into a subregion of the
+     * destination. The text is blended on top of the existing content, pixels outside of the
+     * destination are discarded.
+     *
+     * @param dest            the text will be rendered into this layer
+     * @param textBoundingBox the text bounding box of the given str
+     * @param origin          origin of sub region within the destination (lower left corner, in
+     *                        pixel)
+     * @param str             input string
+     * @param color           color of rendered text
+     */
+    void render(LayerRAM& dest, const TextBoundingBox& textBoundingBox, const ivec2& origin,
+                std::string_view str, const vec4& color);
+
+    /**
+     * \brief renders the given string with the specified color into the destination. The lower
+     * left corner of the glyph bounding box is placed at origin.
+     *
+     * @see render(LayerRAM&, const TextBoundingBox&, const ivec2&, std::string_view, const vec4&)
+     */
+    void render(LayerRAM& dest, const ivec2& origin, std::string_view str, const vec4& color);
+
+    /**
+     * \brief computes the glyph bounding box of a given string in pixels (screen space).
+     * @see TextRenderer::computeTextSize
+     */
+    size2_t computeTextSize(std::string_view str);
+
+    /**
+     * \brief computes the bounding boxes of both text and all glyphs for a given string in pixels
+     * (screen space).
+     * @see TextRenderer::computeBoundingBox
+     */
+    TextBoundingBox computeBoundingBox(std::string_view str);
+
+    void setFontSize(int val);
+    int getFontSize() const { return fontSize_; }
+
+    /**
+     * \brief sets the line spacing relative to the font size (default 0.2 = 20%)
+     *
+     * @param lineSpacing   factor for line spacing
+     */
+    void setLineSpacing(double lineSpacing);
+    double getLineSpacing() const;
+
+    void setLineHeight(int lineHeight);
+    int getLineHeight() const;
+
+    /**
+     * \brief returns the offset of the baseline, which corresponds to ascent
+     */
+    int getBaseLineOffset() const;
+
+    /**
+     * \brief returns the size of the font part below the baseline, which corresponds to descent
+     */
+    int getBaseLineDescender() const;
+
+    void configure(const FontSettings& settings);
+
+    /**
+     * \brief returns the glyph atlas of the current font, family, and size. Glyph bitmaps are
+     * stored top row first, i.e. upside down compared to other layers. The atlas grows on demand
+     * when new glyphs are requested.
+     */
+    const LayerRAMPrecision<unsigned char>& getAtlas();
+
+protected:
+    struct GlyphEntry {
+        ivec2 advance{0};
+        ivec2 size{0};       // corresponds to ivec2(bitmap.width, bitmap.rows)
+        ivec2 bearing{0};    // corresponds to ivec2(bitmap_left, bitmap_top)
+        ivec2 atlasPos{0};   //!< position in glyph atlas
+        bool valid = false;  //!< false if FreeType failed to load the glyph
+    };
+
+    using FontFamilyStyle =
+        std::tuple<std::string, std::string, int>;  // holds font family, style, and size
+
+    struct FontCache {
+        std::unique_ptr<LayerRAMPrecision<unsigned char>> atlas;
+        GlyphTable<GlyphEntry> glyphs;
+
+        // shelf packing state of the atlas
+        ivec2 shelfPos{0};
+        int shelfHeight = 0;
+    };
+
+    /**
+     * \brief request glyph information from the glyph atlas. The glyph will be rasterized and
+     * added to the atlas if it isn't registered yet. Glyphs which could not be loaded are cached
+     * as invalid entries.
+     */
+    const GlyphEntry& requestGlyph(FontCache& fc, unsigned int glyph);
+    GlyphEntry& addGlyph(FontCache& fc, unsigned int glyph);
+    ivec2 allocate(FontCache& fc, const ivec2& extent);
+
+    FontCache& getFontCache();
+    FontFamilyStyle getFontTuple() const;
+
+    /**
+     * Lays out str and calls `callable(const GlyphEntry* glyph, ivec2 topLeft, ivec2 penPos)` for
+     * each glyph and tab. topLeft is the upper left corner of the glyph relative to the start of
+     * the first baseline with y pointing downwards and penPos the pen position after the glyph.
+     * For tabs glyph is nullptr. Returns the accumulated vertical offset of all line breaks.
+     */
+    template <typename Callable>
+    int layout(FontCache& fc, std::string_view str, Callable&& callable);
+
+    double getFontAscender() const;
+    double getFontDescender() const;
+
+    std::string_view::const_iterator validateString(std::string_view str) const;
+
+    static constexpr char lf = '\n';   // Line Feed Ascii for std::endl, \n
+    static constexpr char tab = '\t';  // Tab Ascii
+
+    std::unordered_map<FontFamilyStyle, FontCache> glyphAtlas_;
+
+    FT_Library fontlib_;
+    FT_Face fontface_;
+
+    int fontSize_;        //<! font size in pixel
+    double lineSpacing_;  //!< spacing between two lines in percent (default = 0.2)
+
+    static constexpr int glyphMargin_ = 1;   //<! margin around glyphs in the atlas
+    static constexpr int atlasWidth_ = 512;  //<! initial width of the glyph atlas
+};
+
+namespace util {
+
+/**
+ * \brief Creates a layer with rendered text for a given string
+ *
+ * The CPU counterpart of util::createTextTexture. The size of the layer will be the smallest
+ * possible for the given text and the pixels containing no text will have zero alpha.
+ *
+ * @param textRenderer The renderer that will be used to render the text
+ * @param text         text to be rendered
+ * @param fontColor    the final color of the text
+ * @return RGBA8 layer with the rendered text
+ */
+IVW_MODULE_FONTRENDERING_API std::shared_ptr<Layer> createTextLayer(TextRendererCPU& textRenderer,
+                                                                    std::string_view text,
+                                                                    vec4 fontColor);
+
+}  // namespace util
+
+}  // namespace inviwo
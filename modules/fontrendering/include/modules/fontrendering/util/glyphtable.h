@@ -0,0 +1,111 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <modules/fontrendering/fontrenderingmoduledefine.h>  // for IVW_MODULE_FONTRENDERING...
+
+#include <array>          // for array
+#include <bitset>         // for bitset
+#include <cstddef>        // for size_t
+#include <unordered_map>  // for unordered_map
+#include <utility>        // for move
+
+namespace inviwo {
+
+/**
+ * \class GlyphTable
+ * \brief Lookup table for glyph data keyed on the unicode character code
+ *
+ * Character codes in the Latin-1 range, which covers almost all text in labels and annotations,
+ * are stored in a flat array and found by direct indexing. All other codes fall back to a hash
+ * map.
+ */
+template <typename T>
+class GlyphTable {
+public:
+    static constexpr unsigned int directSize = 256;
+
+    /**
+     * Returns a pointer to the entry of @p code or nullptr if there is none.
+     */
+    T* find(unsigned int code) {
+        if (code < directSize) {
+            return present_[code] ? &direct_[code] : nullptr;
+        }
+        auto it = other_.find(code);
+        return it != other_.end() ? &it->second : nullptr;
+    }
+    const T* find(unsigned int code) const { return const_cast<GlyphTable*>(this)->find(code); }
+
+    /**
+     * Returns the entry of @p code, a default constructed entry is inserted if there is none.
+     */
+    T& operator[](unsigned int code) {
+        if (code < directSize) {
+            present_.set(code);
+            return direct_[code];
+        }
+        return other_[code];
+    }
+
+    /**
+     * Insert or replace the entry of @p code.
+     */
+    T& insert(unsigned int code, T value) { return (*this)[code] = std::move(value); }
+
+    size_t size() const { return present_.count() + other_.size(); }
+    bool empty() const { return size() == 0; }
+
+    void clear() {
+        direct_.fill(T{});
+        present_.reset();
+        other_.clear();
+    }
+
+    /**
+     * Calls @p callable with the character code and a reference to the entry for each entry in
+     * the table, i.e. `callable(unsigned int code, T& entry)`.
+     */
+    template <typename Callable>
+    void forEach(Callable&& callable) {
+        for (unsigned int code = 0; code < directSize; ++code) {
+            if (present_[code]) callable(code, direct_[code]);
+        }
+        for (auto& [code, entry] : other_) {
+            callable(code, entry);
+        }
+    }
+
+private:
+    std::array<T, directSize> direct_{};
+    std::bitset<directSize> present_;
+    std::unordered_map<unsigned int, T> other_;
+};
+
+}  // namespace inviwo
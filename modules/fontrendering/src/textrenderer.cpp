@@ -472,9 +472,8 @@ double TextRenderer::getFontDescender() const {
 std::pair<bool, TextRenderer::GlyphEntry> TextRenderer::requestGlyph(FontCache& fc,
                                                                      unsigned int glyph) {
     // try to find the glyph
-    auto it = fc.glyphMap.find(glyph);
-    if (it != fc.glyphMap.end()) {
-        return std::make_pair(true, it->second);
+    if (const auto* entry = fc.glyphMap.find(glyph)) {
+        return std::make_pair(true, *entry);
     } else {
         // glyph doesn't exist yet. Try to add glyph
         return addGlyph(fc, glyph);
@@ -530,7 +529,7 @@ std::pair<bool, TextRenderer::GlyphEntry> TextRenderer::addGlyph(FontCache& fc,
         fc.lineHeights.push_back(glyphExtent.y + fc.lineHeights.back());
     }
 
-    fc.glyphMap.insert({glyph, glyphEntry});
+    fc.glyphMap.insert(glyph, glyphEntry);
     uploadGlyph(fc, glyph);
 
     return std::make_pair(true, glyphEntry);
@@ -539,15 +538,15 @@ std::pair<bool, TextRenderer::GlyphEntry> TextRenderer::addGlyph(FontCache& fc,
 void TextRenderer::uploadGlyph(FontCache& fc, unsigned int glyph) {
     fc.glyphTex->bind();
 
-    const auto it = fc.glyphMap.find(glyph);
-    if (it == fc.glyphMap.end()) {
+    const auto* entry = fc.glyphMap.find(glyph);
+    if (!entry) {
         // glyph is not registered
         return;
     }
 
     if (FT_Load_Char(fontface_, glyph, FT_LOAD_RENDER)) return;
 
-    const auto& elem = it->second;
+    const auto& elem = *entry;
     glTexSubImage2D(GL_TEXTURE_2D, 0, elem.texAtlasPos.x, elem.texAtlasPos.y, elem.size.x,
                     elem.size.y, GL_RED, GL_UNSIGNED_BYTE, fontface_->glyph->bitmap.buffer);
 }
@@ -600,12 +599,12 @@ void TextRenderer::createDefaultGlyphAtlas() {
             continue;
         }
 
-        const auto it = fc.glyphMap.find(c);
-        if (it == fc.glyphMap.end()) {
+        const auto* entry = fc.glyphMap.find(c);
+        if (!entry) {
             // glyph is not registered
             continue;
         }
-        const auto& elem = it->second;
+        const auto& elem = *entry;
         if (fontface_->glyph->bitmap.buffer) {
             glTexSubImage2D(GL_TEXTURE_2D, 0, elem.texAtlasPos.x, elem.texAtlasPos.y, elem.size.x,
                             elem.size.y, GL_RED, GL_UNSIGNED_BYTE, fontface_->glyph->bitmap.buffer);
@@ -661,9 +660,9 @@ std::shared_ptr<Texture2D> TextRenderer::createAtlasTexture(FontCache& fc) {
         // update y positions of all elements
         std::partial_sum(lineHeights.begin(), lineHeights.end(), lineHeights.begin());
         lineHeights.insert(lineHeights.begin(), 0);
-        for (auto& elem : fc.glyphMap) {
-            elem.second.texAtlasPos.y = lineHeights[elem.second.texAtlasPos.y] + margin;
-        }
+        fc.glyphMap.forEach([&](unsigned int, GlyphEntry& elem) {
+            elem.texAtlasPos.y = lineHeights[elem.texAtlasPos.y] + margin;
+        });
 
         fc.lineLengths = std::move(lineLengths);
         fc.lineHeights = std::move(lineHeights);
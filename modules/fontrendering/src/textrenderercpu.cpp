@@ -0,0 +1,434 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <modules/fontrendering/textrenderercpu.h>
+
+#include <inviwo/core/datastructures/image/layer.h>                // for Layer
+#include <inviwo/core/datastructures/image/layerram.h>             // for LayerRAMPrecision
+#include <inviwo/core/util/exception.h>                            // for Exception, FileException
+#include <inviwo/core/util/formatdispatching.h>                    // for PrecisionValueType
+#include <inviwo/core/util/glmconvert.h>                           // for glm_convert_normalized
+#include <inviwo/core/util/glmvec.h>                               // for ivec2, vec4, size2_t
+#include <inviwo/core/util/logcentral.h>                           // for LogWarn
+#include <inviwo/core/util/sourcecontext.h>                        // for IVW_CONTEXT
+#include <inviwo/core/util/stdextensions.h>                        // for hash
+#include <modules/fontrendering/datastructures/fontsettings.h>     // for FontSettings
+#include <modules/fontrendering/datastructures/textboundingbox.h>  // for TextBoundingBox
+
+#include <algorithm>    // for max, min, copy_n
+#include <cstdint>      // for uint32_t
+#include <limits>       // for numeric_limits
+#include <ostream>      // for operator<<, basic_ostream
+#include <type_traits>  // for is_same_v
+
+#include <freetype/freetype.h>        // for FT_FaceRec_, FT_GlyphS...
+#include <freetype/fterrors.h>        // for FT_Err_Unknown_File_Fo...
+#include <freetype/ftimage.h>         // for FT_Bitmap
+#include <glm/common.hpp>             // for max, min, clamp
+#include <glm/fwd.hpp>                // for u8vec4
+#include <glm/vec4.hpp>               // for operator*, operator+
+#include <glm/vector_relational.hpp>  // for any, greaterThan
+#include <utf8/checked.h>             // for iterator
+#include <utf8/core.h>                // for find_invalid
+
+#include <fmt/std.h>
+
+namespace inviwo {
+
+TextRendererCPU::TextRendererCPU(const std::filesystem::path& fontPath)
+    : fontface_(nullptr), fontSize_(10), lineSpacing_(0.2) {
+
+    if (FT_Init_FreeType(&fontlib_)) {
+        throw Exception("Could not initialize FreeType library", IVW_CONTEXT);
+    }
+
+    setFont(fontPath);
+}
+
+TextRendererCPU::TextRendererCPU(TextRendererCPU&& rhs) noexcept
+    : glyphAtlas_(std::move(rhs.glyphAtlas_))
+    , fontlib_(rhs.fontlib_)
+    , fontface_(rhs.fontface_)
+    , fontSize_(rhs.fontSize_)
+    , lineSpacing_(rhs.lineSpacing_) {
+    rhs.fontlib_ = nullptr;
+    rhs.fontface_ = nullptr;
+}
+
+TextRendererCPU& TextRendererCPU::operator=(TextRendererCPU&& rhs) noexcept {
+    if (this != &rhs) {
+        if (fontlib_) {
+            FT_Done_FreeType(fontlib_);
+        }
+
+        glyphAtlas_ = std::move(rhs.glyphAtlas_);
+        fontlib_ = rhs.fontlib_;
+        fontface_ = rhs.fontface_;
+        fontSize_ = rhs.fontSize_;
+        lineSpacing_ = rhs.lineSpacing_;
+
+        rhs.fontlib_ = nullptr;
+        rhs.fontface_ = nullptr;
+    }
+    return *this;
+}
+
+TextRendererCPU::~TextRendererCPU() {
+    if (fontlib_) {
+        FT_Done_FreeType(fontlib_);
+    }
+}
+
+void TextRendererCPU::setFont(const std::filesystem::path& fontPath) {
+    // free previous font face
+    if (fontface_) {
+        FT_Done_Face(fontface_);
+    }
+    fontface_ = nullptr;
+
+    int error = FT_New_Face(fontlib_, fontPath.string().c_str(), 0, &fontface_);
+    if (error == FT_Err_Unknown_File_Format) {
+        throw Exception(IVW_CONTEXT, "Unsupported font format: {}", fontPath);
+    } else if (error) {
+        throw FileException(IVW_CONTEXT, "Could not open font file: {}", fontPath);
+    }
+
+    FT_Select_Charmap(fontface_, ft_encoding_unicode);
+    FT_Set_Pixel_Sizes(fontface_, 0, fontSize_);
+}
+
+std::string_view::const_iterator TextRendererCPU::validateString(std::string_view str) const {
+    // check input string for invalid utf8 encoding, process only valid part
+    auto end = utf8::find_invalid(str.begin(), str.end());
+    if (end != str.end()) {
+        LogWarn("Invalid UTF-8 encoding detected. This part is fine: " << std::string(str.begin(),
+                                                                                      end));
+    }
+    return end;
+}
+
+template <typename Callable>
+int TextRendererCPU::layout(FontCache& fc, std::string_view str, Callable&& callable) {
+    // the pen position defines where the current glyph is positioned
+    ivec2 penPos(0);
+    // the vertical offset is increased for each additional line
+    int verticalOffset = 0;
+
+    // check input string for invalid utf8 encoding
+    auto end = validateString(str);
+
+    for (utf8::iterator it{str.begin(), str.begin(), end};
+         it != utf8::iterator{end, str.begin(), end}; ++it) {
+        const uint32_t charCode = *it;
+
+        // query font cache for glyph matching the character code, skip missing glyphs
+        const GlyphEntry& glyph = requestGlyph(fc, charCode);
+        if (!glyph.valid) continue;
+
+        if (charCode == lf) {
+            verticalOffset += getLineHeight();
+            // reset pen position to begin of the next line
+            penPos.x = 0;
+            penPos.y += glyph.advance.y;
+            continue;
+        } else if (charCode == tab) {
+            penPos += glyph.advance;
+            penPos.x += (4 * glyph.size.x);  // 4 times glyph character width
+            callable(nullptr, penPos, penPos);
+            continue;
+        }
+
+        // compute top-left position of glyph based on current pen position
+        const ivec2 pos(penPos.x + glyph.bearing.x, verticalOffset + penPos.y - glyph.bearing.y);
+        // advance pen to next glyph
+        penPos += glyph.advance;
+
+        callable(&glyph, pos, penPos);
+    }
+    return verticalOffset;
+}
+
+TextBoundingBox TextRendererCPU::computeBoundingBox(std::string_view str) {
+    if (str.empty()) return {};  // empty string, return empty bounding box
+
+    const int baseline = getBaseLineOffset();
+
+    // textual bounding box contains at least one line, calculate height of first line
+    // For most fonts descender is negative (see FreeType documentation for details)
+    ivec2 textBoxExtent(0, baseline + std::max(-getBaseLineDescender(), 0));
+
+    // glyph bounding box enclosing all individual glyph bounding boxes
+    // start glyph bounding box at baseline
+    ivec2 glyphsTopLeft(std::numeric_limits<int>::max(), baseline);
+    ivec2 glyphsBottomRight(std::numeric_limits<int>::min());
+
+    const int verticalOffset = layout(
+        getFontCache(), str, [&](const GlyphEntry* glyph, ivec2 pos, const ivec2& penPos) {
+            if (glyph) {
+                // pen starts at the first baseline
+                pos.y += baseline;
+                glyphsTopLeft = glm::min(glyphsTopLeft, pos);
+                glyphsBottomRight = glm::max(glyphsBottomRight, pos + glyph->size);
+            } else {
+                glyphsBottomRight.x = std::max(glyphsBottomRight.x, penPos.x);
+            }
+            // textual bounding box only considers maximum pen position
+            textBoxExtent.x = std::max(textBoxExtent.x, penPos.x);
+        });
+
+    // update vertical extent of textual bounding box
+    textBoxExtent.y += verticalOffset;
+
+    // determine glyphs bounding box relative to bottom left corner of text box
+    ivec2 glyphsBottomLeft(glyphsTopLeft.x, textBoxExtent.y - glyphsBottomRight.y);
+    ivec2 glyphsExtent(glyphsBottomRight - glyphsTopLeft);
+
+    return {textBoxExtent, glyphsBottomLeft, glyphsExtent, baseline};
+}
+
+void TextRendererCPU::render(LayerRAM& dest, const TextBoundingBox& textBoundingBox,
+                             const ivec2& origin, std::string_view str, const vec4& color) {
+    auto& fc = getFontCache();
+
+    const ivec2 destDims(dest.getDimensions());
+    const ivec2 penOffset(textBoundingBox.glyphPenOffset);
+    // topmost row of the sub region, glyphs are laid out top-down while layers are stored
+    // bottom-up
+    const int top = origin.y + static_cast<int>(textBoundingBox.glyphsExtent.y) - 1;
+
+    dest.dispatch<void>([&](auto lrprecision) {
+        using ValueType = util::PrecisionValueType<decltype(lrprecision)>;
+        ValueType* data = lrprecision->getDataTyped();
+
+        // same blending as the TextRenderer, i.e. premultiplied alpha and
+        // GL_ONE, GL_ONE_MINUS_SRC_ALPHA
+        const auto blend = [&](ValueType& dst, unsigned char coverage) {
+            if constexpr (std::is_same_v<ValueType, glm::u8vec4>) {
+                const float alpha = static_cast<float>(coverage) / 255.0f;
+                const vec4 src = color * alpha;
+                const vec4 res = src * 255.0f + vec4(dst) * (1.0f - src.a);
+                dst = glm::u8vec4(glm::clamp(res + 0.5f, vec4(0.0f), vec4(255.0f)));
+            } else {
+                const dvec4 src = dvec4(color) * (static_cast<double>(coverage) / 255.0);
+                const dvec4 res = src + util::glm_convert_normalized<dvec4>(dst) * (1.0 - src.a);
+                dst = util::glm_convert_normalized<ValueType>(res);
+            }
+        };
+
+        layout(fc, str, [&](const GlyphEntry* glyph, const ivec2& pos, const ivec2&) {
+            if (!glyph) return;
+
+            // the atlas might have been reallocated while requesting the glyph
+            const auto& atlas = *fc.atlas;
+            const unsigned char* atlasData = atlas.getDataTyped();
+            const int atlasWidth = static_cast<int>(atlas.getDimensions().x);
+
+            // position of the top-left glyph pixel in the destination
+            const ivec2 start(origin.x + pos.x - penOffset.x, top - (pos.y + penOffset.y));
+
+            // clip glyph rows and columns against the destination
+            const int rowBegin = std::max(0, start.y - destDims.y + 1);
+            const int rowEnd = std::min(glyph->size.y, start.y + 1);
+            const int colBegin = std::max(0, -start.x);
+            const int colEnd = std::min(glyph->size.x, destDims.x - start.x);
+
+            for (int row = rowBegin; row < rowEnd; ++row) {
+                const unsigned char* src =
+                    atlasData + (glyph->atlasPos.y + row) * atlasWidth + glyph->atlasPos.x;
+                ValueType* dst = data + (start.y - row) * destDims.x;
+                for (int col = colBegin; col < colEnd; ++col) {
+                    if (src[col] != 0) blend(dst[start.x + col], src[col]);
+                }
+            }
+        });
+    });
+}
+
+void TextRendererCPU::render(LayerRAM& dest, const ivec2& origin, std::string_view str,
+                             const vec4& color) {
+    render(dest, computeBoundingBox(str), origin, str, color);
+}
+
+size2_t TextRendererCPU::computeTextSize(std::string_view str) {
+    return computeBoundingBox(str).glyphsExtent;
+}
+
+void TextRendererCPU::setFontSize(int val) {
+    if (fontSize_ != val) {
+        fontSize_ = val;
+        FT_Set_Pixel_Sizes(fontface_, 0, val);
+    }
+}
+
+void TextRendererCPU::setLineSpacing(double lineSpacing) { lineSpacing_ = lineSpacing; }
+
+double TextRendererCPU::getLineSpacing() const { return lineSpacing_; }
+
+void TextRendererCPU::setLineHeight(int lineHeight) {
+    lineSpacing_ = static_cast<double>(lineHeight) / static_cast<double>(fontSize_) - 1.0;
+}
+
+int TextRendererCPU::getLineHeight() const {
+    return static_cast<int>(fontSize_ * (1.0 + lineSpacing_));
+}
+
+int TextRendererCPU::getBaseLineOffset() const {
+    return static_cast<int>(getFontAscender() + 0.5);
+}
+
+int TextRendererCPU::getBaseLineDescender() const {
+    return static_cast<int>(getFontDescender() + 0.5);
+}
+
+double TextRendererCPU::getFontAscender() const {
+    return (fontface_->ascender * fontSize_ / static_cast<double>(fontface_->units_per_EM));
+}
+
+double TextRendererCPU::getFontDescender() const {
+    return (fontface_->descender * fontSize_ / static_cast<double>(fontface_->units_per_EM));
+}
+
+void TextRendererCPU::configure(const FontSettings& settings) {
+    setFont(settings.getFontFace());
+    setFontSize(settings.getFontSize());
+    setLineSpacing(settings.getLineSpacing());
+}
+
+const LayerRAMPrecision<unsigned char>& TextRendererCPU::getAtlas() {
+    return *getFontCache().atlas;
+}
+
+auto TextRendererCPU::requestGlyph(FontCache& fc, unsigned int glyph) -> const GlyphEntry& {
+    if (const auto* entry = fc.glyphs.find(glyph)) {
+        return *entry;
+    } else {
+        return addGlyph(fc, glyph);
+    }
+}
+
+auto TextRendererCPU::addGlyph(FontCache& fc, unsigned int glyph) -> GlyphEntry& {
+    // glyphs which fail to load are kept as invalid entries to avoid repeated lookups
+    auto& entry = fc.glyphs[glyph];
+
+    if (FT_Load_Char(fontface_, glyph, FT_LOAD_RENDER)) {
+        LogWarn("FreeType: could not load char: '" << static_cast<char>(glyph) << "' (0x"
+                                                   << std::hex << glyph << ")");
+        return entry;
+    }
+
+    // \see
+    // https://www.freetype.org/freetype2/docs/reference/ft2-base_interface.html#FT_GlyphSlotRec
+    const auto& slot = *fontface_->glyph;
+    entry.advance = ivec2(slot.advance.x >> 6, slot.advance.y >> 6);
+    entry.size = ivec2(slot.bitmap.width, slot.bitmap.rows);
+    entry.bearing = ivec2(slot.bitmap_left, slot.bitmap_top);
+    entry.atlasPos = allocate(fc, entry.size + 2 * glyphMargin_) + glyphMargin_;
+    entry.valid = true;
+
+    // copy the glyph bitmap into the atlas, top row first
+    auto* atlasData = fc.atlas->getDataTyped();
+    const int atlasWidth = static_cast<int>(fc.atlas->getDimensions().x);
+    for (int row = 0; row < entry.size.y; ++row) {
+        std::copy_n(slot.bitmap.buffer + row * slot.bitmap.pitch, entry.size.x,
+                    atlasData + (entry.atlasPos.y + row) * atlasWidth + entry.atlasPos.x);
+    }
+
+    return entry;
+}
+
+ivec2 TextRendererCPU::allocate(FontCache& fc, const ivec2& extent) {
+    const ivec2 dims(fc.atlas->getDimensions());
+
+    // Shelf First Fit, start a new shelf if the glyph does not fit into the current one
+    if (fc.shelfPos.x + extent.x > dims.x) {
+        fc.shelfPos = ivec2(0, fc.shelfPos.y + fc.shelfHeight);
+        fc.shelfHeight = 0;
+    }
+
+    const ivec2 required(std::max(dims.x, extent.x),
+                         fc.shelfPos.y + std::max(fc.shelfHeight, extent.y));
+    if (glm::any(glm::greaterThan(required, dims))) {
+        // grow the atlas, all previous glyphs keep their positions
+        const ivec2 newDims(required.x, std::max(required.y, 2 * dims.y));
+        auto atlas = std::make_unique<LayerRAMPrecision<unsigned char>>(
+            size2_t(newDims), LayerType::Color, swizzlemasks::luminance);
+        const auto* src = fc.atlas->getDataTyped();
+        auto* dst = atlas->getDataTyped();
+        for (int row = 0; row < dims.y; ++row) {
+            std::copy_n(src + row * dims.x, dims.x, dst + row * newDims.x);
+        }
+        fc.atlas = std::move(atlas);
+    }
+
+    const ivec2 pos = fc.shelfPos;
+    fc.shelfPos.x += extent.x;
+    fc.shelfHeight = std::max(fc.shelfHeight, extent.y);
+    return pos;
+}
+
+TextRendererCPU::FontCache& TextRendererCPU::getFontCache() {
+    const auto font = getFontTuple();
+
+    auto fontCacheIt = glyphAtlas_.find(font);
+    if (fontCacheIt == glyphAtlas_.end()) {
+        // glyph atlas doesn't exist for the current font/style/size combination
+        FontCache fc;
+        fc.atlas = std::make_unique<LayerRAMPrecision<unsigned char>>(
+            size2_t(atlasWidth_, fontSize_ + 2 * glyphMargin_), LayerType::Color,
+            swizzlemasks::luminance);
+        fontCacheIt = glyphAtlas_.emplace(font, std::move(fc)).first;
+
+        // rasterize all ascii characters between 32 and 128 up front
+        for (unsigned int c = 32u; c < 128u; ++c) {
+            requestGlyph(fontCacheIt->second, c);
+        }
+    }
+    return fontCacheIt->second;
+}
+
+TextRendererCPU::FontFamilyStyle TextRendererCPU::getFontTuple() const {
+    return std::make_tuple(std::string(fontface_->family_name), std::string(fontface_->style_name),
+                           fontSize_);
+}
+
+namespace util {
+
+std::shared_ptr<Layer> createTextLayer(TextRendererCPU& textRenderer, std::string_view text,
+                                       vec4 fontColor) {
+    auto bbox = textRenderer.computeBoundingBox(text);
+    // Avoid empty layers
+    bbox.glyphsExtent = glm::max(bbox.glyphsExtent, size2_t(1));
+
+    auto ram = std::make_shared<LayerRAMPrecision<glm::u8vec4>>(bbox.glyphsExtent);
+    textRenderer.render(*ram, bbox, ivec2(0), text, fontColor);
+    return std::make_shared<Layer>(ram);
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -0,0 +1,147 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/fontrendering/util/glyphtable.h>
+
+#include <map>
+#include <string>
+
+namespace inviwo {
+
+TEST(GlyphTable, Empty) {
+    GlyphTable<int> table;
+    EXPECT_TRUE(table.empty());
+    EXPECT_EQ(0, table.size());
+    EXPECT_EQ(nullptr, table.find(0));
+    EXPECT_EQ(nullptr, table.find('A'));
+    EXPECT_EQ(nullptr, table.find(GlyphTable<int>::directSize));
+    EXPECT_EQ(nullptr, table.find(0x1F600));
+}
+
+TEST(GlyphTable, Lookup) {
+    GlyphTable<std::string> table;
+    table.insert('A', "A");
+    table.insert(0xFF, "y diaeresis");  // last code stored in the flat array
+    table.insert(0x100, "A macron");    // first code stored in the hash map
+    table.insert(0x1F600, "grinning face");
+
+    EXPECT_EQ(4, table.size());
+    EXPECT_FALSE(table.empty());
+
+    ASSERT_NE(nullptr, table.find('A'));
+    EXPECT_EQ("A", *table.find('A'));
+    ASSERT_NE(nullptr, table.find(0xFF));
+    EXPECT_EQ("y diaeresis", *table.find(0xFF));
+    ASSERT_NE(nullptr, table.find(0x100));
+    EXPECT_EQ("A macron", *table.find(0x100));
+    ASSERT_NE(nullptr, table.find(0x1F600));
+    EXPECT_EQ("grinning face", *table.find(0x1F600));
+
+    EXPECT_EQ(nullptr, table.find('B'));
+    EXPECT_EQ(nullptr, table.find(0xFE));
+    EXPECT_EQ(nullptr, table.find(0x101));
+
+    const auto& constTable = table;
+    ASSERT_NE(nullptr, constTable.find('A'));
+    EXPECT_EQ(table.find('A'), constTable.find('A'));
+}
+
+TEST(GlyphTable, DefaultEntriesAreFound) {
+    GlyphTable<int> table;
+    // entries equal to a default constructed value must still be present
+    EXPECT_EQ(0, table['a']);
+    EXPECT_EQ(0, table[0x2000]);
+    EXPECT_EQ(2, table.size());
+    ASSERT_NE(nullptr, table.find('a'));
+    EXPECT_EQ(0, *table.find('a'));
+    ASSERT_NE(nullptr, table.find(0x2000));
+    EXPECT_EQ(0, *table.find(0x2000));
+}
+
+TEST(GlyphTable, InsertOverwrite) {
+    GlyphTable<int> table;
+    for (unsigned int code : {0x78u, 0x3B1u}) {
+        int& first = table.insert(code, 1);
+        EXPECT_EQ(1, first);
+
+        int& second = table.insert(code, 2);
+        EXPECT_EQ(2, second);
+        EXPECT_EQ(&first, &second);
+        ASSERT_NE(nullptr, table.find(code));
+        EXPECT_EQ(2, *table.find(code));
+
+        table[code] = 3;
+        EXPECT_EQ(3, *table.find(code));
+    }
+    EXPECT_EQ(2, table.size());
+}
+
+TEST(GlyphTable, ForEach) {
+    GlyphTable<unsigned int> table;
+    std::map<unsigned int, unsigned int> expected;
+    for (unsigned int code : {0u, 32u, 0x7Au, 255u, 256u, 0x3B1u, 0x1F600u}) {
+        table.insert(code, 2 * code);
+        expected[code] = 2 * code;
+    }
+
+    std::map<unsigned int, unsigned int> visited;
+    table.forEach([&](unsigned int code, unsigned int& entry) {
+        EXPECT_TRUE(visited.emplace(code, entry).second) << "code " << code << " visited twice";
+        ++entry;
+    });
+    EXPECT_EQ(expected, visited);
+
+    // forEach hands out references to the stored entries
+    for (auto& [code, value] : expected) {
+        ASSERT_NE(nullptr, table.find(code));
+        EXPECT_EQ(value + 1, *table.find(code));
+    }
+}
+
+TEST(GlyphTable, Clear) {
+    GlyphTable<int> table;
+    table.insert('A', 1);
+    table.insert(0x400, 2);
+    table.clear();
+
+    EXPECT_TRUE(table.empty());
+    EXPECT_EQ(nullptr, table.find('A'));
+    EXPECT_EQ(nullptr, table.find(0x400));
+
+    // cleared entries are reset to their default value
+    EXPECT_EQ(0, table['A']);
+    EXPECT_EQ(1, table.size());
+}
+
+}  // namespace inviwo
@@ -0,0 +1,223 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/fontrendering/textrenderercpu.h>
+
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/raiiutils.h>
+#include <modules/fontrendering/datastructures/textboundingbox.h>
+
+#include <algorithm>
+#include <limits>
+#include <string_view>
+
+#include <freetype/freetype.h>
+#include <glm/common.hpp>
+
+namespace inviwo {
+
+namespace {
+
+std::filesystem::path testFont() {
+    return filesystem::findBasePath() / "modules" / "fontrendering" / "fonts" /
+           "OpenSans-Semibold.ttf";
+}
+
+/*
+ * Computes the bounding box of an ASCII string directly from the FreeType metrics, following the
+ * layout of TextRenderer::computeBoundingBox. The OpenGL renderer cannot run without a context,
+ * this gives the metrics it would report.
+ */
+TextBoundingBox referenceBoundingBox(const std::filesystem::path& font, int fontSize,
+                                     double lineSpacing, std::string_view str) {
+    FT_Library lib = nullptr;
+    FT_Face face = nullptr;
+    util::OnScopeExit cleanup{[&]() {
+        if (face) FT_Done_Face(face);
+        if (lib) FT_Done_FreeType(lib);
+    }};
+    if (FT_Init_FreeType(&lib) || FT_New_Face(lib, font.string().c_str(), 0, &face)) {
+        ADD_FAILURE() << "Could not load font " << font.string();
+        return {};
+    }
+    FT_Select_Charmap(face, ft_encoding_unicode);
+    FT_Set_Pixel_Sizes(face, 0, fontSize);
+
+    const double unitsPerEM = static_cast<double>(face->units_per_EM);
+    const int ascender = static_cast<int>(face->ascender * fontSize / unitsPerEM + 0.5);
+    const int descender = static_cast<int>(face->descender * fontSize / unitsPerEM + 0.5);
+    const int lineHeight = static_cast<int>(fontSize * (1.0 + lineSpacing));
+
+    ivec2 penPos(0, ascender);
+    ivec2 textBoxExtent(0, ascender + std::max(-descender, 0));
+    ivec2 glyphsTopLeft(std::numeric_limits<int>::max(), ascender);
+    ivec2 glyphsBottomRight(std::numeric_limits<int>::min());
+    int verticalOffset = 0;
+
+    for (char c : str) {
+        if (FT_Load_Char(face, static_cast<FT_ULong>(c), FT_LOAD_RENDER)) continue;
+        const auto& slot = *face->glyph;
+        const ivec2 advance(slot.advance.x >> 6, slot.advance.y >> 6);
+        const ivec2 size(slot.bitmap.width, slot.bitmap.rows);
+        const ivec2 bearing(slot.bitmap_left, slot.bitmap_top);
+
+        if (c == '\n') {
+            verticalOffset += lineHeight;
+            penPos.x = 0;
+            penPos.y += advance.y;
+            continue;
+        } else if (c == '\t') {
+            penPos += advance;
+            penPos.x += 4 * size.x;
+            glyphsBottomRight.x = std::max(glyphsBottomRight.x, penPos.x);
+            textBoxExtent.x = std::max(textBoxExtent.x, penPos.x);
+            continue;
+        }
+
+        const ivec2 pos(penPos.x + bearing.x, verticalOffset + penPos.y - bearing.y);
+        glyphsTopLeft = glm::min(glyphsTopLeft, pos);
+        glyphsBottomRight = glm::max(glyphsBottomRight, pos + size);
+        penPos += advance;
+        textBoxExtent.x = std::max(textBoxExtent.x, penPos.x);
+    }
+    textBoxExtent.y += verticalOffset;
+
+    const ivec2 glyphsBottomLeft(glyphsTopLeft.x, textBoxExtent.y - glyphsBottomRight.y);
+    return {textBoxExtent, glyphsBottomLeft, glyphsBottomRight - glyphsTopLeft, ascender};
+}
+
+// Returns the lower left corner and the extent of all pixels with nonzero alpha
+std::pair<size2_t, size2_t> coveredRegion(const LayerRAM& layer) {
+    const size2_t dims = layer.getDimensions();
+    size2_t min{std::numeric_limits<size_t>::max()};
+    size2_t max{0};
+    for (size_t y = 0; y < dims.y; ++y) {
+        for (size_t x = 0; x < dims.x; ++x) {
+            if (layer.getAsDVec4(size2_t{x, y}).a > 0.0) {
+                min = glm::min(min, size2_t{x, y});
+                max = glm::max(max, size2_t{x + 1, y + 1});
+            }
+        }
+    }
+    if (max == size2_t{0}) return {size2_t{0}, size2_t{0}};
+    return {min, max - min};
+}
+
+}  // namespace
+
+TEST(TextRendererCPU, BoundingBoxMatchesMetrics) {
+    const auto font = testFont();
+    TextRendererCPU renderer{font};
+
+    for (int fontSize : {10, 14, 27}) {
+        for (double lineSpacing : {0.2, 0.5}) {
+            renderer.setFontSize(fontSize);
+            renderer.setLineSpacing(lineSpacing);
+            for (std::string_view str :
+                 {"Inviwo", "Hello World!", "gjpqy", "two\nlines", "tab\tstop", "\"quoted\"\n"}) {
+                SCOPED_TRACE(testing::Message() << "size " << fontSize << ", spacing "
+                                                << lineSpacing << ", text '" << str << "'");
+                const auto bbox = renderer.computeBoundingBox(str);
+                const auto expected = referenceBoundingBox(font, fontSize, lineSpacing, str);
+
+                EXPECT_EQ(expected.textExtent, bbox.textExtent);
+                EXPECT_EQ(expected.glyphsOrigin, bbox.glyphsOrigin);
+                EXPECT_EQ(expected.glyphsExtent, bbox.glyphsExtent);
+                EXPECT_EQ(expected.glyphPenOffset, bbox.glyphPenOffset);
+                EXPECT_EQ(bbox.glyphsExtent, renderer.computeTextSize(str));
+            }
+        }
+    }
+}
+
+TEST(TextRendererCPU, EmptyString) {
+    TextRendererCPU renderer{testFont()};
+    const auto bbox = renderer.computeBoundingBox("");
+    EXPECT_EQ(size2_t{0}, bbox.textExtent);
+    EXPECT_EQ(size2_t{0}, bbox.glyphsExtent);
+
+    // createTextLayer avoids empty layers
+    auto layer = util::createTextLayer(renderer, "", vec4{1.0f});
+    EXPECT_EQ(size2_t{1}, layer->getDimensions());
+}
+
+TEST(TextRendererCPU, RenderedTextFillsBoundingBox) {
+    TextRendererCPU renderer{testFont()};
+    renderer.setFontSize(20);
+
+    for (std::string_view str : {"Inviwo", "gjpqy", "two\nlines"}) {
+        SCOPED_TRACE(testing::Message() << "text '" << str << "'");
+        const auto bbox = renderer.computeBoundingBox(str);
+        auto layer = util::createTextLayer(renderer, str, vec4{1.0f});
+        ASSERT_EQ(bbox.glyphsExtent, layer->getDimensions());
+
+        // Glyph bitmaps are tight around the glyph outlines, the rendered text should hence
+        // cover the bounding box up to the antialiased pixels at its edges.
+        const auto [origin, extent] = coveredRegion(*layer->getRepresentation<LayerRAM>());
+        EXPECT_LE(origin.x, 1u);
+        EXPECT_LE(origin.y, 1u);
+        EXPECT_GE(extent.x + 2, bbox.glyphsExtent.x);
+        EXPECT_GE(extent.y + 2, bbox.glyphsExtent.y);
+    }
+}
+
+TEST(TextRendererCPU, RenderClipsAndBlends) {
+    TextRendererCPU renderer{testFont()};
+    renderer.setFontSize(20);
+
+    const std::string_view str = "Inviwo";
+    const auto bbox = renderer.computeBoundingBox(str);
+
+    // Opaque black destination which is smaller than the text, glyphs outside are discarded
+    const size2_t dims{bbox.glyphsExtent.x / 2, bbox.glyphsExtent.y};
+    LayerRAMPrecision<glm::u8vec4> dest{dims};
+    std::fill_n(dest.getDataTyped(), dims.x * dims.y, glm::u8vec4{0, 0, 0, 255});
+
+    renderer.render(dest, bbox, ivec2{0}, str, vec4{1.0f});
+
+    const auto* data = dest.getDataTyped();
+    bool covered = false;
+    for (size_t i = 0; i < dims.x * dims.y; ++i) {
+        // blending onto an opaque background keeps it opaque and gray for white text
+        EXPECT_EQ(255, data[i].a);
+        EXPECT_EQ(data[i].r, data[i].g);
+        EXPECT_EQ(data[i].r, data[i].b);
+        covered |= data[i].r > 0;
+    }
+    EXPECT_TRUE(covered);
+}
+
+}  // namespace inviwo
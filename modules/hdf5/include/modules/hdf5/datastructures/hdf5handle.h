@@ -83,9 +83,21 @@ public:
 
     Handle* getHandleForPath(const std::string& path) const;
 
+    /**
+     * Create a volume from the selection of the dataset at @p path. The volume gets a VolumeDisk
+     * representation that can read the selection, or any sub-region of it, from the file.
+     * @param path the dataset
+     * @param selection one Selection per dimension of the dataset, at most three dimensions may
+     *        have more than one element
+     * @param type the data format to read the data as, or nullptr to use the format of the dataset
+     * @param loadOnDemand if false, the data is read directly and the data range is computed from
+     *        it. If true, no data is read until requested and the data range is set from the
+     *        data format.
+     */
     std::shared_ptr<Volume> getVolumeAtPathAsType(const Path& path,
                                                   std::vector<Selection> selection,
-                                                  const DataFormatBase* type) const;
+                                                  const DataFormatBase* type,
+                                                  bool loadOnDemand = false) const;
 
     template <typename T>
     std::vector<T> getVectorAtPath(const Path& path) const;
@@ -164,6 +164,7 @@ private:
     StringProperty valueUnit_;
 
     OptionPropertyInt datatype_;
+    BoolProperty loadOnDemand_;
 
     DimSelections selection_;
 
@@ -34,10 +34,12 @@
 #include <inviwo/core/util/formatdispatching.h>
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
 
 #include <modules/base/algorithm/dataminmax.h>
 
 #include <algorithm>
+#include <array>
 
 namespace inviwo {
 
@@ -48,6 +50,87 @@ H5::Group load(const std::filesystem::path& filename, const std::string& path) {
     H5::H5File hdfFile(filename.generic_string(), H5F_ACC_RDONLY);
     return hdfFile.openGroup(path);
 }
+
+/**
+ * Reads a hyperslab selection of a dataset into a VolumeRAM. Sub-regions of the volume are read
+ * by narrowing the hyperslab, hence only the selected part of the dataset is read from the file.
+ */
+class VolumeRAMLoader : public VolumeRegionLoader {
+public:
+    VolumeRAMLoader(const std::filesystem::path& filename, const Path& group, const Path& dataset,
+                    std::vector<hsize_t> start, std::vector<hsize_t> count,
+                    std::vector<hsize_t> stride, std::array<int, 3> volumeAxes)
+        : filename_{filename}
+        , group_{group}
+        , dataset_{dataset}
+        , start_{std::move(start)}
+        , count_{std::move(count)}
+        , stride_{std::move(stride)}
+        , volumeAxes_{volumeAxes} {}
+
+    virtual VolumeRAMLoader* clone() const override { return new VolumeRAMLoader(*this); }
+
+    virtual std::shared_ptr<VolumeRepresentation> createRepresentation(
+        const VolumeRepresentation& src) const override {
+        auto volumeRAM = createVolumeRAM(src.getDimensions(), src.getDataFormat(), nullptr,
+                                         src.getSwizzleMask(), src.getInterpolation(),
+                                         src.getWrapping());
+        updateRegion(volumeRAM, src, size3_t{0});
+        return volumeRAM;
+    }
+
+    virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
+                                      const VolumeRepresentation& src) const override {
+        updateRegion(dest, src, size3_t{0});
+    }
+
+    virtual void updateRegion(std::shared_ptr<VolumeRepresentation> dest,
+                              const VolumeRepresentation&, size3_t offset) const override {
+        auto volumeDst = std::static_pointer_cast<VolumeRAM>(dest);
+        const auto extent = volumeDst->getDimensions();
+
+        auto start = start_;
+        auto count = count_;
+        for (size_t axis = 0; axis < 3; ++axis) {
+            if (const auto dim = volumeAxes_[axis]; dim >= 0) {
+                start[dim] += offset[axis] * stride_[dim];
+                count[dim] = extent[axis];
+            }
+        }
+
+        const Handle handle{filename_, group_};
+        auto dataset = handle.getGroup().openDataSet(dataset_);
+        ::inviwo::util::OnScopeExit closedataset{[&]() { dataset.close(); }};
+
+        H5::DataSpace dataSpace = dataset.getSpace();
+        dataSpace.selectHyperslab(H5S_SELECT_SET, count.data(), start.data(), stride_.data(),
+                                  nullptr);
+        // Row major, i.e. reversed compared to Inviwo
+        const std::array<hsize_t, 3> memoryDimensions{extent.z, extent.y, extent.x};
+        H5::DataSpace memorySpace(3, memoryDimensions.data());
+        memorySpace.selectAll();
+
+        volumeDst->dispatch<void, dispatching::filter::Scalars>([&](auto vrprecision) {
+            using ValueType = ::inviwo::util::PrecisionValueType<decltype(vrprecision)>;
+            try {
+                dataset.read(vrprecision->getDataTyped(), TypeMap<ValueType>::getType(),
+                             memorySpace, dataSpace);
+            } catch (H5::DataSetIException& e) {
+                throw Exception("HDF: unable to read data: " + e.getDetailMsg(), IVW_CONTEXT);
+            }
+        });
+    }
+
+private:
+    std::filesystem::path filename_;
+    Path group_;
+    Path dataset_;
+    std::vector<hsize_t> start_;
+    std::vector<hsize_t> count_;
+    std::vector<hsize_t> stride_;
+    std::array<int, 3> volumeAxes_;  // dataset dimension of each volume axis, -1 if none
+};
+
 }  // namespace
 
 Handle::Handle(const std::filesystem::path& filename)
@@ -125,7 +208,8 @@ double Handle::getMax(const DataFormatBase* type) const {
 
 std::shared_ptr<Volume> Handle::getVolumeAtPathAsType(const Path& path,
                                                       std::vector<Selection> selection,
-                                                      const DataFormatBase* type) const {
+                                                      const DataFormatBase* type,
+                                                      bool loadOnDemand) const {
 
     auto dataset = data_.openDataSet(path);
     ::inviwo::util::OnScopeExit closedataset{[&]() { dataset.close(); }};
@@ -157,8 +241,8 @@ std::shared_ptr<Volume> Handle::getVolumeAtPathAsType(const Path& path,
     std::reverse(selection.begin(), selection.end());
 
     size3_t volumeDimensions(1);
+    std::array<int, 3> volumeAxes{-1, -1, -1};
     int resRank = 0;
-    std::vector<hsize_t> memoryDimensions{1, 1, 1};
 
     for (size_t i = 0; i < rank; ++i) {
         start[i] = selection[i].start;
@@ -168,58 +252,50 @@ std::shared_ptr<Volume> Handle::getVolumeAtPathAsType(const Path& path,
 
         if (count[i] > 1) {
             if (resRank > 2) throw Exception("Invalid selection, resulting rank > 3", IVW_CONTEXT);
-            memoryDimensions[resRank] = count[i];
             volumeDimensions[resRank] = count[i];
+            volumeAxes[2 - resRank] = static_cast<int>(i);
             resRank++;
         }
     }
 
-    dataSpace.selectHyperslab(H5S_SELECT_SET, count.data(), start.data(), stride.data(), nullptr);
-
-    H5::DataSpace memorySpace(3, memoryDimensions.data());
-    memorySpace.selectAll();
-
-    hsize_t selectionSize = memorySpace.getSelectNpoints();
-
     LogInfo("Data rank: " << rank << " dims " << joinString(dataDimensions, " x ") << " size "
-                          << dataSize << " selection " << dataSpace.getSelectNpoints()
-                          << " memory size " << memorySpace.getSelectNpoints() << " memory dim "
-                          << volumeDimensions);
+                          << dataSize << " selection " << glm::compMul(volumeDimensions)
+                          << " memory dim " << volumeDimensions);
 
     const DataFormatBase* format = type ? type : util::getDataFormatFromDataSet(dataset);
 
     // Reverse back the Column major
     std::reverse(&volumeDimensions[0], &volumeDimensions[0] + volumeDimensions.length());
-    auto volumeram = createVolumeRAM(volumeDimensions, format);
-
-    auto minmax = volumeram->dispatch<std::pair<dvec4, dvec4>, dispatching::filter::Scalars>(
-        [&](auto vrprecision) {
-            using ValueType = ::inviwo::util::PrecisionValueType<decltype(vrprecision)>;
-
-            ValueType* data = vrprecision->getDataTyped();
-
-            try {
-                dataset.read(data, TypeMap<ValueType>::getType(), memorySpace, dataSpace);
-            } catch (H5::DataSetIException& e) {
-                throw Exception("HDF: unable to read data: " + e.getDetailMsg(), IVW_CONTEXT);
-            }
-
-            auto res = ::inviwo::util::dataMinMax(data, selectionSize);
-
-            LogInfo("Read HDF volume type: " << DataFormat<ValueType>::str()
-                                             << " data range: " << res.first << ", " << res.second
-                                             << " file: " << dataset.getFileName());
-
-            return res;
-        });
 
     auto volume = std::make_shared<Volume>(volumeDimensions, format);
-    volume->dataMap_.dataRange.x = glm::compMin(minmax.first);
-    volume->dataMap_.dataRange.y = glm::compMax(minmax.second);
+    auto volumeDisk = std::make_shared<VolumeDisk>(filename_, volumeDimensions, format);
+    volumeDisk->setLoader(new VolumeRAMLoader(filename_, path_, path, std::move(start),
+                                              std::move(count), std::move(stride), volumeAxes));
+    volume->addRepresentation(volumeDisk);
+
+    if (loadOnDemand) {
+        // Avoid reading the data just to find the data range
+        volume->dataMap_.dataRange = dvec2{getMin(format), getMax(format)};
+    } else {
+        const auto volumeram = volume->getRepresentation<VolumeRAM>();
+        const auto minmax =
+            volumeram->dispatch<std::pair<dvec4, dvec4>, dispatching::filter::Scalars>(
+                [&](auto vrprecision) {
+                    using ValueType = ::inviwo::util::PrecisionValueType<decltype(vrprecision)>;
+                    auto res = ::inviwo::util::dataMinMax(vrprecision->getDataTyped(),
+                                                          glm::compMul(volumeDimensions));
+
+                    LogInfo("Read HDF volume type: " << DataFormat<ValueType>::str()
+                                                     << " data range: " << res.first << ", "
+                                                     << res.second
+                                                     << " file: " << dataset.getFileName());
+                    return res;
+                });
+        volume->dataMap_.dataRange.x = glm::compMin(minmax.first);
+        volume->dataMap_.dataRange.y = glm::compMax(minmax.second);
+    }
     volume->dataMap_.valueRange = volume->dataMap_.dataRange;
 
-    volume->addRepresentation(volumeram);
-
     return volume;
 }
 
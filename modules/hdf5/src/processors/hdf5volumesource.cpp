@@ -91,6 +91,7 @@ HDF5ToVolume::HDF5ToVolume()
                  {"uchar", "Unsigned Char", 2},
                  {"ushort", "Unsigned Short", 3}},
                 0)
+    , loadOnDemand_("loadOnDemand", "Load on Demand", false)
     , selection_("selection", "Selection", 6)
     , dirty_(false) {
 
@@ -114,8 +115,8 @@ HDF5ToVolume::HDF5ToVolume()
     dataRange_.setReadOnly(true);
     information_.addProperties(dataDimensions_, dataRange_);
 
-    outputGroup_.addProperties(datatype_, overrideRange_, outDataRange_, valueRange_, valueUnit_,
-                               selection_);
+    outputGroup_.addProperties(datatype_, loadOnDemand_, overrideRange_, outDataRange_,
+                               valueRange_, valueUnit_, selection_);
     outputGroup_.onChange([this]() {
         if (automaticEvaluation_) {
             dirty_ = true;
@@ -337,7 +338,7 @@ void HDF5ToVolume::makeVolume() {
 
             volume_ = std::shared_ptr<Volume>(
                 data->getVolumeAtPathAsType(Path(data->getGroup().getObjName()) + volumeMeta.path_,
-                                            selection_.getSelection(), format));
+                                            selection_.getSelection(), format, loadOnDemand_));
 
             dataRange_.set(volume_->dataMap_.dataRange);
             outport_.setData(volume_);
@@ -35,7 +35,7 @@
 #include <inviwo/core/datastructures/representationconverter.h>         // for RepresentationCon...
 #include <inviwo/core/datastructures/representationconverterfactory.h>  // for RepresentationCon...
 #include <inviwo/core/datastructures/volume/volume.h>                   // for Volume, DataReade...
-#include <inviwo/core/datastructures/volume/volumedisk.h>               // for VolumeDisk
+#include <inviwo/core/datastructures/volume/volumedisk.h>               // for VolumeDisk, Volum...
 #include <inviwo/core/datastructures/volume/volumeram.h>                // for VolumeRAM
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>       // for createVolumeRAM
 #include <inviwo/core/datastructures/volume/volumerepresentation.h>     // for VolumeRepresentation
@@ -45,28 +45,27 @@
 #include <inviwo/core/util/fileextension.h>                             // for FileExtension
 #include <inviwo/core/util/formats.h>                                   // for NumericType, Data...
 #include <inviwo/core/util/glmvec.h>                                    // for size3_t, dvec2, vec4
-#include <inviwo/core/util/indexmapper.h>                               // for IndexMapper, Inde...
 #include <inviwo/core/util/safecstr.h>                                  // for SafeCStr
 #include <inviwo/core/util/sourcecontext.h>                             // for IVW_CONTEXT, IVW_...
+#include <inviwo/core/util/volumereorientation.h>                       // for reorientVolume
 #include <modules/base/algorithm/dataminmax.h>                          // for volumeMinMax
 
 #include <warn/push>
 #include <warn/ignore/all>
-#include <glm/common.hpp>              // for max, min
-#include <glm/fwd.hpp>                 // for mat4, mat4x4, vec3
-#include <glm/gtx/component_wise.hpp>  // for compMul
-#include <glm/mat4x4.hpp>              // for mat<>::col_type
-#include <glm/vec2.hpp>                // for vec<>::(anonymous)
-#include <glm/vec3.hpp>                // for operator*, operat...
-#include <glm/vec4.hpp>                // for operator*, operator+
-#include <glm/vector_relational.hpp>   // for any, equal
-#include <nifti1.h>                    // for DT_BINARY, DT_COM...
-#include <nifti1_io.h>                 // for nifti_image, nift...
+#include <glm/common.hpp>             // for max, min
+#include <glm/fwd.hpp>                // for mat4, mat4x4, vec3
+#include <glm/mat4x4.hpp>             // for mat<>::col_type
+#include <glm/vec2.hpp>               // for vec<>::(anonymous)
+#include <glm/vec3.hpp>               // for operator*, operat...
+#include <glm/vec4.hpp>               // for operator*, operator+
+#include <glm/vector_relational.hpp>  // for any, equal
+#include <nifti1.h>                   // for DT_BINARY, DT_COM...
+#include <nifti1_io.h>                // for nifti_image, nift...
 
 #include <warn/pop>
 
 #include <array>          // for array
-#include <cstring>        // for size_t, memcpy
+#include <cstddef>        // for size_t
 #include <string>         // for string
 #include <type_traits>    // for remove_extent_t
 #include <unordered_set>  // for unordered_set
@@ -78,9 +77,9 @@ namespace inviwo {
 
 /**
  * \brief A loader of Nifti files. Used to create VolumeRAM representations.
- * This class us used by the NiftiReader.
+ * This class us used by the NiftiReader. Supports reading sub-regions of a volume.
  */
-class NiftiVolumeRAMLoader : public DiskRepresentationLoader<VolumeRepresentation> {
+class NiftiVolumeRAMLoader : public VolumeRegionLoader {
 public:
     NiftiVolumeRAMLoader(std::shared_ptr<nifti_image> nim_, std::array<int, 7> start_index_,
                          std::array<int, 7> region_size_, std::array<bool, 3> flipAxis);
@@ -91,6 +90,8 @@ public:
         const VolumeRepresentation& src) const override;
     virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
                                       const VolumeRepresentation& src) const override;
+    virtual void updateRegion(std::shared_ptr<VolumeRepresentation> dest,
+                              const VolumeRepresentation& src, size3_t offset) const override;
 
 private:
     std::array<int, 7> start_index;
@@ -414,31 +415,6 @@ NiftiVolumeRAMLoader* NiftiVolumeRAMLoader::clone() const {
     return new NiftiVolumeRAMLoader(*this);
 }
 
-void flip(char* data, size_t elemSize, size3_t dim, std::array<bool, 3> flipAxis) {
-    // Flip data along axes if necessary
-    if (flipAxis[0] || flipAxis[1] || flipAxis[2]) {
-        const auto size = glm::compMul(dim);
-        auto tmp = std::make_unique<char[]>(elemSize * size);
-        auto copy = tmp.get();
-
-        std::memcpy(copy, data, size * elemSize);
-
-        util::IndexMapper3D mapper(dim);
-        for (size_t z = 0; z < dim[2]; ++z) {
-            const auto idz = flipAxis[2] ? dim[2] - 1 - z : z;
-            for (size_t y = 0; y < dim[1]; ++y) {
-                const auto idy = flipAxis[1] ? dim[1] - 1 - y : y;
-                for (size_t x = 0; x < dim[0]; ++x) {
-                    const auto idx = flipAxis[0] ? dim[0] - 1 - x : x;
-                    const auto from = mapper(x, y, z);
-                    const auto to = mapper(idx, idy, idz);
-                    std::memcpy(data + to * elemSize, copy + from * elemSize, elemSize);
-                }
-            }
-        }
-    }
-}
-
 std::shared_ptr<VolumeRepresentation> NiftiVolumeRAMLoader::createRepresentation(
     const VolumeRepresentation& src) const {
 
@@ -455,14 +431,14 @@ std::shared_ptr<VolumeRepresentation> NiftiVolumeRAMLoader::createRepresentation
     auto region = region_size;
     auto readBytes = nifti_read_subregion_image(nim.get(), start.data(), region.data(), &pdata);
 
-    const auto dim = size3_t{region_size[0], region_size[1], region_size[2]};
-    flip(data.get(), voxelSize, dim, flipAxis);
-
     if (readBytes < 0) {
         throw DataReaderException(IVW_CONTEXT, "Error: Could not read data from file: {}",
                                   nim->fname);
     }
 
+    const auto dim = size3_t{region_size[0], region_size[1], region_size[2]};
+    util::reorientVolume(data.get(), voxelSize, dim, {.flip = flipAxis});
+
     auto volumeRAM =
         createVolumeRAM(src.getDimensions(), src.getDataFormat(), data.get(), src.getSwizzleMask(),
                         src.getInterpolation(), src.getWrapping());
@@ -491,7 +467,34 @@ void NiftiVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresenta
     const auto voxelSize = src.getDataFormat()->getSize();
     const auto dim = size3_t{region_size[0], region_size[1], region_size[2]};
 
-    flip(static_cast<char*>(data), voxelSize, dim, flipAxis);
+    util::reorientVolume(data, voxelSize, dim, {.flip = flipAxis});
+}
+
+void NiftiVolumeRAMLoader::updateRegion(std::shared_ptr<VolumeRepresentation> dest,
+                                        const VolumeRepresentation& src, size3_t offset) const {
+    auto volumeDst = std::static_pointer_cast<VolumeRAM>(dest);
+    const auto extent = volumeDst->getDimensions();
+
+    // The region is given in the flipped volume, find the corresponding region in the file
+    const util::VolumeReorientation reorientation{.flip = flipAxis};
+    const auto [fileOffset, fileExtent] =
+        reorientation.sourceRegion(src.getDimensions(), offset, extent);
+
+    auto start = start_index;
+    auto region = region_size;
+    for (size_t i = 0; i < 3; ++i) {
+        start[i] += static_cast<int>(fileOffset[i]);
+        region[i] = static_cast<int>(fileExtent[i]);
+    }
+
+    auto data = volumeDst->getData();
+    auto readBytes = nifti_read_subregion_image(nim.get(), start.data(), region.data(), &data);
+    if (readBytes < 0) {
+        throw DataReaderException(IVW_CONTEXT, "Error: Could not read data from file: {}",
+                                  nim->fname);
+    }
+
+    util::reorientVolume(data, src.getDataFormat()->getSize(), extent, reorientation);
 }
 
 }  // namespace inviwo
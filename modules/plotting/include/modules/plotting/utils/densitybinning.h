@@ -0,0 +1,105 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <modules/plotting/plottingmoduledefine.h>  // for IVW_MODULE_PLOTTING_API
+
+#include <inviwo/core/datastructures/bitset.h>  // for BitSet
+#include <inviwo/core/util/glmvec.h>            // for size2_t, dvec2
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint32_t
+#include <memory>   // for shared_ptr
+#include <vector>   // for vector
+
+namespace inviwo {
+class BufferBase;
+class BufferRAM;
+class Layer;
+
+namespace plot {
+
+/**
+ * \brief A 2D histogram of two data columns
+ * Each bin holds the number of rows falling into it, and optionally the mean of a third value
+ * column for those rows. Bins are stored row by row, i.e. bin (i, j) is at `i + j * dims.x`.
+ * @see binDensity
+ */
+struct IVW_MODULE_PLOTTING_API DensityGrid {
+    size2_t dims{0};
+    dvec2 xRange{0.0, 1.0};
+    dvec2 yRange{0.0, 1.0};
+    std::vector<std::uint32_t> counts;
+    std::vector<double> means;  ///< empty if no value column was given
+    size_t total = 0;           ///< number of binned rows
+    std::uint32_t maxCount = 0;
+
+    /**
+     * Create a vec2 float32 Layer with nearest neighbor interpolation where the first channel is
+     * the count and the second the mean value of each bin (zero if there are no means).
+     */
+    std::shared_ptr<Layer> toLayer() const;
+};
+
+/**
+ * \brief Bin rows of the scalar buffers @p x and @p y into a 2D grid of @p bins
+ * The grid covers @p xRange times @p yRange, rows outside of the ranges, NaN rows, and rows in
+ * @p filtered are skipped. If @p values is given, the mean of its values is computed per bin as
+ * well. The rows are processed in parallel on the thread pool, with one local grid per chunk
+ * which are summed up at the end.
+ *
+ * @param x        buffer with the x coordinates, must have a scalar format
+ * @param y        buffer with the y coordinates, must have a scalar format and the size of @p x
+ * @param values   optional buffer to average per bin, must have a scalar format and the size of x
+ * @param bins     number of bins in x and y
+ * @param xRange   data range covered by the bins in x
+ * @param yRange   data range covered by the bins in y
+ * @param filtered rows to exclude, zero-based row indices
+ * @throw Exception if the buffers differ in size or if @p bins is zero in any dimension
+ */
+IVW_MODULE_PLOTTING_API DensityGrid binDensity(const BufferBase& x, const BufferBase& y,
+                                               const BufferBase* values, size2_t bins,
+                                               dvec2 xRange, dvec2 yRange,
+                                               const BitSet& filtered = {});
+
+/**
+ * \brief Bin rows of the scalar buffer representations @p x and @p y into a 2D grid of @p bins
+ * Same as above, but does not create any representations, which makes it possible to bin on a
+ * background thread after fetching the RAM representations on the main thread.
+ * @see binDensity(const BufferBase&, const BufferBase&, const BufferBase*, size2_t, dvec2, dvec2,
+ *      const BitSet&)
+ */
+IVW_MODULE_PLOTTING_API DensityGrid binDensity(const BufferRAM& x, const BufferRAM& y,
+                                               const BufferRAM* values, size2_t bins,
+                                               dvec2 xRange, dvec2 yRange,
+                                               const BitSet& filtered = {});
+
+}  // namespace plot
+
+}  // namespace inviwo
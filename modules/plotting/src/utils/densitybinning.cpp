@@ -0,0 +1,186 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <modules/plotting/utils/densitybinning.h>
+
+#include <inviwo/core/datastructures/bitset.h>           // for BitSet
+#include <inviwo/core/datastructures/buffer/buffer.h>    // for BufferBase
+#include <inviwo/core/datastructures/buffer/bufferram.h>  // for BufferRAM
+#include <inviwo/core/datastructures/image/imagetypes.h>  // for LayerType, InterpolationType
+#include <inviwo/core/datastructures/image/layer.h>       // for Layer
+#include <inviwo/core/datastructures/image/layerram.h>    // for LayerRAMPrecision
+#include <inviwo/core/util/exception.h>                   // for Exception
+#include <inviwo/core/util/foreach.h>                     // for forEachChunkParallel
+#include <inviwo/core/util/formatdispatching.h>           // for Scalars
+#include <inviwo/core/util/glmfmt.h>                      // for formatter
+#include <inviwo/core/util/glmvec.h>                      // for vec2
+#include <inviwo/core/util/sourcecontext.h>               // for IVW_CONTEXT_CUSTOM
+#include <inviwo/core/util/threadutil.h>                  // for getPoolSize
+
+#include <algorithm>  // for min, transform, max_element
+#include <cmath>      // for isnan
+
+#include <fmt/core.h>     // for format
+#include <half/half.hpp>  // for half
+
+namespace inviwo {
+
+namespace plot {
+
+namespace {
+
+// Rows are converted to double in blocks, this keeps the number of template instantiations
+// linear in the number of formats while the scratch buffers stay in the cache.
+constexpr size_t blockSize = 4096;
+
+void toDouble(const BufferRAM& ram, size_t begin, size_t end, std::vector<double>& dst) {
+    ram.dispatch<void, dispatching::filter::Scalars>([&](auto brprecision) {
+        const auto& data = brprecision->getDataContainer();
+        dst.resize(end - begin);
+        std::transform(data.begin() + begin, data.begin() + end, dst.begin(),
+                       [](auto v) { return static_cast<double>(v); });
+    });
+}
+
+}  // namespace
+
+std::shared_ptr<Layer> DensityGrid::toLayer() const {
+    auto ram = std::make_shared<LayerRAMPrecision<vec2>>(dims, LayerType::Color, swizzlemasks::rgba,
+                                                         InterpolationType::Nearest);
+    auto data = ram->getDataTyped();
+    for (size_t i = 0; i < counts.size(); ++i) {
+        data[i] = vec2(static_cast<float>(counts[i]),
+                       means.empty() ? 0.0f : static_cast<float>(means[i]));
+    }
+    return std::make_shared<Layer>(ram);
+}
+
+DensityGrid binDensity(const BufferBase& x, const BufferBase& y, const BufferBase* values,
+                       size2_t bins, dvec2 xRange, dvec2 yRange, const BitSet& filtered) {
+    return binDensity(*x.getRepresentation<BufferRAM>(), *y.getRepresentation<BufferRAM>(),
+                      values ? values->getRepresentation<BufferRAM>() : nullptr, bins, xRange,
+                      yRange, filtered);
+}
+
+DensityGrid binDensity(const BufferRAM& x, const BufferRAM& y, const BufferRAM* values,
+                       size2_t bins, dvec2 xRange, dvec2 yRange, const BitSet& filtered) {
+    const auto size = x.getSize();
+    if (y.getSize() != size || (values && values->getSize() != size)) {
+        throw Exception(fmt::format("Buffers are not of equal length ({}, {}, {})", size,
+                                    y.getSize(), values ? values->getSize() : size),
+                        IVW_CONTEXT_CUSTOM("plot::binDensity"));
+    }
+    if (bins.x == 0 || bins.y == 0) {
+        throw Exception(fmt::format("Invalid number of bins {}", bins),
+                        IVW_CONTEXT_CUSTOM("plot::binDensity"));
+    }
+
+    const auto nBins = bins.x * bins.y;
+    const auto scale = [](dvec2 range, size_t n) {
+        return range.y > range.x ? static_cast<double>(n) / (range.y - range.x) : 0.0;
+    };
+    const dvec2 binScale{scale(xRange, bins.x), scale(yRange, bins.y)};
+    const bool hasFilter = !filtered.empty();
+
+    struct Local {
+        std::vector<std::uint32_t> counts;
+        std::vector<double> sums;
+        size_t total = 0;
+    };
+    // Each chunk bins into its own grid, so limit the chunks to roughly one per thread
+    const auto chunks = std::min(util::parallelChunkCount(size, 1 << 16), util::getPoolSize() + 1);
+    std::vector<Local> locals(chunks);
+
+    util::forEachChunkParallel(size, chunks, [&](size_t chunk, size_t begin, size_t end) {
+        auto& local = locals[chunk];
+        local.counts.assign(nBins, 0);
+        if (values) local.sums.assign(nBins, 0.0);
+
+        std::vector<double> xs;
+        std::vector<double> ys;
+        std::vector<double> vs;
+        for (size_t blockBegin = begin; blockBegin < end; blockBegin += blockSize) {
+            const auto blockEnd = std::min(blockBegin + blockSize, end);
+            toDouble(x, blockBegin, blockEnd, xs);
+            toDouble(y, blockBegin, blockEnd, ys);
+            if (values) toDouble(*values, blockBegin, blockEnd, vs);
+
+            for (size_t i = 0; i < blockEnd - blockBegin; ++i) {
+                const auto vx = xs[i];
+                const auto vy = ys[i];
+                // written as negated comparisons to skip NaNs as well
+                if (!(vx >= xRange.x && vx <= xRange.y && vy >= yRange.x && vy <= yRange.y)) {
+                    continue;
+                }
+                if (values && std::isnan(vs[i])) continue;
+                if (hasFilter && filtered.contains(static_cast<std::uint32_t>(blockBegin + i))) {
+                    continue;
+                }
+
+                const auto bx = std::min(static_cast<size_t>((vx - xRange.x) * binScale.x),
+                                         bins.x - 1);
+                const auto by = std::min(static_cast<size_t>((vy - yRange.x) * binScale.y),
+                                         bins.y - 1);
+                const auto bin = bx + by * bins.x;
+                ++local.counts[bin];
+                if (values) local.sums[bin] += vs[i];
+                ++local.total;
+            }
+        }
+    });
+
+    DensityGrid grid;
+    grid.dims = bins;
+    grid.xRange = xRange;
+    grid.yRange = yRange;
+    grid.counts.assign(nBins, 0);
+    if (values) grid.means.assign(nBins, 0.0);
+
+    util::forEachChunkParallel(
+        nBins, util::parallelChunkCount(nBins, 1 << 14), [&](size_t, size_t begin, size_t end) {
+            for (size_t bin = begin; bin < end; ++bin) {
+                std::uint32_t count = 0;
+                double sum = 0.0;
+                for (const auto& local : locals) {
+                    count += local.counts[bin];
+                    if (values) sum += local.sums[bin];
+                }
+                grid.counts[bin] = count;
+                if (values && count > 0) grid.means[bin] = sum / count;
+            }
+        });
+
+    for (const auto& local : locals) grid.total += local.total;
+    grid.maxCount = *std::max_element(grid.counts.begin(), grid.counts.end());
+
+    return grid;
+}
+
+}  // namespace plot
+
+}  // namespace inviwo
@@ -0,0 +1,112 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <inviwo/core/datastructures/bitset.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/util/exception.h>
+#include <modules/plotting/utils/densitybinning.h>
+
+#include <cmath>
+#include <limits>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+namespace inviwo {
+
+TEST(DensityBinningTest, CountsAndMeans) {
+    Buffer<float> X;
+    Buffer<double> Y;
+    Buffer<int> V;
+    X.getEditableRAMRepresentation()->getDataContainer() = {0.1f, 0.2f, 0.9f, 1.0f, 0.6f, 2.0f};
+    Y.getEditableRAMRepresentation()->getDataContainer() = {0.1, 0.3, 0.1, 1.0, 0.6, 0.5};
+    V.getEditableRAMRepresentation()->getDataContainer() = {1, 3, 5, 7, 9, 11};
+
+    const auto grid =
+        plot::binDensity(X, Y, &V, size2_t{2, 2}, dvec2{0.0, 1.0}, dvec2{0.0, 1.0});
+
+    ASSERT_EQ(4, grid.counts.size());
+    EXPECT_EQ(2, grid.counts[0]) << "lower left";
+    EXPECT_EQ(1, grid.counts[1]) << "lower right";
+    EXPECT_EQ(0, grid.counts[2]) << "upper left";
+    EXPECT_EQ(2, grid.counts[3]) << "upper right, including the upper range bound";
+    EXPECT_EQ(5, grid.total) << "row outside of the x range is skipped";
+    EXPECT_EQ(2, grid.maxCount);
+
+    ASSERT_EQ(4, grid.means.size());
+    EXPECT_DOUBLE_EQ(2.0, grid.means[0]);
+    EXPECT_DOUBLE_EQ(5.0, grid.means[1]);
+    EXPECT_DOUBLE_EQ(0.0, grid.means[2]);
+    EXPECT_DOUBLE_EQ(8.0, grid.means[3]);
+}
+
+TEST(DensityBinningTest, FilteredAndNaN) {
+    Buffer<double> X;
+    Buffer<double> Y;
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    X.getEditableRAMRepresentation()->getDataContainer() = {0.5, 0.5, nan, 0.5};
+    Y.getEditableRAMRepresentation()->getDataContainer() = {0.5, 0.5, 0.5, nan};
+
+    const auto grid = plot::binDensity(X, Y, nullptr, size2_t{1, 1}, dvec2{0.0, 1.0},
+                                       dvec2{0.0, 1.0}, BitSet(1));
+
+    EXPECT_TRUE(grid.means.empty());
+    ASSERT_EQ(1, grid.counts.size());
+    EXPECT_EQ(1, grid.counts[0]);
+    EXPECT_EQ(1, grid.total);
+}
+
+TEST(DensityBinningTest, SizeMismatchThrows) {
+    Buffer<double> X(4);
+    Buffer<double> Y(3);
+    EXPECT_THROW(
+        plot::binDensity(X, Y, nullptr, size2_t{2, 2}, dvec2{0.0, 1.0}, dvec2{0.0, 1.0}),
+        Exception);
+}
+
+TEST(DensityBinningTest, RepresentationsMatchBuffers) {
+    Buffer<float> X;
+    Buffer<int> Y;
+    X.getEditableRAMRepresentation()->getDataContainer() = {0.1f, 0.2f, 0.9f, 0.7f, 0.6f};
+    Y.getEditableRAMRepresentation()->getDataContainer() = {0, 1, 1, 0, 1};
+
+    const auto expected =
+        plot::binDensity(X, Y, &X, size2_t{3, 2}, dvec2{0.0, 1.0}, dvec2{0.0, 1.0}, BitSet(3));
+    const auto* xRAM = X.getRepresentation<BufferRAM>();
+    const auto grid = plot::binDensity(*xRAM, *Y.getRepresentation<BufferRAM>(), xRAM,
+                                       size2_t{3, 2}, dvec2{0.0, 1.0}, dvec2{0.0, 1.0}, BitSet(3));
+
+    EXPECT_EQ(expected.counts, grid.counts);
+    EXPECT_EQ(expected.means, grid.means);
+    EXPECT_EQ(4, grid.total);
+}
+
+}  // namespace inviwo
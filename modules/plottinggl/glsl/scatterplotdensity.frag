@@ -0,0 +1,71 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include "utils/structs.glsl"
+
+// vec2 texture with the number of points (r) and the mean color value (g) of each bin
+uniform sampler2D density;
+uniform sampler2D transferFunction;
+
+uniform vec2 dims;
+uniform vec4 margins;  // top, right, bottom, left
+uniform float maxCount = 1.0;
+
+uniform vec4 default_color;
+uniform int has_color = 0;
+uniform vec2 minmaxC;
+
+in vec3 texCoord_;
+
+float norm(in float v, in vec2 mm) { 
+    return (v - mm.x) / (mm.y - mm.x); 
+}
+
+void main() {
+    vec2 plotSize = dims - vec2(margins.w + margins.y, margins.z + margins.x);
+    vec2 pos = (texCoord_.xy * dims - margins.wz) / plotSize;
+    if (any(lessThan(pos, vec2(0.0))) || any(greaterThan(pos, vec2(1.0)))) {
+        discard;
+    }
+
+    vec2 bin = texture(density, pos).rg;
+    if (bin.r <= 0.0) {
+        discard;
+    }
+
+    vec4 color = default_color;
+    if (has_color == 1) {
+        color = texture(transferFunction, vec2(norm(bin.g, minmaxC), 0.5));
+    }
+    // logarithmic density mapping to keep sparse bins visible next to dense ones
+    color.a *= log(1.0 + bin.r) / log(1.0 + maxCount);
+
+    color.rgb *= color.a;
+    FragData0 = color;
+    PickingData = vec4(0.0);
+}
@@ -40,6 +40,7 @@
 #include <inviwo/core/properties/boolproperty.h>                          // for BoolProperty
 #include <inviwo/core/properties/compositeproperty.h>                     // for CompositeProperty
 #include <inviwo/core/properties/invalidationlevel.h>                     // for InvalidationLevel
+#include <inviwo/core/properties/optionproperty.h>                        // for OptionProperty
 #include <inviwo/core/properties/ordinalproperty.h>                       // for FloatProperty
 #include <inviwo/core/properties/propertysemantics.h>                     // for PropertySemantics
 #include <inviwo/core/properties/selectioncolorproperty.h>                // for SelectionColorP...
@@ -54,6 +55,7 @@
 #include <modules/plotting/properties/axisstyleproperty.h>                // for AxisStyleProperty
 #include <modules/plotting/properties/boxselectionproperty.h>             // for BoxSelectionPro...
 #include <modules/plotting/properties/marginproperty.h>                   // for MarginProperty
+#include <modules/plotting/utils/densitybinning.h>                        // for DensityGrid
 #include <modules/plottinggl/rendering/boxselectionrenderer.h>            // for BoxSelectionRen...
 #include <modules/plottinggl/utils/axisrenderer.h>                        // for AxisRenderer
 
@@ -73,6 +75,7 @@ namespace inviwo {
 class Column;
 class Event;
 class ImageOutport;
+class Layer;
 class PickingEvent;
 class Processor;
 class TextureUnitContainer;
@@ -91,6 +94,14 @@ public:
     using SelectionCallbackHandle = std::shared_ptr<std::function<SelectionFunc>>;
 
     enum class SortingOrder { Ascending, Descending };
+    /**
+     * Points draws every row as a glyph. Density bins the rows into a 2D histogram on the CPU,
+     * see plot::binDensity, and draws it as a texture. Auto uses density rendering as long as
+     * more than `densityThreshold_` rows are visible, i.e. switches to points when zoomed in.
+     * The binning runs on the thread pool, so density rendering requires a processor to
+     * invalidate when it is done, without one points are always drawn.
+     */
+    enum class RenderMode { Points, Density, Auto };
 
     class Properties : public CompositeProperty {
     public:
@@ -124,6 +135,10 @@ public:
         FloatProperty borderWidth_;
         FloatVec4Property borderColor_;
 
+        OptionProperty<RenderMode> renderMode_;
+        IntProperty densityBinSize_;  ///! Size of the density bins in pixels
+        Size_tProperty densityThreshold_;
+
         AxisStyleProperty axisStyle_;
         AxisProperty xAxis_;
         AxisProperty yAxis_;
@@ -132,12 +147,14 @@ public:
         auto props() {
             return std::tie(radiusRange_, useCircle_, minRadius_, tf_, color_, showHighlighted_,
                             showSelected_, showFiltered_, tooltip_, boxSelectionSettings_, margins_,
-                            axisMargin_, borderWidth_, borderColor_, axisStyle_, xAxis_, yAxis_);
+                            axisMargin_, borderWidth_, borderColor_, renderMode_, densityBinSize_,
+                            densityThreshold_, axisStyle_, xAxis_, yAxis_);
         }
         auto props() const {
             return std::tie(radiusRange_, useCircle_, minRadius_, tf_, color_, showHighlighted_,
                             showSelected_, showFiltered_, tooltip_, boxSelectionSettings_, margins_,
-                            axisMargin_, borderWidth_, borderColor_, axisStyle_, xAxis_, yAxis_);
+                            axisMargin_, borderWidth_, borderColor_, renderMode_, densityBinSize_,
+                            densityThreshold_, axisStyle_, xAxis_, yAxis_);
         }
     };
 
@@ -209,6 +226,12 @@ protected:
     void attachVertexAttributes();
     void setShaderUniforms(TextureUnitContainer& cont, const size2_t& dims, bool useAxisRanges);
     void renderAxis(const size2_t& dims);
+    /**
+     * Request a new density grid if needed and decide whether to use density rendering.
+     * @return true if the density should be drawn instead of the points
+     */
+    bool updateDensity(const size2_t& dims, bool useAxisRanges);
+    void renderDensity(const size2_t& dims);
 
     void objectPicked(PickingEvent* p);
     uint32_t getGlobalPickId(uint32_t localIndex) const;
@@ -231,6 +254,28 @@ protected:
     };
     Points points_;
 
+    /**
+     * The density grid is binned on the thread pool. plot() draws the latest finished grid and
+     * requests a new one when the data, the filtering, the ranges, or the bins differ from the
+     * last request. Only one binning job is running at a time, the processor is invalidated when
+     * it finishes, which will request a new grid if anything changed in the meantime.
+     */
+    struct DensityResult {
+        DensityGrid grid;
+        std::shared_ptr<Layer> layer;
+        bool pending = false;
+    };
+    struct Density {
+        std::shared_ptr<DensityResult> result = std::make_shared<DensityResult>();
+        bool dirty = true;
+        size2_t bins{0};
+        dvec2 xRange{0.0};
+        dvec2 yRange{0.0};
+        bool includeFiltered = false;
+    };
+    Density density_;
+    Shader densityShader_;
+
     std::shared_ptr<const TemplateColumn<uint32_t>> indexColumn_;
 
     SortingOrder sortOrder_ = SortingOrder::Ascending;
@@ -134,7 +134,6 @@ private:
                                                            //! to index of column in the dataframe.
 
     BitSet filteredIndices_;
-    std::unordered_map<uint32_t, uint32_t> indexToRowMap_;
 };
 
 }  // namespace plot
@@ -42,14 +42,13 @@
 #include <modules/opengl/texture/textureutils.h>                       // for ImageInport
 #include <modules/plottinggl/plotters/scatterplotgl.h>                 // for ScatterPlotGL::Sor...
 
-#include <cstddef>        // for size_t
-#include <cstdint>        // for uint32_t
-#include <functional>     // for __base, function
-#include <memory>         // for shared_ptr
-#include <string>         // for operator==, operator+
-#include <string_view>    // for operator==
-#include <unordered_map>  // for unordered_map
-#include <vector>         // for operator!=, vector
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t
+#include <functional>   // for __base, function
+#include <memory>       // for shared_ptr
+#include <string>       // for operator==, operator+
+#include <string_view>  // for operator==
+#include <vector>       // for operator!=, vector
 
 namespace inviwo {
 class PickingEvent;
@@ -100,8 +99,6 @@ private:
     ScatterPlotGL::HighlightCallbackHandle highlightChangedCallBack_;
     ScatterPlotGL::SelectionCallbackHandle selectionChangedCallBack_;
     ScatterPlotGL::SelectionCallbackHandle filteringChangedCallBack_;
-
-    std::unordered_map<uint32_t, uint32_t> indexToRowMap_;
 };
 
 }  // namespace plot
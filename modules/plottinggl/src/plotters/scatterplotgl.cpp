@@ -34,6 +34,7 @@
 #include <inviwo/core/datastructures/buffer/bufferram.h>                  // for BufferRAM
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>         // for BufferRAMPrecision
 #include <inviwo/core/datastructures/image/image.h>                       // for Image
+#include <inviwo/core/datastructures/image/layer.h>                       // for Layer
 #include <inviwo/core/datastructures/representationconverter.h>           // for RepresentationC...
 #include <inviwo/core/datastructures/representationconverterfactory.h>    // for RepresentationC...
 #include <inviwo/core/datastructures/tfprimitive.h>                       // for TFPrimitiveData
@@ -49,20 +50,25 @@
 #include <inviwo/core/properties/compositeproperty.h>                     // for CompositeProperty
 #include <inviwo/core/properties/invalidationlevel.h>                     // for InvalidationLevel
 #include <inviwo/core/properties/minmaxproperty.h>                        // for DoubleMinMaxPro...
+#include <inviwo/core/properties/optionproperty.h>                        // for OptionProperty
 #include <inviwo/core/properties/ordinalproperty.h>                       // for FloatProperty
 #include <inviwo/core/properties/propertysemantics.h>                     // for PropertySemantics
 #include <inviwo/core/properties/selectioncolorproperty.h>                // for SelectionColorP...
 #include <inviwo/core/properties/transferfunctionproperty.h>              // for TransferFunctio...
 #include <inviwo/core/util/dispatcher.h>                                  // for Dispatcher
+#include <inviwo/core/util/exception.h>                                   // for Exception
 #include <inviwo/core/util/foreacharg.h>                                  // for for_each_in_tuple
 #include <inviwo/core/util/formatdispatching.h>                           // for Scalars
 #include <inviwo/core/util/glmvec.h>                                      // for dvec2, vec4
+#include <inviwo/core/util/logcentral.h>                                  // for log
 #include <inviwo/core/util/stdextensions.h>                               // for transform
+#include <inviwo/core/util/threadutil.h>                                  // for dispatchPool
 #include <inviwo/core/util/zip.h>                                         // for make_sequence
 #include <inviwo/dataframe/datastructures/column.h>                       // for Column
 #include <modules/opengl/buffer/buffergl.h>                               // for BufferGL
 #include <modules/opengl/buffer/bufferobject.h>                           // for BufferObject
 #include <modules/opengl/buffer/bufferobjectarray.h>                      // for BufferObjectArray
+#include <modules/opengl/image/layergl.h>                                 // for LayerGL
 #include <modules/opengl/inviwoopengl.h>                                  // for glDrawElements
 #include <modules/opengl/openglutils.h>                                   // for BlendModeState
 #include <modules/opengl/shader/shader.h>                                 // for Shader
@@ -75,6 +81,7 @@
 #include <modules/plotting/properties/axisstyleproperty.h>                // for AxisStyleProperty
 #include <modules/plotting/properties/boxselectionproperty.h>             // for BoxSelectionPro...
 #include <modules/plotting/properties/marginproperty.h>                   // for MarginProperty
+#include <modules/plotting/utils/densitybinning.h>                        // for binDensity
 #include <modules/plottinggl/rendering/boxselectionrenderer.h>            // for BoxSelectionRen...
 #include <modules/plottinggl/utils/axisrenderer.h>                        // for AxisRenderer
 
@@ -122,6 +129,14 @@ ScatterPlotGL::Properties::Properties(std::string_view identifier, std::string_v
     , borderWidth_("borderWidth", "Border Width", 2, 0, 20)
     , borderColor_("borderColor", "Border Color", util::ordinalColor(0.0f, 0.0f, 0.0f, 1.0f))
 
+    , renderMode_("renderMode", "Rendering",
+                  {{"points", "Points", RenderMode::Points},
+                   {"density", "Density", RenderMode::Density},
+                   {"auto", "Auto (density for many points)", RenderMode::Auto}},
+                  2)
+    , densityBinSize_("densityBinSize", "Density Bin Size", 2, 1, 32)
+    , densityThreshold_("densityThreshold", "Max Points", 1'000'000, 0, 100'000'000, 1'000)
+
     , axisStyle_("axisStyle", "Global Axis Style")
     , xAxis_("xAxis", "X Axis")
     , yAxis_("yAxis", "Y Axis", AxisProperty::Orientation::Vertical) {
@@ -153,6 +168,9 @@ ScatterPlotGL::Properties::Properties(const ScatterPlotGL::Properties& rhs)
     , axisMargin_(rhs.axisMargin_)
     , borderWidth_(rhs.borderWidth_)
     , borderColor_(rhs.borderColor_)
+    , renderMode_(rhs.renderMode_)
+    , densityBinSize_(rhs.densityBinSize_)
+    , densityThreshold_(rhs.densityThreshold_)
     , axisStyle_(rhs.axisStyle_)
     , xAxis_(rhs.xAxis_)
     , yAxis_(rhs.yAxis_) {
@@ -169,6 +187,7 @@ ScatterPlotGL::Properties* ScatterPlotGL::Properties::clone() const {
 ScatterPlotGL::ScatterPlotGL(Processor* processor)
     : properties_("scatterplot", "Scatterplot")
     , shader_("scatterplot.vert", "scatterplot.geom", "scatterplot.frag")
+    , densityShader_("img_identity.vert", "scatterplotdensity.frag")
     , axisRenderers_({{properties_.xAxis_, properties_.yAxis_}})
     , picking_(processor, 1, [this](PickingEvent* p) { objectPicked(p); })
     , partitionDirty_(true)
@@ -203,6 +222,8 @@ ScatterPlotGL::ScatterPlotGL(Processor* processor)
 
     if (processor_) {
         shader_.onReload([this]() { processor_->invalidate(InvalidationLevel::InvalidOutput); });
+        densityShader_.onReload(
+            [this]() { processor_->invalidate(InvalidationLevel::InvalidOutput); });
     }
     properties_.showHighlighted_.onChange([this]() {
         if (!properties_.showHighlighted_) {
@@ -289,6 +310,7 @@ void ScatterPlotGL::setXAxisData(const Column* col) {
         points_.xCoord = nullptr;
     }
     partitionDirty_ = true;
+    density_.dirty = true;
     boxSelectionHandler_.setXAxisData(points_.xCoord);
 }
 
@@ -301,6 +323,7 @@ void ScatterPlotGL::setYAxisData(const Column* col) {
         points_.yCoord = nullptr;
     }
     partitionDirty_ = true;
+    density_.dirty = true;
     boxSelectionHandler_.setYAxisData(points_.yCoord);
 }
 
@@ -312,6 +335,7 @@ void ScatterPlotGL::setColorData(const Column* col) {
         points_.color = nullptr;
     }
     partitionDirty_ = true;
+    density_.dirty = true;
     properties_.tf_.setVisible(points_.color != nullptr);
     properties_.color_.setVisible(points_.color == nullptr);
 }
@@ -359,13 +383,17 @@ void ScatterPlotGL::setSortingOrder(SortingOrder order) {
 
 void ScatterPlotGL::setIndices(const BitSet& filtered, const BitSet& selected,
                                const BitSet& highlighted) {
-    partitionDirty_ |= filtered_.set(filtered);
+    const bool filteredChanged = filtered_.set(filtered);
+    partitionDirty_ |= filteredChanged;
+    density_.dirty |= filteredChanged;
     partitionDirty_ |= selected_.set(selected);
     partitionDirty_ |= highlighted_.set(highlighted);
 }
 
 void ScatterPlotGL::setFilteredIndices(const BitSet& indices) {
-    partitionDirty_ |= filtered_.set(indices);
+    const bool filteredChanged = filtered_.set(indices);
+    partitionDirty_ |= filteredChanged;
+    density_.dirty |= filteredChanged;
 }
 
 void ScatterPlotGL::setSelectedIndices(const BitSet& indices) {
@@ -406,11 +434,14 @@ void ScatterPlotGL::invokeEvent(Event* event) {
 }
 
 void ScatterPlotGL::plot(const size2_t& dims, bool useAxisRanges) {
-    if (partitionDirty_) {
+    const bool density = updateDensity(dims, useAxisRanges);
+    if (density) {
+        renderDensity(dims);
+    } else if (partitionDirty_) {
         partitionData();
     }
 
-    if (!points_.indices.empty()) {
+    if (!density && !points_.indices.empty()) {
         utilgl::BlendModeState blending(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
         utilgl::DepthFuncState depthFunc(GL_LEQUAL);
 
@@ -510,6 +541,102 @@ void ScatterPlotGL::setShaderUniforms(TextureUnitContainer& cont, const size2_t&
     }
 }
 
+bool ScatterPlotGL::updateDensity(const size2_t& dims, bool useAxisRanges) {
+    const auto mode = properties_.renderMode_.get();
+    if (mode == RenderMode::Points || !points_.xCoord || !points_.yCoord) return false;
+    // The grid is binned asynchronously and the processor is invalidated when it is done, plots
+    // without a processor, like the ones of the ScatterPlotMatrixProcessor, draw points.
+    if (!processor_) return false;
+
+    // Avoid binning altogether if there are too few rows in total
+    const size_t threshold = properties_.densityThreshold_.get();
+    if (mode == RenderMode::Auto && points_.xCoord->getSize() <= threshold) return false;
+
+    const dvec4 margins = properties_.margins_.getAsVec4() + properties_.axisMargin_.get();
+    const dvec2 plotSize = glm::max(
+        dvec2(dims) - dvec2{margins.y + margins.w, margins.x + margins.z}, dvec2{1.0});
+    const auto bins = glm::max(
+        size2_t(plotSize / static_cast<double>(properties_.densityBinSize_.get())), size2_t{1});
+    const dvec2 rangeX = useAxisRanges ? properties_.xAxis_.range_.get() : dvec2(minmaxX_);
+    const dvec2 rangeY = useAxisRanges ? properties_.yAxis_.range_.get() : dvec2(minmaxY_);
+
+    const bool includeFiltered = properties_.showFiltered_;
+    auto& result = *density_.result;
+    if (!result.pending &&
+        (density_.dirty || density_.bins != bins || density_.xRange != rangeX ||
+         density_.yRange != rangeY || density_.includeFiltered != includeFiltered)) {
+        density_.dirty = false;
+        density_.bins = bins;
+        density_.xRange = rangeX;
+        density_.yRange = rangeY;
+        density_.includeFiltered = includeFiltered;
+        result.pending = true;
+
+        // Fetch the representations here, the job only reads them. The buffers are captured to
+        // keep the representations alive.
+        const auto* xRAM = points_.xCoord->getRepresentation<BufferRAM>();
+        const auto* yRAM = points_.yCoord->getRepresentation<BufferRAM>();
+        const auto* cRAM = points_.color ? points_.color->getRepresentation<BufferRAM>() : nullptr;
+
+        util::dispatchPool([weakResult = std::weak_ptr<DensityResult>(density_.result),
+                            processor = processor_, x = points_.xCoord, y = points_.yCoord,
+                            c = points_.color, xRAM, yRAM, cRAM, bins, rangeX, rangeY,
+                            filtered = includeFiltered ? BitSet{} : filtered_]() {
+            DensityGrid grid;
+            std::shared_ptr<Layer> layer;
+            try {
+                grid = binDensity(*xRAM, *yRAM, cRAM, bins, rangeX, rangeY, filtered);
+                layer = grid.toLayer();
+            } catch (const Exception& e) {
+                util::log(e.getContext(), e.getMessage(), LogLevel::Error);
+            }
+            util::dispatchFrontAndForget([weakResult, processor, grid = std::move(grid),
+                                          layer = std::move(layer)]() {
+                if (auto r = weakResult.lock()) {
+                    r->grid = grid;
+                    r->layer = layer;
+                    r->pending = false;
+                    processor->invalidate(InvalidationLevel::InvalidOutput);
+                }
+            });
+        });
+    }
+
+    // Until the first grid is done nothing is drawn, drawing all points is what density rendering
+    // is there to avoid. grid.total is the number of rows within the axis ranges of the grid,
+    // i.e. zooming in will eventually bring it below the threshold.
+    if (!result.layer) return true;
+    return mode == RenderMode::Density || result.grid.total > threshold;
+}
+
+void ScatterPlotGL::renderDensity(const size2_t& dims) {
+    const auto& result = *density_.result;
+    if (!result.layer || result.grid.maxCount == 0) return;
+
+    utilgl::BlendModeState blending(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    utilgl::GlBoolState depthTest(GL_DEPTH_TEST, false);
+
+    TextureUnitContainer cont;
+    densityShader_.activate();
+
+    auto& unit = cont.emplace_back();
+    result.layer->getRepresentation<LayerGL>()->bindTexture(unit);
+    densityShader_.setUniform("density", unit);
+    densityShader_.setUniform("dims", vec2(dims));
+    densityShader_.setUniform("margins",
+                              properties_.margins_.getAsVec4() + properties_.axisMargin_.get());
+    densityShader_.setUniform("maxCount", static_cast<float>(result.grid.maxCount));
+    densityShader_.setUniform("default_color", properties_.color_.get());
+    densityShader_.setUniform("has_color", static_cast<int>(points_.color != nullptr));
+    if (points_.color) {
+        utilgl::bindAndSetUniforms(densityShader_, cont, properties_.tf_);
+        densityShader_.setUniform("minmaxC", minmaxC_);
+    }
+
+    utilgl::singleDrawImagePlaneRect();
+    densityShader_.deactivate();
+}
+
 void ScatterPlotGL::renderAxis(const size2_t& dims) {
     const size2_t lowerLeft(properties_.margins_.getLeft(), properties_.margins_.getBottom());
     const size2_t upperRight(dims.x - 1 - properties_.margins_.getRight(),
@@ -57,7 +57,6 @@
 #include <inviwo/core/util/glmvec.h>                                   // for vec2, size2_t, ivec2
 #include <inviwo/core/util/sourcecontext.h>                            // for IVW_CONTEXT
 #include <inviwo/core/util/utilities.h>                                // for stripIdentifier
-#include <inviwo/core/util/zip.h>                                      // for enumerate, zipIter...
 #include <inviwo/dataframe/datastructures/dataframe.h>                 // for DataFrame, DataFra...
 #include <inviwo/dataframe/properties/columnoptionproperty.h>          // for ColumnOptionProperty
 #include <modules/brushingandlinking/brushingandlinkingmanager.h>      // for BrushingTargetsInv...
@@ -211,17 +210,6 @@ void ScatterPlotMatrixProcessor::process() {
             p->properties_.set(&scatterPlotproperties_);
         }
 
-        indexToRowMap_ = [&]() {
-            auto iCol = dataFrame_.getData()->getIndexColumn();
-            auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
-            std::unordered_map<uint32_t, uint32_t> indexToRow;
-            indexToRow.reserve(indexCol.size());
-            for (auto&& [row, index] : util::enumerate(indexCol)) {
-                indexToRow.try_emplace(index, static_cast<uint32_t>(row));
-            }
-            return indexToRow;
-        }();
-
         initialSetup = true;
     }
     if (labelsTextures_.empty()) {
@@ -233,17 +221,7 @@ void ScatterPlotMatrixProcessor::process() {
 
     std::unique_ptr<IndexBuffer> indicies = nullptr;
     if (brushing_.isConnected() && (brushing_.isFilteringModified() || initialSetup)) {
-        auto transformIdsToRows = [&](const BitSet& b) {
-            BitSet rows;
-            for (auto id : b) {
-                auto it = indexToRowMap_.find(id);
-                if (it != indexToRowMap_.end()) {
-                    rows.add(it->second);
-                }
-            }
-            return rows;
-        };
-        filteredIndices_ = transformIdsToRows(brushing_.getFilteredIndices());
+        filteredIndices_ = dataFrame_.getData()->idsToRows(brushing_.getFilteredIndices());
         initialSetup = false;
     }
 
@@ -40,7 +40,6 @@
 #include <inviwo/core/properties/optionproperty.h>                     // for OptionPropertyOption
 #include <inviwo/core/properties/ordinalproperty.h>                    // for FloatProperty
 #include <inviwo/core/util/staticstring.h>                             // for operator+
-#include <inviwo/core/util/zip.h>                                      // for enumerate, zipIter...
 #include <inviwo/dataframe/datastructures/dataframe.h>                 // for DataFrameInport
 #include <inviwo/dataframe/properties/columnoptionproperty.h>          // for ColumnOptionProperty
 #include <inviwo/dataframe/util/dataframeutil.h>                       // for createToolTipForRow
@@ -104,37 +103,19 @@ ScatterPlotProcessor::ScatterPlotProcessor()
     highlightChangedCallBack_ =
         scatterPlot_.addHighlightChangedCallback([this](const BitSet& highlighted) {
             if (auto data = dataFramePort_.getData()) {
-                BitSet indices;
-                auto iCol = data->getIndexColumn();
-                auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
-                for (auto idx : highlighted) {
-                    indices.add(indexCol[idx]);
-                }
-                brushingPort_.highlight(indices);
+                brushingPort_.highlight(data->rowsToIds(highlighted));
             }
         });
     selectionChangedCallBack_ =
         scatterPlot_.addSelectionChangedCallback([this](const BitSet& selected) {
             if (auto data = dataFramePort_.getData()) {
-                BitSet indices;
-                auto iCol = data->getIndexColumn();
-                auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
-                for (auto idx : selected) {
-                    indices.add(indexCol[idx]);
-                }
-                brushingPort_.select(indices);
+                brushingPort_.select(data->rowsToIds(selected));
             }
         });
     filteringChangedCallBack_ =
         scatterPlot_.addFilteringChangedCallback([this](const BitSet& filtered) {
             if (auto data = dataFramePort_.getData()) {
-                BitSet indices;
-                auto iCol = data->getIndexColumn();
-                auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
-                for (auto idx : filtered) {
-                    indices.add(indexCol[idx]);
-                }
-                brushingPort_.filter("scatterplot", indices);
+                brushingPort_.filter("scatterplot", data->rowsToIds(filtered));
             }
         });
     addInteractionHandler(&scatterPlot_);
@@ -179,39 +160,16 @@ ScatterPlotProcessor::ScatterPlotProcessor()
 void ScatterPlotProcessor::process() {
     utilgl::BlendModeState blending(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
-    if (dataFramePort_.isChanged()) {
-        indexToRowMap_ = [&]() {
-            auto iCol = dataFramePort_.getData()->getIndexColumn();
-            auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
-            std::unordered_map<uint32_t, uint32_t> indexToRow;
-            indexToRow.reserve(indexCol.size());
-            for (auto&& [row, index] : util::enumerate(indexCol)) {
-                indexToRow.try_emplace(index, static_cast<uint32_t>(row));
-            }
-            return indexToRow;
-        }();
-    }
-
-    auto transformIdsToRows = [&](const BitSet& b) {
-        BitSet rows;
-        for (auto id : b) {
-            auto it = indexToRowMap_.find(id);
-            if (it != indexToRowMap_.end()) {
-                rows.add(it->second);
-            }
-        }
-        return rows;
-    };
+    const auto& data = *dataFramePort_.getData();
 
     if (brushingPort_.isSelectionModified() || dataFramePort_.isChanged()) {
-        scatterPlot_.setSelectedIndices(transformIdsToRows(brushingPort_.getSelectedIndices()));
+        scatterPlot_.setSelectedIndices(data.idsToRows(brushingPort_.getSelectedIndices()));
     }
     if (brushingPort_.isHighlightModified() || dataFramePort_.isChanged()) {
-        scatterPlot_.setHighlightedIndices(
-            transformIdsToRows(brushingPort_.getHighlightedIndices()));
+        scatterPlot_.setHighlightedIndices(data.idsToRows(brushingPort_.getHighlightedIndices()));
     }
     if (brushingPort_.isFilteringModified() || dataFramePort_.isChanged()) {
-        scatterPlot_.setFilteredIndices(transformIdsToRows(brushingPort_.getFilteredIndices()));
+        scatterPlot_.setFilteredIndices(data.idsToRows(brushingPort_.getFilteredIndices()));
     }
 
     if (backgroundPort_.isReady()) {
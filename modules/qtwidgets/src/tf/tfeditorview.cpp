@@ -293,6 +293,11 @@ void TFEditorView::updateHistogram() {
             } else if (!histCalculation_) {
                 histograms_.clear();
                 histCalculation_ = volume->calculateHistograms(2048);
+                histCalculation_->whenPreview([this](const HistogramContainer& histograms) {
+                    updateHistogram(histograms);
+                    resetCachedContent();
+                    update();
+                });
                 histCalculation_->whenDone([this](const HistogramContainer& histograms) {
                     updateHistogram(histograms);
                     resetCachedContent();
@@ -371,7 +376,9 @@ void TFEditorView::drawBackground(QPainter* painter, const QRectF& rect) {
         font.setPointSize(12);
         painter->setFont(font);
         painter->drawText(QRect(0, 0, width(), height()).adjusted(20, 10, -20, -10),
-                          Qt::AlignRight | Qt::AlignTop, QString("Calculating histogram..."));
+                          Qt::AlignRight | Qt::AlignTop,
+                          histCalculation_->hasPreview() ? QString("Refining histogram...")
+                                                         : QString("Calculating histogram..."));
         painter->restore();
     }
 
@@ -0,0 +1,248 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <modules/vectorfieldvisualization/vectorfieldvisualizationmoduledefine.h>  // for IVW_M...
+
+#include <inviwo/core/datastructures/buffer/buffer.h>                      // for Buffer
+#include <inviwo/core/datastructures/datatraits.h>                         // for DataT...
+#include <inviwo/core/datastructures/geometry/mesh.h>                      // for Mesh
+#include <inviwo/core/ports/datainport.h>                                  // for DataI...
+#include <inviwo/core/ports/dataoutport.h>                                 // for DataO...
+#include <inviwo/core/util/document.h>                                     // for Document
+#include <inviwo/core/util/exception.h>                                    // for Excep...
+#include <inviwo/core/util/glmmat.h>                                       // for mat4
+#include <inviwo/core/util/glmvec.h>                                       // for vec3
+#include <inviwo/core/util/sourcecontext.h>                                // for IVW_C...
+#include <modules/vectorfieldvisualization/datastructures/integralline.h>  // for Integ...
+
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t
+#include <map>          // for map
+#include <memory>       // for shared_ptr
+#include <mutex>        // for mutex
+#include <span>         // for span
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <utility>      // for pair
+#include <vector>       // for vector
+
+#include <fmt/core.h>  // for format
+
+namespace inviwo {
+
+class IntegralLineSet;
+
+/**
+ * \brief A set of integral lines stored in a compressed sparse row (CSR) layout.
+ *
+ * Unlike IntegralLineSet, where every IntegralLine owns its positions and meta data buffers, all
+ * positions and each meta data channel are stored in single contiguous buffers. Each line is
+ * described by a LineInfo, i.e. an offset and a size into these buffers. Positions are stored in
+ * single precision, the same as a Mesh, so that toMesh() can share the buffers with the Mesh
+ * instead of copying the vertex data.
+ *
+ * Lines are added through a Builder. A Builder is not thread safe but only touches its own
+ * arrays, hence each tracing thread can fill its own Builder without any synchronization. A
+ * filled Builder is then moved into the set with append(), which is thread safe and only locks
+ * once per Builder, not once per line.
+ */
+class IVW_MODULE_VECTORFIELDVISUALIZATION_API PackedIntegralLineSet {
+public:
+    using TerminationReason = IntegralLine::TerminationReason;
+
+    struct LineInfo {
+        size_t offset;
+        size_t size;
+        uint32_t index;
+        TerminationReason backwardTerminationReason;
+        TerminationReason forwardTerminationReason;
+    };
+
+    /**
+     * Collects lines to be appended to a PackedIntegralLineSet. Every meta data channel must
+     * have one value per position when the Builder is appended.
+     */
+    class IVW_MODULE_VECTORFIELDVISUALIZATION_API Builder {
+    public:
+        Builder() = default;
+
+        /**
+         * Add a line with positions, meta data has to be added separately using getMetaData()
+         */
+        void addLine(std::span<const dvec3> positions, uint32_t index,
+                     TerminationReason backward = TerminationReason::Unknown,
+                     TerminationReason forward = TerminationReason::Unknown);
+
+        /**
+         * Add a copy of \p line including all its meta data
+         */
+        void addLine(const IntegralLine& line);
+
+        /**
+         * Get the meta data channel \p name, creating it if it does not exist.
+         * @throw Exception if the channel exists with a different format
+         */
+        template <typename T>
+        std::vector<T>& getMetaData(std::string_view name);
+
+        size_t size() const { return lines_.size(); }
+        size_t getNumberOfPoints() const { return positions_.size(); }
+        void clear();
+
+    private:
+        friend PackedIntegralLineSet;
+        std::vector<vec3> positions_;
+        std::vector<LineInfo> lines_;
+        std::map<std::string, std::shared_ptr<BufferBase>, std::less<>> metaData_;
+    };
+
+    PackedIntegralLineSet(mat4 modelMatrix, mat4 worldMatrix = mat4(1));
+    /**
+     * Pack all the lines of \p lines
+     */
+    explicit PackedIntegralLineSet(const IntegralLineSet& lines);
+
+    mat4 getModelMatrix() const;
+    mat4 getWorldMatrix() const;
+
+    /**
+     * Move all lines of \p builder into the set. Thread safe with respect to other calls to
+     * append, but not to any of the accessors.
+     * @throw Exception if the meta data channels of \p builder do not match the ones of the set
+     */
+    void append(Builder&& builder);
+
+    size_t size() const;
+    size_t getNumberOfPoints() const;
+
+    const std::vector<LineInfo>& getLines() const;
+    const LineInfo& getLine(size_t line) const;
+
+    std::span<const vec3> getPositions() const;
+    std::span<const vec3> getPositions(size_t line) const;
+    const std::shared_ptr<Buffer<vec3>>& getPositionBuffer() const;
+
+    bool hasMetaData(std::string_view name) const;
+    std::vector<std::string> getMetaDataKeys() const;
+    std::shared_ptr<const BufferBase> getMetaDataBuffer(std::string_view name) const;
+
+    /**
+     * The values of meta data channel \p name for all lines
+     * @throw Exception if the channel is missing or has a different format
+     */
+    template <typename T>
+    std::span<const T> getMetaData(std::string_view name) const;
+
+    /**
+     * The values of meta data channel \p name for one \p line
+     * @throw Exception if the channel is missing or has a different format
+     */
+    template <typename T>
+    std::span<const T> getMetaData(std::string_view name, size_t line) const;
+
+    /**
+     * Create a standalone IntegralLine from line \p line, copying its positions and meta data
+     */
+    IntegralLine getIntegralLine(size_t line) const;
+
+    /**
+     * Create a line mesh with one index buffer of lines with adjacency information. The mesh
+     * shares the position buffer and the requested meta data buffers with the set, only the
+     * indices are created.
+     * @param metaData pairs of meta data channel names and the buffer info to use in the mesh
+     * @throw Exception if a requested meta data channel is missing
+     */
+    std::shared_ptr<Mesh> toMesh(
+        const std::vector<std::pair<std::string, Mesh::BufferInfo>>& metaData = {}) const;
+
+private:
+    mutable std::mutex mutex_;
+    std::shared_ptr<Buffer<vec3>> positions_;
+    std::vector<LineInfo> lines_;
+    std::map<std::string, std::shared_ptr<BufferBase>, std::less<>> metaData_;
+    mat4 modelMatrix_;
+    mat4 worldMatrix_;
+};
+
+namespace detail {
+
+/**
+ * @throw Exception if \p buffer does not have the format \p format
+ */
+IVW_MODULE_VECTORFIELDVISUALIZATION_API void checkMetaDataFormat(const BufferBase& buffer,
+                                                                const DataFormatBase* format,
+                                                                std::string_view name);
+
+}  // namespace detail
+
+template <typename T>
+std::vector<T>& PackedIntegralLineSet::Builder::getMetaData(std::string_view name) {
+    auto it = metaData_.find(name);
+    if (it == metaData_.end()) {
+        it = metaData_.emplace(std::string{name}, std::make_shared<Buffer<T>>()).first;
+    }
+    detail::checkMetaDataFormat(*it->second, DataFormat<T>::get(), name);
+    return static_cast<Buffer<T>&>(*it->second).getEditableRAMRepresentation()->getDataContainer();
+}
+
+template <typename T>
+std::span<const T> PackedIntegralLineSet::getMetaData(std::string_view name) const {
+    auto it = metaData_.find(name);
+    if (it == metaData_.end()) {
+        throw Exception(fmt::format("No meta data with name: {}", name),
+                        IVW_CONTEXT_CUSTOM("PackedIntegralLineSet"));
+    }
+    detail::checkMetaDataFormat(*it->second, DataFormat<T>::get(), name);
+    return static_cast<const Buffer<T>&>(*it->second).getRAMRepresentation()->getDataContainer();
+}
+
+template <typename T>
+std::span<const T> PackedIntegralLineSet::getMetaData(std::string_view name, size_t line) const {
+    const auto& info = lines_[line];
+    return getMetaData<T>(name).subspan(info.offset, info.size);
+}
+
+using PackedIntegralLineSetInport = DataInport<PackedIntegralLineSet>;
+using PackedIntegralLineSetOutport = DataOutport<PackedIntegralLineSet>;
+
+template <>
+struct DataTraits<PackedIntegralLineSet> {
+    static std::string classIdentifier() { return "org.inviwo.PackedIntegralLineSet"; }
+    static std::string dataName() { return "PackedIntegralLineSet"; }
+    static uvec3 colorCode() { return uvec3(255, 120, 0); }
+    static Document info(const PackedIntegralLineSet& data) {
+        Document doc;
+        doc.append("p", fmt::format("Packed Integral Line Set with {} lines and {} points",
+                                    data.size(), data.getNumberOfPoints()));
+        return doc;
+    }
+};
+
+}  // namespace inviwo
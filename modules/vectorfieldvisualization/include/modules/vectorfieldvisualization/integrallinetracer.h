@@ -37,6 +37,9 @@
 #include <modules/vectorfieldvisualization/datastructures/integralline.h>  // for Integral...
 #include <modules/vectorfieldvisualization/properties/integrallineproperties.h>  // for Integral...
 
+#include <algorithm>      // for clamp
+#include <array>          // for array
+#include <cmath>          // for pow
 #include <cstddef>        // for size_t
 #include <limits>         // for numeric_...
 #include <memory>         // for shared_ptr
@@ -93,16 +96,31 @@ private:
     IntegralLine::TerminationReason integrate(size_t steps, SpatialVector pos, IntegralLine& line,
                                               bool fwd) const;
 
+    /**
+     * Dormand-Prince RK45 integration with local error control. The step size is adapted within
+     * [minStepSize_, maxStepSize_] to keep the local error estimate below errorTolerance_, and
+     * `steps` limits the number of accepted steps. If outputSpacing_ is larger than zero, the
+     * accepted steps are resampled to points with equal arc length spacing using cubic Hermite
+     * interpolation, otherwise every accepted step is output.
+     */
+    IntegralLine::TerminationReason integrateAdaptive(size_t steps, SpatialVector pos,
+                                                      IntegralLine& line, bool fwd) const;
+
     IntegralLineProperties::IntegrationScheme integrationScheme_;
 
     int steps_;
     double stepSize_;
+    double minStepSize_;
+    double maxStepSize_;
+    double errorTolerance_;
+    double outputSpacing_;
     IntegralLineProperties::Direction dir_;
     bool normalizeSamples_;
 
     std::shared_ptr<const Sampler> sampler_;
     std::unordered_map<std::string, std::shared_ptr<const Sampler>> metaSamplers_;
 
+    DataMatrix basis_;
     DataMatrix invBasis_;
     DataHomogenouSpatialMatrixrix seedTransformation_;
 };
@@ -113,10 +131,15 @@ IntegralLineTracer<SpatialSampler, TimeDependent>::IntegralLineTracer(
     : integrationScheme_(properties.getIntegrationScheme())
     , steps_(properties.getNumberOfSteps())
     , stepSize_(properties.getStepSize())
+    , minStepSize_(properties.getMinStepSize())
+    , maxStepSize_(std::max(properties.getMinStepSize(), properties.getMaxStepSize()))
+    , errorTolerance_(properties.getErrorTolerance())
+    , outputSpacing_(properties.getOutputSpacing())
     , dir_(properties.getStepDirection())
     , normalizeSamples_(properties.getNormalizeSamples())
     , sampler_(sampler)
-    , invBasis_(glm::inverse(DataMatrix(sampler->getModelMatrix())))
+    , basis_(sampler->getModelMatrix())
+    , invBasis_(glm::inverse(basis_))
     , seedTransformation_(
           properties.getSeedPointTransformationMatrix(sampler->getCoordinateTransformer())) {}
 
@@ -274,6 +297,9 @@ template <typename SpatialSampler, bool TimeDependent>
 IntegralLine::TerminationReason IntegralLineTracer<SpatialSampler, TimeDependent>::integrate(
     size_t steps, SpatialVector pos, IntegralLine& line, bool fwd) const {
     if (steps == 0) return IntegralLine::TerminationReason::StartPoint;
+    if (integrationScheme_ == IntegralLineProperties::IntegrationScheme::RK45) {
+        return integrateAdaptive(steps, pos, line, fwd);
+    }
     for (size_t i = 0; i < steps; i++) {
         if (!sampler_->withinBounds(pos)) {
             return IntegralLine::TerminationReason::OutOfBounds;
@@ -288,6 +314,110 @@ IntegralLine::TerminationReason IntegralLineTracer<SpatialSampler, TimeDependent
     return IntegralLine::TerminationReason::Steps;
 }
 
+template <typename SpatialSampler, bool TimeDependent>
+IntegralLine::TerminationReason
+IntegralLineTracer<SpatialSampler, TimeDependent>::integrateAdaptive(size_t steps,
+                                                                     SpatialVector pos,
+                                                                     IntegralLine& line,
+                                                                     bool fwd) const {
+    // Dormand-Prince coefficients, the last row are the 5th order weights which are also used
+    // for the 7th stage (first same as last).
+    static constexpr std::array<std::array<double, 6>, 6> a{
+        {{1.0 / 5.0},
+         {3.0 / 40.0, 9.0 / 40.0},
+         {44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0},
+         {19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0},
+         {9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0},
+         {35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0}}};
+    // Difference between the 5th and 4th order weights
+    static constexpr std::array<double, 7> e{
+        71.0 / 57600.0, 0.0, -71.0 / 16695.0, 71.0 / 1920.0,
+        -17253.0 / 339200.0, 22.0 / 525.0, -1.0 / 40.0};
+
+    const auto direction = [n = normalizeSamples_](const DataVector& v) {
+        const auto l = glm::length(v);
+        return (n && l != 0.0) ? v / l : v;
+    };
+    // offset in data space (and time) for moving along v for h
+    const auto offset = [&](const DataVector& v, double h) {
+        if constexpr (TimeDependent) {
+            return SpatialVector(invBasis_ * (v * h), h);
+        } else {
+            return SpatialVector(invBasis_ * (v * h));
+        }
+    };
+
+    const double sign = fwd ? 1.0 : -1.0;
+    double h = std::clamp(stepSize_, minStepSize_, maxStepSize_);
+
+    std::array<DataVector, 7> k;
+    DataVector velocity = sampler_->sample(pos);
+    k[0] = direction(velocity);
+
+    double travelled = 0.0;  // arc length since the last output point
+    size_t accepted = 0;
+    while (accepted < steps) {
+        if (!sampler_->withinBounds(pos)) {
+            return IntegralLine::TerminationReason::OutOfBounds;
+        }
+
+        const double hs = h * sign;
+        DataVector nextVelocity{0.0};
+        SpatialVector next{pos};
+        for (size_t i = 1; i < 7; ++i) {
+            DataVector v{0.0};
+            for (size_t j = 0; j < i; ++j) v += a[i - 1][j] * k[j];
+            next = pos + offset(v, hs);
+            nextVelocity = sampler_->sample(next);
+            k[i] = direction(nextVelocity);
+        }
+
+        DataVector errorVector{0.0};
+        for (size_t i = 0; i < 7; ++i) errorVector += e[i] * k[i];
+        const double error = glm::length(errorVector) * h;
+
+        if (error > errorTolerance_ && h > minStepSize_) {
+            const double factor = std::max(0.2, 0.9 * std::pow(errorTolerance_ / error, 0.2));
+            h = std::max(minStepSize_, h * factor);
+            continue;
+        }
+        ++accepted;
+
+        if (outputSpacing_ > 0.0) {
+            if (glm::length(nextVelocity) < std::numeric_limits<double>::epsilon()) {
+                return IntegralLine::TerminationReason::ZeroVelocity;
+            }
+            const double length = glm::length(basis_ * DataVector(next - pos));
+            const SpatialVector t0 = offset(k[0], hs);
+            const SpatialVector t1 = offset(k[6], hs);
+            double at = outputSpacing_ - travelled;
+            for (; at <= length; at += outputSpacing_) {
+                const double s = at / length;
+                const double s2 = s * s;
+                const double s3 = s2 * s;
+                const SpatialVector p = (2.0 * s3 - 3.0 * s2 + 1.0) * pos +
+                                        (s3 - 2.0 * s2 + s) * t0 + (3.0 * s2 - 2.0 * s3) * next +
+                                        (s3 - s2) * t1;
+                if (!addPoint(line, p, velocity + (nextVelocity - velocity) * s)) {
+                    return IntegralLine::TerminationReason::ZeroVelocity;
+                }
+            }
+            travelled = length - (at - outputSpacing_);
+        } else if (!addPoint(line, next, nextVelocity)) {
+            return IntegralLine::TerminationReason::ZeroVelocity;
+        }
+
+        pos = next;
+        velocity = nextVelocity;
+        k[0] = k[6];
+
+        const double factor =
+            error > 0.0 ? std::min(5.0, 0.9 * std::pow(errorTolerance_ / error, 0.2)) : 5.0;
+        h = std::clamp(h * factor, minStepSize_, maxStepSize_);
+    }
+    return IntegralLine::TerminationReason::Steps;
+}
+
 using StreamLine2DTracer = IntegralLineTracer<SpatialSampler<2, 2, double>>;
 using StreamLine3DTracer = IntegralLineTracer<SpatialSampler<3, 3, double>>;
 using PathLine3DTracer = IntegralLineTracer<Spatial4DSampler<3, double>>;
@@ -30,7 +30,7 @@
 #pragma once
 
 #include <modules/vectorfieldvisualization/vectorfieldvisualizationmoduledefine.h>
-#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/poolprocessor.h>
 #include <inviwo/core/processors/processortraits.h>
 #include <inviwo/core/properties/ordinalproperty.h>
 #include <inviwo/core/properties/compositeproperty.h>
@@ -43,10 +43,79 @@
 #include <modules/vectorfieldvisualization/integrallinetracer.h>
 #include <modules/vectorfieldvisualization/ports/seedpointsport.h>
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <vector>
+
 namespace inviwo {
 
+namespace detail {
+
+/**
+ * Trace one line from each seed in @p seeds using @p chunks parallel parts. The lines are traced
+ * into one slot per seed and the index of a line is the index of its seed over all the seed sets.
+ * This makes the result independent of the chunking and the scheduling, and avoids any locking
+ * when storing the lines. Seeds that do not result in a line with more than one point are skipped.
+ * @p stop is checked between seeds, and if set, no lines are returned.
+ * @p progress is called with (done, total) every 256 seeds per chunk.
+ * @return the lines, or nullptr if stopped
+ */
+template <typename Tracer, typename Seeds, typename Stop, typename Progress>
+std::shared_ptr<IntegralLineSet> traceLines(const Tracer& tracer, const Seeds& seeds,
+                                            const mat4& modelMatrix, const mat4& worldMatrix,
+                                            size_t chunks, const Stop& stop,
+                                            const Progress& progress) {
+    std::vector<size_t> offsets{0};
+    for (const auto& seedSet : seeds) offsets.push_back(offsets.back() + seedSet->size());
+    const size_t total = offsets.back();
+
+    std::vector<std::optional<IntegralLine>> slots(total);
+    std::atomic<size_t> finished{0};
+    std::mutex progressMutex;
+    constexpr size_t progressInterval = 256;
+
+    util::forEachChunkParallel(total, chunks, [&](size_t, size_t begin, size_t end) {
+        auto set = static_cast<size_t>(
+            std::upper_bound(offsets.begin(), offsets.end(), begin) - offsets.begin() - 1);
+        size_t pending = 0;
+        for (size_t i = begin; i < end; ++i) {
+            if (stop) return;
+            while (i >= offsets[set + 1]) ++set;
+
+            auto res = tracer.traceFrom((*seeds[set])[i - offsets[set]]);
+            if (res.line.getPositions().size() > 1) {
+                res.line.setIndex(static_cast<uint32_t>(i));
+                slots[i] = std::move(res.line);
+            }
+
+            if (++pending == progressInterval || i + 1 == end) {
+                const auto done = finished += pending;
+                pending = 0;
+                const std::scoped_lock lock{progressMutex};
+                progress(done, total);
+            }
+        }
+    });
+    if (stop) return nullptr;
+
+    auto lines = std::make_shared<IntegralLineSet>(modelMatrix, worldMatrix);
+    auto& vector = lines->getVector();
+    vector.reserve(std::count_if(slots.begin(), slots.end(),
+                                 [](const auto& slot) { return slot.has_value(); }));
+    for (auto& slot : slots) {
+        if (slot) vector.push_back(std::move(*slot));
+    }
+    return lines;
+}
+
+}  // namespace detail
+
 template <typename Tracer>
-class IntegralLineTracerProcessor : public Processor {
+class IntegralLineTracerProcessor : public PoolProcessor {
 public:
     IntegralLineTracerProcessor();
     virtual ~IntegralLineTracerProcessor();
@@ -71,7 +140,8 @@ private:
 
 template <typename Tracer>
 IntegralLineTracerProcessor<Tracer>::IntegralLineTracerProcessor()
-    : sampler_("sampler")
+    : PoolProcessor()
+    , sampler_("sampler")
     , seeds_("seeds")
     , annotationSamplers_("annotationSamplers")
     , lines_("lines")
@@ -102,39 +172,42 @@ IntegralLineTracerProcessor<Tracer>::~IntegralLineTracerProcessor() {}
 template <typename Tracer>
 void IntegralLineTracerProcessor<Tracer>::process() {
     auto sampler = sampler_.getData();
-    auto lines =
-        std::make_shared<IntegralLineSet>(sampler->getModelMatrix(), sampler->getWorldMatrix());
-
-    Tracer tracer(sampler, properties_);
+    auto tracer = std::make_shared<Tracer>(sampler, properties_);
 
     for (auto meta : annotationSamplers_.getSourceVectorData()) {
         auto key = meta.first->getProcessor()->getIdentifier();
         key = util::stripIdentifier(key);
-        tracer.addMetaDataSampler(key, meta.second);
+        tracer->addMetaDataSampler(key, meta.second);
     }
 
-    std::mutex mutex;
-    size_t startID = 0;
-    for (const auto& seeds : seeds_) {
-        util::forEachParallel(*seeds, [&](const auto& p, size_t i) {
-            IntegralLine line = tracer.traceFrom(p);
-            auto size = line.getPositions().size();
-            if (size > 1) {
-                std::lock_guard<std::mutex> lock(mutex);
-                lines->push_back(std::move(line), startID + i);
-            }
-        });
-        startID += seeds->size();
-    }
+    const auto calc = [tracer, seeds = seeds_.getVectorData(),
+                       modelMatrix = sampler->getModelMatrix(),
+                       worldMatrix = sampler->getWorldMatrix(),
+                       curvature = calculateCurvature_.get(),
+                       tortuosity = calculateTortuosity_.get()](
+                          pool::Stop stop,
+                          pool::Progress progress) -> std::shared_ptr<IntegralLineSet> {
+        const auto total = std::accumulate(
+            seeds.begin(), seeds.end(), size_t{0},
+            [](size_t sum, const auto& seedSet) { return sum + seedSet->size(); });
+        auto lines = detail::traceLines(*tracer, seeds, modelMatrix, worldMatrix,
+                                        util::parallelChunkCount(total, 64), stop, progress);
+        if (!lines) return nullptr;
 
-    if (calculateCurvature_) {
-        util::curvature(*lines);
-    }
-    if (calculateTortuosity_) {
-        util::tortuosity(*lines);
-    }
+        if (curvature) {
+            util::curvature(*lines);
+        }
+        if (tortuosity) {
+            util::tortuosity(*lines);
+        }
+        return lines;
+    };
 
-    lines_.setData(lines);
+    lines_.clear();
+    dispatchOne(calc, [this](std::shared_ptr<IntegralLineSet> lines) {
+        lines_.setData(lines);
+        newResults();
+    });
 }
 
 using StreamLines2D = IntegralLineTracerProcessor<StreamLine2DTracer>;
@@ -48,7 +48,7 @@ namespace inviwo {
 
 class IVW_MODULE_VECTORFIELDVISUALIZATION_API IntegralLineProperties : public CompositeProperty {
 public:
-    enum class IntegrationScheme { Euler, RK4 };
+    enum class IntegrationScheme { Euler, RK4, RK45 };
 
     enum class Direction { FWD = 1, BWD = 2, BOTH = 3 };
 
@@ -64,6 +64,19 @@ public:
     int getNumberOfSteps() const;
     float getStepSize() const;
 
+    /**
+     * Step size bounds and local error tolerance used by the adaptive RK45 scheme. The step size
+     * is then only the initial step size.
+     */
+    float getMinStepSize() const;
+    float getMaxStepSize() const;
+    double getErrorTolerance() const;
+    /**
+     * Arc length between output points for the adaptive RK45 scheme, 0 means that every accepted
+     * integration step is output.
+     */
+    float getOutputSpacing() const;
+
     IntegralLineProperties::Direction getStepDirection() const;
     IntegralLineProperties::IntegrationScheme getIntegrationScheme() const;
     CoordinateSpace getSeedPointsSpace() const;
@@ -75,6 +88,10 @@ private:
 public:
     IntProperty numberOfSteps_;
     FloatProperty stepSize_;
+    FloatProperty minStepSize_;
+    FloatProperty maxStepSize_;
+    DoubleProperty errorTolerance_;
+    FloatProperty outputSpacing_;
     BoolProperty normalizeSamples_;
 
     OptionProperty<IntegralLineProperties::Direction> stepDirection_;
@@ -0,0 +1,252 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <modules/vectorfieldvisualization/datastructures/packedintegrallineset.h>
+
+#include <inviwo/core/datastructures/buffer/bufferram.h>                      // for BufferRAM
+#include <inviwo/core/util/formatdispatching.h>                               // for Precisio...
+#include <inviwo/core/util/zip.h>                                             // for zip
+#include <modules/vectorfieldvisualization/datastructures/integrallineset.h>  // for Integra...
+
+#include <algorithm>  // for transform, min, equal
+#include <iterator>   // for back_inserter
+#include <limits>     // for numeric_limits
+
+namespace inviwo {
+
+void detail::checkMetaDataFormat(const BufferBase& buffer, const DataFormatBase* format,
+                                 std::string_view name) {
+    if (buffer.getDataFormat() != format) {
+        throw Exception(
+            fmt::format("Incorrect data format for meta data {}, asking for {} but is {}", name,
+                        format->getString(), buffer.getDataFormat()->getString()),
+            IVW_CONTEXT_CUSTOM("PackedIntegralLineSet"));
+    }
+}
+
+void PackedIntegralLineSet::Builder::addLine(std::span<const dvec3> positions, uint32_t index,
+                                             TerminationReason backward,
+                                             TerminationReason forward) {
+    lines_.push_back({positions_.size(), positions.size(), index, backward, forward});
+    std::transform(positions.begin(), positions.end(), std::back_inserter(positions_),
+                   [](const dvec3& p) { return vec3{p}; });
+}
+
+void PackedIntegralLineSet::Builder::addLine(const IntegralLine& line) {
+    addLine(line.getPositions(), line.getIndex(), line.getBackwardTerminationReason(),
+            line.getForwardTerminationReason());
+
+    for (const auto& [name, buffer] : line.getMetaDataBuffers()) {
+        buffer->getRepresentation<BufferRAM>()->dispatch<void>([&, &key = name](auto ram) {
+            using T = util::PrecisionValueType<decltype(ram)>;
+            const auto& src = ram->getDataContainer();
+            auto& dst = getMetaData<T>(key);
+            dst.insert(dst.end(), src.begin(), src.end());
+        });
+    }
+}
+
+void PackedIntegralLineSet::Builder::clear() {
+    positions_.clear();
+    lines_.clear();
+    metaData_.clear();
+}
+
+PackedIntegralLineSet::PackedIntegralLineSet(mat4 modelMatrix, mat4 worldMatrix)
+    : mutex_{}
+    , positions_{std::make_shared<Buffer<vec3>>()}
+    , lines_{}
+    , metaData_{}
+    , modelMatrix_{modelMatrix}
+    , worldMatrix_{worldMatrix} {}
+
+PackedIntegralLineSet::PackedIntegralLineSet(const IntegralLineSet& lines)
+    : PackedIntegralLineSet(lines.getModelMatrix(), lines.getWorldMatrix()) {
+    Builder builder;
+    for (const auto& line : lines) builder.addLine(line);
+    append(std::move(builder));
+}
+
+mat4 PackedIntegralLineSet::getModelMatrix() const { return modelMatrix_; }
+mat4 PackedIntegralLineSet::getWorldMatrix() const { return worldMatrix_; }
+
+void PackedIntegralLineSet::append(Builder&& builder) {
+    if (builder.lines_.empty()) return;
+
+    for (const auto& [name, buffer] : builder.metaData_) {
+        if (buffer->getSize() != builder.positions_.size()) {
+            throw Exception(fmt::format("Meta data {} has {} values but there are {} positions",
+                                        name, buffer->getSize(), builder.positions_.size()),
+                            IVW_CONTEXT);
+        }
+    }
+
+    std::scoped_lock lock{mutex_};
+
+    if (lines_.empty()) {
+        metaData_ = std::move(builder.metaData_);
+    } else {
+        const bool sameKeys = metaData_.size() == builder.metaData_.size() &&
+                              std::equal(metaData_.begin(), metaData_.end(),
+                                         builder.metaData_.begin(), [](auto& a, auto& b) {
+                                             return a.first == b.first &&
+                                                    a.second->getDataFormat() ==
+                                                        b.second->getDataFormat();
+                                         });
+        if (!sameKeys) {
+            throw Exception("The meta data of the appended lines does not match the line set",
+                            IVW_CONTEXT);
+        }
+        for (auto&& [dst, src] : util::zip(metaData_, builder.metaData_)) {
+            const auto* srcRAM = src.second->getRepresentation<BufferRAM>();
+            dst.second->getEditableRepresentation<BufferRAM>()->dispatch<void>([&](auto dstRAM) {
+                using RAM = std::remove_pointer_t<decltype(dstRAM)>;
+                const auto& values = static_cast<const RAM*>(srcRAM)->getDataContainer();
+                auto& container = dstRAM->getDataContainer();
+                container.insert(container.end(), values.begin(), values.end());
+            });
+        }
+    }
+
+    auto& positions = positions_->getEditableRAMRepresentation()->getDataContainer();
+    const auto offset = positions.size();
+    positions.insert(positions.end(), builder.positions_.begin(), builder.positions_.end());
+
+    lines_.reserve(lines_.size() + builder.lines_.size());
+    for (auto info : builder.lines_) {
+        info.offset += offset;
+        lines_.push_back(info);
+    }
+
+    builder.clear();
+}
+
+size_t PackedIntegralLineSet::size() const { return lines_.size(); }
+
+size_t PackedIntegralLineSet::getNumberOfPoints() const { return positions_->getSize(); }
+
+auto PackedIntegralLineSet::getLines() const -> const std::vector<LineInfo>& { return lines_; }
+
+auto PackedIntegralLineSet::getLine(size_t line) const -> const LineInfo& { return lines_[line]; }
+
+std::span<const vec3> PackedIntegralLineSet::getPositions() const {
+    return positions_->getRAMRepresentation()->getDataContainer();
+}
+
+std::span<const vec3> PackedIntegralLineSet::getPositions(size_t line) const {
+    const auto& info = lines_[line];
+    return getPositions().subspan(info.offset, info.size);
+}
+
+const std::shared_ptr<Buffer<vec3>>& PackedIntegralLineSet::getPositionBuffer() const {
+    return positions_;
+}
+
+bool PackedIntegralLineSet::hasMetaData(std::string_view name) const {
+    return metaData_.find(name) != metaData_.end();
+}
+
+std::vector<std::string> PackedIntegralLineSet::getMetaDataKeys() const {
+    std::vector<std::string> keys;
+    for (const auto& item : metaData_) keys.push_back(item.first);
+    return keys;
+}
+
+std::shared_ptr<const BufferBase> PackedIntegralLineSet::getMetaDataBuffer(
+    std::string_view name) const {
+    auto it = metaData_.find(name);
+    return it != metaData_.end() ? it->second : nullptr;
+}
+
+IntegralLine PackedIntegralLineSet::getIntegralLine(size_t line) const {
+    const auto& info = lines_.at(line);
+
+    IntegralLine res;
+    res.setIndex(info.index);
+    res.setBackwardTerminationReason(info.backwardTerminationReason);
+    res.setForwardTerminationReason(info.forwardTerminationReason);
+
+    const auto positions = getPositions(line);
+    res.getPositions().assign(positions.begin(), positions.end());
+
+    for (const auto& [name, buffer] : metaData_) {
+        buffer->getRepresentation<BufferRAM>()->dispatch<void>([&, &key = name](auto ram) {
+            using T = util::PrecisionValueType<decltype(ram)>;
+            const auto& src = ram->getDataContainer();
+            const auto first = src.begin() + info.offset;
+            res.getMetaData<T>(key, true).assign(first, first + info.size);
+        });
+    }
+    return res;
+}
+
+std::shared_ptr<Mesh> PackedIntegralLineSet::toMesh(
+    const std::vector<std::pair<std::string, Mesh::BufferInfo>>& metaData) const {
+
+    if (getNumberOfPoints() > std::numeric_limits<uint32_t>::max()) {
+        throw Exception("Too many points to index with 32 bit indices", IVW_CONTEXT);
+    }
+
+    auto mesh = std::make_shared<Mesh>(DrawType::Lines, ConnectivityType::Adjacency);
+    mesh->setModelMatrix(modelMatrix_);
+    mesh->setWorldMatrix(worldMatrix_);
+    mesh->addBuffer(BufferType::PositionAttrib, positions_);
+
+    for (const auto& [name, info] : metaData) {
+        auto it = metaData_.find(name);
+        if (it == metaData_.end()) {
+            throw Exception(fmt::format("No meta data with name: {}", name), IVW_CONTEXT);
+        }
+        mesh->addBuffer(info, it->second);
+    }
+
+    // Lines with adjacency, four indices per segment, clamped at the ends of each line
+    auto indexBuffer = mesh->addIndexBuffer(DrawType::Lines, ConnectivityType::Adjacency);
+    auto& indices = indexBuffer->getDataContainer();
+    size_t segments = 0;
+    for (const auto& info : lines_) {
+        if (info.size > 1) segments += info.size - 1;
+    }
+    indices.reserve(4 * segments);
+
+    for (const auto& info : lines_) {
+        if (info.size < 2) continue;
+        const auto first = static_cast<uint32_t>(info.offset);
+        const auto last = static_cast<uint32_t>(info.offset + info.size - 1);
+        for (auto i = first; i < last; ++i) {
+            indices.push_back(i == first ? first : i - 1);
+            indices.push_back(i);
+            indices.push_back(i + 1);
+            indices.push_back(std::min(i + 2, last));
+        }
+    }
+
+    return mesh;
+}
+
+}  // namespace inviwo
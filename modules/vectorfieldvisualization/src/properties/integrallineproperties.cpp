@@ -43,6 +43,10 @@ IntegralLineProperties::IntegralLineProperties(std::string_view identifier,
     : CompositeProperty(identifier, displayName)
     , numberOfSteps_("steps", "Number of Steps", 100, 1, 1000)
     , stepSize_("stepSize", "Step size", 0.001f, 0.001f, 1.0f, 0.001f)
+    , minStepSize_("minStepSize", "Min Step Size", 0.0001f, 0.00001f, 1.0f, 0.00001f)
+    , maxStepSize_("maxStepSize", "Max Step Size", 0.1f, 0.001f, 1.0f, 0.001f)
+    , errorTolerance_("errorTolerance", "Error Tolerance", 1e-6, 1e-12, 1e-2, 1e-7)
+    , outputSpacing_("outputSpacing", "Output Spacing", 0.0f, 0.0f, 1.0f, 0.001f)
     , normalizeSamples_("normalizeSamples", "Normalize Samples", true)
     , stepDirection_("stepDirection", "Step Direction")
     , integrationScheme_("integrationScheme", "Integration Scheme")
@@ -54,6 +58,10 @@ IntegralLineProperties::IntegralLineProperties(const IntegralLineProperties& rhs
     : CompositeProperty(rhs)
     , numberOfSteps_(rhs.numberOfSteps_)
     , stepSize_(rhs.stepSize_)
+    , minStepSize_(rhs.minStepSize_)
+    , maxStepSize_(rhs.maxStepSize_)
+    , errorTolerance_(rhs.errorTolerance_)
+    , outputSpacing_(rhs.outputSpacing_)
     , normalizeSamples_(rhs.normalizeSamples_)
     , stepDirection_(rhs.stepDirection_)
     , integrationScheme_(rhs.integrationScheme_)
@@ -71,6 +79,14 @@ int IntegralLineProperties::getNumberOfSteps() const { return numberOfSteps_.get
 
 float IntegralLineProperties::getStepSize() const { return stepSize_.get(); }
 
+float IntegralLineProperties::getMinStepSize() const { return minStepSize_.get(); }
+
+float IntegralLineProperties::getMaxStepSize() const { return maxStepSize_.get(); }
+
+double IntegralLineProperties::getErrorTolerance() const { return errorTolerance_.get(); }
+
+float IntegralLineProperties::getOutputSpacing() const { return outputSpacing_.get(); }
+
 IntegralLineProperties::Direction IntegralLineProperties::getStepDirection() const {
     return stepDirection_.get();
 }
@@ -94,6 +110,8 @@ void IntegralLineProperties::setUpProperties() {
                                  IntegralLineProperties::IntegrationScheme::Euler);
     integrationScheme_.addOption("rk4", "Runge-Kutta (RK4)",
                                  IntegralLineProperties::IntegrationScheme::RK4);
+    integrationScheme_.addOption("rk45", "Adaptive Runge-Kutta (RK45)",
+                                 IntegralLineProperties::IntegrationScheme::RK45);
     integrationScheme_.setSelectedValue(IntegralLineProperties::IntegrationScheme::RK4);
 
     seedPointsSpace_.addOption("data", "Data", CoordinateSpace::Data);
@@ -104,9 +122,21 @@ void IntegralLineProperties::setUpProperties() {
     addProperty(stepSize_);
     addProperty(stepDirection_);
     addProperty(integrationScheme_);
+    addProperty(minStepSize_);
+    addProperty(maxStepSize_);
+    addProperty(errorTolerance_);
+    addProperty(outputSpacing_);
     addProperty(seedPointsSpace_);
     addProperty(normalizeSamples_);
 
+    const auto isAdaptive = [](const auto& p) {
+        return p.get() == IntegralLineProperties::IntegrationScheme::RK45;
+    };
+    minStepSize_.visibilityDependsOn(integrationScheme_, isAdaptive);
+    maxStepSize_.visibilityDependsOn(integrationScheme_, isAdaptive);
+    errorTolerance_.visibilityDependsOn(integrationScheme_, isAdaptive);
+    outputSpacing_.visibilityDependsOn(integrationScheme_, isAdaptive);
+
     setAllPropertiesCurrentStateAsDefault();
 }
 
@@ -43,6 +43,7 @@
 #include <inviwo/core/util/stringconversion.h>
 #include <modules/base/processors/inputselector.h>
 #include <modules/vectorfieldvisualization/datastructures/integrallineset.h>
+#include <modules/vectorfieldvisualization/datastructures/packedintegrallineset.h>
 #include <modules/vectorfieldvisualization/processors/2d/seedpointgenerator2d.h>
 #include <modules/vectorfieldvisualization/processors/3d/pathlines.h>
 #include <modules/vectorfieldvisualization/processors/3d/streamlines.h>
@@ -115,6 +116,7 @@ VectorFieldVisualizationModule::VectorFieldVisualizationModule(InviwoApplication
     registerProperty<IntegralLineVectorToMesh::ColorByProperty>();
 
     registerDefaultsForDataType<IntegralLineSet>();
+    registerDefaultsForDataType<PackedIntegralLineSet>();
 }
 
 int VectorFieldVisualizationModule::getVersion() const { return 4; }
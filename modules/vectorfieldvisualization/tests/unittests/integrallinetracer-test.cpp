@@ -0,0 +1,196 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/vectorfieldvisualization/integrallinetracer.h>
+#include <modules/vectorfieldvisualization/properties/integrallineproperties.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/util/spatialsampler.h>
+
+#include <cmath>
+#include <memory>
+#include <numbers>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+constexpr dvec3 center{0.5, 0.5, 0.5};
+constexpr double radius = 0.25;
+
+/// Rigid rotation around the z-axis through center with unit angular velocity
+class CircularSampler : public SpatialSampler<3, 3, double> {
+public:
+    explicit CircularSampler(const SpatialEntity<3>& entity)
+        : SpatialSampler<3, 3, double>(entity) {}
+
+protected:
+    virtual dvec3 sampleDataSpace(const dvec3& pos) const override {
+        return {-(pos.y - center.y), pos.x - center.x, 0.0};
+    }
+    virtual bool withinBoundsDataSpace(const dvec3& pos) const override {
+        return glm::all(glm::greaterThanEqual(pos, dvec3{0.0})) &&
+               glm::all(glm::lessThanEqual(pos, dvec3{1.0}));
+    }
+};
+
+class RK45Test : public ::testing::Test {
+protected:
+    RK45Test() : volume_{size3_t{8}, DataVec3Float64::get()}, properties_{"lines", "Lines"} {
+        volume_.setBasis(mat3{1.0f});
+        volume_.setOffset(vec3{0.0f});
+
+        properties_.integrationScheme_.set(IntegralLineProperties::IntegrationScheme::RK45);
+        properties_.stepDirection_.set(IntegralLineProperties::Direction::FWD);
+        properties_.seedPointsSpace_.set(CoordinateSpace::Data);
+        properties_.normalizeSamples_.set(false);
+        properties_.stepSize_.set(0.001f);
+        properties_.minStepSize_.set(0.00001f);
+        properties_.maxStepSize_.set(1.0f);
+        properties_.outputSpacing_.set(0.0f);
+    }
+
+    std::vector<dvec3> trace() const {
+        StreamLine3DTracer tracer(std::make_shared<CircularSampler>(volume_), properties_);
+        auto line = tracer.traceFrom(dvec3{center.x + radius, center.y, center.z}).line;
+        EXPECT_EQ(IntegralLine::TerminationReason::Steps, line.getForwardTerminationReason());
+        return line.getPositions();
+    }
+
+    /// Counterclockwise angle between two points on the circle
+    static double angle(const dvec3& a, const dvec3& b) {
+        const dvec2 u{a.x - center.x, a.y - center.y};
+        const dvec2 v{b.x - center.x, b.y - center.y};
+        return std::atan2(u.x * v.y - u.y * v.x, glm::dot(u, v));
+    }
+
+    static double distanceToCenter(const dvec3& p) {
+        return glm::length(dvec2{p.x - center.x, p.y - center.y});
+    }
+
+    Volume volume_;
+    IntegralLineProperties properties_;
+};
+
+}  // namespace
+
+TEST_F(RK45Test, fixedStepReachesKnownEndPosition) {
+    // With equal step bounds every step is accepted with h = 0.1, i.e. 0.1 radians
+    properties_.minStepSize_.set(0.1f);
+    properties_.maxStepSize_.set(0.1f);
+    properties_.errorTolerance_.set(1e-12);
+    properties_.numberOfSteps_.set(100);
+
+    // A forward trace takes numberOfSteps + 1 steps
+    const auto positions = trace();
+    ASSERT_EQ(102u, positions.size());
+
+    const double h = static_cast<double>(0.1f);
+    const double end = 101 * h;
+    const dvec3 expected{center.x + radius * std::cos(end), center.y + radius * std::sin(end),
+                         center.z};
+    EXPECT_NEAR(expected.x, positions.back().x, 1e-7);
+    EXPECT_NEAR(expected.y, positions.back().y, 1e-7);
+    EXPECT_DOUBLE_EQ(center.z, positions.back().z);
+
+    for (const auto& p : positions) {
+        EXPECT_NEAR(radius, distanceToCenter(p), 1e-7);
+    }
+}
+
+TEST_F(RK45Test, radiusIsConservedWithinTolerance) {
+    for (const double tolerance : {1e-10, 1e-6}) {
+        properties_.errorTolerance_.set(tolerance);
+        properties_.numberOfSteps_.set(50);
+        const auto positions = trace();
+        ASSERT_EQ(52u, positions.size());
+
+        // The error estimate is for the embedded 4th order solution, the 5th order solution
+        // that is used has a smaller error, so the drift per accepted step is below the tolerance
+        for (size_t i = 1; i < positions.size(); ++i) {
+            EXPECT_LE(std::abs(distanceToCenter(positions[i]) - distanceToCenter(positions[i - 1])),
+                      tolerance)
+                << "tolerance " << tolerance << " step " << i;
+        }
+    }
+}
+
+TEST_F(RK45Test, stepSizeFollowsTolerance) {
+    // Mean step length in radians, ignoring the first steps where the initial step grows
+    const auto meanStep = [&](double tolerance) {
+        properties_.errorTolerance_.set(tolerance);
+        properties_.numberOfSteps_.set(50);
+        const auto positions = trace();
+        double sum = 0.0;
+        for (size_t i = 11; i < positions.size(); ++i) {
+            const auto step = angle(positions[i - 1], positions[i]);
+            EXPECT_GT(step, 0.0);
+            EXPECT_LE(step, properties_.maxStepSize_.get() + 1e-9);
+            sum += step;
+        }
+        return sum / static_cast<double>(positions.size() - 11);
+    };
+
+    const auto strict = meanStep(1e-10);
+    const auto loose = meanStep(1e-6);
+
+    // The step size is limited by the tolerance and not by the max step size
+    EXPECT_LT(loose, 0.9 * properties_.maxStepSize_.get());
+    // The local error of a 5(4) pair scales with h^5, a 10^4 times larger tolerance should
+    // allow steps about 10^(4/5) ~ 6.3 times longer
+    EXPECT_GT(loose / strict, 4.0);
+    EXPECT_LT(loose / strict, 10.0);
+}
+
+TEST_F(RK45Test, outputSpacingResamplesAlongCircle) {
+    // Small max steps so that chord and arc length agree closely
+    properties_.maxStepSize_.set(0.02f);
+    properties_.errorTolerance_.set(1e-10);
+    properties_.outputSpacing_.set(0.01f);
+    properties_.numberOfSteps_.set(100);
+
+    const auto positions = trace();
+    ASSERT_GT(positions.size(), 10u);
+
+    const double spacing = static_cast<double>(0.01f);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const double a = static_cast<double>(i) * spacing / radius;
+        EXPECT_NEAR(center.x + radius * std::cos(a), positions[i].x, 1e-4) << "point " << i;
+        EXPECT_NEAR(center.y + radius * std::sin(a), positions[i].y, 1e-4) << "point " << i;
+        EXPECT_NEAR(radius, distanceToCenter(positions[i]), 1e-7) << "point " << i;
+    }
+}
+
+}  // namespace inviwo
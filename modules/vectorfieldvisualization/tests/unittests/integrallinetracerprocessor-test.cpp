@@ -0,0 +1,170 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/vectorfieldvisualization/processors/integrallinetracerprocessor.h>
+#include <modules/vectorfieldvisualization/integrallinetracer.h>
+#include <modules/vectorfieldvisualization/ports/seedpointsport.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/util/spatialsampler.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+/// Constant field along x in the unit cube
+class ConstantSampler : public SpatialSampler<3, 3, double> {
+public:
+    explicit ConstantSampler(const SpatialEntity<3>& entity)
+        : SpatialSampler<3, 3, double>(entity) {}
+
+protected:
+    virtual dvec3 sampleDataSpace(const dvec3&) const override { return {1.0, 0.0, 0.0}; }
+    virtual bool withinBoundsDataSpace(const dvec3& pos) const override {
+        return glm::all(glm::greaterThanEqual(pos, dvec3{0.0})) &&
+               glm::all(glm::lessThanEqual(pos, dvec3{1.0}));
+    }
+};
+
+class TraceLinesTest : public ::testing::Test {
+protected:
+    TraceLinesTest() : volume_{size3_t{8}, DataVec3Float64::get()}, properties_{"lines", "Lines"} {
+        volume_.setBasis(mat3{1.0f});
+        volume_.setOffset(vec3{0.0f});
+        properties_.stepDirection_.set(IntegralLineProperties::Direction::FWD);
+        properties_.seedPointsSpace_.set(CoordinateSpace::Data);
+        properties_.numberOfSteps_.set(20);
+        properties_.stepSize_.set(0.01f);
+
+        // Three seed sets, one of them empty. Every 7th seed lies outside of the field and does
+        // not give a line.
+        size_t index = 0;
+        for (const size_t count : {1000, 0, 537}) {
+            auto seedSet = std::make_shared<SeedPointVector<3>>();
+            for (size_t i = 0; i < count; ++i, ++index) {
+                const auto t = static_cast<float>(index) / 1537.0f;
+                seedSet->emplace_back(index % 7 == 0 ? 2.0f : 0.5f * t, t, 1.0f - t);
+            }
+            seeds_.push_back(seedSet);
+        }
+    }
+
+    std::shared_ptr<IntegralLineSet> trace(size_t chunks, const std::atomic<bool>& stop,
+                                           const std::function<void(size_t, size_t)>& progress) {
+        const StreamLine3DTracer tracer(std::make_shared<ConstantSampler>(volume_), properties_);
+        return detail::traceLines(tracer, seeds_, mat4{1.0f}, mat4{1.0f}, chunks, stop, progress);
+    }
+
+    std::shared_ptr<IntegralLineSet> trace(size_t chunks) {
+        const std::atomic<bool> stop{false};
+        return trace(chunks, stop, [](size_t, size_t) {});
+    }
+
+    Volume volume_;
+    IntegralLineProperties properties_;
+    std::vector<std::shared_ptr<const SeedPointVector<3>>> seeds_;
+};
+
+}  // namespace
+
+TEST_F(TraceLinesTest, orderIsIndependentOfChunking) {
+    const auto serial = trace(1);
+    ASSERT_TRUE(serial);
+    ASSERT_EQ(1537u - 220u, serial->size());
+
+    uint32_t expectedIndex = 0;
+    for (const auto& line : *serial) {
+        if (expectedIndex % 7 == 0) ++expectedIndex;
+        EXPECT_EQ(expectedIndex, line.getIndex());
+        EXPECT_EQ(22u, line.getPositions().size());
+        ++expectedIndex;
+    }
+
+    for (const size_t chunks : {2, 7, 64, 1537}) {
+        for (int repeat = 0; repeat < 3; ++repeat) {
+            const auto parallel = trace(chunks);
+            ASSERT_TRUE(parallel);
+            ASSERT_EQ(serial->size(), parallel->size()) << "chunks " << chunks;
+            for (size_t i = 0; i < serial->size(); ++i) {
+                EXPECT_EQ((*serial)[i].getIndex(), (*parallel)[i].getIndex())
+                    << "chunks " << chunks << " line " << i;
+                EXPECT_EQ((*serial)[i].getPositions(), (*parallel)[i].getPositions())
+                    << "chunks " << chunks << " line " << i;
+            }
+        }
+    }
+}
+
+TEST_F(TraceLinesTest, progressReachesTotal) {
+    const std::atomic<bool> stop{false};
+    std::atomic<size_t> last{0};
+    std::atomic<size_t> calls{0};
+    const auto lines = trace(16, stop, [&](size_t done, size_t total) {
+        EXPECT_EQ(1537u, total);
+        EXPECT_LE(done, total);
+        ++calls;
+        last = std::max(last.load(), done);
+    });
+    ASSERT_TRUE(lines);
+    EXPECT_EQ(1537u, last.load());
+    EXPECT_GE(calls.load(), 16u);
+}
+
+TEST_F(TraceLinesTest, stoppedBeforeStartGivesNoOutput) {
+    const std::atomic<bool> stop{true};
+    size_t calls = 0;
+    const auto lines = trace(16, stop, [&](size_t, size_t) { ++calls; });
+    EXPECT_FALSE(lines);
+    EXPECT_EQ(0u, calls);
+}
+
+TEST_F(TraceLinesTest, stoppedWhileRunningGivesNoOutput) {
+    for (const size_t chunks : {1, 4, 64}) {
+        // Stop after the first progress report, i.e. with most of the seeds left to trace
+        std::atomic<bool> stop{false};
+        std::atomic<size_t> maxDone{0};
+        const auto lines = trace(chunks, stop, [&](size_t done, size_t) {
+            stop = true;
+            maxDone = std::max(maxDone.load(), done);
+        });
+        EXPECT_FALSE(lines) << "chunks " << chunks;
+        EXPECT_LT(maxDone.load(), 1537u) << "chunks " << chunks;
+    }
+}
+
+}  // namespace inviwo
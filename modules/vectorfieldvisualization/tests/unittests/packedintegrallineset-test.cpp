@@ -0,0 +1,204 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/vectorfieldvisualization/datastructures/packedintegrallineset.h>
+#include <modules/vectorfieldvisualization/datastructures/integralline.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+
+#include <array>
+#include <thread>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+std::vector<dvec3> makeLine(size_t size, double x) {
+    std::vector<dvec3> positions;
+    for (size_t i = 0; i < size; ++i) positions.emplace_back(x, static_cast<double>(i), 0.0);
+    return positions;
+}
+
+}  // namespace
+
+TEST(PackedIntegralLineSet, appendBuilders) {
+    PackedIntegralLineSet set{mat4(1)};
+
+    PackedIntegralLineSet::Builder first;
+    first.addLine(makeLine(3, 0.0), 0);
+    first.addLine(makeLine(2, 1.0), 1);
+    auto& velocity = first.getMetaData<float>("velocity");
+    velocity.insert(velocity.end(), {0.0f, 1.0f, 2.0f, 10.0f, 11.0f});
+    set.append(std::move(first));
+
+    EXPECT_EQ(0u, first.size());
+    EXPECT_EQ(0u, first.getNumberOfPoints());
+
+    PackedIntegralLineSet::Builder second;
+    second.addLine(makeLine(4, 2.0), 2, IntegralLine::TerminationReason::OutOfBounds,
+                   IntegralLine::TerminationReason::Steps);
+    auto& secondVelocity = second.getMetaData<float>("velocity");
+    secondVelocity.insert(secondVelocity.end(), {20.0f, 21.0f, 22.0f, 23.0f});
+    set.append(std::move(second));
+
+    ASSERT_EQ(3u, set.size());
+    EXPECT_EQ(9u, set.getNumberOfPoints());
+
+    const std::array<size_t, 3> offsets{0, 3, 5};
+    const std::array<size_t, 3> sizes{3, 2, 4};
+    for (size_t i = 0; i < set.size(); ++i) {
+        EXPECT_EQ(offsets[i], set.getLine(i).offset);
+        EXPECT_EQ(sizes[i], set.getLine(i).size);
+        EXPECT_EQ(i, set.getLine(i).index);
+
+        const auto positions = set.getPositions(i);
+        ASSERT_EQ(sizes[i], positions.size());
+        for (size_t j = 0; j < positions.size(); ++j) {
+            EXPECT_EQ(vec3(static_cast<float>(i), static_cast<float>(j), 0.0f), positions[j]);
+        }
+    }
+
+    const auto lastVelocity = set.getMetaData<float>("velocity", 2);
+    ASSERT_EQ(4u, lastVelocity.size());
+    EXPECT_EQ(20.0f, lastVelocity.front());
+    EXPECT_EQ(23.0f, lastVelocity.back());
+    EXPECT_EQ(IntegralLine::TerminationReason::OutOfBounds,
+              set.getLine(2).backwardTerminationReason);
+    EXPECT_EQ(IntegralLine::TerminationReason::Steps, set.getLine(2).forwardTerminationReason);
+}
+
+TEST(PackedIntegralLineSet, metaDataMismatch) {
+    PackedIntegralLineSet set{mat4(1)};
+
+    PackedIntegralLineSet::Builder first;
+    first.addLine(makeLine(2, 0.0), 0);
+    first.getMetaData<float>("velocity").assign(2, 1.0f);
+    set.append(std::move(first));
+
+    PackedIntegralLineSet::Builder otherName;
+    otherName.addLine(makeLine(2, 0.0), 1);
+    otherName.getMetaData<float>("speed").assign(2, 1.0f);
+    EXPECT_THROW(set.append(std::move(otherName)), Exception);
+
+    PackedIntegralLineSet::Builder otherFormat;
+    otherFormat.addLine(makeLine(2, 0.0), 1);
+    otherFormat.getMetaData<double>("velocity").assign(2, 1.0);
+    EXPECT_THROW(set.append(std::move(otherFormat)), Exception);
+
+    PackedIntegralLineSet::Builder missingValues;
+    missingValues.addLine(makeLine(2, 0.0), 1);
+    missingValues.getMetaData<float>("velocity").assign(1, 1.0f);
+    EXPECT_THROW(set.append(std::move(missingValues)), Exception);
+
+    EXPECT_THROW(set.getMetaData<double>("velocity"), Exception);
+    EXPECT_THROW(set.getMetaData<float>("speed"), Exception);
+    EXPECT_EQ(1u, set.size());
+}
+
+TEST(PackedIntegralLineSet, integralLineRoundTrip) {
+    IntegralLine line;
+    line.setIndex(7);
+    line.setForwardTerminationReason(IntegralLine::TerminationReason::ZeroVelocity);
+    line.getPositions() = makeLine(5, 3.0);
+    line.getMetaData<double>("time", true) = {0.0, 0.1, 0.2, 0.3, 0.4};
+
+    PackedIntegralLineSet set{mat4(1)};
+    PackedIntegralLineSet::Builder builder;
+    builder.addLine(line);
+    set.append(std::move(builder));
+
+    const auto unpacked = set.getIntegralLine(0);
+    EXPECT_EQ(7u, unpacked.getIndex());
+    EXPECT_EQ(IntegralLine::TerminationReason::ZeroVelocity,
+              unpacked.getForwardTerminationReason());
+    EXPECT_EQ(line.getPositions(), unpacked.getPositions());
+    EXPECT_EQ(line.getMetaData<double>("time"), unpacked.getMetaData<double>("time"));
+}
+
+TEST(PackedIntegralLineSet, concurrentAppend) {
+    PackedIntegralLineSet set{mat4(1)};
+
+    constexpr size_t threads = 4;
+    constexpr size_t linesPerThread = 50;
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&set, t]() {
+            PackedIntegralLineSet::Builder builder;
+            for (size_t i = 0; i < linesPerThread; ++i) {
+                const auto index = static_cast<uint32_t>(t * linesPerThread + i);
+                builder.addLine(makeLine(i % 5 + 1, static_cast<double>(index)), index);
+            }
+            set.append(std::move(builder));
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    ASSERT_EQ(threads * linesPerThread, set.size());
+    size_t points = 0;
+    for (size_t i = 0; i < set.size(); ++i) {
+        const auto& info = set.getLine(i);
+        EXPECT_EQ(points, info.offset);
+        points += info.size;
+        // Every line keeps its own positions even though the builders were appended concurrently
+        for (const auto& p : set.getPositions(i)) EXPECT_EQ(static_cast<float>(info.index), p.x);
+    }
+    EXPECT_EQ(points, set.getNumberOfPoints());
+}
+
+TEST(PackedIntegralLineSet, toMesh) {
+    PackedIntegralLineSet set{mat4(1)};
+    PackedIntegralLineSet::Builder builder;
+    builder.addLine(makeLine(3, 0.0), 0);
+    builder.addLine(makeLine(1, 1.0), 1);
+    builder.addLine(makeLine(2, 2.0), 2);
+    builder.getMetaData<float>("velocity").assign(6, 1.0f);
+    set.append(std::move(builder));
+
+    const auto mesh = set.toMesh({{"velocity", Mesh::BufferInfo{BufferType::ScalarMetaAttrib}}});
+
+    // The vertex data is shared with the set, not copied
+    EXPECT_EQ(set.getPositionBuffer().get(), mesh->getBuffer(0));
+    EXPECT_EQ(set.getMetaDataBuffer("velocity").get(), mesh->getBuffer(1));
+
+    ASSERT_EQ(1u, mesh->getNumberOfIndicies());
+    const auto& indices = mesh->getIndices(0)->getRAMRepresentation()->getDataContainer();
+    // Two segments in the first line, none for the single point line, one in the last
+    const std::vector<uint32_t> expected{0, 0, 1, 2, 0, 1, 2, 2, 4, 4, 5, 5};
+    EXPECT_EQ(expected, indices);
+
+    EXPECT_THROW(set.toMesh({{"missing", Mesh::BufferInfo{BufferType::ScalarMetaAttrib}}}),
+                 Exception);
+}
+
+}  // namespace inviwo
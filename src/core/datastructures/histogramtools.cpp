@@ -30,11 +30,38 @@
 #include <inviwo/core/datastructures/histogramtools.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/threadutil.h>
 
 #include <glm/gtx/component_wise.hpp>
 
+#include <numeric>
+
 namespace inviwo {
 
+namespace {
+
+template <typename T>
+struct HistogramReduction {
+    HistogramReduction(size_t jobs, dvec2 dataRange, size_t bins)
+        : accumulators(jobs, detail::HistogramAccumulator<T>{dataRange, bins}), remaining{jobs} {}
+
+    std::vector<detail::HistogramAccumulator<T>> accumulators;
+    std::atomic<size_t> remaining;
+};
+
+/*
+ * Use a stride that does not share any factors with the size of a slice, otherwise the samples
+ * would line up in a few columns of the volume.
+ */
+size_t previewStride(size3_t dims, size_t samples) {
+    const auto slice = dims.x * dims.y;
+    auto stride = std::max(size_t{1}, glm::compMul(dims) / samples);
+    while (std::gcd(stride, slice) != 1) ++stride;
+    return stride;
+}
+
+}  // namespace
+
 void HistogramCalculationState::whenDone(std::function<void(const HistogramContainer&)> callback) {
     if (auto container = container_.lock(); container && done) {
         callback(*container);
@@ -43,6 +70,16 @@ void HistogramCalculationState::whenDone(std::function<void(const HistogramConta
     }
 }
 
+void HistogramCalculationState::whenPreview(
+    std::function<void(const HistogramContainer&)> callback) {
+    if (done) return;
+    if (preview_) {
+        callback(*preview_);
+    } else {
+        callbackHandles_.push_back(previewCallbacks_.add(callback));
+    }
+}
+
 HistogramSupplier::HistogramSupplier() : histograms_{std::make_shared<HistogramContainer>()} {}
 
 HistogramSupplier::HistogramSupplier(const HistogramSupplier& rhs)
@@ -63,27 +100,75 @@ std::shared_ptr<HistogramCalculationState> HistogramSupplier::startCalculation(
         histograms_ = std::make_shared<HistogramContainer>();
         calculation_ = std::make_shared<HistogramCalculationState>(histograms_, bins, dataRange);
 
-        dispatchPool([weakState = std::weak_ptr<HistogramCalculationState>(calculation_),
-                      stop = calculation_->stop_, volumeRam, dataRange, bins]() {
-            auto histograms = volumeRam->dispatch<HistogramContainer>([&](auto vr) {
-                return HistogramContainer(dataRange, bins, vr->getDataTyped(),
-                                          vr->getDataTyped() + glm::compMul(vr->getDimensions()));
-            });
-            if (*stop) return;
-            dispatchFrontAndForget([hist = std::move(histograms), weakState]() {
-                if (auto s = weakState.lock()) {
-                    done(s, std::move(hist));
-                }
-            });
+        const auto dims = volumeRam->getDimensions();
+        const auto size = glm::compMul(dims);
+        const auto jobs = std::clamp(size / minElementsPerJob, size_t{1},
+                                     std::max(size_t{1}, 4 * util::getPoolSize()));
+
+        volumeRam->dispatch<void>([&](auto vr) {
+            using T = util::PrecisionValueType<decltype(vr)>;
+
+            if (size > 4 * previewSampleCount) {
+                dispatchPool([weakState = std::weak_ptr<HistogramCalculationState>(calculation_),
+                              stop = calculation_->stop_, volumeRam, dataRange, bins,
+                              stride = previewStride(dims, previewSampleCount), size]() {
+                    if (*stop) return;
+                    const T* data = static_cast<const T*>(volumeRam->getData());
+                    detail::HistogramAccumulator<T> accumulator{dataRange, bins};
+                    accumulator.add(data, size, stride);
+                    if (*stop) return;
+                    dispatchFrontAndForget(
+                        [hist = HistogramContainer{accumulator.histograms()}, weakState]() {
+                            if (auto s = weakState.lock()) {
+                                preview(s, std::move(hist));
+                            }
+                        });
+                });
+            }
+
+            auto reduction = std::make_shared<HistogramReduction<T>>(jobs, dataRange, bins);
+            for (size_t job = 0; job < jobs; ++job) {
+                dispatchPool([weakState = std::weak_ptr<HistogramCalculationState>(calculation_),
+                              stop = calculation_->stop_, volumeRam, reduction, job, jobs,
+                              size]() {
+                    if (!*stop) {
+                        const size_t begin = (size * job) / jobs;
+                        const size_t end = (size * (job + 1)) / jobs;
+                        const T* data = static_cast<const T*>(volumeRam->getData());
+                        reduction->accumulators[job].add(data + begin, end - begin, 1);
+                    }
+                    // The last job to finish merges the per job results
+                    if (--reduction->remaining != 0 || *stop) return;
+
+                    auto& result = reduction->accumulators.front();
+                    for (size_t i = 1; i < reduction->accumulators.size(); ++i) {
+                        result.merge(reduction->accumulators[i]);
+                    }
+                    dispatchFrontAndForget(
+                        [hist = HistogramContainer{result.histograms()}, weakState]() {
+                            if (auto s = weakState.lock()) {
+                                done(s, std::move(hist));
+                            }
+                        });
+                });
+            }
         });
     }
     return calculation_;
 }
 
+void HistogramSupplier::preview(std::shared_ptr<HistogramCalculationState> state,
+                                HistogramContainer histograms) {
+    if (state->done) return;
+    state->previewCallbacks_.invoke(histograms);
+    state->preview_ = std::move(histograms);
+}
+
 void HistogramSupplier::done(std::shared_ptr<HistogramCalculationState> state,
                              HistogramContainer histograms) {
     state->callbacks_.invoke(histograms);
     state->done = true;
+    state->preview_.reset();
     if (auto container = state->container_.lock()) {
         *container = std::move(histograms);
     }
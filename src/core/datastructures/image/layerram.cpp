@@ -30,6 +30,9 @@
 #include <inviwo/core/datastructures/image/layerram.h>
 #include <inviwo/core/datastructures/image/layer.h>
 #include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/dataconversion.h>
+
+#include <glm/gtx/component_wise.hpp>
 
 namespace inviwo {
 
@@ -37,11 +40,20 @@ LayerRAM::LayerRAM(LayerType type, const DataFormatBase* format)
     : LayerRepresentation(type, format) {}
 
 bool LayerRAM::copyRepresentationsTo(LayerRepresentation* targetLayerRam) const {
+    // Layers of equal size only need a format conversion
+    auto target = static_cast<LayerRAM*>(targetLayerRam);
+    if (getDimensions() == target->getDimensions() && getData() && target->getData() &&
+        getDataFormat()->getComponents() == target->getDataFormat()->getComponents()) {
+        util::convertDataNormalized(getData(), getDataFormat(), target->getData(),
+                                    target->getDataFormat(), glm::compMul(getDimensions()));
+        return true;
+    }
+
     // We use a LayerRamResizer to copy/resize one representation into another.
     // The CImg module implements a LayerRamResizer and registers it with the app
 
     if (auto resizer = InviwoApplication::getPtr()->getLayerRamResizer()) {
-        return resizer->resize(*this, *static_cast<LayerRAM*>(targetLayerRam));
+        return resizer->resize(*this, *target);
     }
     return false;
 }
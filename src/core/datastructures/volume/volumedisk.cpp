@@ -28,6 +28,10 @@
  *********************************************************************************/
 
 #include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/util/glmfmt.h>
+
+#include <glm/vector_relational.hpp>
 
 namespace inviwo {
 
@@ -75,4 +79,28 @@ void VolumeDisk::setWrapping(const Wrapping3D& wrapping) { wrapping_ = wrapping;
 
 Wrapping3D VolumeDisk::getWrapping() const { return wrapping_; }
 
+bool VolumeDisk::canReadRegion() const {
+    return dynamic_cast<const VolumeRegionLoader*>(getLoader()) != nullptr;
+}
+
+std::shared_ptr<VolumeRAM> VolumeDisk::readRegion(size3_t offset, size3_t extent) const {
+    const auto* loader = dynamic_cast<const VolumeRegionLoader*>(getLoader());
+    if (!loader) {
+        throw Exception("The loader does not support reading regions", IVW_CONTEXT);
+    }
+    if (glm::any(glm::greaterThan(offset + extent, dimensions_))) {
+        throw Exception(IVW_CONTEXT, "Region {} + {} is outside of the volume dimensions {}",
+                        offset, extent, dimensions_);
+    }
+
+    auto wrapping = wrapping_;
+    for (size_t i = 0; i < 3; ++i) {
+        if (extent[i] != dimensions_[i]) wrapping[i] = Wrapping::Clamp;
+    }
+    auto ram = createVolumeRAM(extent, getDataFormat(), nullptr, swizzleMask_, interpolation_,
+                               wrapping);
+    loader->updateRegion(ram, *this, offset);
+    return ram;
+}
+
 }  // namespace inviwo
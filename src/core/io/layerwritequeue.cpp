@@ -0,0 +1,184 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <inviwo/core/io/layerwritequeue.h>
+
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/threadutil.h>
+
+#include <algorithm>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+#include <fmt/std.h>
+
+namespace inviwo {
+
+LayerWriteQueue::LayerWriteQueue(InviwoApplication* app, size_t maxQueued)
+    : app_{app}
+    , maxQueued_{std::max(maxQueued, size_t{1})}
+    , mutex_{}
+    , written_{}
+    , queuedCount_{0}
+    , writtenCount_{0}
+    , flushing_{false}
+    , ready_{}
+    , exception_{} {}
+
+LayerWriteQueue::~LayerWriteQueue() {
+    std::unique_lock lock{mutex_};
+    written_.wait(lock, [&]() { return writtenCount_ == queuedCount_ && !flushing_; });
+}
+
+void LayerWriteQueue::write(const Layer& layer, Writer writer, const std::filesystem::path& file,
+                            Callback onWritten) {
+    exception_.throwOnError();
+    {
+        // Wait before making the copy to keep the memory bounded
+        std::unique_lock lock{mutex_};
+        written_.wait(lock, [&]() { return queuedCount_ - writtenCount_ < maxQueued_; });
+    }
+
+    // Make sure LayerRAM is the last valid representation, such that it is the one that gets
+    // cloned. This also forces any download to happen here instead of on the pool thread.
+    layer.getRepresentation<LayerRAM>();
+    write(std::shared_ptr<const Layer>(layer.clone()), std::move(writer), file,
+          std::move(onWritten));
+}
+
+void LayerWriteQueue::write(std::shared_ptr<const Layer> layer, Writer writer,
+                            const std::filesystem::path& file, Callback onWritten) {
+    exception_.throwOnError();
+
+    size_t index = 0;
+    {
+        std::unique_lock lock{mutex_};
+        written_.wait(lock, [&]() { return queuedCount_ - writtenCount_ < maxQueued_; });
+        index = queuedCount_++;
+    }
+
+    util::dispatchPool(app_, [this, index, layer = std::move(layer), writer = std::move(writer),
+                              file, onWritten = std::move(onWritten)]() {
+        encode(index, layer, writer, file, onWritten);
+    });
+}
+
+void LayerWriteQueue::wait() {
+    {
+        std::unique_lock lock{mutex_};
+        written_.wait(lock, [&]() { return writtenCount_ == queuedCount_ && !flushing_; });
+    }
+    exception_.throwOnError();
+}
+
+size_t LayerWriteQueue::size() const {
+    std::scoped_lock lock{mutex_};
+    return queuedCount_ - writtenCount_;
+}
+
+size_t LayerWriteQueue::getMaxQueued() const {
+    std::scoped_lock lock{mutex_};
+    return maxQueued_;
+}
+
+void LayerWriteQueue::setMaxQueued(size_t maxQueued) {
+    {
+        std::scoped_lock lock{mutex_};
+        maxQueued_ = std::max(maxQueued, size_t{1});
+    }
+    written_.notify_all();
+}
+
+void LayerWriteQueue::encode(size_t index, std::shared_ptr<const Layer> layer, Writer writer,
+                             std::filesystem::path file, Callback onWritten) {
+    std::function<void()> store;
+    try {
+        const auto extension = file.extension().string();
+        std::shared_ptr<std::vector<unsigned char>> buffer = writer->writeDataToBuffer(
+            layer.get(), std::string_view{extension}.substr(extension.empty() ? 0 : 1));
+
+        if (buffer) {
+            layer.reset();
+            store = [buffer = std::move(buffer), writer, file, onWritten]() {
+                writer->checkOverwrite(file);
+                std::ofstream out(file, std::ios::out | std::ios::binary);
+                if (!out) {
+                    throw FileException(IVW_CONTEXT_CUSTOM("LayerWriteQueue"),
+                                        "Could not open file {}", file);
+                }
+                out.write(reinterpret_cast<const char*>(buffer->data()),
+                          static_cast<std::streamsize>(buffer->size()));
+                if (onWritten) onWritten(file);
+            };
+        } else {
+            // The writer can not encode into memory, let it write the file in order instead
+            store = [layer = std::move(layer), writer, file, onWritten]() {
+                writer->writeData(layer.get(), file);
+                if (onWritten) onWritten(file);
+            };
+        }
+    } catch (...) {
+        exception_.setException();
+        store = []() {};
+    }
+
+    std::unique_lock lock{mutex_};
+    ready_.emplace(index, std::move(store));
+    flush(lock);
+}
+
+void LayerWriteQueue::flush(std::unique_lock<std::mutex>& lock) {
+    // Only one thread at a time writes files, always the next one in queue order
+    if (flushing_) return;
+    flushing_ = true;
+
+    for (auto it = ready_.find(writtenCount_); it != ready_.end();
+         it = ready_.find(writtenCount_)) {
+        auto store = std::move(it->second);
+        ready_.erase(it);
+
+        lock.unlock();
+        try {
+            store();
+        } catch (...) {
+            exception_.setException();
+        }
+        lock.lock();
+
+        ++writtenCount_;
+        written_.notify_all();
+    }
+
+    flushing_ = false;
+    written_.notify_all();
+}
+
+}  // namespace inviwo
@@ -36,8 +36,12 @@
 namespace inviwo {
 
 RawVolumeRAMLoader::RawVolumeRAMLoader(const std::filesystem::path& rawFile, size_t offset,
-                                       bool littleEndian)
-    : rawFile_(rawFile), offset_(offset), littleEndian_(littleEndian) {}
+                                       bool littleEndian,
+                                       const util::VolumeReorientation& reorientation)
+    : rawFile_(rawFile)
+    , offset_(offset)
+    , littleEndian_(littleEndian)
+    , reorientation_(reorientation) {}
 
 RawVolumeRAMLoader* RawVolumeRAMLoader::clone() const { return new RawVolumeRAMLoader(*this); }
 
@@ -48,6 +52,8 @@ std::shared_ptr<VolumeRepresentation> RawVolumeRAMLoader::createRepresentation(
     auto data = std::make_unique<char[]>(size);
     util::readBytesIntoBuffer(rawFile_, offset_, size, littleEndian_,
                               src.getDataFormat()->getSize(), data.get());
+    util::reorientVolume(data.get(), src.getDataFormat()->getSize(),
+                         reorientation_.sourceDimensions(src.getDimensions()), reorientation_);
 
     auto volumeRAM =
         createVolumeRAM(src.getDimensions(), src.getDataFormat(), data.get(), src.getSwizzleMask(),
@@ -68,9 +74,25 @@ void RawVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresentati
     const auto size = glm::compMul(src.getDimensions());
     util::readBytesIntoBuffer(rawFile_, offset_, size * src.getDataFormat()->getSize(),
                               littleEndian_, src.getDataFormat()->getSize(), volumeDst->getData());
+    util::reorientVolume(volumeDst->getData(), src.getDataFormat()->getSize(),
+                         reorientation_.sourceDimensions(src.getDimensions()), reorientation_);
 
     volumeDst->setSwizzleMask(src.getSwizzleMask());
     volumeDst->setInterpolation(src.getInterpolation());
     volumeDst->setWrapping(src.getWrapping());
 }
+
+void RawVolumeRAMLoader::updateRegion(std::shared_ptr<VolumeRepresentation> dest,
+                                      const VolumeRepresentation& src, size3_t offset) const {
+    auto volumeDst = std::static_pointer_cast<VolumeRAM>(dest);
+    const auto elementSize = src.getDataFormat()->getSize();
+
+    const auto [srcOffset, srcExtent] =
+        reorientation_.sourceRegion(src.getDimensions(), offset, volumeDst->getDimensions());
+    util::readRegionIntoBuffer(rawFile_, offset_,
+                               reorientation_.sourceDimensions(src.getDimensions()), srcOffset,
+                               srcExtent, littleEndian_, elementSize, volumeDst->getData());
+    util::reorientVolume(volumeDst->getData(), elementSize, srcExtent, reorientation_);
+}
+
 }  // namespace inviwo
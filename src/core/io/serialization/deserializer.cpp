@@ -38,7 +38,6 @@
 #include <inviwo/core/util/factory.h>
 #include <inviwo/core/util/exception.h>
 #include <inviwo/core/util/stringconversion.h>
-#include <inviwo/core/util/safecstr.h>
 
 #include <inviwo/core/io/serialization/ticpp.h>
 
@@ -48,6 +47,7 @@ Deserializer::Deserializer(const std::filesystem::path& fileName) : SerializeBas
     try {
         doc_->LoadFile(TIXML_ENCODING_UTF8);
         rootElement_ = doc_->FirstChildElement();
+        enableChildIndex();
         rootElement_->GetAttribute(std::string{SerializeConstants::VersionAttribute},
                                    &inviwoWorkspaceVersion_, false);
     } catch (TxException& e) {
@@ -60,6 +60,7 @@ Deserializer::Deserializer(std::istream& stream, const std::filesystem::path& pa
     try {
         // Base streamed in the xml data. Get the first node.
         rootElement_ = doc_->FirstChildElement();
+        enableChildIndex();
     } catch (TxException& e) {
         throw AbortException(e.what(), IVW_CONTEXT);
     }
@@ -122,7 +123,11 @@ void Deserializer::deserialize(std::string_view key, unsigned char& data,
 
 void Deserializer::setExceptionHandler(ExceptionHandler handler) { exceptionHandler_ = handler; }
 
-void Deserializer::convertVersion(VersionConverter* converter) { converter->convert(rootElement_); }
+void Deserializer::convertVersion(VersionConverter* converter) {
+    // The converter might add, remove, or rename nodes
+    invalidateChildIndex();
+    converter->convert(rootElement_);
+}
 
 void Deserializer::handleError(const ExceptionContext& context) {
     if (exceptionHandler_) {
@@ -137,7 +142,7 @@ void Deserializer::handleError(const ExceptionContext& context) {
 }
 
 TxElement* Deserializer::retrieveChild(std::string_view key) {
-    return retrieveChild_ ? rootElement_->FirstChildElement(SafeCStr{key}, false) : rootElement_;
+    return retrieveChild_ ? findChild(rootElement_, key) : rootElement_;
 }
 
 void Deserializer::registerFactory(FactoryBase* factory) {
@@ -147,7 +152,14 @@ void Deserializer::registerFactory(FactoryBase* factory) {
 int Deserializer::getInviwoWorkspaceVersion() const { return inviwoWorkspaceVersion_; }
 
 std::string detail::getNodeAttribute(TxElement* node, std::string_view key) {
-    return node->GetAttribute(SafeCStr{key});
+    return std::string{getNodeAttributeView(node, key)};
+}
+
+std::string_view detail::getNodeAttributeView(TxElement* node, std::string_view key) {
+    for (auto* attr = node->GetTiXmlElement()->FirstAttribute(); attr; attr = attr->Next()) {
+        if (std::string_view{attr->NameTStr()} == key) return attr->ValueStr();
+    }
+    return {};
 }
 
 void detail::forEachChild(TxElement* node, std::string_view key,
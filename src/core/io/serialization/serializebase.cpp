@@ -29,9 +29,19 @@
 
 #include <inviwo/core/io/serialization/serializebase.h>
 #include <inviwo/core/io/serialization/ticpp.h>
+#include <inviwo/core/util/safecstr.h>
+#include <inviwo/core/algorithm/base64.h>
 
+#include <algorithm>
+#include <bit>
 #include <charconv>
+#include <limits>
+#include <memory_resource>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include <zlib.h>
 
 namespace inviwo {
 
@@ -43,6 +53,34 @@ constexpr bool charconv = false;
 #endif
 }  // namespace config
 
+struct SerializeBase::ChildIndex {
+    using Entry = std::pair<std::string_view, TxElement*>;
+
+    TxElement* find(TxElement* parent, std::string_view key) {
+        auto [it, inserted] = children.try_emplace(parent->GetTiXmlElement());
+        auto& entries = it->second;
+        if (inserted) {
+            // The wrappers are owned by the underlying TiXml nodes and the names are views into
+            // the node values, both stay valid until the document is modified.
+            for (auto* child = parent->FirstChildElement(false); child;
+                 child = child->NextSiblingElement(false)) {
+                entries.emplace_back(child->GetTiXmlElement()->ValueStr(), child);
+            }
+            // Stable to make lookups return the first match in document order
+            std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+                return a.first < b.first;
+            });
+        }
+        const auto found = std::lower_bound(
+            entries.begin(), entries.end(), key,
+            [](const Entry& entry, std::string_view name) { return entry.first < name; });
+        return found != entries.end() && found->first == key ? found->second : nullptr;
+    }
+
+    std::pmr::monotonic_buffer_resource arena{16384};
+    std::pmr::unordered_map<const TiXmlElement*, std::pmr::vector<Entry>> children{&arena};
+};
+
 SerializeBase::SerializeBase()
     : doc_{std::make_unique<TxDocument>()}, rootElement_{nullptr}, retrieveChild_{true} {}
 
@@ -66,6 +104,20 @@ SerializeBase& SerializeBase::operator=(SerializeBase&&) noexcept = default;
 
 const std::filesystem::path& SerializeBase::getFileName() const { return fileName_; }
 
+TxElement* SerializeBase::findChild(TxElement* parent, std::string_view key) {
+    if (childIndex_) {
+        return childIndex_->find(parent, key);
+    } else {
+        return parent->FirstChildElement(SafeCStr{key}, false);
+    }
+}
+
+void SerializeBase::enableChildIndex() { childIndex_ = std::make_unique<ChildIndex>(); }
+
+void SerializeBase::invalidateChildIndex() {
+    if (childIndex_) childIndex_ = std::make_unique<ChildIndex>();
+}
+
 std::string SerializeBase::nodeToString(const TxElement& node) {
     try {
         TiXmlPrinter printer;
@@ -126,10 +178,9 @@ NodeSwitch::NodeSwitch(SerializeBase& serializer, std::string_view key, bool ret
     , storedNode_(serializer_->rootElement_)
     , storedRetrieveChild_(serializer_->retrieveChild_) {
 
-    serializer_->rootElement_ =
-        serializer_->retrieveChild_
-            ? serializer_->rootElement_->FirstChildElement(key.data(), false)
-            : serializer_->rootElement_;
+    serializer_->rootElement_ = serializer_->retrieveChild_
+                                    ? serializer_->findChild(serializer_->rootElement_, key)
+                                    : serializer_->rootElement_;
 
     serializer_->retrieveChild_ = retrieveChild;
 }
@@ -160,8 +211,12 @@ void fromStrInternal(std::string_view value, T& dest) {
             throw SerializationException("Error parsing number", IVW_CONTEXT_CUSTOM("fromStr"));
         }
     } else {
+        // Stream parsing does not throw, check that the whole value was consumed so that callers
+        // can fall back to other parsing, i.e. for inf and nan.
         std::istringstream stream{std::string{value}};
-        stream >> dest;
+        if (!(stream >> dest) || !(stream >> std::ws).eof()) {
+            throw SerializationException("Error parsing number", IVW_CONTEXT_CUSTOM("fromStr"));
+        }
     }
 }
 
@@ -197,4 +252,95 @@ void detail::numericalFromStr(std::string_view value, unsigned long long& dest)
     fromStrInternal(value, dest);
 }
 
+namespace {
+
+void swapToLittleEndian(std::span<char> bytes, size_t componentSize) {
+    if constexpr (std::endian::native == std::endian::big) {
+        for (auto it = bytes.begin(); it != bytes.end(); it += componentSize) {
+            std::reverse(it, it + componentSize);
+        }
+    }
+}
+
+}  // namespace
+
+std::string detail::encodeBinary(std::span<const char> bytes, size_t componentSize,
+                                 bool compress) {
+    std::vector<char> buffer(bytes.begin(), bytes.end());
+    swapToLittleEndian(buffer, componentSize);
+
+    if (compress) {
+        if (buffer.size() > std::numeric_limits<uLong>::max()) {
+            throw SerializationException("Binary data too large to compress",
+                                         IVW_CONTEXT_CUSTOM("Serializer"));
+        }
+        auto size = compressBound(static_cast<uLong>(buffer.size()));
+        std::vector<char> compressed(size);
+        if (compress2(reinterpret_cast<Bytef*>(compressed.data()), &size,
+                      reinterpret_cast<const Bytef*>(buffer.data()),
+                      static_cast<uLong>(buffer.size()), Z_BEST_SPEED) != Z_OK) {
+            throw SerializationException("Unable to compress binary data",
+                                         IVW_CONTEXT_CUSTOM("Serializer"));
+        }
+        compressed.resize(size);
+        buffer = std::move(compressed);
+    }
+    return util::base64_encode(buffer);
+}
+
+std::string detail::decodeBinary(std::string_view encoded, std::string_view encoding,
+                                 size_t componentSize, size_t expectedSize) {
+    auto bytes = util::base64_decode(encoded);
+
+    if (encoding == SerializeConstants::CompressedBinaryEncoding) {
+        // Inflate in chunks so that a corrupt stream can never make us allocate more than
+        // expectedSize bytes, regardless of what it claims to contain.
+        std::string decompressed;
+        z_stream stream{};
+        if (inflateInit(&stream) != Z_OK) {
+            throw SerializationException("Unable to initialize decompression",
+                                         IVW_CONTEXT_CUSTOM("Deserializer"));
+        }
+        stream.next_in = reinterpret_cast<Bytef*>(bytes.data());
+        stream.avail_in = static_cast<uInt>(
+            std::min<size_t>(bytes.size(), std::numeric_limits<uInt>::max()));
+
+        constexpr size_t chunkSize = 1 << 16;
+        int res = Z_OK;
+        while (res == Z_OK && decompressed.size() <= expectedSize) {
+            const auto offset = decompressed.size();
+            decompressed.resize(offset + std::min(chunkSize, expectedSize + 1 - offset));
+            stream.next_out = reinterpret_cast<Bytef*>(decompressed.data() + offset);
+            stream.avail_out = static_cast<uInt>(decompressed.size() - offset);
+            res = inflate(&stream, Z_NO_FLUSH);
+            decompressed.resize(decompressed.size() - stream.avail_out);
+            if (stream.avail_in == 0 && stream.total_in < bytes.size()) {
+                const auto remaining = bytes.size() - stream.total_in;
+                stream.avail_in = static_cast<uInt>(
+                    std::min<size_t>(remaining, std::numeric_limits<uInt>::max()));
+            }
+        }
+        inflateEnd(&stream);
+
+        if (res != Z_STREAM_END || decompressed.size() != expectedSize) {
+            throw SerializationException(
+                fmt::format("Unable to decompress binary data, expected {} bytes", expectedSize),
+                IVW_CONTEXT_CUSTOM("Deserializer"));
+        }
+        bytes = std::move(decompressed);
+    } else if (encoding == SerializeConstants::BinaryEncoding) {
+        if (bytes.size() != expectedSize) {
+            throw SerializationException(
+                fmt::format("Binary data size mismatch, expected {} bytes, found {}",
+                            expectedSize, bytes.size()),
+                IVW_CONTEXT_CUSTOM("Deserializer"));
+        }
+    } else {
+        throw SerializationException(fmt::format("Unknown binary encoding '{}'", encoding),
+                                     IVW_CONTEXT_CUSTOM("Deserializer"));
+    }
+    swapToLittleEndian(bytes, componentSize);
+    return bytes;
+}
+
 }  // namespace inviwo
@@ -53,6 +53,10 @@ Serializer::Serializer(const std::filesystem::path& fileName) : SerializeBase(fi
 
 Serializer::~Serializer() { delete rootElement_; }
 
+void Serializer::setBinaryThreshold(size_t threshold) { binaryThreshold_ = threshold; }
+
+size_t Serializer::getBinaryThreshold() const { return binaryThreshold_; }
+
 void Serializer::serialize(std::string_view key, const std::filesystem::path& path,
                            const SerializationTarget& target) {
 
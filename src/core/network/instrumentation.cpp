@@ -0,0 +1,257 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <inviwo/core/network/instrumentation.h>
+
+#include <algorithm>
+#include <map>
+#include <ostream>
+#include <unordered_map>
+
+#include <fmt/format.h>
+
+namespace inviwo {
+
+namespace {
+
+void writeJsonString(std::ostream& os, std::string_view str) {
+    os << '"';
+    for (const char c : str) {
+        switch (c) {
+            case '"':
+                os << "\\\"";
+                break;
+            case '\\':
+                os << "\\\\";
+                break;
+            case '\n':
+                os << "\\n";
+                break;
+            case '\t':
+                os << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    os << fmt::format("\\u{:04x}", static_cast<int>(c));
+                } else {
+                    os << c;
+                }
+        }
+    }
+    os << '"';
+}
+
+}  // namespace
+
+Instrumentation::Scope::Scope(Instrumentation* instrumentation, Kind kind,
+                              std::string_view processor)
+    : instrumentation_{instrumentation && instrumentation->isEnabled() ? instrumentation
+                                                                        : nullptr}
+    , allocationCounter_{instrumentation_ ? instrumentation_->getAllocationCounter() : nullptr}
+    , event_{kind, {}, {}, {}, {}, 0, 0, {}} {
+    if (instrumentation_) {
+        event_.processor = processor;
+        event_.thread = std::this_thread::get_id();
+        event_.evaluation = instrumentation_->getEvaluationCount();
+        // Sampled last to not count the allocations made by the scope itself
+        if (allocationCounter_) event_.allocations = allocationCounter_();
+        event_.start = Clock::now();
+    }
+}
+
+Instrumentation::Scope::~Scope() {
+    if (instrumentation_) {
+        event_.duration = Clock::now() - event_.start;
+        if (allocationCounter_) {
+            const auto end = allocationCounter_();
+            event_.allocations = {end.count - event_.allocations.count,
+                                  end.bytes - event_.allocations.bytes};
+        }
+        instrumentation_->record(std::move(event_));
+    }
+}
+
+Instrumentation::Instrumentation(size_t capacity)
+    : enabled_{false}, allocationCounter_{nullptr}, evaluation_{0}, mutex_{}
+    , capacity_{std::max(capacity, size_t{1})}, next_{0}, events_{} {}
+
+void Instrumentation::setEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void Instrumentation::setAllocationCounter(AllocationCounter counter) {
+    allocationCounter_.store(counter, std::memory_order_relaxed);
+}
+
+auto Instrumentation::getAllocationCounter() const -> AllocationCounter {
+    return allocationCounter_.load(std::memory_order_relaxed);
+}
+
+void Instrumentation::setCapacity(size_t capacity) {
+    std::scoped_lock lock{mutex_};
+    capacity_ = std::max(capacity, size_t{1});
+    events_.clear();
+    next_ = 0;
+}
+
+size_t Instrumentation::getCapacity() const {
+    std::scoped_lock lock{mutex_};
+    return capacity_;
+}
+
+void Instrumentation::clear() {
+    std::scoped_lock lock{mutex_};
+    events_.clear();
+    next_ = 0;
+}
+
+size_t Instrumentation::beginEvaluation() { return ++evaluation_; }
+
+size_t Instrumentation::getEvaluationCount() const { return evaluation_.load(); }
+
+void Instrumentation::record(Event event) {
+    std::scoped_lock lock{mutex_};
+    if (events_.size() < capacity_) {
+        events_.push_back(std::move(event));
+    } else {
+        events_[next_] = std::move(event);
+        next_ = (next_ + 1) % capacity_;
+    }
+}
+
+std::vector<Instrumentation::Event> Instrumentation::getEvents() const {
+    std::scoped_lock lock{mutex_};
+    std::vector<Event> events;
+    events.reserve(events_.size());
+    events.insert(events.end(), events_.begin() + next_, events_.end());
+    events.insert(events.end(), events_.begin(), events_.begin() + next_);
+    return events;
+}
+
+std::vector<Instrumentation::Summary> Instrumentation::summarize() const {
+    std::map<std::string, Summary, std::less<>> summaries;
+    for (const auto& event : getEvents()) {
+        if (event.kind == Kind::Evaluation) continue;
+
+        auto& summary = summaries[event.processor];
+        summary.processor = event.processor;
+        summary.allocations.count += event.allocations.count;
+        summary.allocations.bytes += event.allocations.bytes;
+        switch (event.kind) {
+            case Kind::InitializeResources:
+                summary.initializeResources += event.duration;
+                break;
+            case Kind::PortOnChange:
+                summary.portOnChange += event.duration;
+                break;
+            case Kind::Process:
+                summary.process += event.duration;
+                summary.outportBytes = event.outportBytes;
+                ++summary.processCount;
+                break;
+            case Kind::BackgroundJob:
+                summary.backgroundJob += event.duration;
+                ++summary.backgroundJobCount;
+                break;
+            case Kind::Evaluation:
+                break;
+        }
+    }
+
+    std::vector<Summary> result;
+    result.reserve(summaries.size());
+    for (auto& item : summaries) result.push_back(std::move(item.second));
+
+    const auto total = [](const Summary& s) {
+        return s.initializeResources + s.portOnChange + s.process + s.backgroundJob;
+    };
+    std::stable_sort(result.begin(), result.end(),
+                     [&](const Summary& a, const Summary& b) { return total(a) > total(b); });
+    return result;
+}
+
+void Instrumentation::exportChromeTrace(std::ostream& os) const {
+    using std::chrono::duration;
+    using Micro = duration<double, std::micro>;
+
+    const auto events = getEvents();
+
+    // Map thread ids to small consecutive numbers in order of appearance
+    std::unordered_map<std::thread::id, size_t> threads;
+    const auto tid = [&](std::thread::id id) {
+        return threads.try_emplace(id, threads.size() + 1).first->second;
+    };
+
+    // Spans are recorded when they end, the outermost span is last but starts first.
+    auto origin = Clock::time_point::max();
+    for (const auto& event : events) origin = std::min(origin, event.start);
+
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto& event : events) {
+        if (!first) os << ',';
+        first = false;
+
+        os << "\n{\"name\":";
+        writeJsonString(os, event.kind == Kind::Evaluation ? name(event.kind) : event.processor);
+        os << ",\"cat\":";
+        writeJsonString(os, name(event.kind));
+        os << fmt::format(
+            ",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{},\"args\":{{"
+            "\"evaluation\":{}",
+            Micro(event.start - origin).count(), Micro(event.duration).count(), tid(event.thread),
+            event.evaluation);
+        if (event.kind == Kind::Process) {
+            os << fmt::format(",\"outportBytes\":{}", event.outportBytes);
+        }
+        if (event.allocations.count != 0) {
+            os << fmt::format(",\"allocations\":{},\"allocatedBytes\":{}",
+                              event.allocations.count, event.allocations.bytes);
+        }
+        os << "}}";
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+std::string_view Instrumentation::name(Kind kind) {
+    switch (kind) {
+        case Kind::Evaluation:
+            return "Evaluation";
+        case Kind::InitializeResources:
+            return "InitializeResources";
+        case Kind::PortOnChange:
+            return "PortOnChange";
+        case Kind::Process:
+            return "Process";
+        case Kind::BackgroundJob:
+            return "BackgroundJob";
+    }
+    return "Unknown";
+}
+
+}  // namespace inviwo
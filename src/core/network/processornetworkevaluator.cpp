@@ -34,6 +34,7 @@
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/network/networkutils.h>
 #include <inviwo/core/network/networklock.h>
+#include <inviwo/core/ports/outport.h>
 #include <inviwo/core/util/clock.h>
 
 namespace inviwo {
@@ -43,7 +44,8 @@ ProcessorNetworkEvaluator::ProcessorNetworkEvaluator(ProcessorNetwork* processor
     , processorsSorted_(util::topologicalSortFiltered(processorNetwork_))
     , needsSorting_(true)
     , evaulationQueued_(false)
-    , exceptionHandler_(StandardEvaluationErrorHandler()) {
+    , exceptionHandler_(StandardEvaluationErrorHandler())
+    , instrumentation_(std::make_shared<Instrumentation>()) {
 
     processorNetwork_->addObserver(this);
 }
@@ -52,6 +54,10 @@ void ProcessorNetworkEvaluator::setExceptionHandler(EvaluationErrorHandler handl
     exceptionHandler_ = handler;
 }
 
+const std::shared_ptr<Instrumentation>& ProcessorNetworkEvaluator::getInstrumentation() const {
+    return instrumentation_;
+}
+
 void ProcessorNetworkEvaluator::onProcessorNetworkEvaluateRequest() {
     // Direct request, thus we don't want to queue the evaluation anymore
     evaulationQueued_ = false;
@@ -107,12 +113,20 @@ void ProcessorNetworkEvaluator::evaluate() {
 
     IVW_CPU_PROFILING_IF(500, "Evaluated Processor Network");
 
+    using Scope = Instrumentation::Scope;
+    using Kind = Instrumentation::Kind;
+    auto* const instrumentation = instrumentation_->isEnabled() ? instrumentation_.get() : nullptr;
+    if (instrumentation) instrumentation->beginEvaluation();
+    const Scope evaluationScope{instrumentation, Kind::Evaluation};
+
     for (auto processor : processorsSorted_) {
         if (!processor->isValid()) {
             if (processor->isReady()) {
                 try {
                     // re-initialize resources (e.g., shaders) if necessary
                     if (processor->getInvalidationLevel() >= InvalidationLevel::InvalidResources) {
+                        const Scope scope{instrumentation, Kind::InitializeResources,
+                                          processor->getIdentifier()};
                         processor->initializeResources();
                     }
                 } catch (...) {
@@ -122,6 +136,8 @@ void ProcessorNetworkEvaluator::evaluate() {
 
                 try {
                     // call onChange for all invalid inports
+                    const Scope scope{instrumentation, Kind::PortOnChange,
+                                      processor->getIdentifier()};
                     for (auto inport : processor->getInports()) {
                         inport->callOnChangeIfChanged();
                     }
@@ -134,9 +150,18 @@ void ProcessorNetworkEvaluator::evaluate() {
 
                 try {
                     IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
+                    Scope scope{instrumentation, Kind::Process, processor->getIdentifier()};
                     // do the actual processing
                     processor->process();
 
+                    if (scope.isActive()) {
+                        size_t bytes = 0;
+                        for (auto outport : processor->getOutports()) {
+                            bytes += outport->getDataSizeInBytes();
+                        }
+                        scope.setOutportBytes(bytes);
+                    }
+
                     // Set processor as valid only if we still are ready.
                     // Callbacks might have made our inports invalid, if so abort
                     // the evaluation by not setting the processor valid.
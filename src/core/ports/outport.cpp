@@ -74,6 +74,8 @@ void Outport::setValid() {
     isReady_.update();
 }
 
+size_t Outport::getDataSizeInBytes() const { return 0; }
+
 void Outport::propagateEvent(Event* event, Inport*) { processor_->propagateEvent(event, this); }
 
 const BaseCallBack* Outport::onConnect(std::function<void()> lambda) {
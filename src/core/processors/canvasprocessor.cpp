@@ -41,6 +41,8 @@
 #include <inviwo/core/util/fileextension.h>
 #include <inviwo/core/util/filedialog.h>
 #include <inviwo/core/io/imagewriterutil.h>
+#include <inviwo/core/io/datawriterfactory.h>
+#include <inviwo/core/common/factoryutil.h>
 #include <inviwo/core/network/networklock.h>
 
 namespace inviwo {
@@ -127,7 +129,8 @@ CanvasProcessor::CanvasProcessor(InviwoApplication* app)
     , saveLayerButton_{"saveLayer", "Save Image Layer",
                        "Save an image snapshot to the specified 'Output Directory' using the "
                        "image format specified by 'Image Type' and the current time as name"_help,
-                       [this]() { saveImageLayer(); }, InvalidationLevel::Valid}
+                       [this]() { saveImageLayerAsync(snapshotPath(), imageTypeExt_); },
+                       InvalidationLevel::Valid}
     , saveLayerToFileButton_{"saveLayerToFile", "Save Image Layer to File...",
                              "Save the current layer to a file. This will open a save dialog to "
                              "specify the output file"_help,
@@ -151,7 +154,7 @@ CanvasProcessor::CanvasProcessor(InviwoApplication* app)
     , saveLayerEvent_{"saveLayerEvent",
                       "Save Image Layer",
                       "Shortcut for saving a snapshot, same as 'Save Image Layer'"_help,
-                      [this](Event*) { saveImageLayer(); },
+                      [this](Event*) { saveImageLayerAsync(snapshotPath(), imageTypeExt_); },
                       IvwKey::Undefined,
                       KeyState::Press}
     , allowContextMenu_{"allowContextMenu", "Allow Context Menu",
@@ -168,7 +171,8 @@ CanvasProcessor::CanvasProcessor(InviwoApplication* app)
                           false}
     , previousImageSize_(customInputDimensions_)
     , widgetMetaData_{
-          createMetaData<ProcessorWidgetMetaData>(ProcessorWidgetMetaData::CLASS_IDENTIFIER)} {
+          createMetaData<ProcessorWidgetMetaData>(ProcessorWidgetMetaData::CLASS_IDENTIFIER)}
+    , saveQueue_{app} {
     addPort(inport_);
     widgetMetaData_->addObserver(this);
 
@@ -300,15 +304,15 @@ size2_t CanvasProcessor::calcScaledSize(size2_t size, float scale) {
     return size;
 }
 
-void CanvasProcessor::saveImageLayer() {
+std::filesystem::path CanvasProcessor::snapshotPath() {
     if (saveLayerDirectory_.get().empty()) saveLayerDirectory_.requestFile();
 
-    const auto snapshotPath(
-        saveLayerDirectory_.get() /
-        (toLower(getIdentifier()) + "-" + currentDateTime() + "." + imageTypeExt_->extension_));
-    saveImageLayer(snapshotPath, imageTypeExt_);
+    return saveLayerDirectory_.get() / (toLower(getIdentifier()) + "-" + currentDateTime() + "." +
+                                        imageTypeExt_->extension_);
 }
 
+void CanvasProcessor::saveImageLayer() { saveImageLayer(snapshotPath(), imageTypeExt_); }
+
 void CanvasProcessor::saveImageLayer(const std::filesystem::path& snapshotPath,
                                      const FileExtension& extension) {
     if (auto layer = getVisibleLayer()) {
@@ -318,6 +322,41 @@ void CanvasProcessor::saveImageLayer(const std::filesystem::path& snapshotPath,
     }
 }
 
+void CanvasProcessor::saveImageLayerAsync(const std::filesystem::path& snapshotPath,
+                                          const FileExtension& extension) {
+    auto layer = getVisibleLayer();
+    if (!layer) {
+        LogError("Could not find visible layer");
+        return;
+    }
+
+    auto writer = util::getDataWriterFactory()->getWriterForTypeAndExtension<Layer>(extension,
+                                                                                   snapshotPath);
+    if (!writer) {
+        LogError("Could not find a writer for " << snapshotPath);
+        return;
+    }
+    writer->setOverwrite(Overwrite::Yes);
+
+    try {
+        saveQueue_.write(*layer, std::move(writer), snapshotPath,
+                         [](const std::filesystem::path& path) {
+                             LogInfoCustom("CanvasProcessor",
+                                           "Canvas layer exported to disk: " << path);
+                         });
+    } catch (const Exception& e) {
+        util::log(e.getContext(), e.getMessage(), LogLevel::Error);
+    }
+}
+
+void CanvasProcessor::waitForSavedImageLayers() {
+    try {
+        saveQueue_.wait();
+    } catch (const Exception& e) {
+        util::log(e.getContext(), e.getMessage(), LogLevel::Error);
+    }
+}
+
 std::optional<std::filesystem::path> CanvasProcessor::exportFile(
     const std::filesystem::path& path, std::string_view name,
     const std::vector<FileExtension>& candidateExtensions, Overwrite overwrite) const {
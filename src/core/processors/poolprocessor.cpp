@@ -30,6 +30,7 @@
 #include <inviwo/core/processors/poolprocessor.h>
 #include <inviwo/core/network/processornetwork.h>
 #include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/network/processornetworkevaluator.h>
 #include <inviwo/core/util/stringconversion.h>
 #include <inviwo/core/util/stdfuture.h>
 
@@ -174,4 +175,13 @@ bool PoolProcessor::removeState(const std::shared_ptr<pool::detail::State>& stat
     return isLast;
 }
 
+std::shared_ptr<Instrumentation> PoolProcessor::getInstrumentation() {
+    if (auto app = getInviwoApplication()) {
+        if (auto evaluator = app->getProcessorNetworkEvaluator()) {
+            return evaluator->getInstrumentation();
+        }
+    }
+    return nullptr;
+}
+
 }  // namespace inviwo
@@ -58,4 +58,14 @@ TEST(CommandLineParserTest, CommandLineParserTest) {
     EXPECT_TRUE(clp.getShowSplashScreen());
 }
 
+TEST(CommandLineParserTest, ExitCode) {
+    const int argc = 2;
+    const char* argv[argc] = {"unittests.exe", "-q"};
+    CommandLineParser clp(argc, const_cast<char**>(argv));
+    EXPECT_TRUE(clp.getQuitApplicationAfterStartup());
+    EXPECT_EQ(0, clp.getExitCode());
+    clp.setExitCode(1);
+    EXPECT_EQ(1, clp.getExitCode());
+}
+
 }  // namespace inviwo
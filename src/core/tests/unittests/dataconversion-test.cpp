@@ -0,0 +1,138 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/dataconversion.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/formats.h>
+#include <inviwo/core/util/glm.h>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace inviwo {
+
+TEST(DataConversion, cast) {
+    const std::vector<double> src{-1.5, 0.0, 2.7, 300.0};
+    std::vector<int> dst(src.size());
+    util::convertData(src.data(), dst.data(), src.size());
+    EXPECT_EQ((std::vector<int>{-1, 0, 2, 300}), dst);
+}
+
+TEST(DataConversion, castVectorExtents) {
+    const std::vector<ivec3> src{{1, 2, 3}, {4, 5, 6}};
+    std::vector<vec2> dst2(src.size());
+    util::convertData(src.data(), dst2.data(), src.size());
+    EXPECT_EQ(vec2(1.0f, 2.0f), dst2[0]);
+    EXPECT_EQ(vec2(4.0f, 5.0f), dst2[1]);
+
+    std::vector<dvec4> dst4(src.size());
+    util::convertData(src.data(), dst4.data(), src.size());
+    EXPECT_EQ(dvec4(1.0, 2.0, 3.0, 0.0), dst4[0]);
+    EXPECT_EQ(dvec4(4.0, 5.0, 6.0, 0.0), dst4[1]);
+}
+
+TEST(DataConversion, normalizedMatchesGlmConvert) {
+    std::vector<std::uint16_t> src(65536);
+    std::iota(src.begin(), src.end(), std::uint16_t{0});
+
+    std::vector<std::uint8_t> u8(src.size());
+    util::convertDataNormalized(src.data(), u8.data(), src.size());
+    std::vector<float> f32(src.size());
+    util::convertDataNormalized(src.data(), f32.data(), src.size());
+    std::vector<std::int16_t> i16(src.size());
+    util::convertDataNormalized(src.data(), i16.data(), src.size());
+
+    for (size_t i = 0; i < src.size(); ++i) {
+        EXPECT_EQ(util::glm_convert_normalized<std::uint8_t>(src[i]), u8[i]);
+        EXPECT_EQ(util::glm_convert_normalized<float>(src[i]), f32[i]);
+        EXPECT_EQ(util::glm_convert_normalized<std::int16_t>(src[i]), i16[i]);
+    }
+}
+
+TEST(DataConversion, normalizedVector) {
+    const std::vector<glm::u8vec3> src(1000, glm::u8vec3{0, 255, 51});
+    std::vector<vec3> dst(src.size());
+    util::convertDataNormalized(src.data(), dst.data(), src.size());
+    for (const auto& v : dst) {
+        EXPECT_EQ(vec3(0.0f, 1.0f, 0.2f), v);
+    }
+}
+
+TEST(DataConversion, mapped) {
+    const std::vector<std::uint16_t> src{0, 1000, 2000, 4000};
+    std::vector<float> dst(src.size());
+    util::convertDataMapped(src.data(), dst.data(), src.size(), dvec2{0.0, 2000.0},
+                            dvec2{-1.0, 1.0});
+    EXPECT_FLOAT_EQ(-1.0f, dst[0]);
+    EXPECT_FLOAT_EQ(0.0f, dst[1]);
+    EXPECT_FLOAT_EQ(1.0f, dst[2]);
+    EXPECT_FLOAT_EQ(3.0f, dst[3]);
+
+    // Integer destinations are clamped
+    std::vector<std::uint8_t> u8(src.size());
+    util::convertDataMapped(src.data(), u8.data(), src.size(), dvec2{0.0, 2000.0},
+                            dvec2{0.0, 255.0});
+    EXPECT_EQ((std::vector<std::uint8_t>{0, 127, 255, 255}), u8);
+}
+
+TEST(DataConversion, mappedVectorPadding) {
+    const std::vector<float> src{0.5f, 1.0f};
+    std::vector<dvec2> dst(src.size());
+    util::convertDataMapped(src.data(), dst.data(), src.size(), dvec2{0.0, 1.0},
+                            dvec2{10.0, 20.0});
+    EXPECT_EQ(dvec2(15.0, 0.0), dst[0]);
+    EXPECT_EQ(dvec2(20.0, 0.0), dst[1]);
+}
+
+TEST(DataConversion, runtimeFormats) {
+    const std::vector<glm::u16vec2> src{{0, 65535}, {65535, 0}};
+    std::vector<vec2> dst(src.size());
+    util::convertDataNormalized(src.data(), DataVec2UInt16::get(), dst.data(),
+                                DataVec2Float32::get(), src.size());
+    EXPECT_EQ(vec2(0.0f, 1.0f), dst[0]);
+    EXPECT_EQ(vec2(1.0f, 0.0f), dst[1]);
+
+    std::vector<glm::i8vec2> cast(src.size());
+    util::convertData(dst.data(), DataVec2Float32::get(), cast.data(), DataVec2Int8::get(),
+                      dst.size());
+    EXPECT_EQ(glm::i8vec2(0, 1), cast[0]);
+
+    std::vector<vec3> wrong(src.size());
+    EXPECT_THROW(util::convertData(src.data(), DataVec2UInt16::get(), wrong.data(),
+                                   DataVec3Float32::get(), src.size()),
+                 Exception);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,152 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/histogram.h>
+#include <inviwo/core/datastructures/histogramtools.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/common/inviwoapplication.h>
+
+#include <chrono>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+namespace inviwo {
+
+TEST(Histogram, mergedAccumulatorsMatchSerial) {
+    std::vector<float> data(10007);
+    std::iota(data.begin(), data.end(), 0.0f);
+    const dvec2 range{0.0, 10006.0};
+    const size_t bins = 64;
+
+    const HistogramContainer serial(range, bins, data.begin(), data.end());
+
+    detail::HistogramAccumulator<float> first(range, bins);
+    detail::HistogramAccumulator<float> second(range, bins);
+    first.add(data.data(), 5000, 1);
+    second.add(data.data() + 5000, data.size() - 5000, 1);
+    first.merge(second);
+    const HistogramContainer merged{first.histograms()};
+
+    ASSERT_EQ(1u, merged.size());
+    EXPECT_EQ(serial[0].getData(), merged[0].getData());
+    EXPECT_DOUBLE_EQ(serial[0].getMaximumBinValue(), merged[0].getMaximumBinValue());
+    EXPECT_DOUBLE_EQ(0.0, merged[0].stats_.min);
+    EXPECT_DOUBLE_EQ(10006.0, merged[0].stats_.max);
+    EXPECT_DOUBLE_EQ(serial[0].stats_.mean, merged[0].stats_.mean);
+    EXPECT_NEAR(serial[0].stats_.standardDeviation, merged[0].stats_.standardDeviation, 1e-6);
+}
+
+TEST(Histogram, stridedSubsample) {
+    std::vector<int> data(1000, 3);
+    for (size_t i = 0; i < data.size(); i += 10) data[i] = 7;
+
+    detail::HistogramAccumulator<int> acc(dvec2{0.0, 9.0}, 10);
+    acc.add(data.data(), data.size(), 10);
+    EXPECT_EQ(100u, acc.count());
+
+    const HistogramContainer hist{acc.histograms()};
+    EXPECT_DOUBLE_EQ(1.0, hist[0][7]);
+    EXPECT_DOUBLE_EQ(0.0, hist[0][3]);
+}
+
+TEST(Histogram, vectorChannels) {
+    std::vector<ivec2> data{{0, 9}, {1, 9}, {2, 9}, {3, 9}};
+    const HistogramContainer hist(dvec2{0.0, 9.0}, 10, data.begin(), data.end());
+    ASSERT_EQ(2u, hist.size());
+    EXPECT_DOUBLE_EQ(3.0, hist[0].stats_.max);
+    EXPECT_DOUBLE_EQ(1.0, hist[1][9]);
+    EXPECT_DOUBLE_EQ(4.0, hist[1].getMaximumBinValue());
+}
+
+TEST(Histogram, supplierMatchesSerial) {
+    // Large enough to get both a preview and several parallel jobs
+    const size3_t dims{260, 260, 260};
+    ASSERT_GT(dims.x * dims.y * dims.z, 4 * HistogramSupplier::previewSampleCount);
+
+    auto ram = std::make_shared<VolumeRAMPrecision<unsigned char>>(dims);
+    auto data = ram->getDataTyped();
+    const auto size = dims.x * dims.y * dims.z;
+    for (size_t i = 0; i < size; ++i) data[i] = static_cast<unsigned char>(i % 251);
+    const dvec2 range{0.0, 255.0};
+    const size_t bins = 256;
+    const HistogramContainer serial(range, bins, data, data + size);
+
+    Volume volume{ram};
+    volume.dataMap_.dataRange = range;
+    auto state = volume.calculateHistograms(bins);
+
+    std::vector<HistogramContainer> previews;
+    state->whenPreview([&](const HistogramContainer& h) { previews.push_back(h); });
+    std::optional<HistogramContainer> result;
+    state->whenDone([&](const HistogramContainer& h) { result = h; });
+
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+    while (!state->isDone() && std::chrono::steady_clock::now() < timeout) {
+        InviwoApplication::getPtr()->processFront();
+    }
+    ASSERT_TRUE(state->isDone());
+    ASSERT_TRUE(result);
+    EXPECT_FALSE(state->hasPreview());
+
+    ASSERT_EQ(1u, result->size());
+    EXPECT_EQ(serial[0].getData(), (*result)[0].getData());
+    EXPECT_DOUBLE_EQ(serial[0].stats_.mean, (*result)[0].stats_.mean);
+    EXPECT_NEAR(serial[0].stats_.standardDeviation, (*result)[0].stats_.standardDeviation, 1e-6);
+    EXPECT_EQ(serial[0].getData(), volume.getHistograms()[0].getData());
+
+    // The preview may lose the race against the full calculation, but if it arrived it should
+    // be a subsample with roughly the same distribution.
+    ASSERT_LE(previews.size(), 1u);
+    for (const auto& preview : previews) {
+        ASSERT_EQ(1u, preview.size());
+        const auto& p = preview[0].getData();
+        const auto& s = serial[0].getData();
+        const auto pTotal = std::accumulate(p.begin(), p.end(), 0.0);
+        const auto sTotal = std::accumulate(s.begin(), s.end(), 0.0);
+        EXPECT_LT(pTotal, sTotal);
+        for (size_t bin = 0; bin < bins; ++bin) {
+            EXPECT_NEAR(s[bin] / sTotal, p[bin] / pTotal, 0.001) << "bin " << bin;
+        }
+    }
+
+    // Asking again with the same parameters reuses the finished calculation
+    EXPECT_EQ(state, volume.calculateHistograms(bins));
+    bool called = false;
+    state->whenPreview([&](const HistogramContainer&) { called = true; });
+    EXPECT_FALSE(called);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,142 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/io/datawriterexception.h>
+#include <inviwo/core/io/layerwritequeue.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace inviwo {
+
+namespace {
+
+/// Encodes the first pixel of the layer as a single byte, or writes it directly if toBuffer is off
+class FirstPixelWriter : public DataWriterType<Layer> {
+public:
+    explicit FirstPixelWriter(bool toBuffer, bool fail = false)
+        : DataWriterType<Layer>{}, toBuffer_{toBuffer}, fail_{fail} {
+        setOverwrite(Overwrite::Yes);
+    }
+    virtual FirstPixelWriter* clone() const override { return new FirstPixelWriter(*this); }
+
+    virtual void writeData(const Layer* data,
+                           const std::filesystem::path& filePath) const override {
+        auto buffer = encode(data);
+        std::ofstream out(filePath, std::ios::out | std::ios::binary);
+        out.write(reinterpret_cast<const char*>(buffer->data()), buffer->size());
+    }
+    virtual std::unique_ptr<std::vector<unsigned char>> writeDataToBuffer(
+        const Layer* data, std::string_view) const override {
+        if (!toBuffer_) return nullptr;
+        return encode(data);
+    }
+
+private:
+    std::unique_ptr<std::vector<unsigned char>> encode(const Layer* data) const {
+        if (fail_) throw DataWriterException("Failed to encode", IVW_CONTEXT);
+        const auto* ram = data->getRepresentation<LayerRAM>();
+        return std::make_unique<std::vector<unsigned char>>(
+            1, static_cast<const unsigned char*>(ram->getData())[0]);
+    }
+
+    bool toBuffer_;
+    bool fail_;
+};
+
+std::shared_ptr<Layer> makeLayer(unsigned char value) {
+    auto ram = std::make_shared<LayerRAMPrecision<unsigned char>>(size2_t{4, 4});
+    std::fill_n(ram->getDataTyped(), 16, value);
+    return std::make_shared<Layer>(ram);
+}
+
+unsigned char readByte(const std::filesystem::path& file) {
+    std::ifstream in(file, std::ios::in | std::ios::binary);
+    return static_cast<unsigned char>(in.get());
+}
+
+void testWriteOrder(bool toBuffer) {
+    const auto dir = std::filesystem::temp_directory_path() / "inviwo-layerwritequeue-test";
+    std::filesystem::create_directories(dir);
+
+    std::mutex mutex;
+    std::vector<std::filesystem::path> order;
+    std::vector<std::filesystem::path> files;
+    {
+        LayerWriteQueue queue{InviwoApplication::getPtr(), 4};
+        auto writer = std::make_shared<FirstPixelWriter>(toBuffer);
+        for (unsigned char i = 0; i < 32; ++i) {
+            files.push_back(dir / fmt::format("layer{:02}.bin", i));
+            queue.write(*makeLayer(i), writer, files.back(), [&](const auto& file) {
+                std::scoped_lock lock{mutex};
+                order.push_back(file);
+            });
+            EXPECT_LE(queue.size(), queue.getMaxQueued());
+        }
+        queue.wait();
+        EXPECT_EQ(queue.size(), size_t{0});
+    }
+
+    EXPECT_EQ(order, files);
+    for (size_t i = 0; i < files.size(); ++i) {
+        EXPECT_EQ(readByte(files[i]), static_cast<unsigned char>(i));
+    }
+    std::filesystem::remove_all(dir);
+}
+
+}  // namespace
+
+TEST(LayerWriteQueue, WritesInOrder) { testWriteOrder(true); }
+
+TEST(LayerWriteQueue, WritesInOrderWithoutBuffer) { testWriteOrder(false); }
+
+TEST(LayerWriteQueue, PropagatesErrors) {
+    const auto file = std::filesystem::temp_directory_path() / "inviwo-layerwritequeue-fail.bin";
+
+    LayerWriteQueue queue{InviwoApplication::getPtr()};
+    queue.write(makeLayer(1), std::make_shared<FirstPixelWriter>(true, true), file);
+    EXPECT_THROW(queue.wait(), DataWriterException);
+    EXPECT_NO_THROW(queue.wait());
+    EXPECT_FALSE(std::filesystem::exists(file));
+}
+
+}  // namespace inviwo
@@ -42,7 +42,9 @@
 #include <inviwo/core/ports/datainport.h>
 #include <inviwo/core/ports/dataoutport.h>
 
+#include <algorithm>
 #include <functional>
+#include <sstream>
 
 namespace inviwo {
 
@@ -256,4 +258,106 @@ TEST(NetworkEvaluator, Error) {
     }
 }
 
+TEST(NetworkEvaluator, Instrumentation) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+    auto& instrumentation = *evaluator.getInstrumentation();
+    EXPECT_FALSE(instrumentation.isEnabled());
+
+    auto at = createA();
+    auto a = at.get();
+    a->onProcess = [](TestProcessor& p) {
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(std::make_shared<int>(0));
+    };
+    auto bt = createB();
+    auto b = bt.get();
+
+    network.addProcessor(std::move(at));
+    network.addProcessor(std::move(bt));
+    network.addConnection(a->getOutports()[0], b->getInports()[0]);
+    EXPECT_TRUE(instrumentation.getEvents().empty());
+
+    instrumentation.setEnabled(true);
+    a->invalidate(InvalidationLevel::InvalidResources);
+
+    using Kind = Instrumentation::Kind;
+    const auto events = instrumentation.getEvents();
+    const auto count = [&](Kind kind, std::string_view id) {
+        return std::count_if(events.begin(), events.end(), [&](const auto& e) {
+            return e.kind == kind && e.processor == id;
+        });
+    };
+    EXPECT_EQ(count(Kind::Evaluation, ""), 1);
+    EXPECT_EQ(count(Kind::InitializeResources, "a"), 1);
+    EXPECT_EQ(count(Kind::InitializeResources, "b"), 0);
+    EXPECT_EQ(count(Kind::Process, "a"), 1);
+    EXPECT_EQ(count(Kind::Process, "b"), 1);
+
+    for (const auto& e : events) {
+        EXPECT_EQ(e.evaluation, 1);
+        if (e.kind == Kind::Process && e.processor == "a") EXPECT_EQ(e.outportBytes, sizeof(int));
+    }
+
+    const auto summary = instrumentation.summarize();
+    ASSERT_EQ(summary.size(), 2);
+    for (const auto& s : summary) EXPECT_EQ(s.processCount, 1);
+
+    std::stringstream trace;
+    instrumentation.exportChromeTrace(trace);
+    EXPECT_NE(trace.str().find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE(trace.str().find("\"cat\":\"Process\""), std::string::npos);
+
+    instrumentation.setCapacity(2);
+    a->invalidate(InvalidationLevel::InvalidOutput);
+    a->invalidate(InvalidationLevel::InvalidOutput);
+    EXPECT_EQ(instrumentation.getEvents().size(), 2);
+    EXPECT_EQ(instrumentation.getEvents().back().kind, Kind::Evaluation);
+    EXPECT_EQ(instrumentation.getEvaluationCount(), 3);
+}
+
+TEST(NetworkEvaluator, InstrumentationAllocations) {
+    // Stands in for the per thread counts of a replaced operator new
+    static thread_local Instrumentation::Allocations allocations;
+
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+    auto& instrumentation = *evaluator.getInstrumentation();
+    EXPECT_EQ(instrumentation.getAllocationCounter(), nullptr);
+    instrumentation.setAllocationCounter([]() { return allocations; });
+    instrumentation.setEnabled(true);
+
+    auto at = createA();
+    auto a = at.get();
+    a->onProcess = [](TestProcessor&) {
+        allocations.count += 3;
+        allocations.bytes += 300;
+    };
+    auto bt = createB();
+    auto b = bt.get();
+    network.addProcessor(std::move(at));
+    network.addProcessor(std::move(bt));
+    network.addConnection(a->getOutports()[0], b->getInports()[0]);
+
+    a->invalidate(InvalidationLevel::InvalidOutput);
+    a->invalidate(InvalidationLevel::InvalidOutput);
+
+    using Kind = Instrumentation::Kind;
+    for (const auto& e : instrumentation.getEvents()) {
+        if (e.kind == Kind::Process && e.processor == "a") {
+            EXPECT_EQ(e.allocations.count, 3);
+            EXPECT_EQ(e.allocations.bytes, 300);
+        } else if (e.kind != Kind::Evaluation) {
+            EXPECT_EQ(e.allocations.count, 0) << e.processor;
+        }
+    }
+    for (const auto& s : instrumentation.summarize()) {
+        EXPECT_EQ(s.allocations.count, s.processor == "a" ? 6 : 0) << s.processor;
+        EXPECT_EQ(s.allocations.bytes, s.processor == "a" ? 600 : 0) << s.processor;
+    }
+
+    std::stringstream trace;
+    instrumentation.exportChromeTrace(trace);
+    EXPECT_NE(trace.str().find("\"allocatedBytes\":300"), std::string::npos);
+}
+
 }  // namespace inviwo
@@ -35,6 +35,10 @@
 #include <inviwo/core/io/serialization/serialization.h>
 #include <inviwo/core/util/filesystem.h>
 
+#include <cmath>
+
+#include <fmt/format.h>
+
 namespace inviwo {
 
 TEST(SerializationTest, initTest) {
@@ -382,4 +386,155 @@ TEST(SerializationTest, mat4Tests) {
     for (int i = 0; i < s; i++)
         for (int j = 0; j < s; j++) EXPECT_EQ(inMat[i][j], outMat[i][j]);
 }
+
+TEST(SerializationTest, manyKeysTest) {
+    auto refpath = filesystem::findBasePath();
+    std::stringstream ss;
+    Serializer serializer(refpath);
+    for (int i = 0; i < 100; ++i) {
+        serializer.serialize(fmt::format("key{}", i), i);
+    }
+    serializer.writeFile(ss);
+    Deserializer deserializer(ss, refpath);
+    // Look up in reverse order and repeatedly, with some keys that does not exist
+    for (int i = 99; i >= 0; --i) {
+        int value = -1;
+        deserializer.deserialize(fmt::format("key{}", i), value);
+        EXPECT_EQ(i, value);
+        deserializer.deserialize(fmt::format("key{}", i), value);
+        EXPECT_EQ(i, value);
+        int missing = -1;
+        deserializer.deserialize(fmt::format("key{}x", i), missing);
+        EXPECT_EQ(-1, missing);
+    }
+}
+
+TEST(SerializationTest, duplicateKeysTest) {
+    auto refpath = filesystem::findBasePath();
+    std::stringstream ss;
+    Serializer serializer(refpath);
+    serializer.serialize("b", 1);
+    serializer.serialize("a", 2);
+    serializer.serialize("b", 3);
+    serializer.writeFile(ss);
+    Deserializer deserializer(ss, refpath);
+    int a = 0;
+    int b = 0;
+    deserializer.deserialize("a", a);
+    deserializer.deserialize("b", b);
+    EXPECT_EQ(2, a);
+    EXPECT_EQ(1, b);
+}
+
+TEST(SerializationTest, infinityTest) {
+    EXPECT_EQ(std::numeric_limits<double>::infinity(),
+              serializationOfType(std::numeric_limits<double>::infinity()));
+    EXPECT_EQ(-std::numeric_limits<float>::infinity(),
+              serializationOfType(-std::numeric_limits<float>::infinity()));
+    EXPECT_TRUE(std::isnan(serializationOfType(std::numeric_limits<double>::quiet_NaN())));
+}
+
+template <typename T>
+T deserializeFromString(const std::string& value) {
+    auto refpath = filesystem::findBasePath();
+    std::stringstream ss;
+    Serializer serializer(refpath);
+    serializer.serialize("serializedValue", value);
+    serializer.writeFile(ss);
+    Deserializer deserializer(ss, refpath);
+    deserializer.setExceptionHandler([](ExceptionContext) { throw; });
+    T outValue{1};
+    deserializer.deserialize("serializedValue", outValue);
+    return outValue;
+}
+
+TEST(SerializationTest, specialValuesFromStringTest) {
+    EXPECT_EQ(std::numeric_limits<double>::infinity(), deserializeFromString<double>("inf"));
+    EXPECT_EQ(-std::numeric_limits<double>::infinity(), deserializeFromString<double>("-inf"));
+    EXPECT_EQ(std::numeric_limits<float>::infinity(), deserializeFromString<float>("inf"));
+    EXPECT_EQ(-std::numeric_limits<float>::infinity(), deserializeFromString<float>("-inf"));
+    EXPECT_TRUE(std::isnan(deserializeFromString<double>("nan")));
+    EXPECT_TRUE(std::isnan(deserializeFromString<float>("nan")));
+    EXPECT_TRUE(std::isnan(deserializeFromString<double>("-nan")));
+    EXPECT_TRUE(std::isnan(deserializeFromString<double>("-nan(ind)")));
+    EXPECT_EQ(2.5, deserializeFromString<double>("2.5"));
+    EXPECT_THROW(deserializeFromString<double>("abc"), SerializationException);
+}
+
+TEST(SerializationTest, binaryVectorTest) {
+    std::vector<float> inVector(5000), outVector;
+    for (size_t i = 0; i < inVector.size(); ++i) inVector[i] = 0.5f * static_cast<float>(i);
+
+    auto refpath = filesystem::findBasePath();
+    std::stringstream ss;
+    Serializer serializer(refpath);
+    serializer.serialize("serializedVector", inVector, "value");
+    serializer.writeFile(ss);
+    EXPECT_EQ(std::string::npos, ss.str().find("<value"));
+
+    Deserializer deserializer(ss, refpath);
+    deserializer.deserialize("serializedVector", outVector, "value");
+    EXPECT_EQ(inVector, outVector);
+}
+
+TEST(SerializationTest, binaryUncompressedVec3Test) {
+    const std::vector<vec3> inVector{{1.1f, 2.2f, 3.3f}, {4.4f, 5.5f, 6.6f}};
+    std::vector<vec3> outVector{vec3{7.0f}, vec3{8.0f}, vec3{9.0f}};
+
+    auto refpath = filesystem::findBasePath();
+    std::stringstream ss;
+    Serializer serializer(refpath);
+    serializer.serializeBinary("serializedVector", std::span<const vec3>{inVector}, false);
+    serializer.writeFile(ss);
+
+    Deserializer deserializer(ss, refpath);
+    deserializer.deserialize("serializedVector", outVector, "value");
+    EXPECT_EQ(inVector, outVector);
+}
+
+TEST(SerializationTest, binaryThresholdTest) {
+    std::vector<int> inVector(2000), outVector;
+    for (size_t i = 0; i < inVector.size(); ++i) inVector[i] = static_cast<int>(i) - 1000;
+
+    auto refpath = filesystem::findBasePath();
+    std::stringstream ss;
+    Serializer serializer(refpath);
+    serializer.setBinaryThreshold(std::numeric_limits<size_t>::max());
+    serializer.serialize("serializedVector", inVector, "value");
+    serializer.writeFile(ss);
+    EXPECT_NE(std::string::npos, ss.str().find("<value"));
+
+    Deserializer deserializer(ss, refpath);
+    deserializer.deserialize("serializedVector", outVector, "value");
+    EXPECT_EQ(inVector, outVector);
+}
+
+TEST(SerializationTest, binaryCountMismatchTest) {
+    const std::vector<int> inVector(2000, 42);
+
+    for (const bool compress : {false, true}) {
+        auto refpath = filesystem::findBasePath();
+        std::stringstream ss;
+        Serializer serializer(refpath);
+        serializer.serializeBinary("serializedVector", std::span<const int>{inVector}, compress);
+        serializer.writeFile(ss);
+
+        for (const auto* count : {"1999", "2001", "4611686018427387904", "18446744073709551615"}) {
+            auto xml = ss.str();
+            const auto pos = xml.find("count=\"2000\"");
+            ASSERT_NE(std::string::npos, pos);
+            xml.replace(pos, 12, fmt::format("count=\"{}\"", count));
+
+            std::stringstream tampered(xml);
+            Deserializer deserializer(tampered, refpath);
+            deserializer.setExceptionHandler([](ExceptionContext) { throw; });
+            std::vector<int> outVector{1, 2, 3};
+            EXPECT_THROW(deserializer.deserialize("serializedVector", outVector, "value"),
+                         SerializationException)
+                << "compress: " << compress << " count: " << count;
+            EXPECT_EQ((std::vector<int>{1, 2, 3}), outVector);
+        }
+    }
+}
+
 }  // namespace inviwo
@@ -0,0 +1,138 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/shuntingyard.h>
+#include <inviwo/core/util/exception.h>
+
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace inviwo {
+
+TEST(ShuntingYard, calculate) {
+    std::map<std::string, double> vars{{"a", 2.0}, {"b", 3.0}};
+    EXPECT_DOUBLE_EQ(8.0, shuntingyard::Calculator::calculate("a + 2 * b", vars));
+    EXPECT_DOUBLE_EQ(15.0, shuntingyard::Calculator::calculate("(a + b) * b", vars));
+    EXPECT_DOUBLE_EQ(8.0, shuntingyard::Calculator::calculate("a ^ b", vars));
+    EXPECT_DOUBLE_EQ(-1.0, shuntingyard::Calculator::calculate("-1", vars));
+}
+
+TEST(ShuntingYard, calculateRepeated) {
+    // Repeated calls reuse the compiled expression, changes to values and variables must still be
+    // picked up
+    std::map<std::string, double> vars{{"a", 2.0}, {"b", 3.0}};
+    EXPECT_DOUBLE_EQ(8.0, shuntingyard::Calculator::calculate("a + 2 * b", vars));
+    vars["a"] = 4.0;
+    EXPECT_DOUBLE_EQ(10.0, shuntingyard::Calculator::calculate("a + 2 * b", vars));
+    vars["c"] = 1.0;
+    EXPECT_DOUBLE_EQ(9.0, shuntingyard::Calculator::calculate("a + 2 * b - c", vars));
+    vars.erase("a");
+    EXPECT_THROW(shuntingyard::Calculator::calculate("a + 2 * b - c", vars), Exception);
+}
+
+TEST(ShuntingYard, expressionSingle) {
+    const shuntingyard::Expression expr{"a * 2 + b / c - 1", {"a", "b", "c"}};
+    EXPECT_EQ(3u, expr.stackDepth());
+    EXPECT_DOUBLE_EQ(2.0 * 2.0 + 9.0 / 3.0 - 1.0, expr.evaluate(std::array{2.0, 9.0, 3.0}));
+    EXPECT_DOUBLE_EQ(1.0 * 2.0 + 4.0 / 2.0 - 1.0, expr.evaluate(std::array{1.0, 4.0, 2.0}));
+}
+
+TEST(ShuntingYard, expressionSlots) {
+    const shuntingyard::Expression expr{"v2 * 2", {"v1", "v2", "v3"}};
+    EXPECT_EQ(1u, expr.slot("v2"));
+    EXPECT_FALSE(expr.slot("v4"));
+    EXPECT_FALSE(expr.uses(0));
+    EXPECT_TRUE(expr.uses(1));
+    EXPECT_FALSE(expr.uses(2));
+}
+
+TEST(ShuntingYard, expressionErrors) {
+    EXPECT_THROW(shuntingyard::Expression("a + b", {"a"}), Exception);
+    EXPECT_THROW(shuntingyard::Expression("a +", {"a"}), Exception);
+    EXPECT_THROW(shuntingyard::Expression("", {"a"}), Exception);
+}
+
+TEST(ShuntingYard, expressionBatch) {
+    // Use a size that is not a multiple of the block size to exercise the tail
+    const size_t size = 3 * shuntingyard::Expression::blockSize + 17;
+    std::vector<std::uint16_t> a(size);
+    std::vector<std::uint16_t> b(size);
+    std::iota(a.begin(), a.end(), std::uint16_t{0});
+    std::iota(b.rbegin(), b.rend(), std::uint16_t{0});
+
+    const shuntingyard::Expression expr{"(a + b) * 0.5 - a", {"a", "b"}};
+
+    std::vector<float> res(size);
+    const std::array<const std::uint16_t*, 2> inputs{a.data(), b.data()};
+    expr.evaluate<std::uint16_t, float>(inputs, res.data(), size);
+
+    for (size_t i = 0; i < size; ++i) {
+        EXPECT_FLOAT_EQ(static_cast<float>((a[i] + b[i]) * 0.5 - a[i]), res[i]);
+    }
+}
+
+TEST(ShuntingYard, expressionBatchNested) {
+    // Evaluating from within a load callback must not clobber the outer evaluation stack
+    const shuntingyard::Expression inner{"a * b + 1", {"a", "b"}};
+    const shuntingyard::Expression outer{"(a + b) * (a - b)", {"a", "b"}};
+
+    const size_t size = shuntingyard::Expression::blockSize + 5;
+    std::vector<double> res(size);
+    outer.evaluate(
+        size,
+        [&](size_t slot, size_t offset, size_t n, double* dest) {
+            for (size_t i = 0; i < n; ++i) {
+                const auto x = static_cast<double>(offset + i);
+                dest[i] = slot == 0 ? x : 0.0;
+            }
+            std::vector<double> tmp(n);
+            std::vector<double> ones(n, 1.0);
+            const std::array<const double*, 2> args{dest, ones.data()};
+            inner.evaluate<double, double>(args, tmp.data(), n);
+            std::copy(tmp.begin(), tmp.end(), dest);
+        },
+        [&](size_t offset, size_t n, const double* result) {
+            std::copy(result, result + n, res.begin() + offset);
+        });
+
+    for (size_t i = 0; i < size; ++i) {
+        const double a = static_cast<double>(i) + 1.0;
+        const double b = 1.0;
+        EXPECT_DOUBLE_EQ((a + b) * (a - b), res[i]);
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,194 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/snapshothistory.h>
+#include <inviwo/core/util/exception.h>
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace inviwo {
+
+namespace {
+
+std::vector<std::string> makeSnapshots(size_t count) {
+    std::vector<std::string> snapshots;
+    std::string state;
+    for (size_t i = 0; i < 50; ++i) {
+        state += fmt::format("<Processor id=\"p{}\" value=\"0\"/>\n", i);
+    }
+    snapshots.push_back(state);
+    for (size_t i = 1; i < count; ++i) {
+        // Alternate between changing a value, appending, and removing text
+        const auto pos = (i * 7919) % state.size();
+        switch (i % 3) {
+            case 0:
+                state.replace(pos, std::min<size_t>(3, state.size() - pos), fmt::format("{}", i));
+                break;
+            case 1:
+                state.insert(pos, fmt::format("<Link id=\"{}\"/>", i));
+                break;
+            default:
+                state.erase(pos, std::min<size_t>(5, state.size() - pos));
+                break;
+        }
+        snapshots.push_back(state);
+    }
+    return snapshots;
+}
+
+}  // namespace
+
+TEST(SnapshotHistory, UndoRedo) {
+    const auto snapshots = makeSnapshots(100);
+    SnapshotHistory history{8};
+    for (const auto& snapshot : snapshots) EXPECT_TRUE(history.push(snapshot));
+    EXPECT_FALSE(history.push(snapshots.back()));
+
+    ASSERT_EQ(snapshots.size(), history.size());
+    EXPECT_EQ(snapshots.back(), *history.current());
+    EXPECT_FALSE(history.canRedo());
+
+    for (size_t i = snapshots.size() - 1; i > 0; --i) {
+        ASSERT_TRUE(history.canUndo());
+        EXPECT_EQ(snapshots[i - 1], *history.undo());
+        EXPECT_EQ(i - 1, history.position());
+    }
+    EXPECT_FALSE(history.canUndo());
+
+    for (size_t i = 1; i < snapshots.size(); ++i) {
+        ASSERT_TRUE(history.canRedo());
+        EXPECT_EQ(snapshots[i], *history.redo());
+    }
+    EXPECT_FALSE(history.canRedo());
+}
+
+TEST(SnapshotHistory, Get) {
+    const auto snapshots = makeSnapshots(70);
+    SnapshotHistory history{16};
+    for (const auto& snapshot : snapshots) history.push(snapshot);
+    for (size_t i = 0; i < 30; ++i) history.undo();
+
+    for (size_t i = 0; i < snapshots.size(); ++i) {
+        EXPECT_EQ(snapshots[i], history.get(i)) << "index " << i;
+    }
+    EXPECT_THROW(history.get(snapshots.size()), RangeException);
+}
+
+TEST(SnapshotHistory, PushDiscardsRedo) {
+    const auto snapshots = makeSnapshots(10);
+    SnapshotHistory history{4};
+    for (const auto& snapshot : snapshots) history.push(snapshot);
+    history.undo();
+    history.undo();
+    history.undo();
+    EXPECT_TRUE(history.push("new state"));
+    EXPECT_EQ(8u, history.size());
+    EXPECT_FALSE(history.canRedo());
+    EXPECT_EQ(snapshots[6], *history.undo());
+    EXPECT_EQ("new state", *history.redo());
+
+    history.clear();
+    EXPECT_TRUE(history.empty());
+    EXPECT_FALSE(history.canUndo());
+    EXPECT_EQ(nullptr, history.current());
+}
+
+TEST(SnapshotHistory, MemoryScalesWithEdits) {
+    const std::string large(1 << 20, 'x');
+    SnapshotHistory history{1000};
+    history.push(large);
+    auto state = large;
+    for (size_t i = 0; i < 100; ++i) {
+        state[(i * 104729) % state.size()] = 'y';
+        history.push(state);
+    }
+    EXPECT_LT(history.memoryUsage(), 3 * large.size());
+}
+
+TEST(SnapshotHistory, DistantEdits) {
+    // A workspace like text where each push edits two processors far apart
+    std::string state;
+    for (size_t i = 0; i < 2000; ++i) {
+        state += fmt::format("<Property identifier=\"p{}\" value=\"0\"/>\n", i);
+    }
+    const auto replaceValue = [](std::string& text, size_t processor, size_t value) {
+        const auto key = fmt::format("\"p{}\" value=\"", processor);
+        const auto pos = text.find(key) + key.size();
+        text.replace(pos, text.find('"', pos) - pos, fmt::format("{}", value));
+    };
+
+    std::vector<std::string> snapshots{state};
+    SnapshotHistory history{1000};
+    history.push(state);
+    for (size_t i = 1; i <= 50; ++i) {
+        replaceValue(state, 3, i);
+        replaceValue(state, 1990, i * 2);
+        if (i % 10 == 0) state.insert(state.find("\"p1000\""), "<Link/>\n");
+        snapshots.push_back(state);
+        EXPECT_TRUE(history.push(state));
+    }
+
+    // The initial keyframe and the current state, plus the edited values for each push but not
+    // the text between the two processors
+    EXPECT_LT(history.memoryUsage(), snapshots.front().size() + state.size() + 50 * 500);
+
+    for (size_t i = snapshots.size() - 1; i > 0; --i) {
+        EXPECT_EQ(snapshots[i - 1], *history.undo());
+    }
+    for (size_t i = 1; i < snapshots.size(); ++i) {
+        EXPECT_EQ(snapshots[i], *history.redo());
+    }
+    for (size_t i = 0; i < snapshots.size(); ++i) {
+        EXPECT_EQ(snapshots[i], history.get(i));
+    }
+}
+
+TEST(SnapshotHistory, LineEdits) {
+    // Inserting, removing, and reordering lines all round trip
+    const std::vector<std::string> snapshots{
+        "a\nb\nc\nd\ne\n", "a\nx\nc\nd\ny\ne\n", "c\nd\ny\ne\na\nx\n", "c\nd", "", "z\n\n\nz",
+        "a\nb\nc\nd\ne\n"};
+    SnapshotHistory history{100};
+    for (const auto& snapshot : snapshots) history.push(snapshot);
+    for (size_t i = snapshots.size() - 1; i > 0; --i) {
+        EXPECT_EQ(snapshots[i - 1], *history.undo());
+    }
+    for (size_t i = 1; i < snapshots.size(); ++i) {
+        EXPECT_EQ(snapshots[i], *history.redo());
+    }
+}
+
+}  // namespace inviwo
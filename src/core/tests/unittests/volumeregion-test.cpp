@@ -0,0 +1,209 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/io/bytereaderutil.h>
+#include <inviwo/core/io/rawvolumeramloader.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/volumereorientation.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+constexpr size3_t dims{7, 5, 4};
+constexpr size_t header = 3;
+
+/// A raw file with a few header bytes followed by uint16 voxels holding their own index
+class VolumeRegionTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() {
+        std::vector<uint16_t> voxels(dims.x * dims.y * dims.z);
+        std::iota(voxels.begin(), voxels.end(), uint16_t{0});
+        std::ofstream out(file(), std::ios::out | std::ios::binary);
+        out.write("abc", header);
+        out.write(reinterpret_cast<const char*>(voxels.data()), voxels.size() * sizeof(uint16_t));
+    }
+    static void TearDownTestSuite() { std::filesystem::remove(file()); }
+
+    static std::filesystem::path file() {
+        return std::filesystem::temp_directory_path() / "inviwo-volumeregion-test.raw";
+    }
+
+    /// The voxel indices of a region, in the order they should be read
+    static std::vector<uint16_t> expected(size3_t offset, size3_t extent) {
+        std::vector<uint16_t> result;
+        for (size_t z = offset.z; z < offset.z + extent.z; ++z) {
+            for (size_t y = offset.y; y < offset.y + extent.y; ++y) {
+                for (size_t x = offset.x; x < offset.x + extent.x; ++x) {
+                    result.push_back(static_cast<uint16_t>((z * dims.y + y) * dims.x + x));
+                }
+            }
+        }
+        return result;
+    }
+
+    static std::vector<uint16_t> read(size3_t offset, size3_t extent, bool littleEndian = true) {
+        std::vector<uint16_t> result(extent.x * extent.y * extent.z);
+        util::readRegionIntoBuffer(file(), header, dims, offset, extent, littleEndian,
+                                   sizeof(uint16_t), result.data());
+        return result;
+    }
+
+    static std::shared_ptr<VolumeDisk> disk(const util::VolumeReorientation& reorientation = {}) {
+        auto vd = std::make_shared<VolumeDisk>(file(), reorientation.reorientedDimensions(dims),
+                                               DataUInt16::get());
+        vd->setLoader(new RawVolumeRAMLoader(file(), header, true, reorientation));
+        return vd;
+    }
+};
+
+}  // namespace
+
+TEST_F(VolumeRegionTest, readWholeVolume) {
+    EXPECT_EQ(expected(size3_t{0}, dims), read(size3_t{0}, dims));
+}
+
+TEST_F(VolumeRegionTest, readWholeSlices) {
+    // Merged into a single read
+    EXPECT_EQ(expected({0, 0, 1}, {7, 5, 2}), read({0, 0, 1}, {7, 5, 2}));
+}
+
+TEST_F(VolumeRegionTest, readWholeRows) {
+    // One read per slice
+    EXPECT_EQ(expected({0, 1, 1}, {7, 3, 3}), read({0, 1, 1}, {7, 3, 3}));
+    EXPECT_EQ(expected({0, 4, 0}, {7, 1, 4}), read({0, 4, 0}, {7, 1, 4}));
+}
+
+TEST_F(VolumeRegionTest, readPartialRows) {
+    EXPECT_EQ(expected({2, 1, 1}, {3, 2, 2}), read({2, 1, 1}, {3, 2, 2}));
+    EXPECT_EQ(expected({6, 4, 3}, {1, 1, 1}), read({6, 4, 3}, {1, 1, 1}));
+    EXPECT_EQ(expected({1, 0, 0}, {6, 5, 4}), read({1, 0, 0}, {6, 5, 4}));
+}
+
+TEST_F(VolumeRegionTest, readSliceAlongX) {
+    for (size_t x = 0; x < dims.x; ++x) {
+        EXPECT_EQ(expected({x, 0, 0}, {1, 5, 4}), read({x, 0, 0}, {1, 5, 4})) << "x = " << x;
+    }
+}
+
+TEST_F(VolumeRegionTest, readEmptyRegion) {
+    EXPECT_TRUE(read({2, 2, 2}, {0, 3, 1}).empty());
+}
+
+TEST_F(VolumeRegionTest, readBigEndian) {
+    auto region = read({2, 1, 1}, {3, 2, 2}, false);
+    for (auto& value : region) value = static_cast<uint16_t>((value << 8) | (value >> 8));
+    EXPECT_EQ(expected({2, 1, 1}, {3, 2, 2}), region);
+}
+
+TEST_F(VolumeRegionTest, readOutsideOfFileThrows) {
+    const size3_t larger{dims.x, dims.y, dims.z + 1};
+    std::vector<uint16_t> result(dims.x * dims.y);
+    EXPECT_THROW(util::readRegionIntoBuffer(file(), header, larger, {0, 0, dims.z},
+                                            {dims.x, dims.y, 1}, true, sizeof(uint16_t),
+                                            result.data()),
+                 Exception);
+}
+
+TEST_F(VolumeRegionTest, volumeDiskReadRegion) {
+    const auto vd = disk();
+    ASSERT_TRUE(vd->canReadRegion());
+
+    const size3_t offset{1, 2, 1};
+    const size3_t extent{4, 3, 2};
+    const auto ram = vd->readRegion(offset, extent);
+    ASSERT_EQ(extent, ram->getDimensions());
+    EXPECT_EQ(DataUInt16::get(), ram->getDataFormat());
+
+    const auto* data = static_cast<const uint16_t*>(ram->getData());
+    EXPECT_EQ(expected(offset, extent),
+              std::vector<uint16_t>(data, data + extent.x * extent.y * extent.z));
+
+    // Axes that are cut are clamped
+    const auto wrapping = ram->getWrapping();
+    for (size_t i = 0; i < 3; ++i) EXPECT_EQ(Wrapping::Clamp, wrapping[i]);
+}
+
+TEST_F(VolumeRegionTest, volumeDiskReadRegionKeepsWrappingOfWholeAxes) {
+    auto vd = disk();
+    vd->setWrapping({Wrapping::Repeat, Wrapping::Repeat, Wrapping::Repeat});
+    const auto ram = vd->readRegion({3, 0, 0}, {1, dims.y, dims.z});
+    const auto wrapping = ram->getWrapping();
+    EXPECT_EQ(Wrapping::Clamp, wrapping[0]);
+    EXPECT_EQ(Wrapping::Repeat, wrapping[1]);
+    EXPECT_EQ(Wrapping::Repeat, wrapping[2]);
+}
+
+TEST_F(VolumeRegionTest, volumeDiskReadRegionMatchesReorientedVolume) {
+    const util::VolumeReorientation reorientation{{2, 0, 1}, {true, false, true}};
+    const auto vd = disk(reorientation);
+    const auto rdims = vd->getDimensions();
+
+    // Reference: the whole volume, reoriented in memory
+    auto whole = expected(size3_t{0}, dims);
+    util::reorientVolume(whole.data(), sizeof(uint16_t), dims, reorientation);
+
+    const size3_t offset{1, 2, 1};
+    const size3_t extent{2, 3, 4};
+    const auto ram = vd->readRegion(offset, extent);
+    ASSERT_EQ(extent, ram->getDimensions());
+    const auto* data = static_cast<const uint16_t*>(ram->getData());
+    for (size_t z = 0; z < extent.z; ++z) {
+        for (size_t y = 0; y < extent.y; ++y) {
+            for (size_t x = 0; x < extent.x; ++x) {
+                const auto from =
+                    ((offset.z + z) * rdims.y + offset.y + y) * rdims.x + offset.x + x;
+                const auto to = (z * extent.y + y) * extent.x + x;
+                EXPECT_EQ(whole[from], data[to]) << x << ", " << y << ", " << z;
+            }
+        }
+    }
+}
+
+TEST_F(VolumeRegionTest, volumeDiskReadRegionOutsideThrows) {
+    const auto vd = disk();
+    EXPECT_THROW(vd->readRegion({1, 0, 0}, dims), Exception);
+    EXPECT_THROW(vd->readRegion({0, 0, 4}, {1, 1, 1}), Exception);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,151 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/volumereorientation.h>
+#include <inviwo/core/util/exception.h>
+
+#include <array>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+// Straightforward per-voxel reference implementation
+std::vector<unsigned char> reference(const std::vector<unsigned char>& src, size_t elementSize,
+                                     size3_t dims, const util::VolumeReorientation& r) {
+    const auto rdims = r.reorientedDimensions(dims);
+    std::vector<unsigned char> dst(src.size());
+    size3_t p{0};
+    for (p.z = 0; p.z < rdims.z; ++p.z) {
+        for (p.y = 0; p.y < rdims.y; ++p.y) {
+            for (p.x = 0; p.x < rdims.x; ++p.x) {
+                size3_t q{0};
+                for (size_t i = 0; i < 3; ++i) {
+                    q[r.permutation[i]] = r.flip[i] ? rdims[i] - 1 - p[i] : p[i];
+                }
+                const auto to = (p.z * rdims.y + p.y) * rdims.x + p.x;
+                const auto from = (q.z * dims.y + q.y) * dims.x + q.x;
+                std::memcpy(&dst[to * elementSize], &src[from * elementSize], elementSize);
+            }
+        }
+    }
+    return dst;
+}
+
+}  // namespace
+
+TEST(VolumeReorientation, Dimensions) {
+    const util::VolumeReorientation r{{2, 0, 1}, {false, true, false}};
+    EXPECT_EQ(size3_t(4, 2, 3), r.reorientedDimensions(size3_t(2, 3, 4)));
+    EXPECT_EQ(size3_t(2, 3, 4), r.sourceDimensions(size3_t(4, 2, 3)));
+    EXPECT_FALSE(r.isFlipOnly());
+    EXPECT_FALSE(r.isIdentity());
+    EXPECT_TRUE(util::VolumeReorientation{}.isIdentity());
+}
+
+TEST(VolumeReorientation, InvalidPermutation) {
+    std::vector<unsigned char> data(8);
+    const util::VolumeReorientation r{{0, 0, 1}, {false, false, false}};
+    EXPECT_THROW(util::reorientVolume(data.data(), 1, size3_t(2, 2, 2), r), Exception);
+}
+
+TEST(VolumeReorientation, AllOrientations) {
+    const std::array<std::array<size_t, 3>, 6> permutations{
+        {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}}};
+
+    for (const size_t elementSize : {1, 3, 4, 5, 16}) {
+        for (const auto dims : {size3_t(1, 1, 1), size3_t(5, 4, 3), size3_t(4, 5, 6)}) {
+            std::vector<unsigned char> src(dims.x * dims.y * dims.z * elementSize);
+            std::iota(src.begin(), src.end(), static_cast<unsigned char>(0));
+
+            for (const auto& permutation : permutations) {
+                for (int flips = 0; flips < 8; ++flips) {
+                    const util::VolumeReorientation r{
+                        permutation, {(flips & 1) != 0, (flips & 2) != 0, (flips & 4) != 0}};
+                    const auto expected = reference(src, elementSize, dims, r);
+
+                    std::vector<unsigned char> copy(src.size());
+                    EXPECT_EQ(r.reorientedDimensions(dims),
+                              util::reorientVolume(src.data(), copy.data(), elementSize, dims, r));
+                    EXPECT_EQ(expected, copy);
+
+                    auto inPlace = src;
+                    EXPECT_EQ(r.reorientedDimensions(dims),
+                              util::reorientVolume(inPlace.data(), elementSize, dims, r));
+                    EXPECT_EQ(expected, inPlace);
+                }
+            }
+        }
+    }
+}
+
+TEST(VolumeReorientation, SourceRegion) {
+    const size3_t dims{5, 4, 3};
+    std::vector<unsigned char> src(dims.x * dims.y * dims.z);
+    std::iota(src.begin(), src.end(), static_cast<unsigned char>(0));
+
+    const util::VolumeReorientation r{{2, 0, 1}, {true, false, true}};
+    const auto rdims = r.reorientedDimensions(dims);
+    std::vector<unsigned char> full(src.size());
+    util::reorientVolume(src.data(), full.data(), 1, dims, r);
+
+    const size3_t offset{1, 2, 1};
+    const size3_t extent{2, 2, 3};
+    const auto [srcOffset, srcExtent] = r.sourceRegion(rdims, offset, extent);
+
+    std::vector<unsigned char> region;
+    for (size_t z = 0; z < srcExtent.z; ++z) {
+        for (size_t y = 0; y < srcExtent.y; ++y) {
+            for (size_t x = 0; x < srcExtent.x; ++x) {
+                region.push_back(
+                    src[((srcOffset.z + z) * dims.y + srcOffset.y + y) * dims.x + srcOffset.x + x]);
+            }
+        }
+    }
+    EXPECT_EQ(extent, util::reorientVolume(region.data(), 1, srcExtent, r));
+
+    size_t i = 0;
+    for (size_t z = 0; z < extent.z; ++z) {
+        for (size_t y = 0; y < extent.y; ++y) {
+            for (size_t x = 0; x < extent.x; ++x) {
+                EXPECT_EQ(full[((offset.z + z) * rdims.y + offset.y + y) * rdims.x + offset.x + x],
+                          region[i++]);
+            }
+        }
+    }
+}
+
+}  // namespace inviwo
@@ -190,6 +190,10 @@ int CommandLineParser::getARGC() const { return argc_; }
 
 char** CommandLineParser::getARGV() const { return argv_; }
 
+void CommandLineParser::setExitCode(int code) { exitCode_ = code; }
+
+int CommandLineParser::getExitCode() const { return exitCode_; }
+
 void CommandLineParser::processCallbacks() {
     std::sort(
         callbacks_.begin(), callbacks_.end(),
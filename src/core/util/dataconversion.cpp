@@ -0,0 +1,110 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/dataconversion.h>
+
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/formats.h>
+
+namespace inviwo {
+
+namespace {
+
+enum class Mode { Cast, Normalized, Mapped };
+
+// Both formats have the same number of components, so we only need to dispatch on the scalar
+// component types and convert size * components values.
+template <typename Src>
+struct ConvertTo {
+    template <typename Result, typename DstFormat>
+    void operator()(const Src* src, void* dst, size_t size, Mode mode, dvec2 srcRange,
+                    dvec2 dstRange) {
+        auto* dstData = static_cast<typename DstFormat::type*>(dst);
+        switch (mode) {
+            case Mode::Cast:
+                util::convertData(src, dstData, size);
+                break;
+            case Mode::Normalized:
+                util::convertDataNormalized(src, dstData, size);
+                break;
+            case Mode::Mapped:
+                util::convertDataMapped(src, dstData, size, srcRange, dstRange);
+                break;
+        }
+    }
+};
+
+struct ConvertFrom {
+    template <typename Result, typename SrcFormat>
+    void operator()(const void* src, DataFormatId dstId, void* dst, size_t size, Mode mode,
+                    dvec2 srcRange, dvec2 dstRange) {
+        using Src = typename SrcFormat::type;
+        dispatching::dispatch<void, dispatching::filter::Scalars>(
+            dstId, ConvertTo<Src>{}, static_cast<const Src*>(src), dst, size, mode, srcRange,
+            dstRange);
+    }
+};
+
+DataFormatId componentFormat(const DataFormatBase* format) {
+    return DataFormatBase::get(format->getNumericType(), 1, format->getPrecision())->getId();
+}
+
+void convert(const void* src, const DataFormatBase* srcFormat, void* dst,
+             const DataFormatBase* dstFormat, size_t size, Mode mode, dvec2 srcRange = {},
+             dvec2 dstRange = {}) {
+    if (srcFormat->getComponents() != dstFormat->getComponents()) {
+        throw Exception(IVW_CONTEXT_CUSTOM("util::convertData"),
+                        "Unable to convert from {} to {}, the number of components differ",
+                        srcFormat->getString(), dstFormat->getString());
+    }
+    dispatching::dispatch<void, dispatching::filter::Scalars>(
+        componentFormat(srcFormat), ConvertFrom{}, src, componentFormat(dstFormat), dst,
+        size * srcFormat->getComponents(), mode, srcRange, dstRange);
+}
+
+}  // namespace
+
+void util::convertData(const void* src, const DataFormatBase* srcFormat, void* dst,
+                       const DataFormatBase* dstFormat, size_t size) {
+    convert(src, srcFormat, dst, dstFormat, size, Mode::Cast);
+}
+
+void util::convertDataNormalized(const void* src, const DataFormatBase* srcFormat, void* dst,
+                                 const DataFormatBase* dstFormat, size_t size) {
+    convert(src, srcFormat, dst, dstFormat, size, Mode::Normalized);
+}
+
+void util::convertDataMapped(const void* src, const DataFormatBase* srcFormat, void* dst,
+                             const DataFormatBase* dstFormat, size_t size, dvec2 srcRange,
+                             dvec2 dstRange) {
+    convert(src, srcFormat, dst, dstFormat, size, Mode::Mapped, srcRange, dstRange);
+}
+
+}  // namespace inviwo
@@ -157,58 +157,30 @@ TokenQueue Calculator::toRPN(std::string expression, std::map<std::string, int>
 }
 
 double Calculator::calculate(std::string expression, std::map<std::string, double>& vars) {
-    // 1. Create the operator precedence map.
-    auto opPrecedence = getOpeatorPrecedence();
+    // Keep the last compiled expression per thread, calculate is typically called repeatedly with
+    // the same expression and variables and only differing values.
+    thread_local std::optional<Expression> cached;
+    thread_local std::vector<double> values;
 
-    // 2. Convert to RPN with Dijkstra's Shunting-yard algorithm.
-    TokenQueue rpn = toRPN(expression, opPrecedence);
+    const auto sameVariables = [&](const Expression& expr) {
+        return expr.variables().size() == vars.size() &&
+               std::equal(vars.begin(), vars.end(), expr.variables().begin(),
+                          [](const auto& var, const std::string& name) {
+                              return var.first == name;
+                          });
+    };
 
-    // 3. Evaluate the expression in RPN form.
-    std::stack<double> evaluation;
-    while (!rpn.empty()) {
-        std::unique_ptr<TokenBase> base{std::move(rpn.front())};
-        rpn.pop();
-
-        Token<std::string>* strTok = dynamic_cast<Token<std::string>*>(base.get());
-        Token<double>* doubleTok = dynamic_cast<Token<double>*>(base.get());
-        if (strTok) {
-            std::string str = strTok->val;
-            auto it = vars.find(str);
-            if (it != vars.end()) {
-                evaluation.push(it->second);
-            } else if (evaluation.size() < 2) {
-                throw Exception("Invalid equation",
-                                IVW_CONTEXT_CUSTOM("shuntingyard::Calculator::calculate"));
-            } else {
-                double right = evaluation.top();
-                evaluation.pop();
-                double left = evaluation.top();
-                evaluation.pop();
-                if (!str.compare("+")) {
-                    evaluation.push(left + right);
-                } else if (!str.compare("*")) {
-                    evaluation.push(left * right);
-                } else if (!str.compare("-")) {
-                    evaluation.push(left - right);
-                } else if (!str.compare("/")) {
-                    evaluation.push(left / right);
-                } else if (!str.compare("^")) {
-                    evaluation.push(pow(left, right));
-
-                } else {
-                    throw Exception("Unknown operator: '" + str + "'",
-                                    IVW_CONTEXT_CUSTOM("shuntingyard::Calculator::calculate"));
-                }
-            }
-        } else if (doubleTok) {
-            evaluation.push(doubleTok->val);
-        } else {
-            throw Exception("Invalid token",
-                            IVW_CONTEXT_CUSTOM("shuntingyard::Calculator::calculate"));
-        }
+    if (!cached || cached->expression() != expression || !sameVariables(*cached)) {
+        std::vector<std::string> names;
+        names.reserve(vars.size());
+        for (const auto& item : vars) names.push_back(item.first);
+        cached.reset();
+        cached.emplace(expression, std::move(names));
     }
 
-    return evaluation.top();
+    values.clear();
+    for (const auto& item : vars) values.push_back(item.second);
+    return cached->evaluate(values);
 }
 
 std::string Calculator::shaderCode(std::string expression, std::map<std::string, double>& vars,
@@ -269,6 +241,113 @@ std::string Calculator::shaderCode(std::string expression, std::map<std::string,
     return evaluation.top();
 }
 
+Expression::Expression(std::string_view expression, std::vector<std::string> variables)
+    : expression_{expression}, variables_{std::move(variables)}, stackDepth_{0} {
+
+    TokenQueue rpn = Calculator::toRPN(expression_, Calculator::getOpeatorPrecedence());
+
+    size_t depth = 0;
+    while (!rpn.empty()) {
+        std::unique_ptr<TokenBase> base{std::move(rpn.front())};
+        rpn.pop();
+
+        if (auto* doubleTok = dynamic_cast<Token<double>*>(base.get())) {
+            instructions_.push_back(
+                {OpCode::Constant, static_cast<std::uint32_t>(constants_.size())});
+            constants_.push_back(doubleTok->val);
+            ++depth;
+        } else if (auto* strTok = dynamic_cast<Token<std::string>*>(base.get())) {
+            const auto& str = strTok->val;
+            if (str.size() == 1 && std::string_view{"+-*/^"}.find(str[0]) != std::string::npos) {
+                if (depth < 2) {
+                    throw Exception(IVW_CONTEXT_CUSTOM("shuntingyard::Expression"),
+                                    "Invalid equation: '{}'", expression_);
+                }
+                static constexpr std::array<OpCode, 5> ops{OpCode::Add, OpCode::Sub, OpCode::Mul,
+                                                           OpCode::Div, OpCode::Pow};
+                instructions_.push_back({ops[std::string_view{"+-*/^"}.find(str[0])], 0});
+                --depth;
+            } else if (auto it = std::find(variables_.begin(), variables_.end(), str);
+                       it != variables_.end()) {
+                instructions_.push_back(
+                    {OpCode::Variable,
+                     static_cast<std::uint32_t>(std::distance(variables_.begin(), it))});
+                ++depth;
+            } else if (Calculator::isvariablechar(str[0])) {
+                throw Exception(IVW_CONTEXT_CUSTOM("shuntingyard::Expression"),
+                                "Unknown variable '{}' in equation: '{}'", str, expression_);
+            } else {
+                throw Exception(IVW_CONTEXT_CUSTOM("shuntingyard::Expression"),
+                                "Unknown operator: '{}'", str);
+            }
+        } else {
+            throw Exception("Invalid token", IVW_CONTEXT_CUSTOM("shuntingyard::Expression"));
+        }
+        stackDepth_ = std::max(stackDepth_, depth);
+    }
+    if (depth != 1) {
+        throw Exception(IVW_CONTEXT_CUSTOM("shuntingyard::Expression"), "Invalid equation: '{}'",
+                        expression_);
+    }
+}
+
+std::optional<size_t> Expression::slot(std::string_view name) const {
+    auto it = std::find(variables_.begin(), variables_.end(), name);
+    if (it == variables_.end()) return std::nullopt;
+    return static_cast<size_t>(std::distance(variables_.begin(), it));
+}
+
+bool Expression::uses(size_t slot) const {
+    return std::any_of(instructions_.begin(), instructions_.end(), [&](const Instruction& inst) {
+        return inst.op == OpCode::Variable && inst.index == slot;
+    });
+}
+
+double Expression::evaluate(std::span<const double> values) const {
+    // Scalar path, expressions rarely need more than a handful of stack levels so only fall back to
+    // a heap allocation for very deep ones.
+    std::array<double, 32> fixed;
+    std::vector<double> dynamic;
+    double* stack = fixed.data();
+    if (stackDepth_ > fixed.size()) {
+        dynamic.resize(stackDepth_);
+        stack = dynamic.data();
+    }
+
+    size_t top = 0;
+    for (const auto& inst : instructions_) {
+        switch (inst.op) {
+            case OpCode::Constant:
+                stack[top++] = constants_[inst.index];
+                break;
+            case OpCode::Variable:
+                stack[top++] = values[inst.index];
+                break;
+            case OpCode::Add:
+                --top;
+                stack[top - 1] += stack[top];
+                break;
+            case OpCode::Sub:
+                --top;
+                stack[top - 1] -= stack[top];
+                break;
+            case OpCode::Mul:
+                --top;
+                stack[top - 1] *= stack[top];
+                break;
+            case OpCode::Div:
+                --top;
+                stack[top - 1] /= stack[top];
+                break;
+            case OpCode::Pow:
+                --top;
+                stack[top - 1] = std::pow(stack[top - 1], stack[top]);
+                break;
+        }
+    }
+    return stack[0];
+}
+
 }  // namespace shuntingyard
 
 }  // namespace inviwo
@@ -0,0 +1,340 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <inviwo/core/util/snapshothistory.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
+namespace inviwo {
+
+namespace {
+
+/// The largest edit distance, in lines, searched for before treating the rest as one hunk
+constexpr std::ptrdiff_t maxEditDistance = 1000;
+
+struct LineRange {
+    size_t prevBegin;
+    size_t prevEnd;
+    size_t nextBegin;
+    size_t nextEnd;
+};
+
+std::vector<std::string_view> splitLines(std::string_view text) {
+    std::vector<std::string_view> lines;
+    while (!text.empty()) {
+        const auto end = std::min(text.find('\n'), text.size() - 1) + 1;
+        lines.push_back(text.substr(0, end));
+        text.remove_prefix(end);
+    }
+    return lines;
+}
+
+/**
+ * Myers' O(ND) difference algorithm on lines given as ids. Returns the ranges of lines that
+ * differ, or a single range covering everything if the edit distance exceeds maxEditDistance.
+ */
+std::vector<LineRange> diffLines(const std::vector<std::uint32_t>& a,
+                                 const std::vector<std::uint32_t>& b) {
+    const auto n = static_cast<std::ptrdiff_t>(a.size());
+    const auto m = static_cast<std::ptrdiff_t>(b.size());
+    const auto maxD = std::min(n + m, maxEditDistance);
+
+    // v[k] is the furthest x reached on diagonal k = x - y, trace[d] holds v[-d..d] before step d
+    std::vector<std::ptrdiff_t> v(2 * maxD + 3, 0);
+    const auto v0 = maxD + 1;
+    std::vector<std::vector<std::ptrdiff_t>> trace;
+
+    std::ptrdiff_t found = -1;
+    for (std::ptrdiff_t d = 0; d <= maxD && found < 0; ++d) {
+        trace.emplace_back(v.begin() + v0 - d, v.begin() + v0 + d + 1);
+        for (auto k = -d; k <= d; k += 2) {
+            auto x = (k == -d || (k != d && v[v0 + k - 1] < v[v0 + k + 1])) ? v[v0 + k + 1]
+                                                                             : v[v0 + k - 1] + 1;
+            auto y = x - k;
+            while (x < n && y < m && a[x] == b[y]) {
+                ++x;
+                ++y;
+            }
+            v[v0 + k] = x;
+            if (x >= n && y >= m) {
+                found = d;
+                break;
+            }
+        }
+    }
+    if (found < 0) {
+        return {{0, a.size(), 0, b.size()}};
+    }
+
+    // Walk the trace backwards collecting the matching runs (snakes), last run first
+    struct Run {
+        std::ptrdiff_t x;
+        std::ptrdiff_t y;
+        std::ptrdiff_t size;
+    };
+    std::vector<Run> runs;
+    auto x = n;
+    auto y = m;
+    for (auto d = found; d >= 0; --d) {
+        const auto& tv = trace[d];
+        const auto at = [&](std::ptrdiff_t k) { return tv[k + d]; };
+        const auto k = x - y;
+        const auto prevK = (k == -d || (k != d && at(k - 1) < at(k + 1))) ? k + 1 : k - 1;
+        const auto prevX = d == 0 ? 0 : at(prevK);
+        const auto prevY = d == 0 ? 0 : prevX - prevK;
+        const auto startX = d == 0 ? 0 : (prevK == k + 1 ? prevX : prevX + 1);
+        if (x > startX) runs.push_back({startX, y - (x - startX), x - startX});
+        x = prevX;
+        y = prevY;
+    }
+
+    std::vector<LineRange> ranges;
+    std::ptrdiff_t px = 0;
+    std::ptrdiff_t py = 0;
+    for (auto it = runs.rbegin(); it != runs.rend(); ++it) {
+        if (it->x > px || it->y > py) {
+            ranges.push_back({static_cast<size_t>(px), static_cast<size_t>(it->x),
+                              static_cast<size_t>(py), static_cast<size_t>(it->y)});
+        }
+        px = it->x + it->size;
+        py = it->y + it->size;
+    }
+    if (px < n || py < m) {
+        ranges.push_back({static_cast<size_t>(px), a.size(), static_cast<size_t>(py), b.size()});
+    }
+    return ranges;
+}
+
+}  // namespace
+
+SnapshotHistory::SnapshotHistory(size_t keyframeInterval)
+    : keyframeInterval_{std::max(keyframeInterval, size_t{1})}
+    , position_{0}
+    , entries_{}
+    , current_{} {}
+
+bool SnapshotHistory::push(std::string snapshot) {
+    if (current_ && *current_ == snapshot) return false;
+
+    if (!entries_.empty()) entries_.erase(entries_.begin() + position_ + 1, entries_.end());
+
+    Entry entry;
+    if (current_) entry.hunks = diff(*current_, snapshot);
+
+    current_ = std::make_shared<const std::string>(std::move(snapshot));
+    if (entries_.size() % keyframeInterval_ == 0) entry.keyframe = current_;
+    entries_.push_back(std::move(entry));
+    position_ = entries_.size() - 1;
+
+    return true;
+}
+
+bool SnapshotHistory::canUndo() const { return !entries_.empty() && position_ > 0; }
+
+bool SnapshotHistory::canRedo() const {
+    return !entries_.empty() && position_ + 1 < entries_.size();
+}
+
+std::shared_ptr<const std::string> SnapshotHistory::undo() {
+    const auto& entry = entries_[position_];
+    --position_;
+    if (const auto& keyframe = entries_[position_].keyframe) {
+        current_ = keyframe;
+    } else {
+        auto state = *current_;
+        backward(state, entry);
+        current_ = std::make_shared<const std::string>(std::move(state));
+    }
+    return current_;
+}
+
+std::shared_ptr<const std::string> SnapshotHistory::redo() {
+    ++position_;
+    const auto& entry = entries_[position_];
+    if (entry.keyframe) {
+        current_ = entry.keyframe;
+    } else {
+        auto state = *current_;
+        forward(state, entry);
+        current_ = std::make_shared<const std::string>(std::move(state));
+    }
+    return current_;
+}
+
+const std::shared_ptr<const std::string>& SnapshotHistory::current() const { return current_; }
+
+std::string SnapshotHistory::get(size_t index) const {
+    if (index >= entries_.size()) {
+        throw RangeException(IVW_CONTEXT, "Snapshot index {} out of range, history has {} entries",
+                             index, entries_.size());
+    }
+
+    // Walk forward from the closest preceding keyframe, or from the current state if closer
+    const auto keyframe = index - index % keyframeInterval_;
+    if (index >= position_ && index - position_ <= index - keyframe) {
+        auto state = *current_;
+        for (auto i = position_ + 1; i <= index; ++i) forward(state, entries_[i]);
+        return state;
+    } else if (index < position_ && position_ - index < index - keyframe) {
+        auto state = *current_;
+        for (auto i = position_; i > index; --i) backward(state, entries_[i]);
+        return state;
+    } else {
+        auto state = *entries_[keyframe].keyframe;
+        for (auto i = keyframe + 1; i <= index; ++i) forward(state, entries_[i]);
+        return state;
+    }
+}
+
+size_t SnapshotHistory::size() const { return entries_.size(); }
+
+bool SnapshotHistory::empty() const { return entries_.empty(); }
+
+size_t SnapshotHistory::position() const { return position_; }
+
+size_t SnapshotHistory::memoryUsage() const {
+    size_t bytes = current_ ? current_->size() : 0;
+    for (const auto& entry : entries_) {
+        bytes += sizeof(Entry);
+        for (const auto& hunk : entry.hunks) {
+            bytes += sizeof(Hunk) + hunk.removed.size() + hunk.inserted.size();
+        }
+        if (entry.keyframe && entry.keyframe != current_) bytes += entry.keyframe->size();
+    }
+    return bytes;
+}
+
+void SnapshotHistory::clear() {
+    position_ = 0;
+    entries_.clear();
+    current_.reset();
+}
+
+auto SnapshotHistory::diff(std::string_view prev, std::string_view next) -> std::vector<Hunk> {
+    // Skip the common prefix and suffix, usually most of the text, before splitting into lines.
+    // Both are extended to whole lines so that the line diff sees complete lines.
+    auto prefix = static_cast<size_t>(
+        std::mismatch(prev.begin(), prev.end(), next.begin(), next.end()).first - prev.begin());
+    if (prefix > 0) {
+        const auto newline = prev.rfind('\n', prefix - 1);
+        prefix = newline == std::string_view::npos ? 0 : newline + 1;
+    }
+
+    const auto maxSuffix = std::min(prev.size(), next.size()) - prefix;
+    auto suffix = static_cast<size_t>(
+        std::mismatch(prev.rbegin(), prev.rbegin() + maxSuffix, next.rbegin()).first -
+        prev.rbegin());
+    if (suffix > 0 && suffix < prev.size() - prefix) {
+        const auto newline = prev.find('\n', prev.size() - suffix);
+        suffix = newline == std::string_view::npos ? 0 : prev.size() - newline - 1;
+    }
+
+    const auto prevLines = splitLines(prev.substr(prefix, prev.size() - prefix - suffix));
+    const auto nextLines = splitLines(next.substr(prefix, next.size() - prefix - suffix));
+
+    std::unordered_map<std::string_view, std::uint32_t> ids;
+    const auto toIds = [&](const std::vector<std::string_view>& lines) {
+        std::vector<std::uint32_t> res;
+        res.reserve(lines.size());
+        for (auto line : lines) {
+            res.push_back(ids.try_emplace(line, static_cast<std::uint32_t>(ids.size()))
+                              .first->second);
+        }
+        return res;
+    };
+    const auto a = toIds(prevLines);
+    const auto b = toIds(nextLines);
+
+    const auto lineOffsets = [&](const std::vector<std::string_view>& lines) {
+        std::vector<size_t> offsets(lines.size() + 1, prefix);
+        for (size_t i = 0; i < lines.size(); ++i) offsets[i + 1] = offsets[i] + lines[i].size();
+        return offsets;
+    };
+    const auto prevOffsets = lineOffsets(prevLines);
+    const auto nextOffsets = lineOffsets(nextLines);
+
+    std::vector<Hunk> hunks;
+    for (const auto& range : diffLines(a, b)) {
+        auto removed = prev.substr(prevOffsets[range.prevBegin],
+                                   prevOffsets[range.prevEnd] - prevOffsets[range.prevBegin]);
+        auto inserted = next.substr(nextOffsets[range.nextBegin],
+                                    nextOffsets[range.nextEnd] - nextOffsets[range.nextBegin]);
+        auto offset = prevOffsets[range.prevBegin];
+
+        // Trim the hunk to the characters that differ, a changed value only stores the value
+        const auto head = static_cast<size_t>(
+            std::mismatch(removed.begin(), removed.end(), inserted.begin(), inserted.end()).first -
+            removed.begin());
+        removed.remove_prefix(head);
+        inserted.remove_prefix(head);
+        offset += head;
+        const auto tail = static_cast<size_t>(
+            std::mismatch(removed.rbegin(), removed.rend(), inserted.rbegin(), inserted.rend())
+                .first -
+            removed.rbegin());
+        removed.remove_suffix(tail);
+        inserted.remove_suffix(tail);
+
+        hunks.push_back({offset, std::string{removed}, std::string{inserted}});
+    }
+    return hunks;
+}
+
+void SnapshotHistory::forward(std::string& state, const Entry& entry) {
+    std::string result;
+    size_t pos = 0;
+    for (const auto& hunk : entry.hunks) {
+        result.append(state, pos, hunk.offset - pos);
+        result.append(hunk.inserted);
+        pos = hunk.offset + hunk.removed.size();
+    }
+    result.append(state, pos);
+    state = std::move(result);
+}
+
+void SnapshotHistory::backward(std::string& state, const Entry& entry) {
+    // Hunk offsets refer to the previous state, track the shift to positions in the current one
+    std::string result;
+    size_t pos = 0;
+    std::ptrdiff_t shift = 0;
+    for (const auto& hunk : entry.hunks) {
+        const auto offset = static_cast<size_t>(static_cast<std::ptrdiff_t>(hunk.offset) + shift);
+        result.append(state, pos, offset - pos);
+        result.append(hunk.removed);
+        pos = offset + hunk.inserted.size();
+        shift += static_cast<std::ptrdiff_t>(hunk.inserted.size()) -
+                 static_cast<std::ptrdiff_t>(hunk.removed.size());
+    }
+    result.append(state, pos);
+    state = std::move(result);
+}
+
+}  // namespace inviwo
@@ -101,10 +101,14 @@ void saveAllCanvases(ProcessorNetwork* network, const std::filesystem::path& dir
             auto path = dir / filepath.view();
 
             LogInfoCustom("util::saveAllCanvases", "Saving canvas to: " << path);
-            cp->saveImageLayer(path);
+            cp->saveImageLayerAsync(path);
         }
         i++;
     }
+    // The canvases are encoded in parallel, make sure all files exist before returning
+    for (auto cp : allConsideredCanvases) {
+        cp->waitForSavedImageLayers();
+    }
 }
 
 bool isValidIdentifierCharacter(char c, std::string_view extra) {
@@ -0,0 +1,277 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <inviwo/core/util/volumereorientation.h>
+
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/sourcecontext.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include <glm/gtx/component_wise.hpp>
+
+namespace inviwo {
+
+namespace {
+
+// Aim for at least this many bytes per parallel job
+constexpr size_t minBytesPerChunk = size_t{1} << 20;
+
+size_t chunkCount(size_t slabs, size_t slabBytes) {
+    return util::parallelChunkCount(slabs, std::max(size_t{1}, minBytesPerChunk /
+                                                                   std::max(slabBytes, size_t{1})));
+}
+
+/*
+ * Call the functor with the element size as a compile time constant for common voxel sizes, such
+ * that the per-voxel copies and swaps can be inlined. Other sizes are passed as 0, in which case
+ * the run time element size is used.
+ */
+template <typename F>
+void dispatchElementSize(size_t elementSize, F&& func) {
+    switch (elementSize) {
+        case 1:
+            return func(std::integral_constant<size_t, 1>{});
+        case 2:
+            return func(std::integral_constant<size_t, 2>{});
+        case 3:
+            return func(std::integral_constant<size_t, 3>{});
+        case 4:
+            return func(std::integral_constant<size_t, 4>{});
+        case 6:
+            return func(std::integral_constant<size_t, 6>{});
+        case 8:
+            return func(std::integral_constant<size_t, 8>{});
+        case 12:
+            return func(std::integral_constant<size_t, 12>{});
+        case 16:
+            return func(std::integral_constant<size_t, 16>{});
+        case 24:
+            return func(std::integral_constant<size_t, 24>{});
+        case 32:
+            return func(std::integral_constant<size_t, 32>{});
+        default:
+            return func(std::integral_constant<size_t, 0>{});
+    }
+}
+
+template <size_t N>
+void flipInPlace(std::byte* data, size_t elementSize, size3_t dims, std::array<bool, 3> flip) {
+    const size_t es = N == 0 ? elementSize : N;
+    const size_t rowBytes = dims.x * es;
+    const size_t sliceBytes = rowBytes * dims.y;
+
+    const auto swapVoxels = [es](std::byte* a, std::byte* b) { std::swap_ranges(a, a + es, b); };
+    // Swap two distinct rows, reversing them if the x-axis is flipped
+    const auto swapRows = [&](std::byte* a, std::byte* b) {
+        if (flip[0]) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                swapVoxels(a + x * es, b + (dims.x - 1 - x) * es);
+            }
+        } else {
+            std::swap_ranges(a, a + rowBytes, b);
+        }
+    };
+    const auto reverseRow = [&](std::byte* a) {
+        for (size_t x = 0; x < dims.x / 2; ++x) {
+            swapVoxels(a + x * es, a + (dims.x - 1 - x) * es);
+        }
+    };
+
+    // When flipping z, each job handles pairs of mirrored slices, otherwise single slices.
+    const size_t slabs = flip[2] ? (dims.z + 1) / 2 : dims.z;
+    util::forEachChunkParallel(
+        slabs, chunkCount(slabs, sliceBytes), [&](size_t, size_t begin, size_t end) {
+            for (size_t z = begin; z < end; ++z) {
+                const size_t mz = flip[2] ? dims.z - 1 - z : z;
+                auto* slice = data + z * sliceBytes;
+                auto* mirror = data + mz * sliceBytes;
+                if (z != mz) {
+                    for (size_t y = 0; y < dims.y; ++y) {
+                        const size_t my = flip[1] ? dims.y - 1 - y : y;
+                        swapRows(slice + y * rowBytes, mirror + my * rowBytes);
+                    }
+                } else if (flip[1]) {
+                    for (size_t y = 0; y < dims.y / 2; ++y) {
+                        swapRows(slice + y * rowBytes, slice + (dims.y - 1 - y) * rowBytes);
+                    }
+                    if (flip[0] && dims.y % 2 == 1) {
+                        reverseRow(slice + (dims.y / 2) * rowBytes);
+                    }
+                } else if (flip[0]) {
+                    for (size_t y = 0; y < dims.y; ++y) {
+                        reverseRow(slice + y * rowBytes);
+                    }
+                }
+            }
+        });
+}
+
+template <size_t N>
+void reorientCopy(const std::byte* src, std::byte* dst, size_t elementSize, size3_t dims,
+                  const util::VolumeReorientation& reorientation) {
+    const size_t es = N == 0 ? elementSize : N;
+    const auto rdims = reorientation.reorientedDimensions(dims);
+    const size_t rowBytes = rdims.x * es;
+
+    // Strides in the source, in voxels, when stepping along the axes of the reoriented volume
+    const std::array<std::ptrdiff_t, 3> srcStrides{
+        1, static_cast<std::ptrdiff_t>(dims.x), static_cast<std::ptrdiff_t>(dims.x * dims.y)};
+    std::array<std::ptrdiff_t, 3> strides{};
+    std::ptrdiff_t start = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        const auto axis = reorientation.permutation[i];
+        if (reorientation.flip[i]) {
+            strides[i] = -srcStrides[axis];
+            start += static_cast<std::ptrdiff_t>(dims[axis] - 1) * srcStrides[axis];
+        } else {
+            strides[i] = srcStrides[axis];
+        }
+    }
+    const bool contiguousRows = strides[0] == 1;
+
+    util::forEachChunkParallel(
+        rdims.z, chunkCount(rdims.z, rowBytes * rdims.y), [&](size_t, size_t begin, size_t end) {
+            for (size_t z = begin; z < end; ++z) {
+                for (size_t y = 0; y < rdims.y; ++y) {
+                    const auto srcIndex = start + static_cast<std::ptrdiff_t>(z) * strides[2] +
+                                          static_cast<std::ptrdiff_t>(y) * strides[1];
+                    auto* dstRow = dst + (z * rdims.y + y) * rowBytes;
+                    if (contiguousRows) {
+                        std::memcpy(dstRow, src + srcIndex * es, rowBytes);
+                    } else {
+                        for (size_t x = 0; x < rdims.x; ++x) {
+                            const auto index =
+                                srcIndex + static_cast<std::ptrdiff_t>(x) * strides[0];
+                            std::memcpy(dstRow + x * es, src + index * es, es);
+                        }
+                    }
+                }
+            }
+        });
+}
+
+void checkValid(const util::VolumeReorientation& reorientation) {
+    if (!reorientation.isValid()) {
+        throw Exception(IVW_CONTEXT_CUSTOM("util::reorientVolume"),
+                        "Invalid axis permutation ({}, {}, {})", reorientation.permutation[0],
+                        reorientation.permutation[1], reorientation.permutation[2]);
+    }
+}
+
+}  // namespace
+
+bool util::VolumeReorientation::isIdentity() const {
+    return isFlipOnly() && !flip[0] && !flip[1] && !flip[2];
+}
+
+bool util::VolumeReorientation::isFlipOnly() const {
+    return permutation == std::array<size_t, 3>{0, 1, 2};
+}
+
+bool util::VolumeReorientation::isValid() const {
+    auto sorted = permutation;
+    std::sort(sorted.begin(), sorted.end());
+    return sorted == std::array<size_t, 3>{0, 1, 2};
+}
+
+size3_t util::VolumeReorientation::reorientedDimensions(size3_t sourceDims) const {
+    return {sourceDims[permutation[0]], sourceDims[permutation[1]], sourceDims[permutation[2]]};
+}
+
+size3_t util::VolumeReorientation::sourceDimensions(size3_t reorientedDims) const {
+    size3_t dims{0};
+    for (size_t i = 0; i < 3; ++i) {
+        dims[permutation[i]] = reorientedDims[i];
+    }
+    return dims;
+}
+
+std::pair<size3_t, size3_t> util::VolumeReorientation::sourceRegion(size3_t reorientedDims,
+                                                                    size3_t offset,
+                                                                    size3_t extent) const {
+    size3_t sourceOffset{0};
+    size3_t sourceExtent{0};
+    for (size_t i = 0; i < 3; ++i) {
+        sourceOffset[permutation[i]] =
+            flip[i] ? reorientedDims[i] - offset[i] - extent[i] : offset[i];
+        sourceExtent[permutation[i]] = extent[i];
+    }
+    return {sourceOffset, sourceExtent};
+}
+
+void util::VolumeReorientation::reorientBasis(mat3& basis, vec3& offset) const {
+    const auto source = basis;
+    for (size_t i = 0; i < 3; ++i) {
+        basis[i] = source[permutation[i]];
+        if (flip[i]) {
+            offset += basis[i];
+            basis[i] = -basis[i];
+        }
+    }
+}
+
+size3_t util::reorientVolume(void* data, size_t elementSize, size3_t dims,
+                             const VolumeReorientation& reorientation) {
+    checkValid(reorientation);
+    if (reorientation.isIdentity() || glm::compMul(dims) == 0) {
+        return reorientation.reorientedDimensions(dims);
+    }
+
+    auto* bytes = static_cast<std::byte*>(data);
+    if (reorientation.isFlipOnly()) {
+        dispatchElementSize(elementSize, [&](auto n) {
+            flipInPlace<decltype(n)::value>(bytes, elementSize, dims, reorientation.flip);
+        });
+        return dims;
+    }
+
+    const auto size = glm::compMul(dims) * elementSize;
+    auto copy = std::make_unique<std::byte[]>(size);
+    std::memcpy(copy.get(), bytes, size);
+    return reorientVolume(copy.get(), bytes, elementSize, dims, reorientation);
+}
+
+size3_t util::reorientVolume(const void* src, void* dst, size_t elementSize, size3_t dims,
+                             const VolumeReorientation& reorientation) {
+    checkValid(reorientation);
+    if (glm::compMul(dims) == 0) return reorientation.reorientedDimensions(dims);
+
+    dispatchElementSize(elementSize, [&](auto n) {
+        reorientCopy<decltype(n)::value>(static_cast<const std::byte*>(src),
+                                         static_cast<std::byte*>(dst), elementSize, dims,
+                                         reorientation);
+    });
+    return reorientation.reorientedDimensions(dims);
+}
+
+}  // namespace inviwo
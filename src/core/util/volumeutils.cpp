@@ -29,6 +29,8 @@
 
 #include <inviwo/core/util/volumeutils.h>
 #include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
 
 namespace inviwo {
 
@@ -98,6 +100,14 @@ double voxelVolume(const Volume& volume) {
     return glm::dot(glm::cross(a, b), c);
 }
 
+const VolumeDisk* getRegionReader(const Volume& volume) {
+    if (!volume.hasRepresentation<VolumeDisk>() || volume.hasRepresentation<VolumeRAM>()) {
+        return nullptr;
+    }
+    const auto* disk = volume.getRepresentation<VolumeDisk>();
+    return disk->canReadRegion() ? disk : nullptr;
+}
+
 }  // namespace util
 
 }  // namespace inviwo
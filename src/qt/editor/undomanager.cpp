@@ -33,6 +33,8 @@
 #include <inviwo/qt/editor/undomanager.h>
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/snapshothistory.h>
 #include <inviwo/core/util/threadutil.h>
 #include <modules/qtwidgets/editorsettings.h>
 
@@ -50,6 +52,8 @@
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
+#include <deque>
+#include <functional>
 #include <vector>
 #include <string>
 #include <filesystem>
@@ -174,10 +178,93 @@ private:
     std::thread saver_;
 };
 
+/**
+ * Owns the SnapshotHistory and applies changes to it on a background thread, in the order they
+ * were queued, so that diffing the serialized workspaces does not block the GUI thread.
+ */
+class HistoryWorker {
+public:
+    using Job = std::function<void(SnapshotHistory&)>;
+
+    HistoryWorker()
+        : quit_{false}
+        , busy_{false}
+        , worker_{[this]() {
+            util::setThreadDescription("Inviwo Undo History");
+            for (;;) {
+                Job job;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    condition_.wait(lock, [this]() { return quit_ || !jobs_.empty(); });
+                    if (quit_) return;
+                    job = std::move(jobs_.front());
+                    jobs_.pop_front();
+                    busy_ = true;
+                }
+
+                try {
+                    job(history_);
+                } catch (const std::exception& e) {
+                    LogErrorCustom("UndoManager", "Error updating the undo history: " << e.what());
+                }
+
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    busy_ = false;
+                    if (jobs_.empty()) idle_.notify_all();
+                }
+            }
+        }} {}
+
+    ~HistoryWorker() {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            quit_ = true;
+        }
+        condition_.notify_one();
+        worker_.join();
+    }
+
+    /**
+     * Queue @p job to be run on the background thread
+     */
+    void post(Job job) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            jobs_.push_back(std::move(job));
+        }
+        condition_.notify_one();
+    }
+
+    /**
+     * Wait for all queued jobs to finish and then call @p func with the history on the calling
+     * thread
+     */
+    template <typename Func>
+    auto sync(Func&& func) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this]() { return jobs_.empty() && !busy_; });
+        return func(history_);
+    }
+
+private:
+    SnapshotHistory history_;
+
+    bool quit_;
+    bool busy_;
+    std::deque<Job> jobs_;
+    std::condition_variable condition_;
+    std::condition_variable idle_;
+    std::mutex mutex_;
+
+    std::thread worker_;
+};
+
 UndoManager::UndoManager(InviwoMainWindow* mainWindow)
     : mainWindow_(mainWindow)
     , manager_{mainWindow_->getInviwoApplication()->getWorkspaceManager()}
     , refPath_{filesystem::findBasePath()}
+    , history_{std::make_unique<HistoryWorker>()}
     , autoSaver_{std::make_unique<AutoSaver>(mainWindow_->getInviwoApplication())}
 
 {
@@ -226,15 +313,15 @@ void UndoManager::pushState() {
     } catch (...) {
         return;
     }
-    auto str = std::make_shared<const std::string>(std::move(stream).str());
 
     dirty_ = false;
-    if (head_ >= 0 && *str == *undoBuffer_[head_]) return;  // No Change
+    auto str = std::make_shared<const std::string>(std::move(stream).str());
+    if (current_ && *str == *current_) return;  // No Change
 
-    ++head_;
-    auto offset = std::min(std::distance(undoBuffer_.begin(), undoBuffer_.end()), head_);
-    undoBuffer_.erase(undoBuffer_.begin() + offset, undoBuffer_.end());
-    undoBuffer_.push_back(str);
+    current_ = str;
+    position_ = size_ == 0 ? 0 : position_ + 1;
+    size_ = position_ + 1;
+    history_->post([str](SnapshotHistory& history) { history.push(*str); });
 
     if (!mainWindow_->getInviwoApplication()->getProcessorNetwork()->empty()) {
         autoSaver_->save(str);
@@ -243,36 +330,35 @@ void UndoManager::pushState() {
     updateActions();
 }
 void UndoManager::undoState() {
-    if (head_ > 0) {
+    if (canUndo()) {
         util::KeepTrueWhileInScope restore(&isRestoring);
-        --head_;
-
-        std::stringstream stream;
-        stream << *undoBuffer_[head_];
-        manager_->load(stream, refPath_);
-
-        dirty_ = false;
-        updateActions();
+        --position_;
+        load(history_->sync([](SnapshotHistory& history) { return history.undo(); }));
     }
 }
 void UndoManager::redoState() {
-    if (head_ >= -1 && head_ < static_cast<DiffType>(undoBuffer_.size()) - 1) {
-
+    if (canRedo()) {
         util::KeepTrueWhileInScope restore(&isRestoring);
-        ++head_;
+        ++position_;
+        load(history_->sync([](SnapshotHistory& history) { return history.redo(); }));
+    }
+}
 
-        std::stringstream stream;
-        stream << *undoBuffer_[head_];
-        manager_->load(stream, refPath_);
+void UndoManager::load(std::shared_ptr<const std::string> state) {
+    current_ = state;
+    std::stringstream stream;
+    stream << *state;
+    manager_->load(stream, refPath_);
 
-        dirty_ = false;
-        updateActions();
-    }
+    dirty_ = false;
+    updateActions();
 }
 
 void UndoManager::clear() {
-    head_ = -1;
-    undoBuffer_.clear();
+    current_.reset();
+    position_ = 0;
+    size_ = 0;
+    history_->post([](SnapshotHistory& history) { history.clear(); });
 }
 
 QAction* UndoManager::getUndoAction() const { return undoAction_; }
@@ -296,9 +382,12 @@ void UndoManager::restore() {
     }
 }
 
+bool UndoManager::canUndo() const { return size_ > 0 && position_ > 0; }
+bool UndoManager::canRedo() const { return position_ + 1 < size_; }
+
 void UndoManager::updateActions() {
-    undoAction_->setEnabled(head_ > 0);
-    redoAction_->setEnabled(head_ >= -1 && head_ < static_cast<DiffType>(undoBuffer_.size()) - 1);
+    undoAction_->setEnabled(canUndo());
+    redoAction_->setEnabled(canRedo());
 }
 
 void UndoManager::onProcessorNetworkChange() { dirty_ = true; }
@@ -0,0 +1,354 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2023 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/moduleregistration.h>
+#include <inviwo/core/network/instrumentation.h>
+#include <inviwo/core/network/networklock.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/processornetworkevaluator.h>
+#include <inviwo/core/network/workspacemanager.h>
+#include <inviwo/core/processors/poolprocessor.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/rendercontext.h>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * End-to-end benchmarks of workspaces. Each given workspace is loaded through the
+ * WorkspaceManager without any GUI. Every iteration invalidates the source processors and waits
+ * until the network, including any background jobs of pool processors, is evaluated.
+ *
+ * Usage:
+ *     bm-workspace [benchmark options] [--source <processor id>]... [--threads <n>]
+ *                  <workspace>...
+ *
+ * If no --source is given, all processors without inports are invalidated. The reported time is
+ * the total wall time per evaluation. The counters hold, per iteration, the number of allocations
+ * and allocated bytes, and for each processor the average time (process and background jobs) and
+ * the allocations made while it ran. The allocations are counted by replacing the global operator
+ * new, and attributed to processors through the allocation counter of the Instrumentation.
+ * Allocations made by pool tasks that a processor dispatches itself are only included in the
+ * totals. On platforms where shared libraries do not use the replacement (e.g. Windows) only the
+ * allocations made in this executable are counted.
+ */
+
+namespace {
+
+std::atomic<size_t> allocations{0};
+std::atomic<size_t> allocatedBytes{0};
+thread_local size_t threadAllocations = 0;
+thread_local size_t threadAllocatedBytes = 0;
+
+void countAllocation(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    ++threadAllocations;
+    threadAllocatedBytes += size;
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    countAllocation(size);
+    if (auto* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    countAllocation(size);
+    const auto alignment = static_cast<std::size_t>(align);
+    // aligned_alloc requires the size to be a multiple of the alignment
+    const auto alignedSize =
+        std::max((size + alignment - 1) / alignment, std::size_t{1}) * alignment;
+#ifdef _MSC_VER
+    if (auto* ptr = _aligned_malloc(alignedSize, alignment)) return ptr;
+#else
+    if (auto* ptr = std::aligned_alloc(alignment, alignedSize)) return ptr;
+#endif
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+#ifdef _MSC_VER
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+namespace inviwo {
+
+namespace {
+
+Instrumentation::Allocations threadAllocationCounter() {
+    return {threadAllocations, threadAllocatedBytes};
+}
+
+/**
+ * Signals when a task is added to the front (main thread) queue of the application
+ */
+class FrontQueueSignal {
+public:
+    void notify() {
+        {
+            std::scoped_lock lock{mutex_};
+            ++enqueued_;
+        }
+        condition_.notify_all();
+    }
+
+    size_t enqueued() {
+        std::scoped_lock lock{mutex_};
+        return enqueued_;
+    }
+
+    /**
+     * Wait until more than @p seen tasks have been enqueued or @p timeout has passed
+     */
+    void waitForMore(size_t seen, std::chrono::milliseconds timeout) {
+        std::unique_lock lock{mutex_};
+        condition_.wait_for(lock, timeout, [&]() { return enqueued_ > seen; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    size_t enqueued_ = 0;
+};
+
+FrontQueueSignal frontQueue;
+
+struct Options {
+    std::vector<std::filesystem::path> workspaces;
+    std::vector<std::string> sources;
+    std::optional<size_t> threads;
+};
+
+std::vector<Processor*> findSources(ProcessorNetwork& network,
+                                    const std::vector<std::string>& ids) {
+    std::vector<Processor*> sources;
+    if (ids.empty()) {
+        network.forEachProcessor([&](Processor* p) {
+            if (p->getInports().empty()) sources.push_back(p);
+        });
+    } else {
+        for (const auto& id : ids) {
+            if (auto* p = network.getProcessorByIdentifier(id)) {
+                sources.push_back(p);
+            } else {
+                throw Exception(fmt::format("Source processor '{}' not found", id),
+                                IVW_CONTEXT_CUSTOM("bm-workspace"));
+            }
+        }
+    }
+    return sources;
+}
+
+bool hasBackgroundJobs(ProcessorNetwork& network) {
+    bool busy = false;
+    network.forEachProcessor([&](Processor* p) {
+        if (auto* pp = dynamic_cast<PoolProcessor*>(p)) busy |= pp->hasJobs();
+    });
+    return busy;
+}
+
+/**
+ * Process queued front tasks until the network is valid and no background jobs remain. Sleeps
+ * while there are no front tasks, finished background jobs enqueue their results as front tasks.
+ * The timeout covers pool tasks that finish without doing so.
+ */
+void waitForNetwork(InviwoApplication& app) {
+    auto& network = *app.getProcessorNetwork();
+    while (true) {
+        const auto seen = frontQueue.enqueued();
+        if (app.processFront() != 0) continue;
+        if (app.getThreadPool().getQueueSize() == 0 && !hasBackgroundJobs(network)) break;
+        frontQueue.waitForMore(seen, std::chrono::milliseconds{10});
+    }
+}
+
+void evaluateWorkspace(benchmark::State& state, InviwoApplication& app,
+                       const std::filesystem::path& workspace,
+                       const std::vector<std::string>& sourceIds) {
+    auto& network = *app.getProcessorNetwork();
+
+    std::string error;
+    const auto onError = [&](ExceptionContext) {
+        try {
+            throw;
+        } catch (const Exception& e) {
+            error = e.getMessage();
+        } catch (const std::exception& e) {
+            error = e.what();
+        } catch (...) {
+            error = "Unknown error";
+        }
+    };
+
+    std::vector<Processor*> sources;
+    try {
+        app.getWorkspaceManager()->load(workspace, onError);
+        waitForNetwork(app);
+        sources = findSources(network, sourceIds);
+    } catch (...) {
+        onError(IVW_CONTEXT_CUSTOM("bm-workspace"));
+    }
+    if (!error.empty()) {
+        state.SkipWithError(error.c_str());
+        app.getWorkspaceManager()->clear();
+        return;
+    }
+
+    auto& instrumentation = *app.getProcessorNetworkEvaluator()->getInstrumentation();
+    instrumentation.clear();
+    instrumentation.setAllocationCounter(&threadAllocationCounter);
+    instrumentation.setEnabled(true);
+    const auto evaluationsBefore = instrumentation.getEvaluationCount();
+    const auto allocationsBefore = allocations.load();
+    const auto allocatedBytesBefore = allocatedBytes.load();
+
+    for (auto _ : state) {
+        {
+            NetworkLock lock{&network};
+            for (auto* source : sources) source->invalidate(InvalidationLevel::InvalidOutput);
+        }
+        waitForNetwork(app);
+    }
+
+    instrumentation.setEnabled(false);
+    instrumentation.setAllocationCounter(nullptr);
+
+    using Counter = benchmark::Counter;
+    state.counters["Evaluations"] = Counter(
+        static_cast<double>(instrumentation.getEvaluationCount() - evaluationsBefore),
+        Counter::kAvgIterations);
+    state.counters["Allocations"] = Counter(
+        static_cast<double>(allocations.load() - allocationsBefore), Counter::kAvgIterations);
+    state.counters["AllocatedBytes"] =
+        Counter(static_cast<double>(allocatedBytes.load() - allocatedBytesBefore),
+                Counter::kAvgIterations, Counter::kIs1024);
+
+    using Seconds = std::chrono::duration<double>;
+    for (const auto& summary : instrumentation.summarize()) {
+        const auto time = summary.initializeResources + summary.portOnChange + summary.process +
+                          summary.backgroundJob;
+        state.counters[summary.processor] =
+            Counter(Seconds(time).count(), Counter::kAvgIterations);
+        state.counters[summary.processor + "/Allocations"] = Counter(
+            static_cast<double>(summary.allocations.count), Counter::kAvgIterations);
+        state.counters[summary.processor + "/AllocatedBytes"] =
+            Counter(static_cast<double>(summary.allocations.bytes), Counter::kAvgIterations,
+                    Counter::kIs1024);
+    }
+    instrumentation.clear();
+
+    app.getWorkspaceManager()->clear();
+}
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg{argv[i]};
+        if (arg == "--source" && i + 1 < argc) {
+            options.sources.emplace_back(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            options.threads = std::stoul(argv[++i]);
+        } else {
+            options.workspaces.emplace_back(arg);
+        }
+    }
+    return options;
+}
+
+}  // namespace
+
+}  // namespace inviwo
+
+int main(int argc, char** argv) {
+    using namespace inviwo;
+
+    benchmark::Initialize(&argc, argv);
+    const auto options = parseOptions(argc, argv);
+    if (options.workspaces.empty()) {
+        std::cerr << "Usage: bm-workspace [benchmark options] [--source <processor id>]... "
+                     "[--threads <n>] <workspace>...\n";
+        return 1;
+    }
+
+    LogCentral logCentral;
+    LogCentral::init(&logCentral);
+
+    // Only pass the program name on, the remaining arguments are ours
+    int appArgc = 1;
+    InviwoApplication app(appArgc, argv, "Inviwo-Benchmarks");
+    app.registerModules(getModuleList());
+    if (options.threads) app.resizePool(*options.threads);
+    app.setPostEnqueueFront([]() { frontQueue.notify(); });
+    RenderContext::getPtr()->activateDefaultRenderContext();
+
+    for (const auto& workspace : options.workspaces) {
+        benchmark::RegisterBenchmark(
+            fmt::format("Workspace/{}", workspace.stem().string()).c_str(),
+            [&app, workspace, &sources = options.sources](benchmark::State& state) {
+                evaluateWorkspace(state, app, workspace, sources);
+            })
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    app.getProcessorNetwork()->clear();
+    return 0;
+}